@@ -33,6 +33,7 @@
 // Include hardware headers
 #include "hardware/dma.h"
 #include "hardware/clocks.h"
+#include "hardware/irq.h"
 #include "hardware/structs/timer.h"
 
 // SSD1306 OLED display headers
@@ -45,6 +46,9 @@
 // Include SPI ram
 #include "spi_ram.h"
 
+// USB (CDC stdio + MIDI)
+#include "tusb.h"
+
 // ============================================================================
 // === TIming & Debugging =====================================================
 // ============================================================================
@@ -52,8 +56,7 @@
 // These do not represent real frequencies
 // Overclocking system clock causes strange behavior 
 // === CONFIGURATION CONSTANTS ===
-#define SYSTEM_CLOCK_MHZ     250   // 250 MHz system clock
-#define PERIPHERAL_CLOCK_MHZ 125   // 100 MHz peripheral clock
+#define SYSTEM_CLOCK_MHZ     250   // Upper limit, the clock planner picks the exact-ratio clock below it
 #define SPI_TARGET_HZ         42   // 42 MHz
 #define I2C_TARGET_HZ       1000   // 1000 kHz
 
@@ -78,6 +81,26 @@ uint8_t default_led_state = 0x01;
 // This will cause the loss of stereo channels when using other effects in front!
 #define STEREO  false 
 
+// Channel layout and rounding of the C++ block kernels (src/kernels)
+#define KERNEL_LAYOUT   (STEREO ? DSP_STEREO : DSP_MONO)
+#define KERNEL_QUALITY  DSP_Q_EXACT     // DSP_Q_FAST: truncating multiplies, < 1 LSB at 24 bit
+
+// Run delay / reverb wet in larger blocks at a lower priority (see deferred.h)
+#define LATENCY_SPLIT   true
+#define DEFER_FRAMES            96                              // 2 ms at 48 kHz
+#define DEFER_LATENCY_FRAMES    (LATENCY_SPLIT ? 2 * DEFER_FRAMES : 0)  // Delay and reverb tap this much early
+
+// Lower clk_sys while the chain is light (see clock_governor.h)
+#define CLOCK_GOVERNOR  true
+
+// Per-effect entry points for the cycle emulator (tools/m0sim.py), set by cmake -DKERNEL_BENCH=ON
+#ifndef KERNEL_BENCH
+#define KERNEL_BENCH    0
+#endif
+
+// Measure SRAM bank contention between the cores at boot (see mem_bench.h), printed in DEBUG
+#define MEM_BENCH       0
+
 // Alarm interval in microseconds
 #define DEBUG_INTERVAL_US   1000000  //  1.0  second
 #define CPU_INTERVAL_US      500000  //  0.5  second
@@ -124,16 +147,17 @@ volatile bool ui_park_req = false;  // Core0 asks Core1 to park
 volatile bool ui_park_ack = false;  // Core1 acknowledges it's parked
 
 // Include the files where we dumped some of the code
+#include "mem_layout.h"     // SRAM bank placement table, before anything placed by it
+#include "mem_bench.h"
 #include "io.h"
 #include "ui_main.h"
 #include "var_conversion.h"
 #include "audio.h"
-#include "flash.h"
+#include "spectrum.h"
+#include "clock_plan.h"
 
-// Update on single-pot change for the selected preamp
-static inline void update_preamp_from_pots(int changed_pot){
-    if (changed_pot < 0 || changed_pot > 5) return;
-    storedPreampPotValue[selected_preamp_style][changed_pot] = pot_value[changed_pot];
+// Reload the parameters of the selected preamp
+static inline void load_selected_preamp_params(void){
     switch (selected_preamp_style) {
         case FENDER:
             load_fender_params_from_memory();   break;
@@ -146,6 +170,13 @@ static inline void update_preamp_from_pots(int changed_pot){
     }
 }
 
+// Update on single-pot change for the selected preamp
+static inline void update_preamp_from_pots(int changed_pot){
+    if (changed_pot < 0 || changed_pot > 5) return;
+    storedPreampPotValue[selected_preamp_style][changed_pot] = pot_value[changed_pot];
+    load_selected_preamp_params();
+}
+
 // ============================================================================
 // === POT changes and effects ================================================
 // ============================================================================
@@ -166,9 +197,127 @@ static EffectUpdateFn effect_param_updaters[NUM_EFFECTS] = {
     [REVB_EFFECT_INDEX]     = update_reverb_params_from_pots,
     [CAB_SIM_EFFECT_INDEX]  = update_speaker_sim_params_from_pots,
     [TREM_EFFECT_INDEX]     = update_tremolo_params_from_pots,
-    [VIBR_EFFECT_INDEX]     = update_vibrato_params_from_pots
+    [VIBR_EFFECT_INDEX]     = update_vibrato_params_from_pots,
+    [WAH_EFFECT_INDEX]      = update_wah_params_from_pots,
+    [MBC_EFFECT_INDEX]      = update_mb_compressor_params_from_pots
 };
 
+typedef void (*EffectLoadFn)(void);
+
+// Recompute all coefficients of an effect from its stored pots
+static EffectLoadFn effect_param_loaders[NUM_EFFECTS] = {
+    [CHRS_EFFECT_INDEX]     = load_chorus_parms_from_memory,
+    [COMP_EFFECT_INDEX]     = load_compressor_parms_from_memory,
+    [DELAY_EFFECT_INDEX]    = load_delay_parms_from_memory,
+    [DS_EFFECT_INDEX]       = load_distortion_parms_from_memory,
+    [EQ_EFFECT_INDEX]       = load_eq_parms_from_memory,
+    [FLNG_EFFECT_INDEX]     = load_flanger_parms_from_memory,
+    [FZ_EFFECT_INDEX]       = load_fuzz_parms_from_memory,
+    [OD_EFFECT_INDEX]       = load_overdrive_parms_from_memory,
+    [PHSR_EFFECT_INDEX]     = load_phaser_parms_from_memory,
+    [PREAMP_EFFECT_INDEX]   = load_selected_preamp_params,
+    [REVB_EFFECT_INDEX]     = load_reverb_parms_from_memory,
+    [CAB_SIM_EFFECT_INDEX]  = load_speaker_sim_parms_from_memory,
+    [TREM_EFFECT_INDEX]     = load_tremolo_parms_from_memory,
+    [VIBR_EFFECT_INDEX]     = load_vibrato_parms_from_memory,
+    [WAH_EFFECT_INDEX]      = load_wah_parms_from_memory,
+    [MBC_EFFECT_INDEX]      = load_mb_compressor_parms_from_memory
+};
+
+// Publish an effect's coefficients from its stored pots (core 1, -1 = none).
+// The loader writes the inactive copy of the effect's coefficient bank, the
+// effect switches to it at the start of its next block.
+static void effect_publish(int effect) {
+    if (effect >= 0 && effect < NUM_EFFECTS && effect_param_loaders[effect]) effect_param_loaders[effect]();
+}
+
+// Clear the filter states of an effect (only while its slot is off)
+static void reset_effect_state(int effect){
+    switch (effect) {
+        case COMP_EFFECT_INDEX: reset_compressor_state(); break;
+        case MBC_EFFECT_INDEX:  reset_mb_compressor_state(); break;
+        case DS_EFFECT_INDEX:   reset_distortion_state(); break;
+        case EQ_EFFECT_INDEX:   reset_eq_state();         break;
+        case FZ_EFFECT_INDEX:   reset_fuzz_state();       break;
+        case OD_EFFECT_INDEX:   reset_overdrive_state();  break;
+        case PREAMP_EFFECT_INDEX:
+            reset_fender_state();
+            reset_vox_state();
+            reset_marshall_state();
+            reset_slo_state();
+            reset_power_amp_state();
+            break;
+        default:
+            break;
+    }
+}
+
+#include "boot.h"    // Background init of the effects, OLED and delay RAM
+
+// ============================================================================
+// === Slot transitions (core 1 side) =========================================
+// ============================================================================
+
+#include "routing.h"
+#include "deferred.h"
+#include "clock_governor.h"
+
+// Bypass toggles and effect changes are not applied to the audio directly:
+// core 1 publishes the wanted effect per slot (-1 = bypassed) once the new
+// effect is pre-warmed, and core 0 crossfades to it (see slot_process_block).
+static volatile int8_t slot_target[ROUTE_MAX_SLOTS]  = { -1, -1, -1, -1, -1, -1 };   // Core 1 -> core 0
+static volatile int8_t slot_running[ROUTE_MAX_SLOTS] = { -1, -1, -1, -1, -1, -1 };   // Core 0 -> core 1 (incl. fading)
+
+// Clean state and fresh coefficients before an effect fades in
+static void prewarm_effect(int effect) {
+    if (boot_clean_mask & (1u << effect)) boot_clean_mask &= ~(1u << effect);   // Cleared by the boot
+    else if (effect == DELAY_EFFECT_INDEX) clear_delay_memory();
+    else if (effect == REVB_EFFECT_INDEX) clear_reverb_memory();
+    else                                  reset_effect_state(effect);
+
+    if (effect_param_loaders[effect]) effect_param_loaders[effect]();
+}
+
+// Effect a slot should run: footswitch slots follow the LEDs, the extra
+// slots their host setting, slots outside the routing graph nothing
+static inline int8_t slot_wanted_effect(int slot) {
+    if (!(route_slot_mask & (1u << slot))) return -1;
+    if (slot >= 3) return route_extra_effect[slot - 3];
+    return (led_state & (1 << slot)) ? (int8_t)selectedEffects[slot] : -1;
+}
+
+// Follow the LEDs / selected effects (call from the core 1 loop)
+static void update_slot_targets(void) {
+    for (int slot = 0; slot < ROUTE_MAX_SLOTS; slot++) {
+        int8_t want = slot_wanted_effect(slot);
+        if (want == slot_target[slot]) continue;
+
+        if (want >= 0) {
+            // Still being set up by the boot: the slot stays dry until then
+            if (!boot_effect_ready(want)) continue;
+
+            // Moved from another slot: wait until that slot has faded it out
+            bool busy = false;
+            for (int other = 0; other < ROUTE_MAX_SLOTS; other++) {
+                if (other != slot && slot_running[other] == want) busy = true;
+            }
+            if (busy || deferred_effect_busy(want)) continue;
+
+            // Heavier chain: full clock first, the governor lowers it again if it fits
+            if (!governor_boost()) continue;
+
+            // Still fading out here: take it back as it is, otherwise start clean
+            if (slot_running[slot] != want) prewarm_effect(want);
+        }
+
+        __dmb();                        // State and coefficients before the switch
+        slot_target[slot] = want;
+    }
+}
+
+#include "preset.h"
+#include "flash.h"      // After preset.h, the settings record holds the morph presets
+
 // ============================================================================
 // === CPU RESOURCES ==========================================================
 // ============================================================================
@@ -178,6 +327,12 @@ static volatile uint32_t interrupt_count = 0;
 static volatile uint64_t total_duration_us = 0;
 static uint64_t cpu0_loop_start_time_us = 0;
 
+// Block time histogram (host telemetry): eighths of the block period, last bin = late block
+#define CPU_HIST_BINS           8
+#define CPU_BLOCK_PERIOD_US     ((AUDIO_BUFFER_FRAMES * 1000000u) / SAMPLE_RATE)
+static volatile uint32_t cpu0_hist[CPU_HIST_BINS + 1];
+static volatile uint32_t cpu0_xruns = 0;        // Blocks that took longer than their period
+
 static inline void cpu0_task_start(void) {
     cpu0_loop_start_time_us = time_us_64();
 }
@@ -189,6 +344,13 @@ static inline void cpu0_task_end(void) {
         cpu0_peak_us = duration;
         cpu0_peak_usage = ((float)duration / sample_period_us) * 100.0f;
     }
+
+    uint32_t bin = (uint32_t)duration * CPU_HIST_BINS / CPU_BLOCK_PERIOD_US;
+    if (bin >= CPU_HIST_BINS) {
+        bin = CPU_HIST_BINS;
+        cpu0_xruns++;
+    }
+    cpu0_hist[bin]++;
 }
 
 void CPU_usage_counter() {
@@ -246,19 +408,79 @@ void reset_cpu1_time(void){
     cpu1_sample_count = 0;
 }
 
+// === I2S ring state (see the elastic output slack at the DMA handler) ===
+#define I2S_DEPTH_MIN       2
+#define I2S_SHRINK_BLOCKS   (2 * SAMPLE_RATE / AUDIO_BUFFER_FRAMES)     // 2 s stable
+
+static uint8_t           i2s_next_in          = 0;              // Next input block to process
+static volatile uint8_t  i2s_depth            = I2S_DEPTH_MIN;  // Output lead in blocks (= latency)
+static uint32_t          i2s_stable           = 0;              // Blocks in a row with a spare block
+static volatile uint16_t i2s_slack_frames     = 0;              // Last block: frames before its output plays
+static volatile uint16_t i2s_min_slack_frames = 0xFFFF;         // Lowest since the telemetry reset
+static volatile uint32_t i2s_grows            = 0;
+static volatile uint32_t i2s_underruns        = 0;              // Output slot already playing when written
+
+#include "host_control.h"   // Needs the loaders, presets, CPU counters and ring state
+
 // ============================================================================
 // === AUDIO Processing =======================================================
 // ============================================================================
 
 // I2S configuration
-static __attribute__((aligned(8))) pio_i2s i2s;
+static PLACE_I2S_DMA __attribute__((aligned(I2S_RING_BUFFERS * 4))) pio_i2s i2s;
+
+// Crossfades: bypass toggles, effect changes and the power amp switch
+#define SLOT_XFADE_MS       8
+#define SLOT_XFADE_STEP     (Q16_ONE / (SLOT_XFADE_MS * SAMPLE_RATE / 1000))
+
+// Ramp from the dry copy to the processed block (in place), g moves to target
+static inline __attribute__((always_inline))
+uint32_t xfade_ramp_block(const int32_t* dry_l, const int32_t* dry_r, int32_t* in_l, int32_t* in_r,
+                          size_t frames, uint32_t g, uint32_t target) {
+    for (size_t i = 0; i < frames; i++) {
+        if (target > g) g = (Q16_ONE - g <= SLOT_XFADE_STEP) ? Q16_ONE : g + SLOT_XFADE_STEP;
+        else            g = (g <= SLOT_XFADE_STEP) ? 0 : g - SLOT_XFADE_STEP;
+        in_l[i] = lerp_fixed(dry_l[i], in_l[i], g);
+        in_r[i] = lerp_fixed(dry_r[i], in_r[i], g);
+    }
+    return g;
+}
+
+// Power amp after the preamp: power_amp_enabled (core 1) is the wanted state,
+// core 0 fades the stage in / out over SLOT_XFADE_MS
+static uint32_t pa_mix_q16 = 0;                     // Power amp share (core 0)
+static PLACE_ROUTING int32_t pa_dry_l[AUDIO_BUFFER_FRAMES];
+static PLACE_ROUTING int32_t pa_dry_r[AUDIO_BUFFER_FRAMES];
+
+static inline __attribute__((always_inline))
+void power_amp_stage_block(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo, const PowerAmpCoefs* c) {
+    uint32_t target = power_amp_enabled ? Q16_ONE : 0;
+    uint32_t g      = pa_mix_q16;
+
+    // Settled
+    if (g == target) {
+        if (g) power_amp_process_block(in_l, in_r, frames, stereo, c);
+        return;
+    }
+
+    // Fading in from off: start from clean sag / shelf states
+    if (g == 0) reset_power_amp_state();
 
-// Selected effects processing per sample
+    memcpy(pa_dry_l, in_l, frames * sizeof(int32_t));
+    memcpy(pa_dry_r, in_r, frames * sizeof(int32_t));
+    power_amp_process_block(in_l, in_r, frames, stereo, c);
+    pa_mix_q16 = xfade_ramp_block(pa_dry_l, pa_dry_r, in_l, in_r, frames, g, target);
+}
+
+// Run one effect on a block (in place)
 static inline __attribute__((always_inline))
-void process_selected_effect_block(int slot, int32_t* in_l, int32_t* in_r, size_t frames) {
-    switch (selectedEffects[slot]) {
+void process_selected_effect_block_for(int effect, int32_t* in_l, int32_t* in_r, size_t frames) {
+    // Dual mono: each chain keeps one side only, so the modulation effects run their mono modes
+    const bool dual = route_block_dual;
+
+    switch (effect) {
         case CHRS_EFFECT_INDEX:
-            chorus_process_block(in_l, in_r, frames, selected_chorus_mode); break;
+            chorus_process_block(in_l, in_r, frames, dual ? (FXmode)MONO : selected_chorus_mode); break;
 
         case COMP_EFFECT_INDEX:
             compressor_process_block(in_l, in_r, frames, STEREO); break;
@@ -270,10 +492,10 @@ void process_selected_effect_block(int slot, int32_t* in_l, int32_t* in_r, size_
             distortion_process_block(in_l, in_r, frames, STEREO); break;
 
         case EQ_EFFECT_INDEX:
-            eq_process_block(in_l, in_r, frames, STEREO); break;
+            dsp_eq_block(coef_live(&eq_bank), eq_state, in_l, in_r, frames, KERNEL_LAYOUT, KERNEL_QUALITY); break;
 
         case FLNG_EFFECT_INDEX:
-            flanger_process_block(in_l, in_r, frames, selected_flanger_mode); break;
+            flanger_process_block(in_l, in_r, frames, dual ? FX_MONO : selected_flanger_mode); break;
 
         case FZ_EFFECT_INDEX:
             fuzz_process_block(in_l, in_r, frames, STEREO); break;
@@ -282,40 +504,337 @@ void process_selected_effect_block(int slot, int32_t* in_l, int32_t* in_r, size_
             overdrive_process_block(in_l, in_r, frames, STEREO); break;
 
         case PHSR_EFFECT_INDEX:
-            phaser_process_block(in_l, in_r, frames, selected_phaser_mode); break;
+            phaser_process_block(in_l, in_r, frames, dual ? FX_MONO : selected_phaser_mode); break;
 
         case PREAMP_EFFECT_INDEX:   // [NEW]
-            // Check what preamp processing is required
-            switch (selected_preamp_style) {
-                case FENDER:
-                    fender_preamp_process_block(in_l, in_r, frames, STEREO);    break;
-                case VOX_AC:
-                    vox_preamp_process_block(in_l, in_r, frames, STEREO);       break;
-                case MARSHALL:
-                    marshall_preamp_process_block(in_l, in_r, frames, STEREO);  break;
-                case SOLDANO:
-                    slo_preamp_process_block(in_l, in_r, frames, STEREO);       break;
-            } break;
+            // Drive trim from the expression pedal (no-op at unity)
+            preamp_drive_trim_block(in_l, in_r, frames);
+
+            // Two preamps in parallel (mono in, stereo out), power amp voiced from both
+            if (dual_amp_active()) {
+                const DualAmpCoefs* dc = coef_live(&dual_bank);
+                PowerAmpCoefs pa_dual;
+                dual_amp_power_coefs(&pa_dual, dc);
+                dual_amp_process_block(in_l, in_r, frames, dc, dual);
+                power_amp_stage_block(in_l, in_r, frames, true, &pa_dual);
+                break;
+            }
+
+            preamp_style_process_block(selected_preamp_style, in_l, in_r, frames, STEREO);
+
+            // Optional power amp + sag stage
+            power_amp_stage_block(in_l, in_r, frames, STEREO, &pa_coef[selected_preamp_style]);
+            break;
 
         case REVB_EFFECT_INDEX:
             reverb_process_block(in_l, in_r, frames); break;
 
         case CAB_SIM_EFFECT_INDEX:
-            speaker_sim_process_block(in_l, in_r, frames, STEREO); break;
+            dsp_cab_block(coef_live(&cab_bank), cab_state, in_l, in_r, frames, KERNEL_LAYOUT, KERNEL_QUALITY); break;
 
         case TREM_EFFECT_INDEX:
-            tremolo_process_block(in_l, in_r, frames, selected_tremolo_mode); break;
+            tremolo_process_block(in_l, in_r, frames, dual ? FX_MONO : selected_tremolo_mode); break;
 
         case VIBR_EFFECT_INDEX:
-            vibrato_process_block(in_l, in_r, frames, selected_vibrato_mode); break;
+            vibrato_process_block(in_l, in_r, frames, dual ? FX_MONO : selected_vibrato_mode); break;
+
+        case WAH_EFFECT_INDEX:
+            wah_process_block(in_l, in_r, frames, STEREO); break;
+
+        case MBC_EFFECT_INDEX:
+            mb_compressor_process_block(in_l, in_r, frames, STEREO); break;
         default:
             break;
     }
 }
 
-// Split buffers across scratch banks (reduce bus contention)
-static __attribute__((aligned(8), section(".scratch_x"))) int32_t buffer_l[AUDIO_BUFFER_FRAMES];
-static __attribute__((aligned(8), section(".scratch_y"))) int32_t buffer_r[AUDIO_BUFFER_FRAMES];
+// ============================================================================
+// === Deferred wet path (core 0, lowest priority) ============================
+// ============================================================================
+
+// Effect in a slot: split effects go through their lane, the rest run here
+static inline __attribute__((always_inline))
+void slot_effect_block(int effect, int32_t* in_l, int32_t* in_r, size_t frames) {
+    if (deferred_lane(effect) >= 0) deferred_process_block(effect, in_l, in_r, frames);
+    else                            process_selected_effect_block_for(effect, in_l, in_r, frames);
+}
+
+// Runs the queued lanes wet-only; the DMA ISR preempts it
+static void __not_in_flash_func(deferred_irq_handler)(void) {
+    for (;;) {
+        const uint8_t  b        = defer_job_buf;
+        const uint32_t start_us = time_us_32();
+        bool ran[DEFER_NUM_LANES];
+
+        for (int k = 0; k < DEFER_NUM_LANES; k++) {
+            DeferLane* ln = &defer_lane[k];
+            ln->valid[b] = false;           // out[b] is rewritten from here
+            ran[k] = ln->fed[b];
+            if (!ran[k]) continue;
+            memcpy(ln->out_l[b], ln->in_l[b], sizeof(ln->out_l[b]));
+            memcpy(ln->out_r[b], ln->in_r[b], sizeof(ln->out_r[b]));
+            __dmb();                        // Copy done before the late flag is read
+
+            // Cycle closed under the copy: in[b] is being refilled, run silence
+            if (defer_job_late) {
+                memset(ln->out_l[b], 0, sizeof(ln->out_l[b]));
+                memset(ln->out_r[b], 0, sizeof(ln->out_r[b]));
+            }
+            deferred_run_lane(k, b);
+        }
+        if (CLOCK_GOVERNOR) governor_job_done(time_us_32() - start_us);     // Wall time, ISR included
+        __dmb();                            // Output before it is published
+
+        // Publish unless the ISR already moved on to b (then fed[b] is its new input)
+        uint32_t irq = save_and_disable_interrupts();
+        if (!defer_job_late) {
+            for (int k = 0; k < DEFER_NUM_LANES; k++) {
+                if (!ran[k]) continue;
+                defer_lane[k].valid[b] = true;
+                defer_lane[k].fed[b]   = false;
+            }
+        }
+
+        // A block closed while this job was late: run it now
+        if (defer_queued >= 0) {
+            defer_job_buf  = (uint8_t)defer_queued;
+            defer_queued   = -1;
+            defer_job_late = false;
+            restore_interrupts(irq);
+            continue;
+        }
+        defer_busy = false;
+        restore_interrupts(irq);
+        return;
+    }
+}
+
+// Claim a spare IRQ below the DMA priority (core 0, before I2S starts)
+static void init_deferred(void) {
+    if (!LATENCY_SPLIT) return;
+
+    delay_wet_only  = true;             // The ISR mixes their dry share
+    reverb_wet_only = true;
+
+    defer_irq = (uint)user_irq_claim_unused(true);
+    irq_set_exclusive_handler(defer_irq, deferred_irq_handler);
+    irq_set_priority(defer_irq, PICO_LOWEST_IRQ_PRIORITY);
+    irq_set_enabled(defer_irq, true);
+}
+
+// ============================================================================
+// === Kernel bench (tools/m0sim.py) ==========================================
+// ============================================================================
+//
+// Entry points the host emulator calls on the ELF: kernel_bench_prepare()
+// sets an effect up like the boot does, kernel_bench_block() runs one block
+// of it from RAM, the way the DMA ISR runs it in a slot. Not called by the
+// firmware itself: `retain` (GCC 11+) and the --undefined link options in
+// CMakeLists.txt keep --gc-sections from dropping them.
+
+#if KERNEL_BENCH
+#define KERNEL_BENCH_EXPORT __attribute__((used, retain))
+
+const uint8_t  KERNEL_BENCH_EXPORT kernel_bench_num_effects = NUM_EFFECTS;
+const uint16_t KERNEL_BENCH_EXPORT kernel_bench_frames      = AUDIO_BUFFER_FRAMES;
+const uint32_t KERNEL_BENCH_EXPORT kernel_bench_rate        = SAMPLE_RATE;
+
+static int32_t kernel_bench_src[2][AUDIO_BUFFER_FRAMES];
+static int32_t kernel_bench_l[AUDIO_BUFFER_FRAMES];
+static int32_t kernel_bench_r[AUDIO_BUFFER_FRAMES];
+
+const char* KERNEL_BENCH_EXPORT __attribute__((noinline)) kernel_bench_name(int effect) {
+    return allEffects[effect];
+}
+
+// Effect state, coefficients and a test signal (-18 dBFS noise), false = needs hardware
+bool KERNEL_BENCH_EXPORT __attribute__((noinline)) kernel_bench_prepare(int effect) {
+    uint32_t seed = 0x12345678u + (uint32_t)effect;
+    for (int i = 0; i < AUDIO_BUFFER_FRAMES; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        kernel_bench_src[0][i] = (int32_t)seed >> 11;
+        seed = seed * 1664525u + 1013904223u;
+        kernel_bench_src[1][i] = (int32_t)seed >> 11;
+    }
+    if (effect == DELAY_EFFECT_INDEX) return false;     // SPI RAM
+    if (!coef_lock) coef_bank_init();                   // No core 1 here
+    boot_init_effect(effect);
+    return true;
+}
+
+// One block of an effect (-1 = only the copy, the overhead to subtract)
+void KERNEL_BENCH_EXPORT __attribute__((noinline)) __not_in_flash_func(kernel_bench_block)(int effect) {
+    for (int i = 0; i < AUDIO_BUFFER_FRAMES; i++) {
+        kernel_bench_l[i] = kernel_bench_src[0][i];
+        kernel_bench_r[i] = kernel_bench_src[1][i];
+    }
+    if (effect >= 0) process_selected_effect_block_for(effect, kernel_bench_l, kernel_bench_r, AUDIO_BUFFER_FRAMES);
+}
+#endif
+
+// ============================================================================
+// === Slot transitions (core 0 side) =========================================
+// ============================================================================
+
+typedef struct {
+    int8_t   effect;                    // Effect in the slot (-1 = dry)
+    uint32_t gain_q16;                  // Wet share, Q16_ONE when settled
+} SlotXfade;
+
+static SlotXfade slot_xfade[ROUTE_MAX_SLOTS] = { { -1, 0 }, { -1, 0 }, { -1, 0 }, { -1, 0 }, { -1, 0 }, { -1, 0 } };
+
+static PLACE_ROUTING int32_t slot_dry_l[AUDIO_BUFFER_FRAMES];
+static PLACE_ROUTING int32_t slot_dry_r[AUDIO_BUFFER_FRAMES];
+
+// Slots a new routing program dropped: they fade out under the old program
+// for one more block before the switch (see route_begin_block)
+static uint8_t route_dropping = 0;
+
+// Run one slot. Switching goes through dry (old effect fades out, then the
+// new one fades in), so at most one effect per slot runs and the dry copy
+// and the ramp only cost CPU while a fade is in progress.
+static inline __attribute__((always_inline))
+void slot_process_block(int slot, int32_t* in_l, int32_t* in_r, size_t frames) {
+    SlotXfade* x = &slot_xfade[slot];
+    int8_t want  = slot_target[slot];
+
+    // Dropped by the next routing program: out within this block, then dry
+    if (route_dropping & (1u << slot)) {
+        if (x->effect >= 0 && x->gain_q16) {
+            memcpy(slot_dry_l, in_l, frames * sizeof(int32_t));
+            memcpy(slot_dry_r, in_r, frames * sizeof(int32_t));
+            slot_effect_block(x->effect, in_l, in_r, frames);
+
+            uint32_t g    = x->gain_q16;
+            uint32_t step = (g + (uint32_t)frames - 1) / (uint32_t)frames;
+            for (size_t i = 0; i < frames; i++) {
+                g = (g > step) ? g - step : 0;
+                in_l[i] = lerp_fixed(slot_dry_l[i], in_l[i], g);
+                in_r[i] = lerp_fixed(slot_dry_r[i], in_r[i], g);
+            }
+        }
+        x->effect   = -1;
+        x->gain_q16 = 0;
+        slot_running[slot] = -1;
+        return;
+    }
+
+    // Faded out: the slot is dry now
+    if (x->effect >= 0 && x->effect != want && x->gain_q16 == 0) x->effect = -1;
+
+    // Dry: start fading the wanted effect in
+    if (x->effect < 0 && want >= 0) {
+        x->effect   = want;
+        x->gain_q16 = 0;
+    }
+    slot_running[slot] = x->effect;
+    if (x->effect < 0) return;
+
+    uint32_t target = (x->effect == want) ? Q16_ONE : 0;
+
+    // Settled
+    if (x->gain_q16 == target) {
+        slot_effect_block(x->effect, in_l, in_r, frames);
+        return;
+    }
+
+    // Fading: keep the dry signal, run the effect, ramp between them
+    memcpy(slot_dry_l, in_l, frames * sizeof(int32_t));
+    memcpy(slot_dry_r, in_r, frames * sizeof(int32_t));
+    slot_effect_block(x->effect, in_l, in_r, frames);
+
+    x->gain_q16 = xfade_ramp_block(slot_dry_l, slot_dry_r, in_l, in_r, frames, x->gain_q16, target);
+}
+
+// Chain buffers in scratch Y with the core 0 stack, core 1 never touches it
+// (see mem_layout.h)
+static PLACE_CHAIN __attribute__((aligned(8))) int32_t buffer_l[AUDIO_BUFFER_FRAMES];
+static PLACE_CHAIN __attribute__((aligned(8))) int32_t buffer_r[AUDIO_BUFFER_FRAMES];
+
+// ============================================================================
+// === Routing (core 0 side) ==================================================
+// ============================================================================
+
+// Branch buffers of the routing graph (buffer 0 is the chain buffer)
+static PLACE_ROUTING int32_t route_aux_l[ROUTE_NUM_BUFS - 1][AUDIO_BUFFER_FRAMES];
+static PLACE_ROUTING int32_t route_aux_r[ROUTE_NUM_BUFS - 1][AUDIO_BUFFER_FRAMES];
+
+static int32_t* const route_buf_l[ROUTE_NUM_BUFS] = { buffer_l, route_aux_l[0], route_aux_l[1] };
+static int32_t* const route_buf_r[ROUTE_NUM_BUFS] = { buffer_r, route_aux_r[0], route_aux_r[1] };
+
+// Take the program for this block (once, before the input is read)
+static inline __attribute__((always_inline)) const RouteProgram* route_begin_block(void) {
+    uint8_t a = route_active;
+    const RouteProgram* p = &route_prog[a];
+
+    // New program: slots it drops that still play get one more block of the
+    // old program to fade out (the old one stays valid until route_running acks)
+    if (a != route_running) {
+        const RouteProgram* old = &route_prog[route_running];
+        uint8_t drop = 0;
+        for (int s = 0; s < ROUTE_MAX_SLOTS; s++) {
+            if (!(p->slot_mask & (1u << s)) && slot_xfade[s].effect >= 0) drop |= (uint8_t)(1u << s);
+        }
+        route_dropping = drop & old->slot_mask;
+        if (route_dropping) {
+            route_block_dual = old->dual_mono;
+            return old;
+        }
+
+        for (int s = 0; s < ROUTE_MAX_SLOTS; s++) {
+            if (!(p->slot_mask & (1u << s))) {
+                slot_xfade[s].effect   = -1;
+                slot_xfade[s].gain_q16 = 0;
+                slot_running[s]        = -1;
+            }
+        }
+        route_running = a;
+    }
+    route_block_dual = p->dual_mono;
+    return p;
+}
+
+// Walk the compiled program (see routing.h), no graph logic here
+static inline __attribute__((always_inline)) void route_process_block(const RouteProgram* p, size_t frames) {
+    for (uint8_t k = 0; k < p->num_ops; k++) {
+        const RouteOp* op = &p->ops[k];
+        int32_t* dl = route_buf_l[op->dst];
+        int32_t* dr = route_buf_r[op->dst];
+        int32_t* sl = route_buf_l[op->src];
+        int32_t* sr = route_buf_r[op->src];
+
+        switch (op->op) {
+            case ROUTE_OP_FX:
+                env_tap_block(ENV_TAP_PRE_SLOT(op->slot), dl, dr, frames);
+                env_slot_tap = ENV_TAP_PRE_SLOT(op->slot);
+                slot_process_block(op->slot, dl, dr, frames);
+                break;
+
+            case ROUTE_OP_COPY:
+                memcpy(dl, sl, frames * sizeof(int32_t));
+                memcpy(dr, sr, frames * sizeof(int32_t));
+                break;
+
+            case ROUTE_OP_SPLIT_LR:
+                for (size_t i = 0; i < frames; i++) {
+                    dl[i] = dr[i] = sr[i];
+                    sr[i] = sl[i];
+                }
+                break;
+
+            case ROUTE_OP_MIX:
+                for (size_t i = 0; i < frames; i++) {
+                    dl[i] = lerp_fixed(dl[i], sl[i], op->mix_q16);
+                    dr[i] = lerp_fixed(dr[i], sr[i], op->mix_q16);
+                }
+                break;
+
+            case ROUTE_OP_MERGE_LR:
+                memcpy(dr, sr, frames * sizeof(int32_t));
+                break;
+        }
+    }
+}
 
 // I2S audio processing
 __attribute__((section(".time_critical"))) 
@@ -323,42 +842,58 @@ static void process_audio(const int32_t* input, int32_t* output, size_t num_fram
     
     // Start CPU counter
     if (SHOW_CPU) cpu0_task_start();
+    const uint32_t gov_start_us = time_us_32();
+
+    // VU meters read their peaks from the envelope service
+    if (currentUI == UI_VU_IN)  env_request(ENV_TAP_INPUT);
+    if (currentUI == UI_VU_OUT) env_request(ENV_TAP_OUTPUT);
+    env_begin_block();
+
+    // MIDI events land on the block boundary (tempo, LFO sync, CC)
+    midi_process_block();
+
+    // Block-rate parameter targets (pots / expression pedal)
+    modulation_process_block(num_frames);
 
-    local_peak_left  = 0;
-    local_peak_right = 0;
+    // Routing program for this block (dual mono needs the right input)
+    const RouteProgram* route = route_begin_block();
+    const bool stereo_in = STEREO || route->dual_mono;
 
     // De-interleave input
     for (size_t i = 0; i < num_frames; i++) {
         buffer_l[i] = input[i * 2 + 1];             
-        if(!STEREO){ buffer_r[i] = buffer_l[i];  } // Input = Mono  
-        else{        buffer_r[i] = input[i * 2]; } // Input = Stereo 
+        if(!stereo_in){ buffer_r[i] = buffer_l[i];  } // Input = Mono  
+        else{           buffer_r[i] = input[i * 2]; } // Input = Stereo / dual mono
     }
 
-    // Check the max inpu value to be shown in the VU meter
-    if (currentUI == UI_VU_IN) {
-        for (size_t i = 0; i < num_frames; i++) {
-            process_audio_clipping(buffer_l[i], buffer_r[i], &local_peak_left, &local_peak_right);
-        }
+    // Feed the spectrum analyzer (input tap)
+    if (currentUI == UI_SPECTRUM && spectrum_tap == SPECTRUM_TAP_INPUT) {
+        spectrum_tap_block(buffer_l, buffer_r, num_frames);
     }
 
-    // RUn effects processing for each effects slot that is enabled
-    for (int slot = 0; slot < 3; slot++) {
-        if (led_state & (1 << slot)) {
-            process_selected_effect_block(slot, buffer_l, buffer_r, num_frames);
-        }
-    }
+    // Run the effect slots along the routing graph
+    // (the envelope taps in front of each slot are measured on demand)
+    env_tap_block(ENV_TAP_INPUT, buffer_l, buffer_r, num_frames);
+    route_process_block(route, num_frames);
+    env_tap_block(ENV_TAP_CHAIN_OUT, buffer_l, buffer_r, num_frames);
+
+    // Hand a full block to the delay / reverb wet path
+    deferred_end_block(num_frames);
 
-    // Apply volume to each sample
+    // Apply volume to each sample (ramped across the block)
     for (size_t i = 0; i < num_frames; i++) {
-        process_audio_volume_sample(&buffer_l[i], &buffer_r[i]);
+        process_audio_volume_sample(&buffer_l[i], &buffer_r[i], (uint32_t)ramp_tick(&volume_ramp));
     }
 
+    // Output protection (1 ms lookahead brickwall, per channel in dual mono)
+    limiter_process_block(buffer_l, buffer_r, num_frames, !route_block_dual);
 
-    // Check the max output value to be shown in the VU meter
-    if (currentUI == UI_VU_OUT) {
-        for (size_t i = 0; i < num_frames; i++) {
-            process_audio_clipping(buffer_l[i], buffer_r[i], &local_peak_left, &local_peak_right);
-        }
+    // Output level (VU meter and any subscriber)
+    env_tap_block(ENV_TAP_OUTPUT, buffer_l, buffer_r, num_frames);
+
+    // Feed the spectrum analyzer (output tap)
+    if (currentUI == UI_SPECTRUM && spectrum_tap == SPECTRUM_TAP_OUTPUT) {
+        spectrum_tap_block(buffer_l, buffer_r, num_frames);
     }
     
     // Check the gain reduction to be shown in the VU meter
@@ -372,30 +907,105 @@ static void process_audio(const int32_t* input, int32_t* output, size_t num_fram
         output[i * 2 + 1] = buffer_r[i];
     }
 
+    // Blocks done (host telemetry)
+    audio_block_seq++;
+
     // End CPU counter
     if (SHOW_CPU) cpu0_task_end();
+    if (CLOCK_GOVERNOR) governor_block_done(time_us_32() - gov_start_us);
 
     // Update peak values for VU meter
-    peak_left = local_peak_left;
-    peak_right = local_peak_right;
+    if (currentUI == UI_VU_IN || currentUI == UI_VU_OUT) {
+        const EnvTap* vu = env_get(currentUI == UI_VU_IN ? ENV_TAP_INPUT : ENV_TAP_OUTPUT);
+        peak_left  = vu->peak_l;
+        peak_right = vu->peak_r;
+    }
 }
 
 
+// ============================================================================
+// === I2S ring (elastic output slack) ========================================
+// ============================================================================
+//
+// The output of input block k goes to ring block k + i2s_depth. Depth 2 is
+// the old ping-pong timing: 2 blocks latency, one block period to compute.
+// Every extra block of depth adds one block of latency and one of slack.
+// - Grow: the output slot was already playing (underrun) or another input
+//   block is waiting. The block goes one slot further, and a skipped slot
+//   that is not playing yet repeats it.
+// - Shrink: after I2S_SHRINK_BLOCKS blocks in a row that each had a spare
+//   block of slack, the depth drops by one. The block is crossfaded over
+//   the one it replaces, so the splice is continuous.
+
+static int32_t i2s_splice[STEREO_BUFFER_SIZE];                  // Block replaced by a shrink
+
+static inline int32_t* i2s_in_ptr(uint b)  { return &i2s.input_buffer[b * STEREO_BUFFER_SIZE]; }
+static inline int32_t* i2s_out_ptr(uint b) { return &i2s.output_buffer[b * STEREO_BUFFER_SIZE]; }
+
+// Blocks until ring block b plays (0 = playing now)
+static inline uint i2s_lead(uint b) {
+    return (b + I2S_RING_BUFFERS - i2s_out_block(&i2s)) % I2S_RING_BUFFERS;
+}
+
 // I2S DMA interrupt handler
 __attribute__((section(".time_critical"))) 
 static void dma_i2s_in_handler(void) {
-    /* We're double buffering using chained TCBs. By checking which buffer the
-     * DMA is currently reading from, we can identify which buffer it has just
-     * finished reading (the completion of which has triggered this interrupt).
-     */
-    if (*(int32_t**)dma_hw->ch[i2s.dma_ch_in_ctrl].read_addr == i2s.input_buffer) {
-        // It is inputting to the second buffer so we can overwrite the first
-        process_audio(i2s.input_buffer, i2s.output_buffer, AUDIO_BUFFER_FRAMES);
-    } else {
-        // It is currently inputting the first buffer, so we write to the second
-        process_audio(&i2s.input_buffer[STEREO_BUFFER_SIZE], &i2s.output_buffer[STEREO_BUFFER_SIZE], AUDIO_BUFFER_FRAMES);
+    // Clear first: a block finishing while we run raises it again
+    dma_hw->ints0 = 1u << i2s.dma_ch_in_data;
+
+    // Every input block the DMA finished (more than one after a late block)
+    uint filling = i2s_in_block(&i2s);
+    while (i2s_next_in != filling) {
+        uint k = i2s_next_in;
+        i2s_next_in = (k + 1) % I2S_RING_BUFFERS;
+
+        uint w      = (k + i2s_depth) % I2S_RING_BUFFERS;
+        bool late   = (i2s_lead(w) == 0) || (i2s_next_in != filling);
+        int  gap    = -1;
+        bool splice = false;
+
+        if (i2s_lead(w) == 0) i2s_underruns++;
+
+        if (late && i2s_depth < I2S_RING_BUFFERS) {
+            if (i2s_lead(w) != 0) gap = (int)w;
+            i2s_depth++;
+            i2s_grows++;
+            i2s_stable = 0;
+            w = (k + i2s_depth) % I2S_RING_BUFFERS;
+        } else if (!late && i2s_depth > I2S_DEPTH_MIN && i2s_stable >= I2S_SHRINK_BLOCKS &&
+                   i2s_lead((k + i2s_depth - 1) % I2S_RING_BUFFERS) != 0) {
+            i2s_depth--;
+            i2s_stable = 0;
+            w = (k + i2s_depth) % I2S_RING_BUFFERS;
+            memcpy(i2s_splice, i2s_out_ptr(w), sizeof(i2s_splice));
+            splice = true;
+        }
+
+        process_audio(i2s_in_ptr(k), i2s_out_ptr(w), AUDIO_BUFFER_FRAMES);
+
+        int32_t* out = i2s_out_ptr(w);
+        if (gap >= 0) memcpy(i2s_out_ptr((uint)gap), out, STEREO_BUFFER_SIZE * sizeof(int32_t));
+        if (splice) {
+            for (size_t i = 0; i < AUDIO_BUFFER_FRAMES; i++) {
+                uint32_t g = (uint32_t)(((i + 1) * Q16_ONE) / AUDIO_BUFFER_FRAMES);
+                out[i * 2]     = lerp_fixed(i2s_splice[i * 2],     out[i * 2],     g);
+                out[i * 2 + 1] = lerp_fixed(i2s_splice[i * 2 + 1], out[i * 2 + 1], g);
+            }
+        }
+
+        // Slack: frames left before this output starts playing
+        uint lead  = i2s_lead(w);
+        uint slack = lead ? (lead - 1) * AUDIO_BUFFER_FRAMES + i2s_out_frames_left(&i2s) : 0;
+        i2s_slack_frames = (uint16_t)slack;
+        if (slack < i2s_min_slack_frames) i2s_min_slack_frames = (uint16_t)slack;
+
+        // One block less depth would have done too
+        if (slack > AUDIO_BUFFER_FRAMES) i2s_stable++;
+        else                             i2s_stable = 0;
     }
-    dma_hw->ints0 = 1u << i2s.dma_ch_in_data;  // clear the IRQ
+
+    // Clock change right after the blocks, a whole period before the next one
+    governor_apply(&i2s);
 }
 
 // ============================================================================
@@ -415,6 +1025,9 @@ static inline bool tap_button_is_down(void) {
 // === IO Actions =============================================================
 // ============================================================================
 
+#include "ui_modulation.h"   // Route field helpers are shared with the actions
+#include "ui_amp.h"
+#include "ui_preset.h"
 #include "actions.h"
 
 void handle_tap_tempo_button(){
@@ -446,7 +1059,11 @@ void handle_tap_tempo_button(){
     if (!tap && tap_was_down) {
         // Released → only count as TAP TEMPO if NOT a long hold
         uint64_t held = now_u - tap_down_us;
-        if (held < HOLD_FOR_SAVE && held > 50*1000) { // debounce 50 ms
+        if (held < HOLD_FOR_SAVE && held > 50*1000 && morph_source == MORPH_SRC_FOOT) {
+            // Morph in FOOT mode: TAP starts the glide to the other preset
+            morph_trigger_glide();
+        }
+        else if (held < HOLD_FOR_SAVE && held > 50*1000) { // debounce 50 ms
             if (last_tap_us != 0) {
                 uint32_t interval = (now_u - last_tap_us) / 1000; // ms
                 if (interval >= 50 && interval <= 2000) {
@@ -466,6 +1083,7 @@ void handle_tap_tempo_button(){
 // === UI Generation ==========================================================
 // ============================================================================
 
+#include "ui_spectrum.h"
 #include "ui_draw.h"
 
 // ============================================================================
@@ -523,6 +1141,8 @@ void print_enabled_effects(void) {
                         printf("- %s", stereo_mode_names[selected_tremolo_mode]);  break;
                     case VIBR_EFFECT_INDEX:
                         printf("- %s", stereo_mode_names[selected_vibrato_mode]);  break;
+                    case WAH_EFFECT_INDEX:
+                        printf("- %s", wah_mode_names[selected_wah_mode]);         break;
                 }
             } else {
                 printf("\n - Slot %d: (Invalid effect index: %d)", slot + 1, effect_index);
@@ -537,27 +1157,36 @@ void print_enabled_effects(void) {
 // ============================================================================
 
 // === Clock Setup ===
-void setup_system_and_peripheral_clocks() {
-    // Set system clock to 250 MHz using default PLLs
-    set_sys_clock_khz(SYSTEM_CLOCK_MHZ * 1000, true);
+// Clock plan picked at boot (clock_plan.h)
+static ClockPlan clock_plan;
+static bool      clock_plan_ok = false;
 
-    // this sets up USB and might reconfigure clk_peri
-    stdio_init_all();  
+void setup_system_and_peripheral_clocks() {
+    // Fastest system clock with an exact I2S divider (see clock_plan.h),
+    // the plain SYSTEM_CLOCK_MHZ if there is none
+    clock_plan_ok = clock_plan_find(SAMPLE_RATE, i2s_config_default.sck_mult, SYSTEM_CLOCK_MHZ * 1000000u, &clock_plan);
+    if (clock_plan_ok) set_sys_clock_pll(clock_plan.vco_hz, clock_plan.postdiv1, clock_plan.postdiv2);
+    else               set_sys_clock_khz(SYSTEM_CLOCK_MHZ * 1000, true);
 
-    // Important: USB takes time to enumerate and reset clocks
-    sleep_ms(100);  // ← Give USB time to settle and override clocks
+    // USB (CDC stdio + MIDI) is set up by core 1, which runs tud_task and
+    // takes the USB interrupt (see second_thread)
 
     // Read settings stored in flash
     init_settings_from_flash();
+    route_init();
 
-    // Set clk_peri to 125 MHz (from clk_sys)
+    // Set clk_peri to half of clk_sys (from pll_sys, which the clock governor never changes)
+    uint32_t sys_hz = clock_get_hz(clk_sys);
     clock_configure(
         clk_peri,
         0, // No glitchless mux
-        CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLK_SYS,
-        SYSTEM_CLOCK_MHZ * 1000 * 1000,    // Source frequency (clk_sys)
-        PERIPHERAL_CLOCK_MHZ * 1000 * 1000 // Desired frequency
+        CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS,
+        sys_hz,                            // Source frequency (pll_sys = clk_sys at boot)
+        sys_hz / 2                         // Desired frequency
     );
+
+    // Slower levels of the boot plan
+    governor_init(&clock_plan, clock_plan_ok, &i2s_config_default);
 }
 
 // === Get I2C Frequency ===
@@ -565,19 +1194,30 @@ uint32_t i2c_get_freq(i2c_inst_t *i2c) {
     i2c_hw_t *hw = (i2c == i2c0) ? i2c0_hw : i2c1_hw;
     uint32_t hcnt = hw->fs_scl_hcnt;
     uint32_t lcnt = hw->fs_scl_lcnt;
-    return clock_get_hz(clk_peri) / (hcnt + lcnt + 2);
+    return clock_get_hz(clk_sys) / (hcnt + lcnt + 2);      // I2C is clocked from clk_sys
 }
 
 // === Print Current Clock Speeds ===
 void print_clock_info() {
     printf("Clock Frequencies:\n");
     printf(" - clk_sys     = %0.2f MHz\n", (double)clock_get_hz(clk_sys)  / 1e6);
+    if (clock_plan_ok) {
+        printf("   plan: VCO %0.1f MHz / %u / %u, SCK div %u + %u/256 (pattern %u)\n",
+               (double)clock_plan.vco_hz / 1e6, clock_plan.postdiv1, clock_plan.postdiv2,
+               clock_plan.sck_div_int, clock_plan.sck_div_frac, clock_plan.pattern);
+    } else {
+        printf("   plan: none within %d MHz, fractional I2S dividers\n", SYSTEM_CLOCK_MHZ);
+    }
+    for (int l = 1; l < gov_num_levels; l++) {
+        printf("   governor level %d: %0.2f MHz (clk_sys div %u)%s\n", l, (double)gov_levels[l].sys_hz / 1e6,
+               gov_levels[l].sys_div, (l == gov_level) ? " <" : "");
+    }
     printf(" - clk_peri    = %0.2f MHz\n", (double)clock_get_hz(clk_peri) / 1e6);
     printf(" - clk_usb     = %0.2f MHz\n", (double)clock_get_hz(clk_usb)  / 1e6);
     printf(" - clk_adc     = %0.2f MHz\n", (double)clock_get_hz(clk_adc)  / 1e6);
     printf(" - clk_rtc     = %0.2f kHz\n", (double)clock_get_hz(clk_rtc)  / 1e3);
     printf(" - SPI1 actual = %0.2f MHz\n", (double)spi_get_baudrate(spi1) / 5e5); // Baud * x2
-    printf(" - I2C0 actual = %0.2f kHz\n", (double)i2c_get_freq(i2c0)     / 5e2); // Baud * x2   
+    printf(" - I2C0 actual = %0.2f kHz\n", (double)i2c_get_freq(i2c0)     / 1e3);   
 }
 
 // ============================================================================
@@ -597,63 +1237,39 @@ static __not_in_flash_func(void core1_park_loop)(void) {
 volatile bool dsp_ready = false;
 
 void second_thread() {
+    // USB device (CDC stdio + MIDI) on this core: the USB interrupt lands on
+    // the core that calls tusb_init, next to tud_task. No wait for the
+    // enumeration, tud_task finishes it
+    tusb_init();
+    stdio_init_all();
+
+    // Lock of the effect coefficient banks, before the first loader
+    coef_bank_init();
+
+    // Only what the audio blocks read, the rest follows in boot_poll (boot.h)
     I2C_Initialize(I2C_TARGET_HZ);
-    SSD1306_Init();
-    SSD1306_ClearScreen();
-    
-    // Draw centered logo
-    SSD1306_DrawSplashLogoBitmap(32, 0, true);
 
     // Setup encoder, GPIO expander, and potentiometers
     setup_encoder();
-    spi_ram_init(SPI_TARGET_HZ / 2);
     setup_pca9555_interrupt();   // set before global IRQ handler
     setup_global_irq_handler();  // must be after the above
     initialize_potentiometers();
     initialize_gpio_expander();
     
-    // Call audio init functions
-    reverb_init();
-    init_chorus();
-    init_phaser();
-    init_delay();
-    init_compressor();
-    init_speaker_sim();
+    // Block-rate services of the audio core
+    init_modulation();
+    init_midi();
 
     last_pot_change_time = get_absolute_time();
     sleep_ms(10);
     read_all_pots(true);
 
-    // Update the parameters based on stored pot values
-    load_chorus_parms_from_memory();
-    load_compressor_parms_from_memory();
-    load_delay_parms_from_memory();
-    load_distortion_parms_from_memory();
-    load_eq_parms_from_memory();
-    load_flanger_parms_from_memory();
-    load_fuzz_parms_from_memory();
-    load_overdrive_parms_from_memory();
-    load_phaser_parms_from_memory();
-    load_reverb_parms_from_memory();
-    load_speaker_sim_parms_from_memory();
-    load_tremolo_parms_from_memory();
-    load_vibrato_parms_from_memory();
-    
-    load_fender_params_from_memory();
-    load_vox_params_from_memory();
-    load_marshall_params_from_memory();
-    load_slo_params_from_memory();   
-
-    // Update the volume based on the curret potentiometer state
-    update_volume_from_pot();
+    // Seed the expression pedal from the initial scan
+    // (the volume follows pot 6 from the first audio block)
+    init_expression();
 
     int changed = -1;
-    dsp_ready = true;   // <<< signal ready
-
-    // Optionally wait some time to show the logo
-    sleep_ms(1000);
-    SSD1306_UpdateScreen();
-    SetFont(&Font8x8);
+    dsp_ready = true;   // <<< signal ready (audio starts dry)
 
     // Timer tracking variables
     uint64_t last_debug_time   = time_us_64();
@@ -671,6 +1287,24 @@ void second_thread() {
 
         uint64_t now = time_us_64();
 
+        // Effects, OLED and delay RAM still coming up
+        boot_poll(now);
+
+        // Expression pedal (mux is left on EXP-2 between pot scans)
+        expression_poll(now);
+
+        // USB device stack and MIDI input (events go to core 0 through the queue)
+        tud_task();
+        midi_poll_usb();
+        host_poll();
+
+        // Routing graph changes, then bypass / effect changes: pre-warm, then let core 0 crossfade
+        route_poll();
+        update_slot_targets();
+        governor_poll(now);
+        int program = midi_take_program();
+        if (program == 0 || program == 1) preset_recall(program);
+
         // Shared GPIO interrupt handling
         if (pca9555_interrupt_flag) {
             pca9555_interrupt_flag = false;
@@ -709,20 +1343,6 @@ void second_thread() {
                 selected_slot = switch_pressed - 1; // Convert to 0-based index
             }
 
-            for (int slot = 0; slot < 3; slot++) {
-                // Was previously ON, now OFF
-                if ((prev_led_state & (1 << slot)) && !(led_state & (1 << slot))) {
-                    if (selectedEffects[slot] == DELAY_EFFECT_INDEX) {
-                        clear_delay_memory();  // Call the function we made before
-                        if(DEBUG) printf("Delay memory cleared for slot %d\n", slot + 1);
-                    }
-                    else if (selectedEffects[slot] == REVB_EFFECT_INDEX) {
-                        clear_reverb_memory();  // Call the function we made before
-                        if(DEBUG) printf("Reverb memory cleared for slot %d\n", slot + 1);
-                    }
-                }
-            }
-
             prev_led_state = led_state;
 
             // Handle encoder button if pressed
@@ -813,15 +1433,19 @@ void second_thread() {
                 // Print the selecyed effect
                 // if(DEBUG) printf("Selected effect: %s\n", allEffects[selectedEffects[selected_slot]]);
 
+                // Only the function pots belong to the effect (volume / EXP-2 are routed per block)
                 int effect_index = selectedEffects[selected_slot];
-                if (effect_index >= 0 && effect_index < NUM_EFFECTS && effect_param_updaters[effect_index]) {
+                if (changed < NUM_FUNC_POTS &&
+                    effect_index >= 0 && effect_index < NUM_EFFECTS && effect_param_updaters[effect_index]) {
                     effect_param_updaters[effect_index](changed);
                 }
 
-                update_volume_from_pot();
                 // Reset the last pot change time
                 last_pot_change_time = get_absolute_time();
             }
+
+            // Preset morph (EXP / encoder / timed glide)
+            morph_tick(CONTROL_INTERVAL_US);
         }
         // Only tick LEDs when we're NOT saving or being asked to park
         if (!saving_in_progress && !ui_park_req) {
@@ -857,8 +1481,10 @@ void second_thread() {
             // While saving, keep LEDs and I/O alive, but skip drawUI()
         } else {
             saving_drawn = false;
-            // Normal UI cadence
-            if (now - last_display_time >= DISPLAY_INTERVAL_US) {
+            // Normal UI cadence (after the splash)
+            if (!boot_ui_ready) {
+                last_display_time = now;
+            } else if (now - last_display_time >= DISPLAY_INTERVAL_US) {
                 last_display_time += DISPLAY_INTERVAL_US;
                 drawUI(changed);
             }
@@ -887,6 +1513,7 @@ void second_thread() {
                 }
                 if(PRINT_RAM){   
                     printf("RAM   : %.1f%% | %d bytes\n", get_free_ram_percent(), get_free_ram_bytes());
+                    mem_layout_print();
                 }
                 if(PRINT_FLASH){    
                     printf("FLASH : %.1f%% | %d bytes\n", get_flash_used_percent(), get_flash_used_bytes());
@@ -899,6 +1526,9 @@ void second_thread() {
                     printf("-------------------------\n");
                     print_enabled_effects();
                 }   
+                if(MEM_BENCH){
+                    mem_bench_print();
+                }
             }
         }
         
@@ -915,6 +1545,10 @@ void second_thread() {
 // ============================================================================
 
 int main() {
+    // Bank contention benchmark (scribbles on the banks), then zero them
+    if (MEM_BENCH) mem_bench_run();
+    mem_layout_init();
+
     // Overclock the system 
     setup_system_and_peripheral_clocks();
 
@@ -923,8 +1557,15 @@ int main() {
     // Wait for Core 1 to be ready
     while (!dsp_ready) tight_loop_contents();
 
+    // Output limiter must be primed before the first block
+    limiter_reset();
+
+    // Wet path of delay / reverb (lower priority than the DMA IRQ)
+    init_deferred();
+
     // Setup audio
     i2s_program_start_synched(pio0, &i2s_config_default, dma_i2s_in_handler, &i2s);
+    if (DEBUG) printf("Audio running %.1f ms after reset\n", (double)time_us_64() / 1000.0);
 
     // Calculate sample time
     sample_period_us = (1000000.0f * AUDIO_BUFFER_FRAMES) / SAMPLE_RATE;
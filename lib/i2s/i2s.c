@@ -76,25 +76,25 @@ static bool validate_sck_bck_sync(pio_i2s_clocks* clocks) {
     return (fractional_ratio == 0.0f);
 }
 
-static void dma_double_buffer_init(pio_i2s* i2s, void (*dma_handler)(void)) {
+static void dma_ring_buffer_init(pio_i2s* i2s, void (*dma_handler)(void)) {
     // Set up DMA for PIO I2s - two channels, in and out
     i2s->dma_ch_in_ctrl  = dma_claim_unused_channel(true);
     i2s->dma_ch_out_ctrl = dma_claim_unused_channel(true);
     i2s->dma_ch_out_data = dma_claim_unused_channel(true);
     i2s->dma_ch_in_data  = dma_claim_unused_channel(true);
 
-    // Control blocks support double-buffering with interrupts on buffer change
-    i2s->in_ctrl_blocks[0]  = i2s->input_buffer;
-    i2s->in_ctrl_blocks[1]  = &i2s->input_buffer[STEREO_BUFFER_SIZE];
-    i2s->out_ctrl_blocks[0] = i2s->output_buffer;
-    i2s->out_ctrl_blocks[1] = &i2s->output_buffer[STEREO_BUFFER_SIZE];
+    // Control blocks cycle through the ring with interrupts on buffer change
+    for (int b = 0; b < I2S_RING_BUFFERS; b++) {
+        i2s->in_ctrl_blocks[b]  = &i2s->input_buffer[b * STEREO_BUFFER_SIZE];
+        i2s->out_ctrl_blocks[b] = &i2s->output_buffer[b * STEREO_BUFFER_SIZE];
+    }
 
-    // DMA I2S OUT control channel - wrap read address every 8 bytes (2 words)
+    // DMA I2S OUT control channel - wrap read address every ring (1 word per block)
     // Transfer 1 word at a time, to the out channel read address and trigger.
     dma_channel_config c = dma_channel_get_default_config(i2s->dma_ch_out_ctrl);
     channel_config_set_read_increment(&c, true);
     channel_config_set_write_increment(&c, false);
-    channel_config_set_ring(&c, false, 3);
+    channel_config_set_ring(&c, false, I2S_RING_BITS);
     channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
     dma_channel_configure(i2s->dma_ch_out_ctrl, &c, &dma_hw->ch[i2s->dma_ch_out_data].al3_read_addr_trig, i2s->out_ctrl_blocks, 1, false);
 
@@ -115,7 +115,7 @@ static void dma_double_buffer_init(pio_i2s* i2s, void (*dma_handler)(void)) {
     c = dma_channel_get_default_config(i2s->dma_ch_in_ctrl);
     channel_config_set_read_increment(&c, true);
     channel_config_set_write_increment(&c, false);
-    channel_config_set_ring(&c, false, 3);
+    channel_config_set_ring(&c, false, I2S_RING_BITS);
     channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
     dma_channel_configure(i2s->dma_ch_in_ctrl, &c, &dma_hw->ch[i2s->dma_ch_in_data].al2_write_addr_trig, i2s->in_ctrl_blocks, 1, false);
 
@@ -152,6 +152,7 @@ static void i2s_slave_program_init(PIO pio, const i2s_config* config, pio_i2s* i
     uint offset  = 0;
     i2s->pio     = pio;
     i2s->sm_mask = 0;
+    i2s->config  = *config;
 
     pio_i2s_clocks clocks;
     calc_clocks(config, &clocks);
@@ -182,6 +183,7 @@ static void i2s_sync_program_init(PIO pio, const i2s_config* config, pio_i2s* i2
     uint offset  = 0;
     i2s->pio     = pio;
     i2s->sm_mask = 0;
+    i2s->config  = *config;
 
     pio_i2s_clocks clocks;
     calc_clocks(config, &clocks);
@@ -221,19 +223,19 @@ static void i2s_sync_program_init(PIO pio, const i2s_config* config, pio_i2s* i2
 }
 
 void i2s_program_start_slaved(PIO pio, const i2s_config* config, void (*dma_handler)(void), pio_i2s* i2s) {
-    if (((uint32_t)i2s & 0x7) != 0) {
-        panic("pio_i2s argument must be 8-byte aligned!");
+    if (((uint32_t)i2s->in_ctrl_blocks & (I2S_RING_BUFFERS * 4 - 1)) != 0) {
+        panic("pio_i2s control blocks must be aligned to the ring size!");
     }
     i2s_slave_program_init(pio, config, i2s);
-    dma_double_buffer_init(i2s, dma_handler);
+    dma_ring_buffer_init(i2s, dma_handler);
     pio_enable_sm_mask_in_sync(i2s->pio, i2s->sm_mask);
 }
 
 void i2s_program_start_synched(PIO pio, const i2s_config* config, void (*dma_handler)(void), pio_i2s* i2s) {
-    if (((uint32_t)i2s & 0x7) != 0) {
-        panic("pio_i2s argument must be 8-byte aligned!");
+    if (((uint32_t)i2s->in_ctrl_blocks & (I2S_RING_BUFFERS * 4 - 1)) != 0) {
+        panic("pio_i2s control blocks must be aligned to the ring size!");
     }
     i2s_sync_program_init(pio, config, i2s);
-    dma_double_buffer_init(i2s, dma_handler);
+    dma_ring_buffer_init(i2s, dma_handler);
     pio_enable_sm_mask_in_sync(i2s->pio, i2s->sm_mask);
 }
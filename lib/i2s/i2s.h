@@ -21,6 +21,7 @@
  */
 #include <stdio.h>
 #include "hardware/pio.h"
+#include "hardware/dma.h"
 
 #ifndef I2S_TEST_I2S_H
 #define I2S_TEST_I2S_H
@@ -34,6 +35,15 @@
 #define SAMPLE_RATE         48000
 #define STEREO_BUFFER_SIZE  AUDIO_BUFFER_FRAMES * 2
 
+// DMA ring of blocks (power of two). 2 = plain ping-pong, more blocks let
+// the output run further ahead of the input when a block is late.
+#define I2S_RING_BUFFERS    4
+#define I2S_RING_BITS       4       // log2(I2S_RING_BUFFERS * sizeof(int32_t*)), DMA ring wrap
+
+#if (I2S_RING_BUFFERS & (I2S_RING_BUFFERS - 1)) != 0 || (1 << I2S_RING_BITS) != I2S_RING_BUFFERS * 4
+#error "I2S_RING_BUFFERS must be a power of two matching I2S_RING_BITS"
+#endif
+
 typedef struct i2s_config {
     uint32_t fs;
     uint32_t sck_mult;
@@ -58,7 +68,7 @@ typedef struct pio_i2s_clocks {
     uint8_t  bck_f;
 } pio_i2s_clocks;
 
-// NOTE: Use __attribute__ ((aligned(8))) on this struct or the DMA wrap won't work!
+// NOTE: Use __attribute__ ((aligned(I2S_RING_BUFFERS * 4))) on this struct or the DMA wrap won't work!
 typedef struct pio_i2s {
     PIO        pio;
     uint8_t    sm_mask;
@@ -69,15 +79,44 @@ typedef struct pio_i2s {
     uint       dma_ch_in_data;
     uint       dma_ch_out_ctrl;
     uint       dma_ch_out_data;
-    int32_t*   in_ctrl_blocks[2];  // Control blocks MUST have 8-byte alignment.
-    int32_t*   out_ctrl_blocks[2];
-    int32_t    input_buffer[STEREO_BUFFER_SIZE * 2];
-    int32_t    output_buffer[STEREO_BUFFER_SIZE * 2];
+    int32_t*   in_ctrl_blocks[I2S_RING_BUFFERS] __attribute__((aligned(I2S_RING_BUFFERS * 4)));  // Control blocks MUST be aligned to the ring size.
+    int32_t*   out_ctrl_blocks[I2S_RING_BUFFERS] __attribute__((aligned(I2S_RING_BUFFERS * 4)));
+    int32_t    input_buffer[STEREO_BUFFER_SIZE * I2S_RING_BUFFERS];
+    int32_t    output_buffer[STEREO_BUFFER_SIZE * I2S_RING_BUFFERS];
     i2s_config config;
 } pio_i2s;
 
 extern const i2s_config i2s_config_default;
 
+// Ring block the input DMA is filling now (the control channel already points at the next one)
+static inline uint i2s_in_block(const pio_i2s* i2s) {
+    uint next = (uint)((uintptr_t)dma_hw->ch[i2s->dma_ch_in_ctrl].read_addr - (uintptr_t)i2s->in_ctrl_blocks) / sizeof(int32_t*);
+    return (next + I2S_RING_BUFFERS - 1) % I2S_RING_BUFFERS;
+}
+
+// Ring block the output DMA is playing now
+static inline uint i2s_out_block(const pio_i2s* i2s) {
+    uint next = (uint)((uintptr_t)dma_hw->ch[i2s->dma_ch_out_ctrl].read_addr - (uintptr_t)i2s->out_ctrl_blocks) / sizeof(int32_t*);
+    return (next + I2S_RING_BUFFERS - 1) % I2S_RING_BUFFERS;
+}
+
+// Frames of the playing block not sent yet
+static inline uint i2s_out_frames_left(const pio_i2s* i2s) {
+    return (uint)dma_hw->ch[i2s->dma_ch_out_data].transfer_count / 2;
+}
+
+// Retune the running state machines after clk_sys changed (8.8 dividers:
+// SCK on the SCK / input machines, BCK on the synched output machine)
+static inline void i2s_set_clkdiv(const pio_i2s* i2s, uint32_t sck_div_x256, uint32_t bck_div_x256) {
+    if (i2s->config.sck_enable) {
+        pio_sm_set_clkdiv_int_frac(i2s->pio, i2s->sm_sck, (uint16_t)(sck_div_x256 >> 8), (uint8_t)sck_div_x256);
+    }
+    pio_sm_set_clkdiv_int_frac(i2s->pio, i2s->sm_din, (uint16_t)(sck_div_x256 >> 8), (uint8_t)sck_div_x256);
+    if (i2s->sm_dout != i2s->sm_din) {
+        pio_sm_set_clkdiv_int_frac(i2s->pio, i2s->sm_dout, (uint16_t)(bck_div_x256 >> 8), (uint8_t)bck_div_x256);
+    }
+}
+
 void i2s_program_start_slaved(PIO pio, const i2s_config* config, void (*dma_handler)(void), pio_i2s* i2s);
 void i2s_program_start_synched(PIO pio, const i2s_config* config, void (*dma_handler)(void), pio_i2s* i2s);
 
@@ -0,0 +1,60 @@
+/* tusb_config.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef TUSB_CONFIG_H
+#define TUSB_CONFIG_H
+
+// ============================================================================
+// === TinyUSB configuration: CDC (stdio, control) + MIDI composite device ====
+// ============================================================================
+//
+// The firmware links tinyusb_device itself, so pico_stdio_usb keeps using
+// CDC interface 0 but the descriptors (usb_descriptors.c) and tud_task()
+// are ours. tud_task() runs in the core 1 loop.
+
+#define CFG_TUSB_RHPORT0_MODE       (OPT_MODE_DEVICE | OPT_MODE_FULL_SPEED)
+#define CFG_TUSB_OS                 OPT_OS_PICO
+
+#ifndef CFG_TUSB_MEM_SECTION
+#define CFG_TUSB_MEM_SECTION
+#endif
+
+#ifndef CFG_TUSB_MEM_ALIGN
+#define CFG_TUSB_MEM_ALIGN          __attribute__((aligned(4)))
+#endif
+
+// --- Device ---
+#define CFG_TUD_ENDPOINT0_SIZE      64
+
+#define CFG_TUD_CDC                 2       // stdio, host control
+#define CFG_TUD_MSC                 0
+#define CFG_TUD_HID                 0
+#define CFG_TUD_MIDI                1
+#define CFG_TUD_VENDOR              0
+
+// --- CDC FIFOs ---
+#define CFG_TUD_CDC_RX_BUFSIZE      256
+#define CFG_TUD_CDC_TX_BUFSIZE      512     // Holds a full control response frame
+#define CFG_TUD_CDC_EP_BUFSIZE      64
+
+// --- MIDI FIFOs (a clock burst at 24 PPQN is a few bytes per ms) ---
+#define CFG_TUD_MIDI_RX_BUFSIZE     128
+#define CFG_TUD_MIDI_TX_BUFSIZE     64
+
+#endif // TUSB_CONFIG_H
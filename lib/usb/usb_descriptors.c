@@ -0,0 +1,145 @@
+/* usb_descriptors.c
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include "tusb.h"
+#include "pico/unique_id.h"
+
+// ============================================================================
+// === Device =================================================================
+// ============================================================================
+
+#define USB_VID     0x2E8A      // Raspberry Pi
+#define USB_PID     0x10D5      // RP2040-DSP (CDC + MIDI)
+#define USB_BCD     0x0200
+
+static const tusb_desc_device_t desc_device = {
+    .bLength            = sizeof(tusb_desc_device_t),
+    .bDescriptorType    = TUSB_DESC_DEVICE,
+    .bcdUSB             = USB_BCD,
+
+    // IAD for the CDC function
+    .bDeviceClass       = TUSB_CLASS_MISC,
+    .bDeviceSubClass    = MISC_SUBCLASS_COMMON,
+    .bDeviceProtocol    = MISC_PROTOCOL_IAD,
+
+    .bMaxPacketSize0    = CFG_TUD_ENDPOINT0_SIZE,
+    .idVendor           = USB_VID,
+    .idProduct          = USB_PID,
+    .bcdDevice          = 0x0100,
+
+    .iManufacturer      = 0x01,
+    .iProduct           = 0x02,
+    .iSerialNumber      = 0x03,
+
+    .bNumConfigurations = 0x01
+};
+
+uint8_t const* tud_descriptor_device_cb(void) {
+    return (uint8_t const*)&desc_device;
+}
+
+// ============================================================================
+// === Configuration ==========================================================
+// ============================================================================
+
+enum {
+    ITF_NUM_CDC = 0,            // stdio stays on CDC 0
+    ITF_NUM_CDC_DATA,
+    ITF_NUM_MIDI,
+    ITF_NUM_MIDI_STREAMING,
+    ITF_NUM_CDC_CTRL,           // Binary host control (host_control.h)
+    ITF_NUM_CDC_CTRL_DATA,
+    ITF_NUM_TOTAL
+};
+
+#define EPNUM_CDC_NOTIF     0x81
+#define EPNUM_CDC_OUT       0x02
+#define EPNUM_CDC_IN        0x82
+#define EPNUM_MIDI_OUT      0x03
+#define EPNUM_MIDI_IN       0x83
+#define EPNUM_CTRL_NOTIF    0x84
+#define EPNUM_CTRL_OUT      0x05
+#define EPNUM_CTRL_IN       0x85
+
+#define CONFIG_TOTAL_LEN    (TUD_CONFIG_DESC_LEN + 2 * TUD_CDC_DESC_LEN + TUD_MIDI_DESC_LEN)
+
+static const uint8_t desc_configuration[] = {
+    // Config number, interface count, string index, total length, attribute, power in mA
+    TUD_CONFIG_DESCRIPTOR(1, ITF_NUM_TOTAL, 0, CONFIG_TOTAL_LEN, 0x00, 100),
+
+    // Interface number, string index, EP notification address and size, EP data address (out, in) and size
+    TUD_CDC_DESCRIPTOR(ITF_NUM_CDC, 4, EPNUM_CDC_NOTIF, 8, EPNUM_CDC_OUT, EPNUM_CDC_IN, 64),
+
+    // Interface number, string index, EP Out & EP In address, EP size
+    TUD_MIDI_DESCRIPTOR(ITF_NUM_MIDI, 5, EPNUM_MIDI_OUT, EPNUM_MIDI_IN, 64),
+
+    // Second CDC: host control protocol
+    TUD_CDC_DESCRIPTOR(ITF_NUM_CDC_CTRL, 6, EPNUM_CTRL_NOTIF, 8, EPNUM_CTRL_OUT, EPNUM_CTRL_IN, 64),
+};
+
+uint8_t const* tud_descriptor_configuration_cb(uint8_t index) {
+    (void)index;
+    return desc_configuration;
+}
+
+// ============================================================================
+// === Strings ================================================================
+// ============================================================================
+
+static const char* string_desc_arr[] = {
+    (const char[]){ 0x09, 0x04 },   // 0: English (0x0409)
+    "Milan Wendt",                  // 1: Manufacturer
+    "RP2040-DSP",                   // 2: Product
+    NULL,                           // 3: Serial (flash unique ID)
+    "RP2040-DSP Console",           // 4: CDC
+    "RP2040-DSP MIDI",              // 5: MIDI
+    "RP2040-DSP Control",           // 6: CDC host control
+};
+
+static uint16_t desc_str[32 + 1];
+
+uint16_t const* tud_descriptor_string_cb(uint8_t index, uint16_t langid) {
+    (void)langid;
+    uint8_t chr_count;
+    char serial[2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES + 1];
+
+    if (index == 0) {
+        memcpy(&desc_str[1], string_desc_arr[0], 2);
+        chr_count = 1;
+    } else {
+        if (index >= sizeof(string_desc_arr) / sizeof(string_desc_arr[0])) return NULL;
+
+        const char* str = string_desc_arr[index];
+        if (index == 3) {
+            pico_get_unique_board_id_string(serial, sizeof(serial));
+            str = serial;
+        }
+
+        chr_count = (uint8_t)strlen(str);
+        if (chr_count > 32) chr_count = 32;
+        for (uint8_t i = 0; i < chr_count; i++) {
+            desc_str[1 + i] = str[i];
+        }
+    }
+
+    // First word: length (bytes, including header) and descriptor type
+    desc_str[0] = (uint16_t)((TUSB_DESC_STRING << 8) | (2 * chr_count + 2));
+    return desc_str;
+}
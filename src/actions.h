@@ -78,8 +78,9 @@ void handleButtonPress() {
                 break;
 
             case HI_LEFT_ARROW:
-                // Jump to OUTPUT VU
-                currentUI = UI_VU_OUT;
+                // Jump to the preset morph (last screen of the loop)
+                currentUI = UI_MORPH;
+                encoder_position = MORPH_UI_LEFT;
                 break;
 
             default:
@@ -111,13 +112,89 @@ void handleButtonPress() {
             // Otherwise, go back to input VU
             else{ currentUI = UI_VU_IN; }
         } 
-        // Otherwise, go back to home
+        // Otherwise, go on to the spectrum analyzer
         else if (encoder_position == 1) { 
-            currentUI = UI_HOME;
-            encoder_position = 5;  // Set pointer to right arrow
+            spectrum_reset();
+            currentUI = UI_SPECTRUM;
+            encoder_position = 1;  // point to right arrow
         }
     }
 
+    else if (currentUI == UI_SPECTRUM) {
+        if (encoder_position == 0) { 
+            currentUI = UI_VU_OUT;
+        }
+        else if (encoder_position == 1) { 
+            currentUI = UI_MOD_MATRIX;
+            encoder_position = 1;  // point to right arrow
+        }
+        // Toggle the analyzer tap between input and output
+        else {
+            spectrum_tap = (spectrum_tap == SPECTRUM_TAP_INPUT) ? SPECTRUM_TAP_OUTPUT : SPECTRUM_TAP_INPUT;
+            spectrum_reset();
+        }
+    }
+
+    else if (currentUI == UI_MOD_MATRIX) {
+        if (encoder_position == 0) { 
+            spectrum_reset();
+            currentUI = UI_SPECTRUM;
+        }
+        else if (encoder_position == 1) { 
+            currentUI = UI_MORPH;
+            encoder_position = MORPH_UI_RIGHT;
+        }
+        // Edit the hovered route field
+        else {
+            mod_matrix_cursor = encoder_position;
+            encoder_position  = modUiFieldValue(mod_matrix_cursor);
+            currentUI = UI_MOD_EDIT;
+        }
+    }
+
+    // Commit the field (already applied live) and go back to the matrix
+    else if (currentUI == UI_MOD_EDIT) {
+        encoder_position = mod_matrix_cursor;
+        currentUI = UI_MOD_MATRIX;
+    }
+
+    else if (currentUI == UI_MORPH) {
+        switch (encoder_position) {
+            case MORPH_UI_LEFT:
+                currentUI = UI_MOD_MATRIX;
+                encoder_position = 0;  // point to left arrow
+                break;
+            case MORPH_UI_RIGHT:
+                currentUI = UI_HOME;
+                encoder_position = 5;  // Set pointer to right arrow
+                break;
+            case MORPH_UI_STORE_A:
+                preset_store(0);
+                break;
+            case MORPH_UI_STORE_B:
+                preset_store(1);
+                break;
+            case MORPH_UI_SOURCE:
+                morph_source = (MorphSource)((morph_source + 1) % NUM_MORPH_SRCS);
+                break;
+            case MORPH_UI_TIME:
+                morph_time_index = (morph_time_index + 1) % NUM_MORPH_TIMES;
+                break;
+            case MORPH_UI_POS:
+                // The encoder only owns the position in ENC mode
+                if (morph_source == MORPH_SRC_ENCODER) {
+                    encoder_position = (int)((morph_pos_q16 * MORPH_UI_STEPS + Q16_ONE / 2) / Q16_ONE);
+                    currentUI = UI_MORPH_EDIT;
+                }
+                break;
+        }
+    }
+
+    else if (currentUI == UI_MORPH_EDIT) {
+        encoder_position = MORPH_UI_POS;
+        currentUI = UI_MORPH;
+    }
+
     else if (currentUI == UI_VU_GAIN) {
         if (encoder_position == 0) { currentUI = UI_VU_IN;  } 
         else{                        currentUI = UI_VU_OUT; }
@@ -127,14 +204,12 @@ void handleButtonPress() {
         // Apply selected effect to the correct slot and return to home
         // Check if the effect is already selected in another slot
         bool effectAlreadySelected = false;
-        for (int i = 0; i < 3; ++i) {
-            if (i != selected_slot && selectedEffects[i] == effectListIndex) {
-                // Effect already selected in another slot, show error
-                // Print error message to serial console
-                if(DEBUG) printf("Effect already selected in slot %d\n", i + 1);
-                effectAlreadySelected = true;
-                return;
-            }
+        if (effect_in_other_slot(effectListIndex, selected_slot)) {
+            // Effect already selected in another slot, show error
+            // Print error message to serial console
+            if(DEBUG) printf("Effect already selected in another slot\n");
+            effectAlreadySelected = true;
+            return;
         }
         if (!effectAlreadySelected) {
             selectedEffects[selected_slot] = effectListIndex;
@@ -174,6 +249,12 @@ void handleButtonPress() {
                 encoder_position = stereo_mode_menu_index;
                 currentUI = UI_STEREO_MODE_MENU;
             } 
+            // Show menu for the wah sweep source
+            else if (effectListIndex == WAH_EFFECT_INDEX){
+                wah_mode_menu_index = selected_wah_mode;
+                encoder_position = wah_mode_menu_index;
+                currentUI = UI_WAH_MODE_MENU;
+            } 
             // Show menu for preamp selection [NEW]
             else if (effectListIndex == PREAMP_EFFECT_INDEX){
                 preamp_select_menu_index = selected_preamp_style;
@@ -187,10 +268,34 @@ void handleButtonPress() {
             }
         }
     }
+    // Last row of the preamp menu: power amp / dual amp setup
+    else if (currentUI == UI_PREAMP_SELECTION && preamp_select_menu_index == NUM_PREAMPS) {
+        encoder_position = AMP_UI_POWER_AMP;
+        currentUI = UI_AMP_SETUP;
+    }
+    else if (currentUI == UI_AMP_SETUP) {
+        if (encoder_position == AMP_UI_BACK) {
+            encoder_position = 1;  // reset to effect name
+            currentUI = UI_HOME;
+        }
+        // Edit the hovered row
+        else {
+            amp_setup_cursor = encoder_position;
+            encoder_position = ampUiFieldValue(amp_setup_cursor);
+            currentUI = UI_AMP_SETUP_EDIT;
+        }
+    }
+    // Commit the row (already applied live) and go back to the list
+    else if (currentUI == UI_AMP_SETUP_EDIT) {
+        encoder_position = amp_setup_cursor;
+        currentUI = UI_AMP_SETUP;
+    }
     // Set the selected delay / chorus / stereo mode and return to home
     else if (currentUI == UI_DELAY_MODE_MENU  ||
              currentUI == UI_CHORUS_MODE_MENU ||
              currentUI == UI_STEREO_MODE_MENU ||
+             currentUI == UI_WAH_MODE_MENU    ||
+             currentUI == UI_EXP_TARGET_MENU  ||
              currentUI == UI_PREAMP_SELECTION) {
         // Changin the mode hapens in the draw function
         // That way we can update the selected mode in real time
@@ -198,6 +303,13 @@ void handleButtonPress() {
         currentUI = UI_HOME;
     } 
 
+    // Click while the EXP-2 pot is shown: choose what the pedal controls
+    else if (currentUI == UI_POT && last_changed_pot == EXP_POT_INDEX) {
+        exp_target_menu_index = exp_target;
+        encoder_position = exp_target_menu_index;
+        currentUI = UI_EXP_TARGET_MENU;
+    }
+
     else if (currentUI == UI_DELAY_FRACTION_L_MENU) {
         // Commit selected item and return to HOME
         delay_time_fraction_l = (DelayFraction)encoder_position;
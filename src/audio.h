@@ -62,12 +62,22 @@ volatile int32_t local_peak_right = 0;
 
 absolute_time_t last_sample_time = {0}; // Timestamp for VU meter timing
 
+// Incremented by core 0 after every processed block (core 1 syncs parameter writes to it)
+volatile uint32_t audio_block_seq = 0;
+
 // Compressor gain reduction for VU meter
 static int32_t comp_linear_gain_q24_l = 0;
 static int32_t comp_linear_gain_q24_r = 0;
 
-// Audio volume in Q0.16 format (0..65536)
-static uint32_t volume_q16 = 0;
+// Per-sample linear ramp towards a value set once per block
+typedef struct {
+    int32_t value;      // Current value (advanced by ramp_tick)
+    int32_t step;       // Increment per sample
+    int32_t target;     // Value at the end of the block
+} ParamRamp;
+
+// Audio volume in Q0.16 format (0..65536), ramped per block from the volume pot
+static ParamRamp volume_ramp = { 0, 0, 0 };
 
 // Define I2S audio parameters
 float sample_period_us = 0.0f;
@@ -154,14 +164,22 @@ static inline void process_audio_clipping(int32_t sample_left, int32_t sample_ri
     if (abs_right > *local_peak_right) *local_peak_right = abs_right;
 }
 
-// Update volume from potentiometer (pot_value scaled 0..POT_MAX)
-static inline void update_volume_from_pot(void) {
-    volume_q16 = ((uint32_t)pot_value[6] * Q16_ONE) / POT_MAX;
+// Start a new block: land on the last target and head for the new one
+static inline __attribute__((always_inline)) void ramp_begin_block(ParamRamp* r, int32_t target, size_t frames) {
+    r->value  = r->target;
+    r->target = target;
+    r->step   = (target - r->value) / (int32_t)frames;
+}
+
+// Advance one sample
+static inline __attribute__((always_inline)) int32_t ramp_tick(ParamRamp* r) {
+    r->value += r->step;
+    return r->value;
 }
 
 // Takes ~1% of core 0 CPU time at 48kHz
 // Apply volume to one stereo sample pair (24-bit quality)
-static inline void process_audio_volume_sample(int32_t* inout_l, int32_t* inout_r) {
+static inline void process_audio_volume_sample(int32_t* inout_l, int32_t* inout_r, uint32_t volume_q16) {
     *inout_l = multiply_q16(*inout_l, volume_q16);
     *inout_r = multiply_q16(*inout_r, volume_q16);
 }
@@ -261,12 +279,22 @@ int32_t triode_ws_35_asym_fast_q24(int32_t x,
     return y;
 }
 
+// ============================================================================
+// === Shared Services ========================================================
+// ============================================================================
+
+#include "coef_bank.h"
+#include "envelope.h"
+#include "expression.h"
+#include "limiter.h"
+
 // ============================================================================
 // === Audio Effect Functions ================================================
 // ============================================================================
 
 #include <chorus.h>
 #include <compressor.h>
+#include <mb_compressor.h>    // After compressor.h (shares CompCurve)
 #include <delay.h>
 #include <distortion.h>
 #include <eq.h>
@@ -278,9 +306,19 @@ int32_t triode_ws_35_asym_fast_q24(int32_t x,
 #include <speaker_sim.h>
 #include <tremolo.h>
 #include <vibrato.h>
+#include <wah.h>
 
 #include <preamp_fender.h>
 #include <preamp_vox.h>
 #include <preamp_marshall.h>
 #include <preamp_soldano.h>
+#include <power_amp.h>        // After the preamps (voiced per preamp style)
+#include <dual_amp.h>
 //#include <preamp.h>
+
+// ============================================================================
+// === Parameter Modulation ===================================================
+// ============================================================================
+
+#include "modulation.h"
+#include "midi_control.h"    // Drained before the modulation block update
@@ -0,0 +1,146 @@
+/* boot.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef BOOT_H
+#define BOOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// === Staged boot (core 1) ===================================================
+// ============================================================================
+//
+// Core 1 only sets up what the audio blocks read (pots, expander, volume,
+// modulation, MIDI queue) before it releases core 0, which starts I2S with
+// every slot dry. The rest runs from the core 1 loop, one short step per
+// pass, while audio already passes:
+//
+//   BOOT_EFFECTS     init + coefficients of one effect per pass
+//   BOOT_OLED        display, splash, spectrum tables
+//   BOOT_SPI_RAM     SPI bus for the delay line
+//   BOOT_DELAY_CLEAR zero BOOT_CLEAR_BLOCKS delay blocks per pass (~200 ms)
+//
+// A slot only switches to an effect in boot_ready_mask (update_slot_targets),
+// so an effect that is on at power-up fades in as soon as its state is set.
+// The boot already cleared it, so its first pre-warm skips the clear.
+
+#define BOOT_SPLASH_US      1000000             // Logo time before the UI takes over
+#define BOOT_CLEAR_BLOCKS   32                  // Delay blocks per pass (~2 ms of SPI)
+
+typedef enum {
+    BOOT_EFFECTS,
+    BOOT_OLED,
+    BOOT_SPI_RAM,
+    BOOT_DELAY_CLEAR,
+    BOOT_DONE
+} BootStage;
+
+static BootStage boot_stage        = BOOT_EFFECTS;
+static uint32_t  boot_step         = 0;         // Effect / delay block of the stage
+static uint32_t  boot_ready_mask   = 0;         // Effects whose state is set up
+static uint32_t  boot_clean_mask   = 0;         // Ready and untouched since the boot cleared them
+static bool      boot_ui_ready     = false;     // Splash gone, drawUI may run
+static uint64_t  boot_splash_until = 0;
+
+static inline bool boot_effect_ready(int effect) {
+    return (boot_ready_mask & (1u << effect)) != 0;
+}
+
+static inline void boot_mark_ready(int effect) {
+    boot_ready_mask |= 1u << effect;
+    boot_clean_mask |= 1u << effect;
+}
+
+// State and coefficients of one effect (the delay has its own stages)
+static void boot_init_effect(int effect) {
+    switch (effect) {
+        case CHRS_EFFECT_INDEX:    init_chorus();        break;
+        case PHSR_EFFECT_INDEX:    init_phaser();        break;
+        case COMP_EFFECT_INDEX:    init_compressor();    break;
+        case MBC_EFFECT_INDEX:     init_mb_compressor(); break;
+        case CAB_SIM_EFFECT_INDEX: init_speaker_sim();   break;
+        case WAH_EFFECT_INDEX:     init_wah();           break;
+        case REVB_EFFECT_INDEX:    reverb_init();        break;
+        case PREAMP_EFFECT_INDEX:
+            init_power_amp();
+            load_fender_params_from_memory();
+            load_vox_params_from_memory();
+            load_marshall_params_from_memory();
+            load_slo_params_from_memory();
+            load_dual_amp_params();
+            break;
+        default:
+            break;
+    }
+    if (effect_param_loaders[effect]) effect_param_loaders[effect]();
+}
+
+// One boot step, call from the core 1 loop
+static void boot_poll(uint64_t now) {
+    // Splash time over: hand the display to the UI
+    if (!boot_ui_ready && boot_splash_until != 0 && now >= boot_splash_until) {
+        SSD1306_UpdateScreen();
+        SetFont(&Font8x8);
+        boot_ui_ready = true;
+    }
+
+    switch (boot_stage) {
+        case BOOT_EFFECTS:
+            if (boot_step != DELAY_EFFECT_INDEX) {
+                boot_init_effect((int)boot_step);
+                boot_mark_ready((int)boot_step);
+            }
+            if (++boot_step >= NUM_EFFECTS) {
+                boot_stage = BOOT_OLED;
+                boot_step  = 0;
+            }
+            break;
+
+        case BOOT_OLED:
+            SSD1306_Init();
+            SSD1306_ClearScreen();
+            SSD1306_DrawSplashLogoBitmap(32, 0, true);
+            boot_splash_until = now + BOOT_SPLASH_US;
+            spectrum_init();
+            boot_stage = BOOT_SPI_RAM;
+            break;
+
+        case BOOT_SPI_RAM:
+            spi_ram_init(SPI_TARGET_HZ / 2);
+            boot_stage = BOOT_DELAY_CLEAR;
+            break;
+
+        case BOOT_DELAY_CLEAR:
+            clear_delay_blocks(boot_step, BOOT_CLEAR_BLOCKS);
+            boot_step += BOOT_CLEAR_BLOCKS;
+            if (boot_step >= SPI_BLOCK_COUNT / 2) {
+                init_delay_state();
+                load_delay_parms_from_memory();
+                boot_mark_ready(DELAY_EFFECT_INDEX);
+                boot_stage = BOOT_DONE;
+            }
+            break;
+
+        case BOOT_DONE:
+            break;
+    }
+}
+
+#endif // BOOT_H
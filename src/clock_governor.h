@@ -0,0 +1,245 @@
+/* clock_governor.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef CLOCK_GOVERNOR_H
+#define CLOCK_GOVERNOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// === Clock governor =========================================================
+// ============================================================================
+//
+// Lowers clk_sys while the chain is light. The levels are the boot plan's
+// pll_sys divided by a whole number (230.4 -> 115.2 MHz), kept only where
+// the I2S dividers stay exact, so fs never moves. The PLL stays locked:
+// a switch is one write to the clk_sys divider plus the PIO dividers, done
+// by core 0 right after its DMA block (the furthest point from a deadline).
+// clk_peri runs from pll_sys, so SPI and UART don't notice. I2C is clocked
+// from clk_sys: core 1 re-derives its divider after every level change, and
+// waits for a faster level to run before its next transfer (or takes the
+// request back), so the bus only ever runs slower than I2C_TARGET_HZ in
+// between.
+//
+// Core 1 measures the peak core 0 load (DMA block and deferred job, each
+// against its own period) every GOV_POLL_US:
+// - above GOV_UP_PCT, or any deferred overrun: back to the fastest level
+// - a slower level would have stayed under GOV_TARGET_PCT for GOV_HOLD_US:
+//   step down to it
+// - before an effect is switched in: fastest level first (governor_boost),
+//   the hold restarts with the new chain
+//
+// Core 1 (UI, USB, spectrum) is not measured, GOV_MIN_SYS_HZ keeps it fed.
+
+#define GOV_MAX_LEVELS      3
+#define GOV_MAX_PATTERN     16                  // Slower levels may use a longer divider pattern
+#define GOV_MIN_SYS_HZ      100000000u
+#define GOV_TARGET_PCT      60
+#define GOV_UP_PCT          80
+#define GOV_HOLD_US         1000000             // 1 s below target before stepping down
+#define GOV_POLL_US         10000
+#define GOV_BLOCK_US        ((AUDIO_BUFFER_FRAMES * 1000000u) / SAMPLE_RATE)
+#define GOV_JOB_US          ((DEFER_FRAMES * 1000000u) / SAMPLE_RATE)
+#define GOV_SWITCH_WAIT_US  (2 * GOV_BLOCK_US)  // Core 0 switches at the end of its next block
+
+typedef struct {
+    uint32_t sys_hz;
+    uint8_t  sys_div;                           // clk_sys = pll_sys / sys_div
+    uint32_t sck_div_x256;                      // I2S PIO dividers (8.8)
+    uint32_t bck_div_x256;
+} GovLevel;
+
+static GovLevel gov_levels[GOV_MAX_LEVELS];     // Fastest first
+static uint8_t  gov_num_levels = 1;             // 1 = fixed clock
+
+static volatile uint8_t  gov_level    = 0;      // Running (core 0)
+static volatile uint8_t  gov_request  = 0;      // Wanted (core 1)
+static volatile uint32_t gov_switches = 0;
+static volatile uint32_t gov_applies  = 0;      // governor_apply() calls finished (core 0)
+
+// Peaks since the last poll (core 0 raises, core 1 clears)
+static volatile uint16_t gov_block_peak_us = 0;
+static volatile uint16_t gov_job_peak_us   = 0;
+static volatile bool     gov_hold_reset    = false;
+
+static uint8_t gov_i2c_level = 0;               // Level the I2C divider is set for (core 1)
+
+// Levels from the boot plan (core 0, before I2S starts)
+static void governor_init(const ClockPlan* plan, bool plan_ok, const i2s_config* cfg) {
+    const uint64_t sck_pio_hz = (uint64_t)cfg->fs * cfg->sck_mult * CLOCK_PLAN_SCK_PIO_MULT;
+    const uint64_t bck_pio_hz = (uint64_t)cfg->fs * cfg->bit_depth * 2 * CLOCK_PLAN_BCK_PIO_MULT;
+
+    gov_num_levels = 1;
+    if (!CLOCK_GOVERNOR || !plan_ok) return;
+
+    gov_levels[0] = (GovLevel){ plan->sys_hz, 1,
+                                ((uint32_t)plan->sck_div_int << 8) | plan->sck_div_frac,
+                                (uint32_t)(((uint64_t)plan->sys_hz * 256) / bck_pio_hz) };
+
+    for (uint32_t d = 2; d <= 256 && gov_num_levels < GOV_MAX_LEVELS; d++) {
+        if (plan->sys_hz % d) continue;
+        uint32_t sys = plan->sys_hz / d;
+        if (sys < GOV_MIN_SYS_HZ) break;
+
+        uint64_t sck = (uint64_t)sys * 256;
+        uint64_t bck = (uint64_t)sys * 256;
+        if ((sck % sck_pio_hz) || (bck % bck_pio_hz)) continue;
+        sck /= sck_pio_hz;
+        bck /= bck_pio_hz;
+        if (sck < 256 || bck < 256) break;
+        if (clock_plan_pattern((uint8_t)(sck & 0xFF)) > GOV_MAX_PATTERN) continue;
+
+        gov_levels[gov_num_levels++] = (GovLevel){ sys, (uint8_t)d, (uint32_t)sck, (uint32_t)bck };
+    }
+}
+
+// ============================================================================
+// === Core 0 =================================================================
+// ============================================================================
+
+static inline __attribute__((always_inline)) void governor_block_done(uint32_t us) {
+    if (us > gov_block_peak_us) gov_block_peak_us = (uint16_t)((us > 0xFFFFu) ? 0xFFFFu : us);
+}
+
+static inline __attribute__((always_inline)) void governor_job_done(uint32_t us) {
+    if (us > gov_job_peak_us) gov_job_peak_us = (uint16_t)((us > 0xFFFFu) ? 0xFFFFu : us);
+}
+
+// End of the DMA handler: switch to the requested level
+static inline __attribute__((always_inline)) void governor_apply(const pio_i2s* i2s) {
+    const uint8_t want = gov_request;
+    if (want == gov_level) {
+        gov_applies++;
+        return;
+    }
+
+    const GovLevel* l = &gov_levels[want];
+
+    // A few cycles between the writes, so no interrupt in between
+    uint32_t irq = save_and_disable_interrupts();
+    clocks_hw->clk[clk_sys].div = (uint32_t)l->sys_div << CLOCKS_CLK_SYS_DIV_INT_LSB;
+    i2s_set_clkdiv(i2s, l->sck_div_x256, l->bck_div_x256);
+    restore_interrupts(irq);
+
+    clock_set_reported_hz(clk_sys, l->sys_hz);
+    gov_block_peak_us = 0;
+    gov_job_peak_us   = 0;
+    gov_level         = want;
+    gov_switches++;
+    gov_applies++;
+}
+
+// ============================================================================
+// === Core 1 =================================================================
+// ============================================================================
+
+// I2C runs from clk_sys: new divider for the running level (between transfers)
+static void governor_sync_i2c(void) {
+    const uint8_t l = gov_level;
+    if (l == gov_i2c_level) return;
+    i2c_set_baudrate(I2C_PORT, I2C_TARGET_HZ * 1000);      // From the reported clk_sys
+    gov_i2c_level = l;
+}
+
+// Ask for a faster level and wait for it, the I2C divider follows right away.
+// On a timeout the request is taken back, and core 0 gets one more
+// governor_apply() to finish a switch it may have started on it, so no
+// faster level can land later in the middle of a transfer.
+static bool governor_raise(uint8_t want) {
+    gov_request = want;
+    uint32_t start = time_us_32();
+    while (gov_level != want && time_us_32() - start < GOV_SWITCH_WAIT_US) tight_loop_contents();
+
+    if (gov_level != want) {
+        gov_request = gov_level;
+        const uint32_t applies = gov_applies;
+        start = time_us_32();
+        while (gov_applies == applies && time_us_32() - start < GOV_SWITCH_WAIT_US) tight_loop_contents();
+        gov_request = gov_level;                // Landed after all: keep it
+    }
+    governor_sync_i2c();
+    return gov_level == want;
+}
+
+// Fastest clock before the chain gets heavier, true once it runs
+static bool governor_boost(void) {
+    if (gov_num_levels < 2) return true;
+    gov_hold_reset = true;
+    return governor_raise(0);
+}
+
+// Call from the core 1 loop
+static void governor_poll(uint64_t now) {
+    static uint64_t last_poll     = 0;
+    static uint64_t hold_start    = 0;
+    static uint32_t hold_peak     = 0;          // Peak load of the hold, % of the fastest level
+    static uint32_t seen_switches = 0;
+    static uint32_t seen_overruns = 0;
+
+    if (gov_num_levels < 2) return;
+    governor_sync_i2c();                        // After a step down (or a raise that timed out)
+    if (now - last_poll < GOV_POLL_US) return;
+    last_poll = now;
+
+    // Load since the last poll at the running clock
+    uint32_t block_pct = (uint32_t)gov_block_peak_us * 100 / GOV_BLOCK_US;
+    uint32_t job_pct   = LATENCY_SPLIT ? (uint32_t)gov_job_peak_us * 100 / GOV_JOB_US : 0;
+    gov_block_peak_us = 0;
+    gov_job_peak_us   = 0;
+
+    uint32_t overruns = defer_overruns;
+    bool     overrun  = (overruns != seen_overruns);
+    seen_overruns = overruns;
+
+    // Switch pending or just done: measure the new clock from scratch
+    if (gov_request != gov_level) return;
+    if (gov_switches != seen_switches || gov_hold_reset) {
+        seen_switches  = gov_switches;
+        gov_hold_reset = false;
+        hold_start     = now;
+        hold_peak      = 0;
+        return;
+    }
+
+    const uint8_t cur = gov_level;
+    uint32_t pct = (block_pct > job_pct) ? block_pct : job_pct;
+
+    if (cur != 0 && (pct > GOV_UP_PCT || overrun)) {
+        governor_raise(0);
+        return;
+    }
+
+    uint32_t at_top = (uint32_t)(((uint64_t)pct * gov_levels[cur].sys_hz) / gov_levels[0].sys_hz);
+    if (at_top > hold_peak) hold_peak = at_top;
+    if (now - hold_start < GOV_HOLD_US) return;
+
+    // Slowest level the whole hold would have fitted
+    uint8_t want = 0;
+    for (uint8_t l = 1; l < gov_num_levels; l++) {
+        uint64_t load = ((uint64_t)hold_peak * gov_levels[0].sys_hz) / gov_levels[l].sys_hz;
+        if (load <= GOV_TARGET_PCT) want = l;
+    }
+    if (want > cur) gov_request = want;
+
+    hold_start = now;
+    hold_peak  = 0;
+}
+
+#endif // CLOCK_GOVERNOR_H
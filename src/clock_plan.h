@@ -0,0 +1,108 @@
+/* clock_plan.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef CLOCK_PLAN_H
+#define CLOCK_PLAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// === Clock planner ==========================================================
+// ============================================================================
+//
+// clk_sys = XOSC * fbdiv / (postdiv1 * postdiv2), VCO 750..1600 MHz. The I2S
+// state machines divide clk_sys by an 8.8 fixed point PIO divider:
+//
+//   SCK PIO clock = fs * sck_mult * 2     (24.576 MHz at 48 kHz, 256 fs)
+//   BCK PIO clock = fs * bit_depth * 4
+//
+// A plan is usable when the SCK divider is exact in 8.8 (fs comes out exact,
+// BCK is a whole ratio of it). Its jitter is the pattern of the fractional
+// part: an integer divider has none, frac 128 alternates every 2 periods,
+// frac 32 every 8, and so on. The search keeps the fastest clk_sys up to the
+// limit whose pattern is at most CLOCK_PLAN_MAX_PATTERN.
+//
+// With the 12 MHz crystal no PLL setting gives an integer SCK divider at
+// 48 kHz (it would need a 3.072 GHz VCO). The best plans below 250 MHz are
+// 230.4 MHz (pattern 8) and 153.6 MHz (pattern 4). tools/clock_plan.py runs
+// the same search on the host.
+
+#define CLOCK_PLAN_XOSC_HZ          12000000u
+#define CLOCK_PLAN_VCO_MIN_HZ       750000000u
+#define CLOCK_PLAN_VCO_MAX_HZ       1600000000u
+#define CLOCK_PLAN_MAX_PATTERN      8               // Longest fractional divider pattern accepted
+#define CLOCK_PLAN_SCK_PIO_MULT     2               // Must match i2s.pio
+#define CLOCK_PLAN_BCK_PIO_MULT     2
+
+typedef struct {
+    uint32_t sys_hz;
+    uint32_t vco_hz;
+    uint8_t  postdiv1;
+    uint8_t  postdiv2;
+    uint16_t sck_div_int;                           // SCK PIO divider (8.8)
+    uint8_t  sck_div_frac;
+    uint16_t pattern;                               // Divider pattern length, 1 = integer
+} ClockPlan;
+
+// Pattern length of an 8.8 divider's fractional part
+static inline uint16_t clock_plan_pattern(uint8_t frac) {
+    if (frac == 0) return 1;
+    uint16_t n = 256;
+    while ((frac & 1) == 0) {
+        frac >>= 1;
+        n >>= 1;
+    }
+    return n;
+}
+
+// Fastest plan up to max_hz, false if none fits the pattern limit
+static bool clock_plan_find(uint32_t fs, uint32_t sck_mult, uint32_t max_hz, ClockPlan* best) {
+    const uint64_t sck_pio_hz = (uint64_t)fs * sck_mult * CLOCK_PLAN_SCK_PIO_MULT;
+    bool found = false;
+
+    for (uint32_t fbdiv = 16; fbdiv <= 320; fbdiv++) {
+        uint32_t vco = CLOCK_PLAN_XOSC_HZ * fbdiv;
+        if (vco < CLOCK_PLAN_VCO_MIN_HZ || vco > CLOCK_PLAN_VCO_MAX_HZ) continue;
+
+        for (uint32_t pd1 = 1; pd1 <= 7; pd1++) {
+            for (uint32_t pd2 = 1; pd2 <= pd1; pd2++) {
+                if (vco % (pd1 * pd2)) continue;
+                uint32_t sys = vco / (pd1 * pd2);
+                if (sys > max_hz || (found && sys <= best->sys_hz)) continue;
+
+                // SCK divider must be exact in 8.8
+                uint64_t div_x256 = (uint64_t)sys * 256;
+                if (div_x256 % sck_pio_hz) continue;
+                div_x256 /= sck_pio_hz;
+                if (div_x256 < 256 || div_x256 >= (1u << 24)) continue;
+
+                uint16_t pattern = clock_plan_pattern((uint8_t)(div_x256 & 0xFF));
+                if (pattern > CLOCK_PLAN_MAX_PATTERN) continue;
+
+                *best = (ClockPlan){ sys, vco, (uint8_t)pd1, (uint8_t)pd2,
+                                     (uint16_t)(div_x256 >> 8), (uint8_t)(div_x256 & 0xFF), pattern };
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+#endif // CLOCK_PLAN_H
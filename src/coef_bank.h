@@ -0,0 +1,91 @@
+/* coef_bank.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef COEF_BANK_H
+#define COEF_BANK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// ============================================================================
+// === Coefficient Banks ======================================================
+// ============================================================================
+//
+// The loaders (core 1) compute an effect's coefficients in floats, its
+// kernel (core 0) runs on them. Every effect keeps the values its loader
+// writes in one struct with two copies: core 1 rewrites the inactive copy
+// and marks it pending, core 0 switches to it at the start of the effect's
+// next block (coef_live). A block so always runs on one whole set.
+//
+// Neither core waits for the other: core 1 holds one hardware spin lock
+// while it edits, core 0 only tries to take it for the switch. If core 1 is
+// in the middle of an edit the block runs on the old set and switches one
+// block later.
+//
+// Values core 0 writes itself (ramps, smoothed gains) and filter states
+// stay outside the banks.
+
+typedef struct {
+    void*            copy[2];
+    uint16_t         size;
+    volatile uint8_t live;              // Copy core 0 runs on (core 0 writes)
+    volatile bool    pending;           // Inactive copy is newer (core 1 sets, core 0 clears)
+} CoefBank;
+
+#define COEF_BANK(copies)   { { &(copies)[0], &(copies)[1] }, sizeof((copies)[0]), 0, false }
+
+static spin_lock_t* coef_lock = NULL;
+static uint32_t     coef_irq  = 0;      // Core 1 interrupt state during an edit
+
+// Core 1, before the first loader runs
+static void coef_bank_init(void) {
+    coef_lock = spin_lock_instance((uint)spin_lock_claim_unused(true));
+}
+
+// Core 1: open the inactive copy, holds the lock until coef_commit (don't nest)
+static inline void* coef_edit(CoefBank* b) {
+    coef_irq = spin_lock_blocking(coef_lock);
+    uint8_t next = b->live ^ 1;
+    if (!b->pending) memcpy(b->copy[next], b->copy[b->live], b->size);
+    return b->copy[next];
+}
+
+// Core 1: hand the edited copy to core 0 (spin_unlock orders the writes)
+static inline void coef_commit(CoefBank* b) {
+    b->pending = true;
+    spin_unlock(coef_lock, coef_irq);
+}
+
+// Core 0, block start of the effect: take a pending copy, return the live one
+static inline __attribute__((always_inline)) const void* coef_live(CoefBank* b) {
+    if (b->pending && spin_try_lock_unsafe(coef_lock)) {
+        b->live ^= 1;
+        b->pending = false;
+        spin_unlock_unsafe(coef_lock);
+    }
+    return b->copy[b->live];
+}
+
+// Live copy without switching (other readers of a bank, either core)
+static inline __attribute__((always_inline)) const void* coef_peek(const CoefBank* b) {
+    return b->copy[b->live];
+}
+
+#endif // COEF_BANK_H
@@ -0,0 +1,211 @@
+/* deferred.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef DEFERRED_H
+#define DEFERRED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// === Latency split (deferred wet path) ======================================
+// ============================================================================
+//
+// The DMA ISR keeps the small block for the dry path (drives, preamps, the
+// dry share of every effect). Delay and reverb are split: the ISR applies
+// their dry gain itself and queues the slot input into a DEFER_FRAMES block;
+// a lowest-priority IRQ on core 0 runs the effect wet-only on the whole
+// block while the DMA ISR keeps preempting it.
+//
+// Cycle c (DEFER_FRAMES long): the ISR writes in[c & 1] and reads out[c & 1],
+// the job runs in[(c - 1) & 1] -> out[(c - 1) & 1]. So the wet signal comes
+// back exactly 2 * DEFER_FRAMES late (DEFER_LATENCY_FRAMES, set in Main.c),
+// the same for every sample. The delay and the reverb take that back: their
+// output taps read DEFER_LATENCY_FRAMES ahead of the loop taps, so the first
+// echo and the reverb onset land where the pots put them and the echo spacing
+// stays exact.
+//
+// A job still running at the end of a cycle is an overrun, counted in
+// defer_overruns: the ISR is about to refill that job's buffer, so the late
+// job's output is dropped (wet silent for one cycle) and it leaves fed[] to
+// the ISR. A lane the late job copies after the close would see new input
+// over old, so it runs on silence instead (the delay / reverb memory keeps
+// its timeline). The block just closed waits and runs once the late job
+// returns.
+//
+// The job never ticks the modulation's per-block mix ramps (they are set for
+// the ISR's small block): each lane snapshots the mix target when its cycle
+// closes and ramps to it across the DEFER_FRAMES block on its own ParamRamp.
+
+#define DEFER_NUM_LANES         2                               // One per deferrable effect
+
+#if (DEFER_FRAMES % AUDIO_BUFFER_FRAMES) != 0
+#error "DEFER_FRAMES must be a multiple of AUDIO_BUFFER_FRAMES"
+#endif
+
+typedef struct {
+    int32_t in_l[2][DEFER_FRAMES];
+    int32_t in_r[2][DEFER_FRAMES];
+    int32_t out_l[2][DEFER_FRAMES];
+    int32_t out_r[2][DEFER_FRAMES];
+    volatile bool fed[2];               // ISR queued input into in[b] (job clears)
+    volatile bool valid[2];             // out[b] holds a finished job
+    int32_t dry_q24;                    // Dry gain ramp state (ISR)
+    int32_t mix_next[2];                // Mix target snapshot at the close of cycle b (ISR)
+    ParamRamp mix_ramp;                 // Wet mix across the job's block (job only)
+} DeferLane;
+
+static PLACE_DEFERRED DeferLane defer_lane[DEFER_NUM_LANES];
+
+static uint32_t          defer_pos      = 0;    // Frames into the current cycle (ISR)
+static uint8_t           defer_buf      = 0;    // Buffer of the current cycle (ISR)
+static volatile uint8_t  defer_job_buf  = 0;    // Buffer the job works on
+static volatile bool     defer_busy     = false;
+static volatile bool     defer_job_late = false;    // Running job overran, drop its output
+static volatile int8_t   defer_queued   = -1;       // Closed block waiting for the job
+static volatile uint32_t defer_overruns = 0;
+static uint              defer_irq;
+
+static const int8_t defer_lane_effect[DEFER_NUM_LANES] = { DELAY_EFFECT_INDEX, REVB_EFFECT_INDEX };
+static ParamRamp* const defer_lane_mix[DEFER_NUM_LANES] = { &delay_mix_ramp, &reverb_mix_ramp };
+
+// Lane of an effect, -1 = runs in the ISR
+static inline int deferred_lane(int effect) {
+    if (!LATENCY_SPLIT) return -1;
+    for (int k = 0; k < DEFER_NUM_LANES; k++) {
+        if (defer_lane_effect[k] == effect) return k;
+    }
+    return -1;
+}
+
+// Dry gain of a split effect (Q8.24), what its kernel would have mixed in.
+// Reads the block's mix target (ISR side), never the job's running mix, and
+// peeks the coefficient bank: only the job switches it.
+static inline int32_t deferred_dry_gain_q24(int effect) {
+    if (effect == DELAY_EFFECT_INDEX) {
+        const DelayCoefs* c = coef_peek(&delay_bank);
+        return (int32_t)(((uint64_t)(uint32_t)(Q16_ONE - delay_mix_ramp.target) * c->volume_q16) >> 8);
+    }
+    const ReverbCoefs* c = coef_peek(&reverb_bank);
+    return qmul(Q24_ONE - reverb_mix_ramp.target, c->output_gain_q24);
+}
+
+// Core 1: the job may still touch the effect's state (don't prewarm yet)
+static inline bool deferred_effect_busy(int effect) {
+    int lane = deferred_lane(effect);
+    if (lane < 0) return false;
+    return defer_busy || defer_lane[lane].fed[0] || defer_lane[lane].fed[1];
+}
+
+// ============================================================================
+// === Core 0: ISR side =======================================================
+// ============================================================================
+
+// Replaces the effect in a slot: dry now, wet from the job two cycles back
+static inline __attribute__((always_inline))
+void deferred_process_block(int effect, int32_t* in_l, int32_t* in_r, size_t frames) {
+    DeferLane* ln = &defer_lane[deferred_lane(effect)];
+    const uint8_t b = defer_buf;
+
+    // Joined mid-cycle: the front of the block is silence, not old input
+    if (!ln->fed[b] && defer_pos > 0) {
+        memset(ln->in_l[b], 0, defer_pos * sizeof(int32_t));
+        memset(ln->in_r[b], 0, defer_pos * sizeof(int32_t));
+    }
+    memcpy(&ln->in_l[b][defer_pos], in_l, frames * sizeof(int32_t));
+    memcpy(&ln->in_r[b][defer_pos], in_r, frames * sizeof(int32_t));
+    ln->fed[b] = true;
+
+    // Dry gain ramped across the block (mix / output pots)
+    int32_t target = deferred_dry_gain_q24(effect);
+    int32_t step   = (target - ln->dry_q24) / (int32_t)frames;
+    int32_t g      = ln->dry_q24;
+
+    if (ln->valid[b]) {
+        const int32_t* wl = &ln->out_l[b][defer_pos];
+        const int32_t* wr = &ln->out_r[b][defer_pos];
+        for (size_t i = 0; i < frames; i++) {
+            g += step;
+            in_l[i] = clamp24(clamp32((((int64_t)in_l[i] * g) >> 24) + wl[i]));
+            in_r[i] = clamp24(clamp32((((int64_t)in_r[i] * g) >> 24) + wr[i]));
+        }
+    } else {
+        for (size_t i = 0; i < frames; i++) {
+            g += step;
+            in_l[i] = qmul(in_l[i], g);
+            in_r[i] = qmul(in_r[i], g);
+        }
+    }
+    ln->dry_q24 = target;
+}
+
+// End of every ISR block: close the cycle and hand its input to the job
+static inline __attribute__((always_inline)) void deferred_end_block(size_t frames) {
+    if (!LATENCY_SPLIT) return;
+
+    defer_pos += frames;
+    if (defer_pos < DEFER_FRAMES) return;
+    defer_pos = 0;
+
+    const uint8_t b = defer_buf;
+    for (int k = 0; k < DEFER_NUM_LANES; k++) {
+        defer_lane[k].mix_next[b] = defer_lane_mix[k]->target;
+    }
+
+    if (defer_busy) {
+        // Last job not done: the next cycle refills b ^ 1, nothing of it is
+        // published; b runs after the late job
+        defer_overruns++;
+        defer_job_late = true;
+        for (int k = 0; k < DEFER_NUM_LANES; k++) {
+            defer_lane[k].fed[b ^ 1]   = false;
+            defer_lane[k].valid[b ^ 1] = false;
+        }
+        defer_queued = (int8_t)b;
+    } else {
+        defer_job_buf  = b;
+        defer_job_late = false;
+        defer_busy     = true;
+        irq_set_pending(defer_irq);
+    }
+    defer_buf = b ^ 1;
+}
+
+// ============================================================================
+// === Core 0: job side =======================================================
+// ============================================================================
+
+// Wet-only kernel of a lane on out[b], mix ramped on the lane's own ramp
+static inline void deferred_run_lane(int k, uint8_t b) {
+    DeferLane* ln = &defer_lane[k];
+    ramp_begin_block(&ln->mix_ramp, ln->mix_next[b], DEFER_FRAMES);
+
+    switch (defer_lane_effect[k]) {
+        case DELAY_EFFECT_INDEX:
+            delay_process_block_mix(ln->out_l[b], ln->out_r[b], DEFER_FRAMES, selected_delay_mode, &ln->mix_ramp);
+            break;
+        case REVB_EFFECT_INDEX:
+            reverb_process_block_mix(ln->out_l[b], ln->out_r[b], DEFER_FRAMES, &ln->mix_ramp);
+            break;
+        default:
+            break;
+    }
+}
+
+#endif // DEFERRED_H
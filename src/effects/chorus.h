@@ -31,25 +31,30 @@
 #define CHORUS_MIN_DELAY_SAMPLES 16
 
 // === Buffer ===
-static int32_t chorus_buffer[MAX_CHORUS_DELAY_SAMPLES];
+static PLACE_CHORUS int32_t chorus_buffer[MAX_CHORUS_DELAY_SAMPLES];
 static uint32_t chorus_write_pos = 0;
 
-// === Parameters ===
-static uint32_t chorus_depth_q16 = Q16_ONE / 2;
-static uint32_t chorus_speed_q16 = Q16_ONE / 4;
-static uint32_t chorus_mix_q16   = Q16_ONE / 2;
-static uint32_t chorus_volume_q24 = Q24_ONE;
+// === Parameters (coefficient bank) ===
+typedef struct {
+    uint32_t lfo_inc;
+    uint32_t depth_q16;
+    uint32_t mix_q16;
+    uint32_t volume_q24;
+    uint32_t lpf_coef_q16;
+} ChorusCoefs;
+
+#define CHORUS_COEFS_DEFAULT { 0, Q16_ONE / 2, Q16_ONE / 2, Q24_ONE, 0x4000 }
+static ChorusCoefs chorus_coefs[2] = { CHORUS_COEFS_DEFAULT, CHORUS_COEFS_DEFAULT };
+static CoefBank    chorus_bank     = COEF_BANK(chorus_coefs);
 
 // === LFO Phases ===
 static uint32_t chorus_lfo_phase[3] = {0, 0x55555555, 0xAAAAAAAA};
-static uint32_t chorus_lfo_inc = 0;
 
 extern bool lfo_led_state;
 
 // --- LPF states ---
 static int32_t chorus_lpf_state_l = 0;
 static int32_t chorus_lpf_state_r = 0;
-static uint32_t chorus_lpf_coef_q16 = 0x4000; // default
 
 // one global flag the UI can poke (no header needed)
 volatile int8_t ui_chorus_mode_pending = -1;  // -1 = no change
@@ -140,16 +145,17 @@ static inline void init_chorus(void) {
 
 // === Load Parameters ===
 static inline void load_chorus_parms_from_memory(void) {
+    ChorusCoefs* c = coef_edit(&chorus_bank);
     int32_t pot;
 
     // Speed: 0.05 to 5 Hz
     pot = storedPotValue[CHRS_EFFECT_INDEX][0];
     float hz = 0.05f + ((float)pot / POT_MAX) * (5.0f - 0.05f);
-    chorus_lfo_inc = (uint32_t)((hz / SAMPLE_RATE) * 4294967296.0f);
+    c->lfo_inc = (uint32_t)((hz / SAMPLE_RATE) * 4294967296.0f);
 
     // Depth: 0 to 1
     pot = storedPotValue[CHRS_EFFECT_INDEX][1];
-    chorus_depth_q16 = map_pot_to_q16(pot, 0, Q16_ONE);
+    c->depth_q16 = map_pot_to_q16(pot, 0, Q16_ONE);
 
     // LPF cutoff: 100 Hz to 8 kHz (pot #4)
     pot = storedPotValue[CHRS_EFFECT_INDEX][4];
@@ -161,15 +167,17 @@ static inline void load_chorus_parms_from_memory(void) {
     float alpha = expf(-2.0f * 3.1415926f * freq_hz / SAMPLE_RATE);
     if (alpha < 0.0f) alpha = 0.0f;
     if (alpha > 1.0f) alpha = 1.0f;
-    chorus_lpf_coef_q16 = float_to_q16(alpha);
+    c->lpf_coef_q16 = float_to_q16(alpha);
 
     // Mix: 0 to 1
     pot = storedPotValue[CHRS_EFFECT_INDEX][3];
-    chorus_mix_q16 = map_pot_to_q16(pot, 0, Q16_ONE);
+    c->mix_q16 = map_pot_to_q16(pot, 0, Q16_ONE);
 
     // Volume: 0.1 to 4.0
     pot = storedPotValue[CHRS_EFFECT_INDEX][5];
-    chorus_volume_q24 = map_pot_to_q24(pot, float_to_q24(0.1f), float_to_q24(3.0f));
+    c->volume_q24 = map_pot_to_q24(pot, float_to_q24(0.1f), float_to_q24(3.0f));
+
+    coef_commit(&chorus_bank);
 }
 
 static inline void update_chorus_params_from_pots(int changed_pot) {
@@ -180,11 +188,11 @@ static inline void update_chorus_params_from_pots(int changed_pot) {
 
 // === Process Sample ===
 // Same structure as yours, but only computes the needed taps per mode.
-static inline void process_audio_chorus_sample(int32_t* inout_l, int32_t* inout_r, ChorusMode cmode) {
+static inline void process_audio_chorus_sample(int32_t* inout_l, int32_t* inout_r, ChorusMode cmode, const ChorusCoefs* c) {
     // advance all phases so their *offsets* stay fixed
-    chorus_lfo_phase[0] += chorus_lfo_inc;
-    chorus_lfo_phase[1] += chorus_lfo_inc;
-    chorus_lfo_phase[2] += chorus_lfo_inc;    
+    chorus_lfo_phase[0] += c->lfo_inc;
+    chorus_lfo_phase[1] += c->lfo_inc;
+    chorus_lfo_phase[2] += c->lfo_inc;    
 
     const uint32_t max_depth_samples = MAX_CHORUS_DELAY_SAMPLES - CHORUS_MIN_DELAY_SAMPLES - 4;
 
@@ -194,7 +202,7 @@ static inline void process_audio_chorus_sample(int32_t* inout_l, int32_t* inout_
     // tap 0 (always used)
     {
         uint32_t lfo_val_q16 = lfo_q16_shape(chorus_lfo_phase[0], LFO_TRIANGLE);
-        uint32_t scaled_q16  = (lfo_val_q16 * chorus_depth_q16) >> 16;
+        uint32_t scaled_q16  = (lfo_val_q16 * c->depth_q16) >> 16;
 
         uint32_t delay_samples = CHORUS_MIN_DELAY_SAMPLES + ((max_depth_samples * scaled_q16) >> 16);
         uint32_t int_delay = delay_samples;
@@ -212,7 +220,7 @@ static inline void process_audio_chorus_sample(int32_t* inout_l, int32_t* inout_
     if (cmode != MONO) {
         // tap 1 (stereo modes)
         uint32_t lfo_val_q16 = lfo_q16_shape(chorus_lfo_phase[1], LFO_TRIANGLE);
-        uint32_t scaled_q16  = (lfo_val_q16 * chorus_depth_q16) >> 16;
+        uint32_t scaled_q16  = (lfo_val_q16 * c->depth_q16) >> 16;
 
         uint32_t delay_samples = CHORUS_MIN_DELAY_SAMPLES + ((max_depth_samples * scaled_q16) >> 16);
         uint32_t int_delay = delay_samples;
@@ -229,7 +237,7 @@ static inline void process_audio_chorus_sample(int32_t* inout_l, int32_t* inout_
         if (cmode == STEREO_3) {
             // tap 2 (only stereo-3)
             lfo_val_q16 = lfo_q16_shape(chorus_lfo_phase[2], LFO_TRIANGLE);
-            scaled_q16  = (lfo_val_q16 * chorus_depth_q16) >> 16;
+            scaled_q16  = (lfo_val_q16 * c->depth_q16) >> 16;
 
             delay_samples = CHORUS_MIN_DELAY_SAMPLES + ((max_depth_samples * scaled_q16) >> 16);
             int_delay = delay_samples;
@@ -266,15 +274,15 @@ static inline void process_audio_chorus_sample(int32_t* inout_l, int32_t* inout_
     left_tap  = chorus_process_allpass_q16(left_tap,  &chorus_ap_state_l, chorus_ap_coef_q16);
     right_tap = chorus_process_allpass_q16(right_tap, &chorus_ap_state_r, chorus_ap_coef_q16);
 
-    left_tap  = chorus_process_lpf_q16(left_tap,  &chorus_lpf_state_l, chorus_lpf_coef_q16);
-    right_tap = chorus_process_lpf_q16(right_tap, &chorus_lpf_state_r, chorus_lpf_coef_q16);
+    left_tap  = chorus_process_lpf_q16(left_tap,  &chorus_lpf_state_l, c->lpf_coef_q16);
+    right_tap = chorus_process_lpf_q16(right_tap, &chorus_lpf_state_r, c->lpf_coef_q16);
 
     // mix
-    int64_t mix_l = ((int64_t)*inout_l * (Q16_ONE - chorus_mix_q16) + (int64_t)left_tap  * chorus_mix_q16) >> 16;
-    int64_t mix_r = ((int64_t)*inout_r * (Q16_ONE - chorus_mix_q16) + (int64_t)right_tap * chorus_mix_q16) >> 16;
+    int64_t mix_l = ((int64_t)*inout_l * (Q16_ONE - c->mix_q16) + (int64_t)left_tap  * c->mix_q16) >> 16;
+    int64_t mix_r = ((int64_t)*inout_r * (Q16_ONE - c->mix_q16) + (int64_t)right_tap * c->mix_q16) >> 16;
 
-    mix_l = (mix_l * chorus_volume_q24) >> 24;
-    mix_r = (mix_r * chorus_volume_q24) >> 24;
+    mix_l = (mix_l * c->volume_q24) >> 24;
+    mix_r = (mix_r * c->volume_q24) >> 24;
 
     *inout_l = clamp24((int32_t)mix_l);
     *inout_r = clamp24((int32_t)mix_r);
@@ -283,8 +291,12 @@ static inline void process_audio_chorus_sample(int32_t* inout_l, int32_t* inout_
 void chorus_process_block(int32_t* in_l, int32_t* in_r, size_t frames, FXmode mode) {
     // Check if mode has changed
     chorus_apply_pending_mode_if_any();
+
+    // MONO from the caller overrides the UI mode (dual mono chains), the phases stay set
+    ChorusMode cmode = ((ChorusMode)mode == MONO) ? MONO : chorus_current_mode;
+    const ChorusCoefs* c = coef_live(&chorus_bank);
     for (size_t i = 0; i < frames; i++) {
-        process_audio_chorus_sample(&in_l[i], &in_r[i], chorus_current_mode);
+        process_audio_chorus_sample(&in_l[i], &in_r[i], cmode, c);
     }
     // LED (only update when selected)
     if (lfo_update_led_flag) {
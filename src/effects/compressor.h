@@ -22,85 +22,136 @@
 
 #include <stdint.h>
 
-// === Fixed-point compressor without floating point ===
-#define SOFT_KNEE_WIDTH_Q24 float_to_q24(0.1f)  // ~10 dB knee width
-
-// Compressor parameters (Q8.24 fixed-point)
-static int32_t comp_threshold_q24 = 0;
-static int32_t comp_inv_ratio_q24 = 0;
-static int32_t comp_gain_q24 = Q24_ONE;
-static int32_t comp_attack_a_q24 = 0;
-static int32_t comp_release_a_q24 = 0;
-
-static int32_t env_l_q24 = 0;
-static int32_t env_r_q24 = 0;
+// === Fixed-point compressor, gain computer in the log2 domain ===
+//
+// Detection is stereo linked (louder channel) and runs at block rate on the
+// shared envelope service. Level, threshold, ratio, knee and makeup live in
+// log2 units (Q16), so the gain computer is adds and multiplies plus one
+// table lookup each way (log2_q16 / exp2_q24). The linear gain is ramped
+// across the block. An optional lookahead delays the audio behind the
+// detector so the gain is already down when a transient arrives. The delay
+// line is written even with the lookahead off, so a new lookahead crossfades
+// from the old read tap to the new one over COMP_LA_XFADE_SAMPLES.
+
+#define COMP_KNEE_DB            10.0f       // Soft knee width
+#define COMP_LOOKAHEAD_RING     128         // Delay line (power of two)
+#define COMP_NUM_LOOKAHEADS     4
+#define COMP_LA_XFADE_SAMPLES   96          // 2 ms tap crossfade on a lookahead change
+
+static const uint8_t comp_lookahead_samples[COMP_NUM_LOOKAHEADS] = { 0, 24, 48, 96 };  // 0 / 0.5 / 1 / 2 ms
+
+// Static curve of a gain computer (log2 units in Q16), shared with the multiband compressor
+typedef struct {
+    int32_t threshold_log2;
+    int32_t slope_q16;                      // 1 - 1/ratio
+    int32_t knee_log2;                      // Knee width
+    int32_t knee_coef_q16;                  // slope / (2 * knee)
+} CompCurve;
+
+// Compressor parameters (coefficient bank)
+typedef struct {
+    CompCurve curve;
+    int32_t   makeup_log2;                  // log2 units in Q16
+    uint32_t  lookahead;                    // Samples
+    EnvTimes  times;
+} CompCoefs;
+
+static CompCoefs comp_coefs[2];
+static CoefBank  comp_bank = COEF_BANK(comp_coefs);
+
+// Block-rate follower fed by the shared envelope service (linked detection)
+static EnvFollower comp_env;
+
+// Applied gain (incl. makeup), ramped across each block
 static int32_t gain_l_q24 = Q24_ONE;
-static int32_t gain_r_q24 = Q24_ONE;
-
-// Compute compressor gain for a single channel
-static inline int32_t compute_gain_q24(int32_t env_q24) {
-    if (env_q24 <= 0 || comp_inv_ratio_q24 >= Q24_ONE)
-        return Q24_ONE;
-
-    const int32_t knee_half = SOFT_KNEE_WIDTH_Q24 >> 1;
-    const int32_t knee_start = comp_threshold_q24 - knee_half;
-    const int32_t knee_end   = comp_threshold_q24 + knee_half;
-
-    if (env_q24 <= knee_start)
-        return Q24_ONE;
-
-    int32_t gain_end;
-    {
-        int32_t ratio_delta = Q24_ONE - comp_inv_ratio_q24;
-        int32_t over_thresh = env_q24 - comp_threshold_q24;
-        int32_t frac = qdiv(over_thresh, env_q24);
-        if (frac > Q24_ONE) frac = Q24_ONE;
-        gain_end = Q24_ONE - qmul(frac, ratio_delta);
-    }
 
-    if (env_q24 >= knee_end)
-        return gain_end;
+// Lookahead delay line
+static PLACE_COMPRESSOR int32_t comp_la_l[COMP_LOOKAHEAD_RING];
+static PLACE_COMPRESSOR int32_t comp_la_r[COMP_LOOKAHEAD_RING];
+static uint32_t comp_la_idx = 0;
+static uint32_t comp_la_cur  = 0;           // Lookahead being faded to / played
+static uint32_t comp_la_prev = 0;           // Lookahead being faded from
+static uint32_t comp_la_fade = Q16_ONE;     // Q16, Q16_ONE = on comp_la_cur only
+
+// Curve from threshold (dB, same scale as db_to_q24), ratio and knee width (core 1)
+static inline void comp_curve_set(CompCurve* c, float threshold_db, float ratio, float knee_db) {
+    c->threshold_log2 = log2_q16((uint32_t)db_to_q24(threshold_db));
+    c->slope_q16      = (int32_t)((1.0f - 1.0f / ratio) * 65536.0f);
+    c->knee_log2      = db_to_log2_q16(knee_db);
+    c->knee_coef_q16  = (int32_t)((float)c->slope_q16 / (2.0f * c->knee_log2 / 65536.0f));
+}
+
+// Gain reduction in log2 units (>= 0) for a detector level
+static inline int32_t comp_curve_gain_reduction(const CompCurve* c, int32_t env_q24) {
+    if (env_q24 <= 0 || c->slope_q16 <= 0) return 0;
+
+    int32_t over = log2_q16((uint32_t)env_q24) - c->threshold_log2;
+    int32_t x    = over + (c->knee_log2 >> 1);          // Position inside the knee
+
+    if (x <= 0) return 0;
+    if (x >= c->knee_log2) return (int32_t)(((int64_t)over * c->slope_q16) >> 16);
 
-    uint32_t t_q16 = (uint32_t)(((int64_t)(env_q24 - knee_start) << 16) / SOFT_KNEE_WIDTH_Q24);
-    return lerp_fixed(Q24_ONE, gain_end, t_q16);
+    // Quadratic knee: slope * x^2 / (2 * knee)
+    int64_t x2 = ((int64_t)x * x) >> 16;
+    return (int32_t)((x2 * c->knee_coef_q16) >> 16);
 }
 
 // Initialize default compressor values
 static inline void init_compressor(void) {
-    env_l_q24 = env_r_q24 = 0;
-    comp_threshold_q24 = float_to_q24(0.1f);  // ~ -20 dB
-    comp_inv_ratio_q24 = float_to_q24(1.0f / 4.0f);
-    comp_gain_q24 = Q24_ONE;
+    env_follower_reset(&comp_env);
+    CompCoefs* c = coef_edit(&comp_bank);
+    comp_curve_set(&c->curve, -20.0f, 4.0f, COMP_KNEE_DB);
+    c->makeup_log2 = 0;
+    coef_commit(&comp_bank);
+}
+
+// Clear detector and lookahead (only while the slot is off)
+static inline void reset_compressor_state(void) {
+    env_follower_reset(&comp_env);
+    memset(comp_la_l, 0, sizeof(comp_la_l));
+    memset(comp_la_r, 0, sizeof(comp_la_r));
+    const CompCoefs* c = coef_peek(&comp_bank);
+    comp_la_cur  = c->lookahead;
+    comp_la_prev = c->lookahead;
+    comp_la_fade = Q16_ONE;
+    gain_l_q24 = Q24_ONE;
 }
 
 // Load pot values
 static inline void load_compressor_parms_from_memory(void) {
+    CompCoefs* c = coef_edit(&comp_bank);
     int pot;
 
     // Threshold: -20 dB to +20 dB
     pot = storedPotValue[COMP_EFFECT_INDEX][0];
     float thresh_db = -20.0f + ((float)pot / POT_MAX) * 40.0f;
-    comp_threshold_q24 = db_to_q24(thresh_db);
 
     // Ratio: 1.1:1 to 20:1
     pot = storedPotValue[COMP_EFFECT_INDEX][1];
     float ratio = 1.1f + ((float)pot / POT_MAX) * 18.9f;
-    comp_inv_ratio_q24 = float_to_q24(1.0f / ratio);
+    comp_curve_set(&c->curve, thresh_db, ratio, COMP_KNEE_DB);
 
     // Attack time: 1 to 100 ms
     pot = storedPotValue[COMP_EFFECT_INDEX][2];
     float attack_ms = 1.0f + ((float)pot / POT_MAX) * 99.0f;
-    comp_attack_a_q24 = ms_to_coeff_q24(attack_ms, 48000.0f);
 
     // Release time: 20 to 500 ms
     pot = storedPotValue[COMP_EFFECT_INDEX][3];
     float release_ms = 20.0f + ((float)pot / POT_MAX) * 480.0f;
-    comp_release_a_q24 = ms_to_coeff_q24(release_ms, 48000.0f);
+
+    // Follower runs once per block
+    env_follower_set_times(&c->times, attack_ms, release_ms);
+
+    // Lookahead: off, 0.5, 1 or 2 ms
+    pot = storedPotValue[COMP_EFFECT_INDEX][4];
+    c->lookahead = comp_lookahead_samples[map_pot_to_int(pot, 0, COMP_NUM_LOOKAHEADS - 1)];
 
     // Makeup gain: 0 to +20 dB
     pot = storedPotValue[COMP_EFFECT_INDEX][5];
     float makeup_db = ((float)pot / POT_MAX) * 20.0f;
-    comp_gain_q24 = db_to_q24(makeup_db);
+    c->makeup_log2 = db_to_log2_q16(makeup_db);
+
+    coef_commit(&comp_bank);
 }
 
 static inline void update_compressor_params_from_pots(int changed_pot) {
@@ -109,51 +160,66 @@ static inline void update_compressor_params_from_pots(int changed_pot) {
     load_compressor_parms_from_memory();
 }
 
-static inline void process_audio_compressor_sample(int32_t* inout_l, int32_t* inout_r, bool stereo) {
-    for (int ch = 0; ch < 2; ++ch) {
-        int32_t* x = (ch == 0) ? inout_l : inout_r;
-        int32_t abs_x = (*x < 0) ? -*x : *x;
-        int32_t* env_ptr = (ch == 0) ? &env_l_q24 : &env_r_q24;
-
-        // Envelope follower
-        if (abs_x > *env_ptr)
-            *env_ptr = (int32_t)(((int64_t)*env_ptr * comp_attack_a_q24 + (int64_t)abs_x * (Q24_ONE - comp_attack_a_q24)) >> 24);
-        else
-            *env_ptr = (int32_t)(((int64_t)*env_ptr * comp_release_a_q24 + (int64_t)abs_x * (Q24_ONE - comp_release_a_q24)) >> 24);
-
-        // Gain is computed less frequently in block processor
+void compressor_process_block(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo) {
+    // Level in front of this slot, measured once per block by the envelope service
+    const CompCoefs* c = coef_live(&comp_bank);
+    const EnvTap* tap = env_get(env_slot_tap);
+    env_request(env_slot_tap);
+
+    // Linked detection: louder channel drives both
+    int32_t peak = tap->peak_l;
+    if (stereo && tap->peak_r > peak) peak = tap->peak_r;
+    int32_t env = env_follower_tap(&comp_env, &c->times, env_slot_tap, peak);
+
+    int32_t gr_log2 = comp_curve_gain_reduction(&c->curve, env);
+    comp_linear_gain_q24_l = exp2_q24(-gr_log2);
+    comp_linear_gain_q24_r = comp_linear_gain_q24_l;
+
+    // Ramp from last block's gain to the new one (no zipper at block rate)
+    int32_t target = exp2_q24(c->makeup_log2 - gr_log2);
+    int32_t step   = (target - gain_l_q24) / (int32_t)frames;
+
+    // New lookahead: fade over from the old tap (a running fade finishes first)
+    if (comp_la_fade == Q16_ONE && c->lookahead != comp_la_cur) {
+        comp_la_prev = comp_la_cur;
+        comp_la_cur  = c->lookahead;
+        comp_la_fade = 0;
     }
+    uint32_t la      = comp_la_cur;
+    uint32_t la_prev = comp_la_prev;
 
-    // Apply cached gain
-    int64_t y_l = ((int64_t)(*inout_l) * gain_l_q24) >> 24;
-    y_l = (y_l * comp_gain_q24) >> 24;
-    *inout_l = clamp24((int32_t)y_l);
-
-    if(!stereo){    
-        *inout_r = *inout_l;    // Process MONO 
-    } 
-    else{          
-        int64_t y_r = ((int64_t)(*inout_r) * gain_r_q24) >> 24;
-        y_r = (y_r * comp_gain_q24) >> 24;
-        *inout_r = clamp24((int32_t)y_r);
-    }
-}
-
-void compressor_process_block(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo) {
     for (size_t i = 0; i < frames; i++) {
-        process_audio_compressor_sample(&in_l[i], &in_r[i], stereo);
+        // Audio runs behind the detector by the lookahead (0 reads back the new sample)
+        uint32_t w  = comp_la_idx & (COMP_LOOKAHEAD_RING - 1);
+        uint32_t rd = (comp_la_idx - la) & (COMP_LOOKAHEAD_RING - 1);
+        comp_la_l[w] = in_l[i];
+        comp_la_r[w] = in_r[i];
+        int32_t x_l = comp_la_l[rd];
+        int32_t x_r = comp_la_r[rd];
+
+        if (comp_la_fade < Q16_ONE) {
+            uint32_t rp  = (comp_la_idx - la_prev) & (COMP_LOOKAHEAD_RING - 1);
+            int32_t  p_l = comp_la_l[rp];
+            int32_t  p_r = comp_la_r[rp];
+            comp_la_fade += Q16_ONE / COMP_LA_XFADE_SAMPLES;
+            if (comp_la_fade > Q16_ONE) comp_la_fade = Q16_ONE;
+            x_l = p_l + (int32_t)((((int64_t)x_l - p_l) * comp_la_fade) >> 16);
+            x_r = p_r + (int32_t)((((int64_t)x_r - p_r) * comp_la_fade) >> 16);
+        }
+        comp_la_idx++;
 
-        // Update gain every N samples to reduce CPU
-        static int counter = 0;
-        if (++counter >= 4) {
-            counter = 0;
-            gain_l_q24 = compute_gain_q24(env_l_q24);
-            gain_r_q24 = compute_gain_q24(env_r_q24);
+        gain_l_q24 += step;
+        in_l[i] = clamp24(clamp32(((int64_t)x_l * gain_l_q24) >> 24));
 
-            comp_linear_gain_q24_l = gain_l_q24;
-            comp_linear_gain_q24_r = gain_r_q24;
+        if (!stereo) {
+            in_r[i] = in_l[i];      // Process MONO
+        } else {
+            in_r[i] = clamp24(clamp32(((int64_t)x_r * gain_l_q24) >> 24));
         }
     }
+
+    // Land exactly on target (division remainder)
+    gain_l_q24 = target;
 }
 
 #endif // COMPRESSOR_H
\ No newline at end of file
@@ -28,18 +28,53 @@
 #define MAX_DELAY_SAMPLES  98304      // ~2 sec at 48 kHz
 #define BLOCK_SIZE         AUDIO_BUFFER_FRAMES // Make RAM delay samples and block size match
 #define SPI_BLOCK_COUNT    (MAX_DELAY_SAMPLES / BLOCK_SIZE)
+#define PERCH_DELAY_SAMPLES   (MAX_DELAY_SAMPLES / 2)
+#define MIN_DELAY_SAMPLES     (SAMPLE_RATE / 1000) // 1 ms worth of samples
+
+// === Parameters (coefficient bank) ===
+typedef struct {
+    uint32_t feedback_q16;
+    uint32_t lpf_alpha_q16;
+    uint32_t volume_q16;
+    uint32_t tap_l, tap_r;                      // Output tap, samples behind the write index
+    uint32_t lag_l, lag_r;                      // delay_samples - tap
+} DelayCoefs;
+
+#define DELAY_COEFS_DEFAULT { Q16_ONE / 4, Q16_ONE / 4, Q16_ONE, MIN_DELAY_SAMPLES, MIN_DELAY_SAMPLES, 0, 0 }
+static DelayCoefs delay_coefs[2] = { DELAY_COEFS_DEFAULT, DELAY_COEFS_DEFAULT };
+static CoefBank   delay_bank     = COEF_BANK(delay_coefs);
 
-// === Parameters ===
-static uint32_t delay_feedback_q16 = Q16_ONE / 4;
 static uint32_t delay_mix_q16 = Q16_ONE / 2;
 static uint32_t delay_dry_q16 = Q16_ONE / 2; // computed as 1 - mix
-static uint32_t volume_gain_q16 = Q16_ONE;
+static ParamRamp delay_mix_ramp = { Q16_ONE / 2, 0, Q16_ONE / 2 }; // mix target, set per block by the modulation
+static bool     delay_wet_only  = false;        // Dry share mixed by the caller (latency split)
 
-// === LPF parameters ===
-static uint32_t lpf_alpha_q16 = Q16_ONE / 4;
+// === LPF state ===
 static int32_t lpf_state_l = 0;
 static int32_t lpf_state_r = 0;
 
+// === Latency lead (deferred wet path) ===
+// The wet path plays DEFER_LATENCY_FRAMES late (deferred.h). The output tap
+// reads that much closer to the write index than delay_samples, the loop
+// still goes round delay_samples: its tap is the output tap lag samples ago,
+// kept in a small ring instead of a second SPI read.
+#define DELAY_LAG_RING     256
+#define DELAY_LAG_MASK     (DELAY_LAG_RING - 1)
+
+_Static_assert(DEFER_LATENCY_FRAMES < DELAY_LAG_RING, "delay lag ring shorter than the wet path latency");
+
+static int32_t  delay_lag_ring_l[DELAY_LAG_RING], delay_lag_ring_r[DELAY_LAG_RING];
+static uint32_t delay_lag_pos = 0;
+
+// Output taps of the current delay times, never closer than MIN_DELAY_SAMPLES
+static inline void delay_set_taps(DelayCoefs* c) {
+    const uint32_t lead = DEFER_LATENCY_FRAMES;
+    c->tap_l = delay_samples_l > MIN_DELAY_SAMPLES + lead ? delay_samples_l - lead : MIN_DELAY_SAMPLES;
+    c->tap_r = delay_samples_r > MIN_DELAY_SAMPLES + lead ? delay_samples_r - lead : MIN_DELAY_SAMPLES;
+    c->lag_l = delay_samples_l > c->tap_l ? delay_samples_l - c->tap_l : 0;
+    c->lag_r = delay_samples_r > c->tap_r ? delay_samples_r - c->tap_r : 0;
+}
+
 // === Left channel state ===
 static uint32_t spi_write_index_l = 0, spi_read_index_l = 0;
 static int32_t write_block_l[BLOCK_SIZE], read_block_l[BLOCK_SIZE];
@@ -76,20 +111,29 @@ static inline void spi_read_block(uint32_t block_index, int32_t* block, uint32_t
 }
 
 // === Initialization ===
-static inline void init_delay(void) {
-    memset(write_block_l, 0, sizeof(write_block_l));
-    memset(write_block_r, 0, sizeof(write_block_r));
-
+// Zero delay blocks [first, first + count) in both halves (the boot clears in steps)
+static inline void clear_delay_blocks(uint32_t first, uint32_t count) {
     int32_t tmp_block[BLOCK_SIZE] = {0};
 
-    for (uint32_t i = 0; i < SPI_BLOCK_COUNT / 2; i++) {
+    for (uint32_t i = first; i < first + count && i < SPI_BLOCK_COUNT / 2; i++) {
         spi_write_block(i, tmp_block, 0);
         spi_write_block(i, tmp_block, MAX_DELAY_SAMPLES * 4 / 2);
     }
+}
+
+// Read / write positions on a cleared RAM
+static inline void init_delay_state(void) {
+    memset(write_block_l, 0, sizeof(write_block_l));
+    memset(write_block_r, 0, sizeof(write_block_r));
+    memset(delay_lag_ring_l, 0, sizeof(delay_lag_ring_l));
+    memset(delay_lag_ring_r, 0, sizeof(delay_lag_ring_r));
+    delay_set_taps(coef_edit(&delay_bank));
+    coef_commit(&delay_bank);
+    const DelayCoefs* c = coef_peek(&delay_bank);
 
     // Left
     spi_read_index_l = 0;
-    spi_write_index_l = delay_samples_l % MAX_DELAY_SAMPLES;
+    spi_write_index_l = c->tap_l % MAX_DELAY_SAMPLES;
     write_block_index_l = (spi_write_index_l / BLOCK_SIZE) % (SPI_BLOCK_COUNT / 2);
     write_block_pos_l = spi_write_index_l % BLOCK_SIZE;
 
@@ -98,7 +142,7 @@ static inline void init_delay(void) {
 
     // Right
     spi_read_index_r = 0;
-    spi_write_index_r = delay_samples_r % MAX_DELAY_SAMPLES;
+    spi_write_index_r = c->tap_r % MAX_DELAY_SAMPLES;
     write_block_index_r = (spi_write_index_r / BLOCK_SIZE) % (SPI_BLOCK_COUNT / 2);
     write_block_pos_r = spi_write_index_r % BLOCK_SIZE;
 
@@ -106,6 +150,11 @@ static inline void init_delay(void) {
     spi_read_block(read_block_start_index_r % (SPI_BLOCK_COUNT / 2), read_block_r, MAX_DELAY_SAMPLES * 4 / 2);
 }
 
+static inline void init_delay(void) {
+    clear_delay_blocks(0, SPI_BLOCK_COUNT / 2);
+    init_delay_state();
+}
+
 static inline void clear_delay_memory(void) {
     int32_t tmp_block[BLOCK_SIZE] = {0};
 
@@ -129,15 +178,16 @@ static inline void clear_delay_memory(void) {
     lpf_state_r = 0;
 
     // Reset read/write indexes
+    const DelayCoefs* c = coef_peek(&delay_bank);
     spi_read_index_l = 0;
-    spi_write_index_l = delay_samples_l % MAX_DELAY_SAMPLES;
+    spi_write_index_l = c->tap_l % MAX_DELAY_SAMPLES;
     write_block_index_l = (spi_write_index_l / BLOCK_SIZE) % (SPI_BLOCK_COUNT / 2);
     write_block_pos_l = spi_write_index_l % BLOCK_SIZE;
     read_block_start_index_l = spi_read_index_l / BLOCK_SIZE;
     spi_read_block(read_block_start_index_l % (SPI_BLOCK_COUNT / 2), read_block_l, 0);
 
     spi_read_index_r = 0;
-    spi_write_index_r = delay_samples_r % MAX_DELAY_SAMPLES;
+    spi_write_index_r = c->tap_r % MAX_DELAY_SAMPLES;
     write_block_index_r = (spi_write_index_r / BLOCK_SIZE) % (SPI_BLOCK_COUNT / 2);
     write_block_pos_r = spi_write_index_r % BLOCK_SIZE;
     read_block_start_index_r = spi_read_index_r / BLOCK_SIZE;
@@ -145,7 +195,7 @@ static inline void clear_delay_memory(void) {
 }
 
 // === Main process (sample-based) ===
-static inline void process_audio_delay_sample(int32_t* inout_l, int32_t* inout_r, DelayMode mode) {
+static inline void process_audio_delay_sample(int32_t* inout_l, int32_t* inout_r, DelayMode mode, const DelayCoefs* c) {
     // === Compute block info ===
     uint32_t block_idx_l = spi_read_index_l / BLOCK_SIZE;
     uint32_t offset_l    = spi_read_index_l % BLOCK_SIZE;
@@ -163,28 +213,35 @@ static inline void process_audio_delay_sample(int32_t* inout_l, int32_t* inout_r
     int32_t delayed_l = read_block_l[offset_l];
     int32_t delayed_r = read_block_r[offset_r];
 
+    // === Loop taps, delay_samples back ===
+    delay_lag_ring_l[delay_lag_pos] = delayed_l;
+    delay_lag_ring_r[delay_lag_pos] = delayed_r;
+    int32_t loop_l = delay_lag_ring_l[(delay_lag_pos - c->lag_l) & DELAY_LAG_MASK];
+    int32_t loop_r = delay_lag_ring_r[(delay_lag_pos - c->lag_r) & DELAY_LAG_MASK];
+    delay_lag_pos = (delay_lag_pos + 1) & DELAY_LAG_MASK;
+
     // === Feedback inputs based on mode ===
     int32_t fb_l, fb_r;
     int32_t pre_lpf_l, pre_lpf_r;
 
     switch (mode) {
         case DELAY_MODE_PARALLEL:
-            fb_l = multiply_q16(delayed_l, delay_feedback_q16);
-            fb_r = multiply_q16(delayed_r, delay_feedback_q16);
+            fb_l = multiply_q16(loop_l, c->feedback_q16);
+            fb_r = multiply_q16(loop_r, c->feedback_q16);
             pre_lpf_l = *inout_l + fb_l;
             pre_lpf_r = *inout_r + fb_r;
             break;
 
         case DELAY_MODE_CROSS:
-            fb_l = multiply_q16(delayed_r, delay_feedback_q16);  // Right feeds into Left
-            fb_r = multiply_q16(delayed_l, delay_feedback_q16);  // Left feeds into Right
+            fb_l = multiply_q16(loop_r, c->feedback_q16);  // Right feeds into Left
+            fb_r = multiply_q16(loop_l, c->feedback_q16);  // Left feeds into Right
 
             pre_lpf_l = *inout_l + fb_l;
             pre_lpf_r = *inout_r + fb_r;
             break;
         
         case DELAY_MODE_MIXED:
-            fb_l = multiply_q16((delayed_l + delayed_r) >> 1, delay_feedback_q16);  // Mixed feedback
+            fb_l = multiply_q16((loop_l + loop_r) >> 1, c->feedback_q16);  // Mixed feedback
             fb_r = fb_l;  // Same value for both
             pre_lpf_l = *inout_l + fb_l;
             pre_lpf_r = *inout_r + fb_r;
@@ -193,15 +250,15 @@ static inline void process_audio_delay_sample(int32_t* inout_l, int32_t* inout_r
         case DELAY_MODE_PINGPONG:
             int32_t mono_input = (*inout_l >> 1) + (*inout_r >> 1);
 
-            int32_t fb_l = multiply_q16(delayed_r, delay_feedback_q16);
+            int32_t fb_l = multiply_q16(loop_r, c->feedback_q16);
             int32_t pre_lpf_l = mono_input + fb_l;
-            lpf_state_l += multiply_q16((pre_lpf_l - lpf_state_l), lpf_alpha_q16);
+            lpf_state_l += multiply_q16((pre_lpf_l - lpf_state_l), c->lpf_alpha_q16);
             int32_t to_store_l = lpf_state_l;
             write_block_l[write_block_pos_l++] = to_store_l;
 
-            int32_t fb_r = multiply_q16(delayed_l, delay_feedback_q16);
+            int32_t fb_r = multiply_q16(loop_l, c->feedback_q16);
             int32_t pre_lpf_r = fb_r;
-            lpf_state_r += multiply_q16((pre_lpf_r - lpf_state_r), lpf_alpha_q16);
+            lpf_state_r += multiply_q16((pre_lpf_r - lpf_state_r), c->lpf_alpha_q16);
             int32_t to_store_r = lpf_state_r;
             write_block_r[write_block_pos_r++] = to_store_r;
 
@@ -221,21 +278,21 @@ static inline void process_audio_delay_sample(int32_t* inout_l, int32_t* inout_r
             // === Output mix ===
             *inout_l = multiply_q16(*inout_l, delay_dry_q16) + multiply_q16(delayed_l, delay_mix_q16);
             *inout_r = multiply_q16(*inout_r, delay_dry_q16) + multiply_q16(delayed_r, delay_mix_q16);
-            *inout_l = multiply_q16(*inout_l, volume_gain_q16);
-            *inout_r = multiply_q16(*inout_r, volume_gain_q16);
+            *inout_l = multiply_q16(*inout_l, c->volume_q16);
+            *inout_r = multiply_q16(*inout_r, c->volume_q16);
 
             // === Update delay indices ===
             spi_write_index_l = (spi_write_index_l + 1) % MAX_DELAY_SAMPLES;
-            spi_read_index_l  = (spi_write_index_l + MAX_DELAY_SAMPLES - delay_samples_l) % MAX_DELAY_SAMPLES;
+            spi_read_index_l  = (spi_write_index_l + MAX_DELAY_SAMPLES - c->tap_l) % MAX_DELAY_SAMPLES;
 
             spi_write_index_r = (spi_write_index_r + 1) % MAX_DELAY_SAMPLES;
-            spi_read_index_r  = (spi_write_index_r + MAX_DELAY_SAMPLES - delay_samples_r) % MAX_DELAY_SAMPLES;
+            spi_read_index_r  = (spi_write_index_r + MAX_DELAY_SAMPLES - c->tap_r) % MAX_DELAY_SAMPLES;
             return; // Early return for ping-pong mode
     }
     
     // === LPF and write to buffer ===
-    lpf_state_l += multiply_q16((pre_lpf_l - lpf_state_l), lpf_alpha_q16);
-    lpf_state_r += multiply_q16((pre_lpf_r - lpf_state_r), lpf_alpha_q16);
+    lpf_state_l += multiply_q16((pre_lpf_l - lpf_state_l), c->lpf_alpha_q16);
+    lpf_state_r += multiply_q16((pre_lpf_r - lpf_state_r), c->lpf_alpha_q16);
 
     write_block_l[write_block_pos_l++] = lpf_state_l;
     write_block_r[write_block_pos_r++] = lpf_state_r;
@@ -256,22 +313,21 @@ static inline void process_audio_delay_sample(int32_t* inout_l, int32_t* inout_r
     *inout_l = multiply_q16(*inout_l, delay_dry_q16) + multiply_q16(delayed_l, delay_mix_q16);
     *inout_r = multiply_q16(*inout_r, delay_dry_q16) + multiply_q16(delayed_r, delay_mix_q16);
 
-    *inout_l = multiply_q16(*inout_l, volume_gain_q16);
-    *inout_r = multiply_q16(*inout_r, volume_gain_q16);
+    *inout_l = multiply_q16(*inout_l, c->volume_q16);
+    *inout_r = multiply_q16(*inout_r, c->volume_q16);
 
     // === Update indices ===
     spi_write_index_l = (spi_write_index_l + 1) % MAX_DELAY_SAMPLES;
-    spi_read_index_l  = (spi_write_index_l + MAX_DELAY_SAMPLES - delay_samples_l) % MAX_DELAY_SAMPLES;
+    spi_read_index_l  = (spi_write_index_l + MAX_DELAY_SAMPLES - c->tap_l) % MAX_DELAY_SAMPLES;
 
     spi_write_index_r = (spi_write_index_r + 1) % MAX_DELAY_SAMPLES;
-    spi_read_index_r  = (spi_write_index_r + MAX_DELAY_SAMPLES - delay_samples_r) % MAX_DELAY_SAMPLES;
+    spi_read_index_r  = (spi_write_index_r + MAX_DELAY_SAMPLES - c->tap_r) % MAX_DELAY_SAMPLES;
 }
 
-#define PERCH_DELAY_SAMPLES   (MAX_DELAY_SAMPLES / 2)
-#define MIN_DELAY_SAMPLES     (SAMPLE_RATE / 1000) // 1 ms worth of samples
-
 // === Load parameters from memory ===
 static inline void load_delay_parms_from_memory(void) {
+    DelayCoefs* c = coef_edit(&delay_bank);
+
     // Set left delay time based on POT | TAP
     if (!tap_tempo_active_l){
         delay_samples_l = MIN_DELAY_SAMPLES +
@@ -301,23 +357,23 @@ static inline void load_delay_parms_from_memory(void) {
         if (delay_samples_r < MIN_DELAY_SAMPLES) delay_samples_r = MIN_DELAY_SAMPLES;
         if (delay_samples_r > PERCH_DELAY_SAMPLES) delay_samples_r = PERCH_DELAY_SAMPLES;
     }
-        delay_feedback_q16 = ((uint32_t)storedPotValue[DELAY_EFFECT_INDEX][2] * Q16_ONE) / POT_MAX;
-    delay_mix_q16      = ((uint32_t)storedPotValue[DELAY_EFFECT_INDEX][3] * Q16_ONE) / POT_MAX;
-    delay_dry_q16      = Q16_ONE - delay_mix_q16;
+    c->feedback_q16 = ((uint32_t)storedPotValue[DELAY_EFFECT_INDEX][2] * Q16_ONE) / POT_MAX;
+    // Mix (pot 3) is picked up per block by the modulation and ramped in delay_process_block
 
     float min_alpha = 0.05f;
     float pot_fraction = (float)storedPotValue[DELAY_EFFECT_INDEX][4] / (float)POT_MAX;
     float alpha_f = min_alpha + pot_fraction * (1.0f - min_alpha);
-    lpf_alpha_q16 = float_to_q16(alpha_f);
+    c->lpf_alpha_q16 = float_to_q16(alpha_f);
 
     float min_gain = 0.1f;
     float max_gain = 2.5f;
     float gain_fraction = (float)storedPotValue[DELAY_EFFECT_INDEX][5] / (float)POT_MAX;
     float gain_f = min_gain + gain_fraction * (max_gain - min_gain);
-    volume_gain_q16 = float_to_q16(gain_f);
+    c->volume_q16 = float_to_q16(gain_f);
 
-    spi_read_index_l = (spi_write_index_l + MAX_DELAY_SAMPLES - delay_samples_l) % MAX_DELAY_SAMPLES;
-    spi_read_index_r = (spi_write_index_r + MAX_DELAY_SAMPLES - delay_samples_r) % MAX_DELAY_SAMPLES;
+    // The read indices follow the new taps from the next sample on
+    delay_set_taps(c);
+    coef_commit(&delay_bank);
 }
 
 // === Update parameters from pots ===
@@ -331,10 +387,18 @@ static inline void update_delay_params_from_pots(int changed_pot) {
     load_delay_parms_from_memory();
 }
 
-void delay_process_block(int32_t* in_l, int32_t* in_r, size_t frames, DelayMode mode) {
+// Mix ticked from the given ramp (the deferred lane brings its own)
+static inline void delay_process_block_mix(int32_t* in_l, int32_t* in_r, size_t frames, DelayMode mode, ParamRamp* mix) {
+    const DelayCoefs* c = coef_live(&delay_bank);
     for (size_t i = 0; i < frames; i++) {
-        process_audio_delay_sample(&in_l[i], &in_r[i], mode);
+        delay_mix_q16 = (uint32_t)ramp_tick(mix);
+        delay_dry_q16 = delay_wet_only ? 0 : Q16_ONE - delay_mix_q16;
+        process_audio_delay_sample(&in_l[i], &in_r[i], mode, c);
     }
 }
 
+void delay_process_block(int32_t* in_l, int32_t* in_r, size_t frames, DelayMode mode) {
+    delay_process_block_mix(in_l, in_r, frames, mode, &delay_mix_ramp);
+}
+
 #endif // DELAY_H
@@ -22,13 +22,20 @@
 
 #include <stdint.h>
 
-// --- distortion parameters in Q8.24 ---
-static int32_t ds_gain          = 0x01000000;
-static int32_t ds_volume        = 0x01000000;
-static int32_t ds_low_gain_q24  = 0x01000000;
-static int32_t ds_mid_gain_q24  = 0x01000000;
-static int32_t ds_mid_a_q24     = MID_A_Q24;
-static int32_t ds_high_gain_q24 = 0x01000000;
+// --- distortion parameters in Q8.24 (coefficient bank) ---
+typedef struct {
+    int32_t gain;
+    int32_t volume;
+    int32_t low_gain_q24;
+    int32_t mid_gain_q24;
+    int32_t mid_a_q24;
+    int32_t high_gain_q24;
+} DsCoefs;
+
+#define DS_COEFS_DEFAULT { 0x01000000, 0x01000000, 0x01000000, 0x01000000, MID_A_Q24, 0x01000000 }
+static DsCoefs  ds_coefs[2] = { DS_COEFS_DEFAULT, DS_COEFS_DEFAULT };
+static CoefBank ds_bank     = COEF_BANK(ds_coefs);
+
 static int32_t ds_asym_q24      = 0x0119999A;   // Fixed at ~40%
 
 // --- Filter states ---
@@ -63,6 +70,7 @@ static inline int32_t diode_clip(int32_t x) {
 
 // --- Per-channel distortion processing ---
 static inline __attribute__((always_inline)) int32_t process_ds_channel(
+    const DsCoefs* c,
     int32_t s,
     int32_t *low_state,
     int32_t *mid_lp_state,
@@ -72,7 +80,7 @@ static inline __attribute__((always_inline)) int32_t process_ds_channel(
     int32_t *hpf_state
 ) {
     // was: s = (int32_t)(((int64_t)s * ds_gain) >> 24);
-    s = qmul(s, ds_gain);
+    s = qmul(s, c->gain);
 
     // HPF before clipping to reduce rumble
     s = apply_1pole_hpf(s, hpf_state, HPF_A_Q24);
@@ -86,25 +94,25 @@ static inline __attribute__((always_inline)) int32_t process_ds_channel(
     // Low-shelf
     int32_t low_out = apply_1pole_lpf(s, low_state, BASS_A_Q24);
     // was: low_out = (int32_t)(((int64_t)low_out * ds_low_gain_q24) >> 24);
-    low_out = qmul(low_out, ds_low_gain_q24);
+    low_out = qmul(low_out, c->low_gain_q24);
 
     // Mid band-pass
     int32_t mid_band = apply_1pole_lpf(
-        apply_1pole_hpf(s, mid_hp_state, ds_mid_a_q24),
-        mid_lp_state, ds_mid_a_q24
+        apply_1pole_hpf(s, mid_hp_state, c->mid_a_q24),
+        mid_lp_state, c->mid_a_q24
     );
     // was: mid_out = (int32_t)(((int64_t)mid_band * ds_mid_gain_q24) >> 24);
-    int32_t mid_out = qmul(mid_band, ds_mid_gain_q24);
+    int32_t mid_out = qmul(mid_band, c->mid_gain_q24);
 
     // High-shelf
     int32_t high_out = s - apply_1pole_lpf(s, high_state, TREBLE_A_Q24);
     // was: high_out = (int32_t)(((int64_t)high_out * ds_high_gain_q24) >> 24);
-    high_out = qmul(high_out, ds_high_gain_q24);
+    high_out = qmul(high_out, c->high_gain_q24);
 
     // Mix tonestack (use rounded collapse for the final scale)
     int64_t sum = (int64_t)low_out + (int64_t)mid_out + (int64_t)high_out;
     // was: int64_t y = sum; y = (y * ds_volume) >> 24;
-    int64_t y = sum * (int64_t)ds_volume;
+    int64_t y = sum * (int64_t)c->volume;
     // round-to-nearest, sign-aware
     y += (y >= 0) ? (1LL<<23) : -(1LL<<23);
     int32_t output = clamp24((int32_t)(y >> 24));
@@ -112,44 +120,50 @@ static inline __attribute__((always_inline)) int32_t process_ds_channel(
 }
 
 // --- Process stereo sample ---
-static inline void process_audio_distortion_sample(int32_t* inout_l, int32_t* inout_r, bool stereo) {
-    *inout_l = process_ds_channel(*inout_l, &ds_low_state_l, &ds_mid_lp_state_l, &ds_mid_hp_state_l, &ds_high_state_l, &ds_lpf_state_l, &ds_hpf_state_l);
+static inline void process_audio_distortion_sample(int32_t* inout_l, int32_t* inout_r, bool stereo, const DsCoefs* c) {
+    *inout_l = process_ds_channel(c, *inout_l, &ds_low_state_l, &ds_mid_lp_state_l, &ds_mid_hp_state_l, &ds_high_state_l, &ds_lpf_state_l, &ds_hpf_state_l);
     if(!stereo){    *inout_r = *inout_l; } // Process MONO
-    else{           *inout_r = process_ds_channel(*inout_r, &ds_low_state_r, &ds_mid_lp_state_r, &ds_mid_hp_state_r, &ds_high_state_r, &ds_lpf_state_r, &ds_hpf_state_r);}
+    else{           *inout_r = process_ds_channel(c, *inout_r, &ds_low_state_r, &ds_mid_lp_state_r, &ds_mid_hp_state_r, &ds_high_state_r, &ds_lpf_state_r, &ds_hpf_state_r);}
+}
+
+// --- Reset filter states ---
+static inline void reset_distortion_state(void) {
+    ds_low_state_l = ds_mid_lp_state_l = ds_mid_hp_state_l = ds_high_state_l = 0;
+    ds_low_state_r = ds_mid_lp_state_r = ds_mid_hp_state_r = ds_high_state_r = 0;
+    ds_lpf_state_l = ds_lpf_state_r = 0;
+    ds_hpf_state_l = ds_hpf_state_r = 0;
 }
 
 // --- Load parameters ---
 static inline void load_distortion_parms_from_memory(void) {
+    DsCoefs* c = coef_edit(&ds_bank);
     int32_t pot;
 
     // Gain from -26dB to 0dB
     pot = storedPotValue[DS_EFFECT_INDEX][0];
-    ds_gain          = map_pot_to_q24(pot, float_to_q24(0.05f), float_to_q24(1.0f));
+    c->gain          = map_pot_to_q24(pot, float_to_q24(0.05f), float_to_q24(1.0f));
 
     // Bass from -12dB to +6dB
     pot = storedPotValue[DS_EFFECT_INDEX][1];
-    ds_low_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
+    c->low_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
 
     // Mid from -12dB to +9.5dB
     pot = storedPotValue[DS_EFFECT_INDEX][2];
-    ds_mid_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(3.0f));
+    c->mid_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(3.0f));
 
     // Mid frequency: 400 Hz to 1 kHz
     pot = storedPotValue[DS_EFFECT_INDEX][3];
-    ds_mid_a_q24 = map_pot_to_q24(pot, 0x0009F15A, 0x001F68E3);
+    c->mid_a_q24 = map_pot_to_q24(pot, 0x0009F15A, 0x001F68E3);
 
     // Treb from -12dB to +6dB
     pot = storedPotValue[DS_EFFECT_INDEX][4];
-    ds_high_gain_q24 = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
+    c->high_gain_q24 = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
 
     // Volume from -6dB to +28dB
     pot = storedPotValue[DS_EFFECT_INDEX][5];
-    ds_volume        = map_pot_to_q24(pot, float_to_q24(0.5f), float_to_q24(26.0f));
+    c->volume        = map_pot_to_q24(pot, float_to_q24(0.5f), float_to_q24(26.0f));
 
-    ds_low_state_l = ds_mid_lp_state_l = ds_mid_hp_state_l = ds_high_state_l = 0;
-    ds_low_state_r = ds_mid_lp_state_r = ds_mid_hp_state_r = ds_high_state_r = 0;
-    ds_lpf_state_l = ds_lpf_state_r = 0;
-    ds_hpf_state_l = ds_hpf_state_r = 0;
+    coef_commit(&ds_bank);
 }
 
 // --- Update from UI ---
@@ -160,8 +174,9 @@ static inline void update_distortion_params_from_pots(int changed_pot) {
 }
 
 void distortion_process_block(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo) {
+    const DsCoefs* c = coef_live(&ds_bank);
     for (size_t i = 0; i < frames; i++) {
-        process_audio_distortion_sample(&in_l[i], &in_r[i], stereo);
+        process_audio_distortion_sample(&in_l[i], &in_r[i], stereo, c);
     }
 }
 
@@ -0,0 +1,128 @@
+/* dual_amp.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef DUAL_AMP_H
+#define DUAL_AMP_H
+
+// ============================================================================
+// === Dual Amp (two preamps in parallel) =====================================
+// ============================================================================
+//
+// The selected preamp (A) and a second style (B) run on the same mono input.
+// The style is dispatched once per block: A runs its own block loop in
+// place, B on a copy of the input in dual_b_l, then one pass mixes both into
+// the stereo output. Each amp keeps its own stored pots and runs on its
+// left-channel state, so A and B must be different styles.
+//
+// Blend crossfades A -> B, pan spreads A to the left and B to the right
+// (balance law, unity at center). The power amp after the pair is voiced
+// from both styles, its coefficients interpolated by the blend.
+//
+// Pan only reaches the output while everything after the amp is stereo. A
+// mono effect later in the chain keeps the left channel (A-heavy when
+// panned); in dual mono routing each chain keeps one side and MERGE_LR takes
+// the right one from the other chain. So dual mono mixes the pair at center
+// pan, and the chain carries the blend instead of one panned side.
+
+#define DUAL_AMP_OFF        (-1)
+#define DUAL_AMP_STEPS      10                  // Blend / pan in 10 % steps (UI)
+
+// Output gains (Q8.24) and the blend (Q16), written by core 1 (coefficient bank)
+typedef struct {
+    int32_t  a_l_q24, a_r_q24;
+    int32_t  b_l_q24, b_r_q24;
+    int32_t  a_c_q24, b_c_q24;                  // Center pan
+    uint32_t blend_q16;
+} DualAmpCoefs;
+
+#define DUAL_AMP_COEFS_DEFAULT { Q24_ONE, 0, 0, Q24_ONE, Q24_ONE / 2, Q24_ONE / 2, Q16_ONE / 2 }
+static DualAmpCoefs dual_coefs[2] = { DUAL_AMP_COEFS_DEFAULT, DUAL_AMP_COEFS_DEFAULT };
+static CoefBank     dual_bank     = COEF_BANK(dual_coefs);
+
+// B's input and its unused right output
+static PLACE_ROUTING int32_t dual_b_l[AUDIO_BUFFER_FRAMES];
+static PLACE_ROUTING int32_t dual_b_r[AUDIO_BUFFER_FRAMES];
+
+// B style, or DUAL_AMP_OFF. Same as A counts as off.
+static inline bool dual_amp_active(void) {
+    return dual_amp_style != DUAL_AMP_OFF && dual_amp_style != (int8_t)selected_preamp_style;
+}
+
+// Recompute the output gains from blend / pan (0..DUAL_AMP_STEPS)
+static inline void load_dual_amp_params(void) {
+    float blend = (float)dual_amp_blend / DUAL_AMP_STEPS;
+    float pos_a = 0.5f - 0.5f * (float)dual_amp_pan / DUAL_AMP_STEPS;     // 0 = hard left
+    float pos_b = 1.0f - pos_a;
+    DualAmpCoefs* c = coef_edit(&dual_bank);
+
+    c->a_l_q24 = float_to_q24((1.0f - blend) * fminf(1.0f, 2.0f * (1.0f - pos_a)));
+    c->a_r_q24 = float_to_q24((1.0f - blend) * fminf(1.0f, 2.0f * pos_a));
+    c->b_l_q24 = float_to_q24(blend * fminf(1.0f, 2.0f * (1.0f - pos_b)));
+    c->b_r_q24 = float_to_q24(blend * fminf(1.0f, 2.0f * pos_b));
+    c->a_c_q24 = float_to_q24(1.0f - blend);
+    c->b_c_q24 = float_to_q24(blend);
+    c->blend_q16 = ((uint32_t)dual_amp_blend * Q16_ONE) / DUAL_AMP_STEPS;
+
+    coef_commit(&dual_bank);
+}
+
+// One preamp style over a block (mono: left-channel state, right = copy).
+// Not inlined: the single amp and both dual amp passes share one copy of
+// the four style loops.
+static void __not_in_flash_func(preamp_style_process_block)(preamp style, int32_t* in_l, int32_t* in_r,
+                                                            size_t frames, bool stereo) {
+    switch (style) {
+        case FENDER:
+            fender_preamp_process_block(in_l, in_r, frames, stereo);    break;
+        case VOX_AC:
+            vox_preamp_process_block(in_l, in_r, frames, stereo);       break;
+        case MARSHALL:
+            marshall_preamp_process_block(in_l, in_r, frames, stereo);  break;
+        case SOLDANO:
+            slo_preamp_process_block(in_l, in_r, frames, stereo);       break;
+    }
+}
+
+// Power amp voicing between A and B at the current blend
+static inline void dual_amp_power_coefs(PowerAmpCoefs* out, const DualAmpCoefs* c) {
+    power_amp_blend_coefs(out, &pa_coef[selected_preamp_style], &pa_coef[(preamp)dual_amp_style], c->blend_q16);
+}
+
+// c: coef_live(&dual_bank), taken once per block for both calls
+// center: mix at center pan (dual mono routing keeps one side per chain)
+static void __not_in_flash_func(dual_amp_process_block)(int32_t* in_l, int32_t* in_r, size_t frames,
+                                                        const DualAmpCoefs* c, bool center) {
+    memcpy(dual_b_l, in_l, frames * sizeof(int32_t));
+    preamp_style_process_block(selected_preamp_style, in_l, in_r, frames, false);
+    preamp_style_process_block((preamp)dual_amp_style, dual_b_l, dual_b_r, frames, false);
+
+    const int32_t al = center ? c->a_c_q24 : c->a_l_q24;
+    const int32_t ar = center ? c->a_c_q24 : c->a_r_q24;
+    const int32_t bl = center ? c->b_c_q24 : c->b_l_q24;
+    const int32_t br = center ? c->b_c_q24 : c->b_r_q24;
+
+    for (size_t i = 0; i < frames; i++) {
+        int32_t a = in_l[i];
+        int32_t b = dual_b_l[i];
+        in_l[i] = clamp24(clamp32(((int64_t)a * al + (int64_t)b * bl) >> 24));
+        in_r[i] = clamp24(clamp32(((int64_t)a * ar + (int64_t)b * br) >> 24));
+    }
+}
+
+#endif // DUAL_AMP_H
@@ -29,21 +29,27 @@
 #define FLANGER_MIN_DELAY_SAMPLES 8
 
 // === Delay line ===
-static int32_t flanger_buffer_l[FLANGER_MAX_SAMPLES] = {0};
-static int32_t flanger_buffer_r[FLANGER_MAX_SAMPLES] = {0};
+static PLACE_FLANGER int32_t flanger_buffer_l[FLANGER_MAX_SAMPLES] = {0};
+static PLACE_FLANGER int32_t flanger_buffer_r[FLANGER_MAX_SAMPLES] = {0};
 static uint32_t flanger_write_pos = 0;
 
-// === Parameters ===
-static uint32_t flanger_depth_q16    = Q16_ONE / 2;
-static uint32_t flanger_speed_q16    = Q16_ONE / 4;
-static uint32_t flanger_feedback_q16 = 0;
-static uint32_t flanger_mix_q16      = Q16_ONE / 2;
-static uint32_t flanger_volume_q24   = Q24_ONE;
+// === Parameters (coefficient bank) ===
+typedef struct {
+    uint32_t lfo_inc;
+    uint32_t depth_q16;
+    uint32_t feedback_q16;
+    uint32_t mix_q16;
+    uint32_t volume_q24;
+    uint32_t lpf_coef_q16;
+} FlangerCoefs;
+
+#define FLANGER_COEFS_DEFAULT { 0, Q16_ONE / 2, 0, Q16_ONE / 2, Q24_ONE, 0x4000 }
+static FlangerCoefs flanger_coefs[2] = { FLANGER_COEFS_DEFAULT, FLANGER_COEFS_DEFAULT };
+static CoefBank     flanger_bank     = COEF_BANK(flanger_coefs);
 
 // === LFO state ===
 static uint32_t flanger_lfo_phase_l = 0;
 static uint32_t flanger_lfo_phase_r = 0x80000000;  // 180 degrees phase shift
-static uint32_t flanger_lfo_inc = 0;
 
 extern bool lfo_led_state;
 
@@ -55,7 +61,6 @@ static uint32_t flanger_ap_coef_q16 = 0x8000; // ~0.5
 // === LPF states ===
 static int32_t flanger_lpf_state_l = 0;
 static int32_t flanger_lpf_state_r = 0;
-static uint32_t flanger_lpf_coef_q16 = 0x4000; // default
 
 static inline int32_t flanger_process_allpass_q16(int32_t x, int32_t *state, uint32_t coef_q16) {
     int32_t y = *state + ((int64_t)coef_q16 * (x - *state) >> 16);
@@ -105,20 +110,21 @@ static inline void init_flanger(void) {
 
 // === Load Parameters ===
 static inline void load_flanger_parms_from_memory(void) {
+    FlangerCoefs* c = coef_edit(&flanger_bank);
     int32_t pot;
 
     // Speed: 0.05 to 5 Hz
     pot = storedPotValue[FLNG_EFFECT_INDEX][0];
     float hz = 0.05f + ((float)pot / POT_MAX) * (5.0f - 0.05f);
-    flanger_lfo_inc = (uint32_t)((hz / SAMPLE_RATE) * 4294967296.0f);
+    c->lfo_inc = (uint32_t)((hz / SAMPLE_RATE) * 4294967296.0f);
 
     // Depth: 0 to 1
     pot = storedPotValue[FLNG_EFFECT_INDEX][1];
-    flanger_depth_q16 = map_pot_to_q16(pot, 0, Q16_ONE);
+    c->depth_q16 = map_pot_to_q16(pot, 0, Q16_ONE);
 
     // Feedback: 0 to 0.9
     pot = storedPotValue[FLNG_EFFECT_INDEX][2];
-    flanger_feedback_q16 = map_pot_to_q16(pot, 0, (uint32_t)(0.9f * Q16_ONE));
+    c->feedback_q16 = map_pot_to_q16(pot, 0, (uint32_t)(0.9f * Q16_ONE));
 
     // LPF cutoff: 100 Hz to 8 kHz (pot #4)
     pot = storedPotValue[FLNG_EFFECT_INDEX][4];
@@ -130,15 +136,17 @@ static inline void load_flanger_parms_from_memory(void) {
     float alpha = expf(-2.0f * 3.1415926f * freq_hz / SAMPLE_RATE);
     if (alpha < 0.0f) alpha = 0.0f;
     if (alpha > 1.0f) alpha = 1.0f;
-   flanger_lpf_coef_q16 = float_to_q16(alpha);
+    c->lpf_coef_q16 = float_to_q16(alpha);
 
     // Mix: 0 to 1
     pot = storedPotValue[FLNG_EFFECT_INDEX][3];
-    flanger_mix_q16 = map_pot_to_q16(pot, 0, Q16_ONE);
+    c->mix_q16 = map_pot_to_q16(pot, 0, Q16_ONE);
 
     // Volume: 0.1 to 3.0
     pot = storedPotValue[FLNG_EFFECT_INDEX][5];
-    flanger_volume_q24 = map_pot_to_q24(pot, float_to_q24(0.1f), float_to_q24(3.0f));
+    c->volume_q24 = map_pot_to_q24(pot, float_to_q24(0.1f), float_to_q24(3.0f));
+
+    coef_commit(&flanger_bank);
 }
 
 static inline void update_flanger_params_from_pots(int changed_pot) {
@@ -148,9 +156,9 @@ static inline void update_flanger_params_from_pots(int changed_pot) {
 }
 
 // === Process Sample ===
-static inline void process_audio_flanger_sample(int32_t* inout_l, int32_t* inout_r, FXmode mode) {
+static inline void process_audio_flanger_sample(int32_t* inout_l, int32_t* inout_r, FXmode mode, const FlangerCoefs* c) {
     // Advance left once
-    flanger_lfo_phase_l += flanger_lfo_inc;
+    flanger_lfo_phase_l += c->lfo_inc;
 
     // Derive right from left (wrap on uint32_t is fine)
     flanger_lfo_phase_r = flanger_lfo_phase_l + (mode == FX_MONO ? 0u : 0x80000000u);
@@ -159,7 +167,7 @@ static inline void process_audio_flanger_sample(int32_t* inout_l, int32_t* inout
 
     // Left
     uint32_t lfo_q16_l = lfo_q16_shape(flanger_lfo_phase_l, LFO_TRIANGLE);
-    uint32_t scaled_l = (lfo_q16_l * flanger_depth_q16) >> 16;
+    uint32_t scaled_l = (lfo_q16_l * c->depth_q16) >> 16;
 
     uint32_t delay_l = FLANGER_MIN_DELAY_SAMPLES + ((max_depth_samples * scaled_l) >> 16);
     uint32_t int_delay_l = delay_l;
@@ -179,7 +187,7 @@ static inline void process_audio_flanger_sample(int32_t* inout_l, int32_t* inout
 
     // Right
     uint32_t lfo_q16_r = lfo_q16_shape(flanger_lfo_phase_r, LFO_TRIANGLE);
-    uint32_t scaled_r = (lfo_q16_r * flanger_depth_q16) >> 16;
+    uint32_t scaled_r = (lfo_q16_r * c->depth_q16) >> 16;
 
     uint32_t delay_r = FLANGER_MIN_DELAY_SAMPLES + ((max_depth_samples * scaled_r) >> 16);
     uint32_t int_delay_r = delay_r;
@@ -198,8 +206,8 @@ static inline void process_audio_flanger_sample(int32_t* inout_l, int32_t* inout
     int32_t delayed_r = flanger_lagrange_cubic_q16(y_minus1_r, y0_r, y1_r, y2_r, frac_q16_r);
 
     // Feedback
-    int32_t fb_l = (int32_t)(((int64_t)delayed_l * flanger_feedback_q16) >> 16);
-    int32_t fb_r = (int32_t)(((int64_t)delayed_r * flanger_feedback_q16) >> 16);
+    int32_t fb_l = (int32_t)(((int64_t)delayed_l * c->feedback_q16) >> 16);
+    int32_t fb_r = (int32_t)(((int64_t)delayed_r * c->feedback_q16) >> 16);
 
     int32_t new_l = *inout_l + fb_l;
     int32_t new_r = *inout_r + fb_r;
@@ -212,15 +220,15 @@ static inline void process_audio_flanger_sample(int32_t* inout_l, int32_t* inout
     delayed_r = flanger_process_allpass_q16(delayed_r >> 1, &flanger_ap_state_r, flanger_ap_coef_q16);
 
     // LPF smoothing
-    delayed_l = flanger_process_lpf_q16(delayed_l << 1, &flanger_lpf_state_l, flanger_lpf_coef_q16);    // Boost energy
-    delayed_r = flanger_process_lpf_q16(delayed_r << 1, &flanger_lpf_state_r, flanger_lpf_coef_q16);
+    delayed_l = flanger_process_lpf_q16(delayed_l << 1, &flanger_lpf_state_l, c->lpf_coef_q16);    // Boost energy
+    delayed_r = flanger_process_lpf_q16(delayed_r << 1, &flanger_lpf_state_r, c->lpf_coef_q16);
 
     // Mix dry/wet
-    int64_t mix_l = ((int64_t)*inout_l * (Q16_ONE - flanger_mix_q16) + (int64_t)delayed_l * flanger_mix_q16) >> 16;
-    int64_t mix_r = ((int64_t)*inout_r * (Q16_ONE - flanger_mix_q16) + (int64_t)delayed_r * flanger_mix_q16) >> 16;
+    int64_t mix_l = ((int64_t)*inout_l * (Q16_ONE - c->mix_q16) + (int64_t)delayed_l * c->mix_q16) >> 16;
+    int64_t mix_r = ((int64_t)*inout_r * (Q16_ONE - c->mix_q16) + (int64_t)delayed_r * c->mix_q16) >> 16;
 
-    mix_l = (mix_l * flanger_volume_q24) >> 24;
-    mix_r = (mix_r * flanger_volume_q24) >> 24;
+    mix_l = (mix_l * c->volume_q24) >> 24;
+    mix_r = (mix_r * c->volume_q24) >> 24;
 
     *inout_l = clamp24((int32_t)mix_l);
     *inout_r = clamp24((int32_t)mix_r);
@@ -229,8 +237,9 @@ static inline void process_audio_flanger_sample(int32_t* inout_l, int32_t* inout
 }
 
 void flanger_process_block(int32_t* in_l, int32_t* in_r, size_t frames, FXmode mode) {
+    const FlangerCoefs* c = coef_live(&flanger_bank);
     for (size_t i = 0; i < frames; i++) {
-        process_audio_flanger_sample(&in_l[i], &in_r[i], mode);
+        process_audio_flanger_sample(&in_l[i], &in_r[i], mode, c);
     }
     // LED (only update when selected)
     if (lfo_update_led_flag) {
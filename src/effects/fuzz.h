@@ -22,13 +22,20 @@
 
 #include <stdint.h>
 
-// --- fuzz parameters in Q8.24 ---
-static int32_t fz_gain          = 0x01000000;
-static int32_t fz_volume        = 0x01000000;
-static int32_t fz_low_gain_q24  = 0x01000000;
-static int32_t fz_mid_gain_q24  = 0x01000000;
-static int32_t fz_mid_a_q24     = MID_A_Q24;
-static int32_t fz_high_gain_q24 = 0x01000000;
+// --- fuzz parameters in Q8.24 (coefficient bank) ---
+typedef struct {
+    int32_t gain;
+    int32_t volume;
+    int32_t low_gain_q24;
+    int32_t mid_gain_q24;
+    int32_t mid_a_q24;
+    int32_t high_gain_q24;
+} FzCoefs;
+
+#define FZ_COEFS_DEFAULT { 0x01000000, 0x01000000, 0x01000000, 0x01000000, MID_A_Q24, 0x01000000 }
+static FzCoefs  fz_coefs[2] = { FZ_COEFS_DEFAULT, FZ_COEFS_DEFAULT };
+static CoefBank fz_bank     = COEF_BANK(fz_coefs);
+
 static int32_t fz_asym_q24      = 0x01400000;  // ~1.25 in Q8.24 (more distortion on negative side)
 
 // --- Filter states ---
@@ -67,6 +74,7 @@ static inline __attribute__((always_inline)) int32_t hard_clip(int32_t x) {
 
 // --- Per-channel fuzz processing ---
 static inline __attribute__((always_inline)) int32_t process_fz_channel(
+    const FzCoefs* c,
     int32_t s,
     int32_t *low_state,
     int32_t *mid_lp_state,
@@ -77,7 +85,7 @@ static inline __attribute__((always_inline)) int32_t process_fz_channel(
 ) {
     // Gain
     // was: s = (int32_t)(((int64_t)s * fz_gain) >> 24);
-    s = qmul(s, fz_gain);
+    s = qmul(s, c->gain);
 
     // HPF before clipping to reduce rumble
     s = apply_1pole_hpf(s, hpf_state, HPF_A_Q24);   // Global HPF
@@ -91,68 +99,74 @@ static inline __attribute__((always_inline)) int32_t process_fz_channel(
     // Low-shelf
     int32_t low_out = apply_1pole_lpf(s, low_state, BASS_A_Q24); // Global BASS
     // was: low_out = (int32_t)(((int64_t)low_out * fz_low_gain_q24) >> 24);
-    low_out = qmul(low_out, fz_low_gain_q24);
+    low_out = qmul(low_out, c->low_gain_q24);
 
     // Mid band-pass
     int32_t mid_band = apply_1pole_lpf(
-        apply_1pole_hpf(s, mid_hp_state, fz_mid_a_q24),
-        mid_lp_state, fz_mid_a_q24
+        apply_1pole_hpf(s, mid_hp_state, c->mid_a_q24),
+        mid_lp_state, c->mid_a_q24
     );
     // was: mid_out = (int32_t)(((int64_t)mid_band * fz_mid_gain_q24) >> 24);
-    int32_t mid_out = qmul(mid_band, fz_mid_gain_q24);
+    int32_t mid_out = qmul(mid_band, c->mid_gain_q24);
 
     // High-shelf filter
     int32_t high_out = s - apply_1pole_lpf(s, high_state, TREBLE_A_Q24); // Global TREB
     // was: high_out = (int32_t)(((int64_t)high_out * fz_high_gain_q24) >> 24);
-    high_out = qmul(high_out, fz_high_gain_q24);
+    high_out = qmul(high_out, c->high_gain_q24);
 
     // Final volume scale (round collapse once)
     int64_t y = (int64_t)low_out + (int64_t)mid_out + (int64_t)high_out;
-    y = y * (int64_t)fz_volume;
+    y = y * (int64_t)c->volume;
     y += (y >= 0) ? (1LL<<23) : -(1LL<<23);   // round-to-nearest
     int32_t output = clamp24((int32_t)(y >> 24));
     return output;
 }
 
 // --- Process stereo sample ---
-static inline void process_audio_fuzz_sample(int32_t* inout_l, int32_t* inout_r, bool stereo) {
-    *inout_l = process_fz_channel(*inout_l, &fz_low_state_l, &fz_mid_lp_state_l, &fz_mid_hp_state_l, &fz_high_state_l, &fz_lpf_state_l, &fz_hpf_state_l);
+static inline void process_audio_fuzz_sample(int32_t* inout_l, int32_t* inout_r, bool stereo, const FzCoefs* c) {
+    *inout_l = process_fz_channel(c, *inout_l, &fz_low_state_l, &fz_mid_lp_state_l, &fz_mid_hp_state_l, &fz_high_state_l, &fz_lpf_state_l, &fz_hpf_state_l);
     if(!stereo){    *inout_r = *inout_l; } // Process MONO
-    else{           *inout_r = process_fz_channel(*inout_r, &fz_low_state_r, &fz_mid_lp_state_r, &fz_mid_hp_state_r, &fz_high_state_r, &fz_lpf_state_r, &fz_hpf_state_r); }
+    else{           *inout_r = process_fz_channel(c, *inout_r, &fz_low_state_r, &fz_mid_lp_state_r, &fz_mid_hp_state_r, &fz_high_state_r, &fz_lpf_state_r, &fz_hpf_state_r); }
+}
+
+// --- Reset filter states ---
+static inline void reset_fuzz_state(void) {
+    fz_low_state_l = fz_mid_lp_state_l = fz_mid_hp_state_l = fz_high_state_l = 0;
+    fz_low_state_r = fz_mid_lp_state_r = fz_mid_hp_state_r = fz_high_state_r = 0;
+    fz_lpf_state_l = fz_lpf_state_r = 0;
+    fz_hpf_state_l = fz_hpf_state_r = 0;
 }
 
 // --- Load parameters ---
 static inline void load_fuzz_parms_from_memory(void) {
+    FzCoefs* c = coef_edit(&fz_bank);
     int32_t pot;
 
     // Gain from -26dB to 0dB
     pot = storedPotValue[FZ_EFFECT_INDEX][0];
-    fz_gain          = map_pot_to_q24(pot, float_to_q24(0.05f), float_to_q24(1.0f));
+    c->gain          = map_pot_to_q24(pot, float_to_q24(0.05f), float_to_q24(1.0f));
 
     // Bass from -12dB to +6dB
     pot = storedPotValue[FZ_EFFECT_INDEX][1];
-    fz_low_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
+    c->low_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
 
     // Mid from -12dB to +9.5dB
     pot = storedPotValue[FZ_EFFECT_INDEX][2];
-    fz_mid_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(3.0f));
+    c->mid_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(3.0f));
 
     // Mid frequency: 400 Hz to 1 kHz
     pot = storedPotValue[FZ_EFFECT_INDEX][3];
-    fz_mid_a_q24 = map_pot_to_q24(pot, 0x0009F15A, 0x001F68E3);
+    c->mid_a_q24 = map_pot_to_q24(pot, 0x0009F15A, 0x001F68E3);
 
     // Treb from -12dB to +6dB
     pot = storedPotValue[FZ_EFFECT_INDEX][4];
-    fz_high_gain_q24 = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
+    c->high_gain_q24 = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
 
     // Volume from -6dB to +28dB
     pot = storedPotValue[FZ_EFFECT_INDEX][5];
-    fz_volume        = map_pot_to_q24(pot, float_to_q24(0.5f), float_to_q24(26.0f));
+    c->volume        = map_pot_to_q24(pot, float_to_q24(0.5f), float_to_q24(26.0f));
 
-    fz_low_state_l = fz_mid_lp_state_l = fz_mid_hp_state_l = fz_high_state_l = 0;
-    fz_low_state_r = fz_mid_lp_state_r = fz_mid_hp_state_r = fz_high_state_r = 0;
-    fz_lpf_state_l = fz_lpf_state_r = 0;
-    fz_hpf_state_l = fz_hpf_state_r = 0;
+    coef_commit(&fz_bank);
 }
 
 // --- Update from UI ---
@@ -163,8 +177,9 @@ static inline void update_fuzz_params_from_pots(int changed_pot) {
 }
 
 void fuzz_process_block(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo) {
+    const FzCoefs* c = coef_live(&fz_bank);
     for (size_t i = 0; i < frames; i++) {
-        process_audio_fuzz_sample(&in_l[i], &in_r[i], stereo);
+        process_audio_fuzz_sample(&in_l[i], &in_r[i], stereo, c);
     }
 }
 
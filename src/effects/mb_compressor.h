@@ -0,0 +1,204 @@
+/* mb_compressor.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MB_COMPRESSOR_H
+#define MB_COMPRESSOR_H
+
+#include <stdint.h>
+
+// ============================================================================
+// === Multiband Compressor (3 bands) =========================================
+// ============================================================================
+//
+// Complementary one-pole crossovers: low = LP(x), rest = x - low,
+// mid = LP(rest), high = rest - mid. The bands always sum back to the
+// input, so with no gain reduction the effect is transparent, and the
+// split costs two multiplies per sample and channel.
+//
+// Each band keeps a block peak (stereo linked), one block-rate follower
+// and the same log2-domain gain computer as the compressor (CompCurve).
+// The band gains are ramped across the block. The split runs one bit
+// down (the threshold is shifted to match), the sum restores it.
+//
+// The gain pass is the expensive part: three 32x32->64 multiplies per
+// sample and channel, each an __aeabi_lmul call on the M0+. The loop
+// hand-compiled to Thumb (tests/kernels/mbc_apply.s, checked by
+// tests/test_m0sim.py) takes 4454 cycles per channel and 24-frame block in
+// tools/m0sim.py, ~186 per sample: ~8.9k cycles for a stereo block, 7.7 % of
+// core 0 at 230.4 MHz. `m0sim.py bench` gives the compiled figure.
+//
+// Pots: Low Freq | High Freq | Threshold | Ratio | Speed | Volume
+
+#define MBC_NUM_BANDS       3
+#define MBC_KNEE_DB         6.0f
+#define MBC_HEADROOM_SHIFT  1               // Bands may exceed full scale before the sum
+
+// Parameters (coefficient bank)
+typedef struct {
+    int32_t   xover_lo_q24;                         // One-pole alphas
+    int32_t   xover_hi_q24;
+    CompCurve curve;                                // Shared by all bands
+    int32_t   makeup_log2;
+    EnvTimes  times[MBC_NUM_BANDS];
+} MbcCoefs;
+
+static MbcCoefs mbc_coefs[2];
+static CoefBank mbc_bank = COEF_BANK(mbc_coefs);
+
+// State
+static OnePole     mbc_lp_lo;
+static OnePole     mbc_lp_hi;
+static EnvFollower mbc_env[MBC_NUM_BANDS];
+static int32_t     mbc_gain_q24[MBC_NUM_BANDS] = { Q24_ONE, Q24_ONE, Q24_ONE };
+
+// Band buffers for the current block (split pass -> gain pass)
+static PLACE_MB_COMPRESSOR int32_t mbc_band_l[MBC_NUM_BANDS][AUDIO_BUFFER_FRAMES];
+static PLACE_MB_COMPRESSOR int32_t mbc_band_r[MBC_NUM_BANDS][AUDIO_BUFFER_FRAMES];
+
+static inline void init_mb_compressor(void) {
+    MbcCoefs* c = coef_edit(&mbc_bank);
+    comp_curve_set(&c->curve, -20.0f, 3.0f, MBC_KNEE_DB);
+    c->curve.threshold_log2 -= MBC_HEADROOM_SHIFT << 16;
+    coef_commit(&mbc_bank);
+}
+
+// Clear filter and detector states (only while the slot is off)
+static inline void reset_mb_compressor_state(void) {
+    mbc_lp_lo.state_l = mbc_lp_lo.state_r = 0;
+    mbc_lp_hi.state_l = mbc_lp_hi.state_r = 0;
+    for (int b = 0; b < MBC_NUM_BANDS; b++) {
+        env_follower_reset(&mbc_env[b]);
+        mbc_gain_q24[b] = Q24_ONE;
+    }
+}
+
+// Load pot values
+static inline void load_mb_compressor_parms_from_memory(void) {
+    MbcCoefs* c = coef_edit(&mbc_bank);
+    int pot;
+
+    // Low / mid crossover: 80 to 400 Hz
+    pot = storedPotValue[MBC_EFFECT_INDEX][0];
+    c->xover_lo_q24 = alpha_from_hz(map_pot_to_freq(pot, 80.0f, 400.0f));
+
+    // Mid / high crossover: 1 to 5 kHz
+    pot = storedPotValue[MBC_EFFECT_INDEX][1];
+    c->xover_hi_q24 = alpha_from_hz(map_pot_to_freq(pot, 1000.0f, 5000.0f));
+
+    // Threshold: -30 dB to +10 dB, ratio 1.1:1 to 10:1 (all bands)
+    pot = storedPotValue[MBC_EFFECT_INDEX][2];
+    float thresh_db = -30.0f + ((float)pot / POT_MAX) * 40.0f;
+    pot = storedPotValue[MBC_EFFECT_INDEX][3];
+    float ratio = 1.1f + ((float)pot / POT_MAX) * 8.9f;
+    comp_curve_set(&c->curve, thresh_db, ratio, MBC_KNEE_DB);
+    c->curve.threshold_log2 -= MBC_HEADROOM_SHIFT << 16;     // Detector sees the split level
+
+    // Speed: attack 2..30 ms, release 50..500 ms; the low band releases slower
+    pot = storedPotValue[MBC_EFFECT_INDEX][4];
+    float t = (float)pot / POT_MAX;
+    float attack_ms  = 2.0f  + t * 28.0f;
+    float release_ms = 50.0f + t * 450.0f;
+    env_follower_set_times(&c->times[0], attack_ms * 2.0f, release_ms * 2.0f);
+    env_follower_set_times(&c->times[1], attack_ms,        release_ms);
+    env_follower_set_times(&c->times[2], attack_ms * 0.5f, release_ms);
+
+    // Makeup gain: 0 to +12 dB
+    pot = storedPotValue[MBC_EFFECT_INDEX][5];
+    c->makeup_log2 = db_to_log2_q16(((float)pot / POT_MAX) * 12.0f);
+
+    coef_commit(&mbc_bank);
+}
+
+static inline void update_mb_compressor_params_from_pots(int changed_pot) {
+    if (changed_pot < 0 || changed_pot > 5) return;
+    storedPotValue[MBC_EFFECT_INDEX][changed_pot] = pot_value[changed_pot];
+    load_mb_compressor_parms_from_memory();
+}
+
+static inline __attribute__((always_inline)) int32_t mbc_abs(int32_t x) {
+    return (x < 0) ? -x : x;
+}
+
+void mb_compressor_process_block(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo) {
+    const MbcCoefs* c = coef_live(&mbc_bank);
+    int32_t peak[MBC_NUM_BANDS] = { 0, 0, 0 };
+    const int32_t a_lo = c->xover_lo_q24;
+    const int32_t a_hi = c->xover_hi_q24;
+
+    // --- Split (and band peaks, linked) ---
+    for (size_t i = 0; i < frames; i++) {
+        int32_t x    = in_l[i] >> MBC_HEADROOM_SHIFT;
+        int32_t low  = apply_1pole_lpf(x, &mbc_lp_lo.state_l, a_lo);
+        int32_t rest = x - low;
+        int32_t mid  = apply_1pole_lpf(rest, &mbc_lp_hi.state_l, a_hi);
+        mbc_band_l[0][i] = low;
+        mbc_band_l[1][i] = mid;
+        mbc_band_l[2][i] = rest - mid;
+        if (mbc_abs(low)        > peak[0]) peak[0] = mbc_abs(low);
+        if (mbc_abs(mid)        > peak[1]) peak[1] = mbc_abs(mid);
+        if (mbc_abs(rest - mid) > peak[2]) peak[2] = mbc_abs(rest - mid);
+
+        if (stereo) {
+            x    = in_r[i] >> MBC_HEADROOM_SHIFT;
+            low  = apply_1pole_lpf(x, &mbc_lp_lo.state_r, a_lo);
+            rest = x - low;
+            mid  = apply_1pole_lpf(rest, &mbc_lp_hi.state_r, a_hi);
+            mbc_band_r[0][i] = low;
+            mbc_band_r[1][i] = mid;
+            mbc_band_r[2][i] = rest - mid;
+            if (mbc_abs(low)        > peak[0]) peak[0] = mbc_abs(low);
+            if (mbc_abs(mid)        > peak[1]) peak[1] = mbc_abs(mid);
+            if (mbc_abs(rest - mid) > peak[2]) peak[2] = mbc_abs(rest - mid);
+        }
+    }
+
+    // --- One detector / gain computer pass per band ---
+    int32_t target[MBC_NUM_BANDS], step[MBC_NUM_BANDS];
+    for (int b = 0; b < MBC_NUM_BANDS; b++) {
+        int32_t env = env_follower_block(&mbc_env[b], &c->times[b], peak[b]);
+        int32_t gr  = comp_curve_gain_reduction(&c->curve, env);
+        target[b] = exp2_q24(c->makeup_log2 - gr);
+        step[b]   = (target[b] - mbc_gain_q24[b]) / (int32_t)frames;
+    }
+
+    // --- Apply ramped band gains and sum ---
+    int32_t g0 = mbc_gain_q24[0], g1 = mbc_gain_q24[1], g2 = mbc_gain_q24[2];
+    for (size_t i = 0; i < frames; i++) {
+        g0 += step[0];
+        g1 += step[1];
+        g2 += step[2];
+
+        int64_t y = (int64_t)mbc_band_l[0][i] * g0 + (int64_t)mbc_band_l[1][i] * g1 + (int64_t)mbc_band_l[2][i] * g2;
+        in_l[i] = clamp24(clamp32(y >> (24 - MBC_HEADROOM_SHIFT)));
+
+        if (!stereo) {
+            in_r[i] = in_l[i];      // Process MONO
+        } else {
+            y = (int64_t)mbc_band_r[0][i] * g0 + (int64_t)mbc_band_r[1][i] * g1 + (int64_t)mbc_band_r[2][i] * g2;
+            in_r[i] = clamp24(clamp32(y >> (24 - MBC_HEADROOM_SHIFT)));
+        }
+    }
+
+    // Land exactly on target (division remainder)
+    for (int b = 0; b < MBC_NUM_BANDS; b++) {
+        mbc_gain_q24[b] = target[b];
+    }
+}
+
+#endif // MB_COMPRESSOR_H
@@ -22,13 +22,20 @@
 
 #include <stdint.h>
 
-// --- overdrive parameters in Q8.24 ---
-static int32_t od_gain          = 0x01000000;
-static int32_t od_volume        = 0x01000000;
-static int32_t od_low_gain_q24  = 0x01000000;
-static int32_t od_mid_gain_q24  = 0x01000000;
-static int32_t od_mid_a_q24     = MID_A_Q24;
-static int32_t od_high_gain_q24 = 0x01000000;
+// --- overdrive parameters in Q8.24 (coefficient bank) ---
+typedef struct {
+    int32_t gain;
+    int32_t volume;
+    int32_t low_gain_q24;
+    int32_t mid_gain_q24;
+    int32_t mid_a_q24;
+    int32_t high_gain_q24;
+} OdCoefs;
+
+#define OD_COEFS_DEFAULT { 0x01000000, 0x01000000, 0x01000000, 0x01000000, MID_A_Q24, 0x01000000 }
+static OdCoefs  od_coefs[2] = { OD_COEFS_DEFAULT, OD_COEFS_DEFAULT };
+static CoefBank od_bank     = COEF_BANK(od_coefs);
+
 static int32_t od_asym_q24      = 0x018C28F6;   // Fixed at ~70%
 
 
@@ -61,6 +68,7 @@ static inline __attribute__((always_inline)) int32_t soft_clip(int32_t x) {
 
 // --- Per-channel overdrive processing ---
 static inline __attribute__((always_inline)) int32_t process_od_channel(
+    const OdCoefs* c,
     int32_t s,
     int32_t *low_state,
     int32_t *mid_lp_state,
@@ -70,7 +78,7 @@ static inline __attribute__((always_inline)) int32_t process_od_channel(
     int32_t *hpf_state
 ) {
     //s = (int32_t)(((int64_t)s * od_gain) >> 24);
-    s = qmul(s, od_gain);
+    s = qmul(s, c->gain);
 
     // HPF before clipping to reduce rumble
     s = apply_1pole_hpf(s, hpf_state, HPF_A_Q24);   // Global HPF
@@ -84,68 +92,74 @@ static inline __attribute__((always_inline)) int32_t process_od_channel(
     // Low-shelf
     int32_t low_out = apply_1pole_lpf(s, low_state, BASS_A_Q24); // Global BASS
     //low_out = (int32_t)(((int64_t)low_out * od_low_gain_q24) >> 24);
-    low_out = qmul(low_out, od_low_gain_q24);
+    low_out = qmul(low_out, c->low_gain_q24);
 
     // Mid band-pass
     int32_t mid_band = apply_1pole_lpf(
-        apply_1pole_hpf(s, mid_hp_state, od_mid_a_q24),
-        mid_lp_state, od_mid_a_q24
+        apply_1pole_hpf(s, mid_hp_state, c->mid_a_q24),
+        mid_lp_state, c->mid_a_q24
     );
     //int32_t mid_out = (int32_t)(((int64_t)mid_band * od_mid_gain_q24) >> 24);
-    int32_t mid_out = qmul(mid_band, od_mid_gain_q24);
+    int32_t mid_out = qmul(mid_band, c->mid_gain_q24);
 
     // High-shelf filter
     int32_t high_out = s - apply_1pole_lpf(s, high_state, TREBLE_A_Q24); // Global TREB
     //high_out = (int32_t)(((int64_t)high_out * od_high_gain_q24) >> 24);
-    high_out = qmul(high_out, od_high_gain_q24);
+    high_out = qmul(high_out, c->high_gain_q24);
 
     // Mix Tonestack
     int64_t y = (int64_t)low_out + (int64_t)mid_out + (int64_t)high_out;
-    y = y * (int64_t)od_volume;
+    y = y * (int64_t)c->volume;
     y += (y >= 0) ? (1LL<<23) : -(1LL<<23);   // round-to-nearest
     int32_t output = clamp24((int32_t)(y >> 24));
     return output;
 }
 
 // --- Process stereo sample ---
-static inline void process_audio_overdrive_sample(int32_t* inout_l, int32_t* inout_r, bool stereo) {
-    *inout_l = process_od_channel(*inout_l, &od_low_state_l, &od_mid_lp_state_l, &od_mid_hp_state_l, &od_high_state_l, &od_lpf_state_l, &od_hpf_state_l);
+static inline void process_audio_overdrive_sample(int32_t* inout_l, int32_t* inout_r, bool stereo, const OdCoefs* c) {
+    *inout_l = process_od_channel(c, *inout_l, &od_low_state_l, &od_mid_lp_state_l, &od_mid_hp_state_l, &od_high_state_l, &od_lpf_state_l, &od_hpf_state_l);
     if(!stereo){    *inout_r = *inout_l; } // Process MONO
-    else{           *inout_r = process_od_channel(*inout_r, &od_low_state_r, &od_mid_lp_state_r, &od_mid_hp_state_r, &od_high_state_r, &od_lpf_state_r, &od_hpf_state_r);   }
+    else{           *inout_r = process_od_channel(c, *inout_r, &od_low_state_r, &od_mid_lp_state_r, &od_mid_hp_state_r, &od_high_state_r, &od_lpf_state_r, &od_hpf_state_r);   }
+}
+
+// --- Reset filter states ---
+static inline void reset_overdrive_state(void) {
+    od_low_state_l = od_mid_lp_state_l = od_mid_hp_state_l = od_high_state_l = 0;
+    od_low_state_r = od_mid_lp_state_r = od_mid_hp_state_r = od_high_state_r = 0;
+    od_lpf_state_l = od_lpf_state_r = 0;
+    od_hpf_state_l = od_hpf_state_r = 0;
 }
 
 // --- Load parameters ---
 static inline void load_overdrive_parms_from_memory(void) {
+    OdCoefs* c = coef_edit(&od_bank);
     int32_t pot;
 
     // Gain from -26dB to 0dB
     pot = storedPotValue[OD_EFFECT_INDEX][0];
-    od_gain          = map_pot_to_q24(pot, float_to_q24(0.05f), float_to_q24(1.0f));
+    c->gain          = map_pot_to_q24(pot, float_to_q24(0.05f), float_to_q24(1.0f));
 
     // Bass from -12dB to +6dB
     pot = storedPotValue[OD_EFFECT_INDEX][1];
-    od_low_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
+    c->low_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
 
     // Mid from -12dB to +9.5dB
     pot = storedPotValue[OD_EFFECT_INDEX][2];
-    od_mid_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(3.0f));
+    c->mid_gain_q24  = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(3.0f));
 
     // Mid frequency: 400 Hz to 1 kHz
     pot = storedPotValue[OD_EFFECT_INDEX][3];
-    od_mid_a_q24 = map_pot_to_q24(pot, 0x0009F15A, 0x001F68E3);
+    c->mid_a_q24 = map_pot_to_q24(pot, 0x0009F15A, 0x001F68E3);
 
     // Treb from -12dB to +6dB
     pot = storedPotValue[OD_EFFECT_INDEX][4];
-    od_high_gain_q24 = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
+    c->high_gain_q24 = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(2.0f));
 
     // Volume from -6dB to +26dB
     pot = storedPotValue[OD_EFFECT_INDEX][5];
-    od_volume        = map_pot_to_q24(pot, float_to_q24(0.5f), float_to_q24(20.0f));
+    c->volume        = map_pot_to_q24(pot, float_to_q24(0.5f), float_to_q24(20.0f));
 
-    od_low_state_l = od_mid_lp_state_l = od_mid_hp_state_l = od_high_state_l = 0;
-    od_low_state_r = od_mid_lp_state_r = od_mid_hp_state_r = od_high_state_r = 0;
-    od_lpf_state_l = od_lpf_state_r = 0;
-    od_hpf_state_l = od_hpf_state_r = 0;
+    coef_commit(&od_bank);
 }
 
 // --- Update from UI ---
@@ -156,8 +170,9 @@ static inline void update_overdrive_params_from_pots(int changed_pot) {
 }
 
 void overdrive_process_block(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo) {
+    const OdCoefs* c = coef_live(&od_bank);
     for (size_t i = 0; i < frames; i++) {
-        process_audio_overdrive_sample(&in_l[i], &in_r[i], stereo);
+        process_audio_overdrive_sample(&in_l[i], &in_r[i], stereo, c);
     }
 }
 
@@ -26,19 +26,22 @@
 // === Fixed-point constants ===
 #define NUM_PHASER_STAGES 4
 
-// === Depth limits ===
-static int32_t phaser_low_a_q24;
-static int32_t phaser_high_a_q24;
-
 // === LFO Phase States ===
 static uint32_t phaser_lfo_phase[2] = {0, 0x80000000}; // 180 deg apart
-static uint32_t phaser_lfo_inc = 0;
 
-// === Parameters (Q24) ===
-static int32_t phaser_depth_q24    = Q24_ONE / 2;
-static int32_t phaser_feedback_q24 = 0;
-static int32_t phaser_mix_q24      = Q24_ONE / 2;
-static int32_t phaser_volume_q24   = Q24_ONE; // default 1.0
+// === Parameters (Q24, coefficient bank) ===
+typedef struct {
+    int32_t  low_a_q24;                 // Depth limits
+    int32_t  high_a_q24;
+    uint32_t lfo_inc;
+    int32_t  feedback_q24;
+    int32_t  mix_q24;
+    int32_t  volume_q24;
+} PhaserCoefs;
+
+#define PHASER_COEFS_DEFAULT { 0, 0, 0, 0, Q24_ONE / 2, Q24_ONE }
+static PhaserCoefs phaser_coefs[2] = { PHASER_COEFS_DEFAULT, PHASER_COEFS_DEFAULT };
+static CoefBank    phaser_bank     = COEF_BANK(phaser_coefs);
 
 // === Allpass State ===
 typedef struct {
@@ -63,33 +66,33 @@ static inline int32_t allpass_process(int32_t x, int32_t a_q24, AllpassState* st
 }
 
 // === Map LFO to coefficient ===
-static inline int32_t phaser_lfo_coef(uint32_t phase) {
+static inline int32_t phaser_lfo_coef(const PhaserCoefs* c, uint32_t phase) {
     int32_t tri_val = lfo_q16_shape(phase, LFO_TRIANGLE_SMOOTH) << 8; // Q24
 
     // Linear interpolation between low and high
-    int64_t sweep = (int64_t)phaser_low_a_q24 * (Q24_ONE - tri_val)
-                  + (int64_t)phaser_high_a_q24 * tri_val;
+    int64_t sweep = (int64_t)c->low_a_q24 * (Q24_ONE - tri_val)
+                  + (int64_t)c->high_a_q24 * tri_val;
     return (int32_t)(sweep >> 24); // Back to Q24
 }
 
 
 // === Update LFO phases ===
-static inline void update_phaser_lfos(void) {
-    phaser_lfo_phase[0] += phaser_lfo_inc;
-    phaser_lfo_phase[1] += phaser_lfo_inc;
+static inline void update_phaser_lfos(uint32_t inc) {
+    phaser_lfo_phase[0] += inc;
+    phaser_lfo_phase[1] += inc;
 }
 
 // === Process Stereo Sample ===
-static inline void process_audio_phaser_sample(int32_t* inout_l, int32_t* inout_r, FXmode mode) {
-    update_phaser_lfos();
+static inline void process_audio_phaser_sample(int32_t* inout_l, int32_t* inout_r, FXmode mode, const PhaserCoefs* c) {
+    update_phaser_lfos(c->lfo_inc);
 
     // Set mono | stereo coefficients
-    int32_t coef_l = phaser_lfo_coef(phaser_lfo_phase[0]);
+    int32_t coef_l = phaser_lfo_coef(c, phaser_lfo_phase[0]);
     int32_t coef_r = coef_l;
     if (mode == FX_MONO) {
         // Mono mode uses same coefficient for both channels
     } else {
-        coef_r = phaser_lfo_coef(phaser_lfo_phase[1]);
+        coef_r = phaser_lfo_coef(c, phaser_lfo_phase[1]);
     }
 
     // --- small internal headroom: -6 dB ---
@@ -105,19 +108,19 @@ static inline void process_audio_phaser_sample(int32_t* inout_l, int32_t* inout_
         x_r = allpass_process(x_r, coef_r, &phaser_right[i]);
     }
 
-    feedback_l = (int32_t)(((int64_t)x_l * phaser_feedback_q24) >> 24);
-    feedback_r = (int32_t)(((int64_t)x_r * phaser_feedback_q24) >> 24);
+    feedback_l = (int32_t)(((int64_t)x_l * c->feedback_q24) >> 24);
+    feedback_r = (int32_t)(((int64_t)x_r * c->feedback_q24) >> 24);
 
-    int64_t dry_l = ((int64_t)*inout_l * (Q24_ONE - phaser_mix_q24)) >> 24;
-    int64_t wet_l = ((int64_t)x_l * phaser_mix_q24) >> 24;
-    int64_t dry_r = ((int64_t)*inout_r * (Q24_ONE - phaser_mix_q24)) >> 24;
-    int64_t wet_r = ((int64_t)x_r * phaser_mix_q24) >> 24;
+    int64_t dry_l = ((int64_t)*inout_l * (Q24_ONE - c->mix_q24)) >> 24;
+    int64_t wet_l = ((int64_t)x_l * c->mix_q24) >> 24;
+    int64_t dry_r = ((int64_t)*inout_r * (Q24_ONE - c->mix_q24)) >> 24;
+    int64_t wet_r = ((int64_t)x_r * c->mix_q24) >> 24;
 
     int32_t mixed_l = (int32_t)(dry_l + wet_l);
     int32_t mixed_r = (int32_t)(dry_r + wet_r);
 
-    *inout_l = clamp24((int32_t)(((int64_t)mixed_l * phaser_volume_q24) >> 24));
-    *inout_r = clamp24((int64_t)(((int64_t)mixed_r * phaser_volume_q24) >> 24));
+    *inout_l = clamp24((int32_t)(((int64_t)mixed_l * c->volume_q24) >> 24));
+    *inout_r = clamp24((int64_t)(((int64_t)mixed_r * c->volume_q24) >> 24));
 }
 
 // === Initialize Phaser ===
@@ -131,43 +134,46 @@ static inline void init_phaser(void) {
 
 // === Load parameters ===
 static inline void load_phaser_parms_from_memory(void) {
+    PhaserCoefs* c = coef_edit(&phaser_bank);
     int32_t pot;
 
     // LFO speed: 0.05 to 4.0 Hz
     pot = storedPotValue[PHSR_EFFECT_INDEX][0];
     float hz = 0.05f + ((float)pot / POT_MAX) * (4.0f - 0.05f);
-    phaser_lfo_inc = (uint32_t)((hz / SAMPLE_RATE) * 4294967296.0f);
+    c->lfo_inc = (uint32_t)((hz / SAMPLE_RATE) * 4294967296.0f);
 
     // Low frequency: 100 Hz to 2000 Hz
     pot = storedPotValue[PHSR_EFFECT_INDEX][1];
     float low_f = map_pot_to_freq(pot, 100, 1000);
-    phaser_low_a_q24 = fc_to_q24(low_f, 48000);
+    c->low_a_q24 = fc_to_q24(low_f, 48000);
 
     // High frequency: 300 Hz to 6000 Hz
     pot = storedPotValue[PHSR_EFFECT_INDEX][2];
     float high_f = map_pot_to_freq(pot, 1500, 6000);
-    phaser_high_a_q24 = fc_to_q24(high_f, 48000);
+    c->high_a_q24 = fc_to_q24(high_f, 48000);
 
     // Ensure proper order
-    if (phaser_high_a_q24 < phaser_low_a_q24) {
-        int32_t tmp = phaser_high_a_q24;
-        phaser_high_a_q24 = phaser_low_a_q24;
-        phaser_low_a_q24 = tmp;
+    if (c->high_a_q24 < c->low_a_q24) {
+        int32_t tmp = c->high_a_q24;
+        c->high_a_q24 = c->low_a_q24;
+        c->low_a_q24 = tmp;
     }
 
     // Feedback: 0.0 to 0.95 with nonlinear curve
     pot = storedPotValue[PHSR_EFFECT_INDEX][3];
     int32_t norm_fb = (int32_t)(((int64_t)pot * Q24_ONE) / POT_MAX);     // Q24
     int64_t norm_fb_sq = ((int64_t)norm_fb * norm_fb) >> 24;            // Q24
-    phaser_feedback_q24 = (int32_t)((norm_fb_sq * float_to_q24(0.95f)) >> 24);
+    c->feedback_q24 = (int32_t)((norm_fb_sq * float_to_q24(0.95f)) >> 24);
 
     // Mix: 0.0 to 1.0
     pot = storedPotValue[PHSR_EFFECT_INDEX][4];
-    phaser_mix_q24 = map_pot_to_q24(pot, 0, Q24_ONE);
+    c->mix_q24 = map_pot_to_q24(pot, 0, Q24_ONE);
 
     // Volume: 0.1 to 4.0
     pot = storedPotValue[PHSR_EFFECT_INDEX][5];
-    phaser_volume_q24 = map_pot_to_q24(pot, float_to_q24(0.1f), float_to_q24(4.0f));
+    c->volume_q24 = map_pot_to_q24(pot, float_to_q24(0.1f), float_to_q24(4.0f));
+
+    coef_commit(&phaser_bank);
 }
 
 // === Update parameters from pots ===
@@ -178,8 +184,9 @@ static inline void update_phaser_params_from_pots(int changed_pot) {
 }
 
 void phaser_process_block(int32_t* in_l, int32_t* in_r, size_t frames, FXmode mode) {
+    const PhaserCoefs* c = coef_live(&phaser_bank);
     for (size_t i = 0; i < frames; i++) {
-        process_audio_phaser_sample(&in_l[i], &in_r[i], mode);
+        process_audio_phaser_sample(&in_l[i], &in_r[i], mode, c);
     }
     // LED (only update when selected)
     if (lfo_update_led_flag) {
@@ -0,0 +1,201 @@
+/* power_amp.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef POWER_AMP_H
+#define POWER_AMP_H
+
+/*  Push-pull power amp + supply sag, runs after the selected preamp (Q8.24)
+    Flow: Preamp out → Drive (sag headroom) → Phase-inverter clip
+          → NFB presence / resonance shelf → Makeup (sag headroom)
+
+    - Sag: linked |out| follower, updated every PA_ENV_DECIM samples like the
+      preamps' envB. Once per block it sets the headroom in the log2 domain:
+      drive up by the sag, makeup down by the same amount, so small signals
+      keep their level and only the clip ceiling drops.
+    - Phase inverter: y = 1.5v - 0.5v^3 (knee at |v| = 1), the negative half
+      is driven 1/8 harder and scaled back, so it clips earlier and lower.
+    - NFB shelf: less feedback at the extremes = resonance (lows) and
+      presence (highs) boost. Corners are shift one-poles (~120 Hz, ~2.2 kHz),
+      gains in 1/16 steps (small integer multiply, no Q8.24 multiply).
+    Cost per frame: 4 Q8.24 multiplies, the follower a quarter of one, no
+    divides. A preamp channel is around 35, so the stage adds ~12 %.
+*/
+
+/* ========================== Compile-time knobs =========================== */
+#define PA_ENV_DECIM            4        // Sag follower decimation (power of two)
+#define PA_ASYM_SHIFT           3        // Negative half: 1/8 hotter, 1/8 lower ceiling
+#define PA_RES_SHIFT            6        // Resonance corner, ~120 Hz
+#define PA_PRES_SHIFT           2        // Presence corner, ~2.2 kHz
+#define PA_SAMPLE_SHIFT         7        // Full scale samples (2^31) <-> 1.0 in Q8.24
+#define PA_SHELF_SHIFT          4        // Shelf gains - 1.0 in 1/16 steps
+
+#if (AUDIO_BUFFER_FRAMES % PA_ENV_DECIM) != 0
+#error "AUDIO_BUFFER_FRAMES must be a multiple of PA_ENV_DECIM"
+#endif
+
+/* ============================== Voicing ================================== */
+typedef struct {
+    float drive_db;             // Into the phase inverter (>= 0)
+    float sag_db;               // Headroom lost at full output
+    float sag_attack_hz;
+    float sag_release_hz;
+    float resonance_db;         // Low shelf from reduced feedback
+    float presence_db;          // High shelf from reduced feedback
+} pa_voice_t;
+
+// Indexed by preamp style
+static const pa_voice_t PA_VOICE[] = {
+    [FENDER]   = { .drive_db = 3.0f, .sag_db = 3.0f, .sag_attack_hz = 12.0f, .sag_release_hz = 3.0f, .resonance_db = 1.5f, .presence_db = 1.0f },  // 6L6, tube rectifier
+    [VOX_AC]   = { .drive_db = 6.0f, .sag_db = 4.0f, .sag_attack_hz = 15.0f, .sag_release_hz = 4.0f, .resonance_db = 0.0f, .presence_db = 0.0f },  // EL84, no NFB
+    [MARSHALL] = { .drive_db = 4.0f, .sag_db = 2.0f, .sag_attack_hz = 20.0f, .sag_release_hz = 5.0f, .resonance_db = 2.0f, .presence_db = 3.0f },  // EL34
+    [SOLDANO]  = { .drive_db = 2.0f, .sag_db = 1.5f, .sag_attack_hz = 25.0f, .sag_release_hz = 6.0f, .resonance_db = 3.0f, .presence_db = 2.5f },  // 6L6, SS rectifier
+};
+
+/* ============================ Parameters/State ============================ */
+typedef struct {
+    int32_t drive_q24;          // Drive / 2^PA_SAMPLE_SHIFT
+    int32_t makeup_q24;         // 2^PA_SAMPLE_SHIFT / (1.5 * drive)
+    int32_t sag_log2;           // Headroom loss at env = 1.0 (log2, Q16)
+    int32_t att_a_q24;          // Follower alphas at the decimated rate
+    int32_t rel_a_q24;
+    int32_t res_k;              // Shelf gains - 1.0 in 1/2^PA_SHELF_SHIFT (0 = off)
+    int32_t pres_k;
+} PowerAmpCoefs;
+
+// Set once by init_power_amp before the preamp slot is ready, no coefficient bank
+static PowerAmpCoefs pa_coef[NUM_PREAMPS];
+
+static int32_t pa_env_q24 = 0;                      // Linked sag envelope, |y| in Q8.24
+static int32_t pa_drive_q24  = 0;                   // Ramp state (end of last block)
+static int32_t pa_makeup_q24 = 0;
+static int32_t pa_res_state_l=0,  pa_res_state_r=0;
+static int32_t pa_pres_state_l=0, pa_pres_state_r=0;
+
+/* =============================== Core process ============================ */
+static inline __attribute__((always_inline)) int32_t __not_in_flash_func(process_power_amp_channel)(
+    int32_t s, int32_t drive_q24, int32_t makeup_q24,
+    const PowerAmpCoefs* c,
+    int32_t* res_state, int32_t* pres_state
+){
+    int32_t v = qmul(s, drive_q24);
+
+    // Phase inverter: the negative half clips earlier and lower
+    bool neg = (v < 0);
+    if (neg) v += v >> PA_ASYM_SHIFT;
+    if (v >  Q24_ONE) v =  Q24_ONE;
+    if (v < -Q24_ONE) v = -Q24_ONE;
+    int32_t y = v + ((v - qmul(qmul(v, v), v)) >> 1);
+    if (neg) y -= y >> PA_ASYM_SHIFT;
+
+    // Reduced feedback at the band edges
+    if (c->res_k){
+        *res_state += (y - *res_state) >> PA_RES_SHIFT;
+        y += (*res_state >> PA_SHELF_SHIFT) * c->res_k;
+    }
+    if (c->pres_k){
+        *pres_state += (y - *pres_state) >> PA_PRES_SHIFT;
+        y += ((y - *pres_state) >> PA_SHELF_SHIFT) * c->pres_k;
+    }
+
+    return clamp24(clamp32(((int64_t)y * makeup_q24) >> 24));
+}
+
+/* =============================== Public API ============================== */
+// c: pa_coef[style], or a blend of two styles (dual amp)
+static inline void __not_in_flash_func(power_amp_process_block)(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo,
+                                                                const PowerAmpCoefs* c){
+    // Headroom for this block from the sag envelope (log2 domain)
+    int32_t sag = (int32_t)(((int64_t)pa_env_q24 * c->sag_log2) >> 24);
+    int32_t drive_target  = qmul(c->drive_q24,  exp2_q24(sag));
+    int32_t makeup_target = qmul(c->makeup_q24, exp2_q24(-sag));
+    int32_t drive_step    = (drive_target  - pa_drive_q24)  / (int32_t)frames;
+    int32_t makeup_step   = (makeup_target - pa_makeup_q24) / (int32_t)frames;
+
+    int32_t drive  = pa_drive_q24;
+    int32_t makeup = pa_makeup_q24;
+
+    for (size_t i = 0; i < frames; i++){
+        drive  += drive_step;
+        makeup += makeup_step;
+
+        int32_t yl = process_power_amp_channel(in_l[i], drive, makeup, c, &pa_res_state_l, &pa_pres_state_l);
+        int32_t yr = yl;
+        if (stereo){
+            yr = process_power_amp_channel(in_r[i], drive, makeup, c, &pa_res_state_r, &pa_pres_state_r);
+        }
+
+        // Sag follower on the linked output level
+        if ((i & (PA_ENV_DECIM - 1)) == 0){
+            int32_t al = (yl >= 0) ? yl : -yl;
+            int32_t ar = (yr >= 0) ? yr : -yr;
+            int32_t x  = ((al > ar) ? al : ar) >> PA_SAMPLE_SHIFT;
+            apply_1pole_lpf(x, &pa_env_q24, (x > pa_env_q24) ? c->att_a_q24 : c->rel_a_q24);
+        }
+
+        in_l[i] = yl;
+        in_r[i] = yr;       // Copy for MONO
+    }
+
+    // Land exactly on target (division remainder)
+    pa_drive_q24  = drive_target;
+    pa_makeup_q24 = makeup_target;
+}
+
+// Coefficients between two styles, w_q16 = 0 (a) .. Q16_ONE (b). Linear in
+// every field: drive and makeup stay within 0.5 dB of unity gain over the
+// voicing table, the shelf gains step in 1/16.
+static inline void power_amp_blend_coefs(PowerAmpCoefs* out, const PowerAmpCoefs* a, const PowerAmpCoefs* b, uint32_t w_q16){
+    out->drive_q24  = lerp_fixed(a->drive_q24,  b->drive_q24,  w_q16);
+    out->makeup_q24 = lerp_fixed(a->makeup_q24, b->makeup_q24, w_q16);
+    out->sag_log2   = lerp_fixed(a->sag_log2,   b->sag_log2,   w_q16);
+    out->att_a_q24  = lerp_fixed(a->att_a_q24,  b->att_a_q24,  w_q16);
+    out->rel_a_q24  = lerp_fixed(a->rel_a_q24,  b->rel_a_q24,  w_q16);
+    out->res_k      = lerp_fixed(a->res_k,      b->res_k,      w_q16);
+    out->pres_k     = lerp_fixed(a->pres_k,     b->pres_k,     w_q16);
+}
+
+// Reset filter states (init / enable only)
+static inline void reset_power_amp_state(void){
+    pa_env_q24 = 0;
+    pa_res_state_l  = pa_res_state_r  = 0;
+    pa_pres_state_l = pa_pres_state_r = 0;
+    pa_drive_q24  = pa_coef[selected_preamp_style].drive_q24;
+    pa_makeup_q24 = pa_coef[selected_preamp_style].makeup_q24;
+}
+
+/* =============================== Param load ============================== */
+// Coefficients for every preamp style, so switching styles needs no reload
+static inline void init_power_amp(void){
+    for (int p = 0; p < NUM_PREAMPS; p++){
+        const pa_voice_t* v = &PA_VOICE[p];
+        PowerAmpCoefs*    c = &pa_coef[p];
+        float drive = powf(10.0f, v->drive_db / 20.0f);
+
+        c->drive_q24  = float_to_q24(drive / (float)(1 << PA_SAMPLE_SHIFT));
+        c->makeup_q24 = float_to_q24((float)(1 << PA_SAMPLE_SHIFT) / (1.5f * drive));
+        c->sag_log2   = db_to_log2_q16(v->sag_db);
+        c->att_a_q24  = alpha_from_hz(v->sag_attack_hz  * PA_ENV_DECIM);
+        c->rel_a_q24  = alpha_from_hz(v->sag_release_hz * PA_ENV_DECIM);
+        c->res_k      = (int32_t)((powf(10.0f, v->resonance_db / 20.0f) - 1.0f) * (1 << PA_SHELF_SHIFT) + 0.5f);
+        c->pres_k     = (int32_t)((powf(10.0f, v->presence_db  / 20.0f) - 1.0f) * (1 << PA_SHELF_SHIFT) + 0.5f);
+    }
+    reset_power_amp_state();
+}
+
+#endif // POWER_AMP_H
@@ -97,38 +97,63 @@ static const marshall_voice_t JCM_VOICE = {
 };
 
 /* ============================ Parameters/State ============================ */
-static int32_t jcm_prevol_q24        = 0x01000000; // pot[0]
-static int32_t jcm_master_q24        = 0x01000000; // pot[5]
-static int32_t jcm_bass_gain_q24     = 0x01000000; // pot[1]
-static int32_t jcm_mid_gain_q24      = 0x01000000; // pot[2]
-static int32_t jcm_treble_gain_q24   = 0x01000000; // pot[3]
-static int32_t jcm_presence_gain_q24 = 0x01000000; // pot[4]
-
-static int32_t jcm_input_pad_q24     = 0x01000000;
-static int32_t jcm_bright_mix_q24    = 0;
-static int32_t jcm_stack_makeup_q24  = 0x01000000;
-
-static int32_t jcm_stageA_gain_q24   = 0x01000000;
-static int32_t jcm_stageB_gain_q24   = 0x01000000;
-
-static int32_t jcm_stageA_k3_q24     = 0;
-static int32_t jcm_stageA_k5_q24     = 0;
-static int32_t jcm_stageB_k3_q24     = 0;
-static int32_t jcm_stageB_k5_q24     = 0;
-
-static int32_t jcm_cf_amount_q24     = 0;
-
-static int32_t jcm_pre_hpf_a_q24     = 0;
-static int32_t jcm_cpl1_a_q24        = 0;
-static int32_t jcm_bright_a_q24      = 0;
-static int32_t jcm_cpl2_a_q24        = 0;
-static int32_t jcm_bass_a_q24        = 0;
-static int32_t jcm_mid_a_q24         = 0;
-static int32_t jcm_treble_a_q24      = 0;
-static int32_t jcm_presence_a_q24    = 0;
-static int32_t jcm_post_lpf_a_q24    = 0;
-
-static int32_t jcm_envB_a_q24        = 0;
+typedef struct {
+    int32_t prevol_q24;          // pot[0]
+    int32_t master_q24;          // pot[5]
+    int32_t bass_gain_q24;       // pot[1]
+    int32_t mid_gain_q24;        // pot[2]
+    int32_t treble_gain_q24;     // pot[3]
+    int32_t presence_gain_q24;   // pot[4]
+
+    int32_t input_pad_q24;
+    int32_t bright_mix_q24;
+    int32_t stack_makeup_q24;
+
+    int32_t stageA_gain_q24;
+    int32_t stageB_gain_q24;
+
+    int32_t stageA_k3_q24;
+    int32_t stageA_k5_q24;
+    int32_t stageB_k3_q24;
+    int32_t stageB_k5_q24;
+
+    int32_t cf_amount_q24;
+
+    int32_t pre_hpf_a_q24;
+    int32_t cpl1_a_q24;
+    int32_t bright_a_q24;
+    int32_t cpl2_a_q24;
+    int32_t bass_a_q24;
+    int32_t mid_a_q24;
+    int32_t treble_a_q24;
+    int32_t presence_a_q24;
+    int32_t post_lpf_a_q24;
+
+    int32_t envB_a_q24;
+
+    /* --- Cached constants (non-RT) */
+    int32_t ws_x5_on_q24, cf_recover_q24;
+    int32_t k3A_neg_base_q24, k5A_neg_base_q24;
+    int32_t k3B_neg_base_q24, k3B_neg_depth_q24;
+    int32_t k5B_neg_base_q24, k5B_neg_depth_q24;
+    int32_t bright_mix_prevol_q24;
+    int32_t presence_delta_q24;
+} MarshallCoefs;
+
+#define JCM_COEFS_DEFAULT { \
+    .prevol_q24        = 0x01000000, \
+    .master_q24        = 0x01000000, \
+    .bass_gain_q24     = 0x01000000, \
+    .mid_gain_q24      = 0x01000000, \
+    .treble_gain_q24   = 0x01000000, \
+    .presence_gain_q24 = 0x01000000, \
+    .input_pad_q24     = 0x01000000, \
+    .stack_makeup_q24  = 0x01000000, \
+    .stageA_gain_q24   = 0x01000000, \
+    .stageB_gain_q24   = 0x01000000 \
+}
+static MarshallCoefs jcm_coefs[2] = { JCM_COEFS_DEFAULT, JCM_COEFS_DEFAULT };
+static CoefBank jcm_bank = COEF_BANK(jcm_coefs);
 
 static int32_t jcm_pre_hpf_state_l=0, jcm_pre_hpf_state_r=0;
 static int32_t jcm_cpl1_state_l=0, jcm_cpl1_state_r=0;
@@ -144,16 +169,9 @@ static int32_t jcm_post_lpf_state_l=0, jcm_post_lpf_state_r=0;
 static int32_t jcm_envB_state_l=0, jcm_envB_state_r=0;
 static uint8_t jcm_envB_decim_l=0, jcm_envB_decim_r=0;
 
-/* --- Cached constants (non-RT) */
-static int32_t jcm_ws_x5_on_q24, jcm_cf_recover_q24;
-static int32_t jcm_k3A_neg_base_q24, jcm_k5A_neg_base_q24;
-static int32_t jcm_k3B_neg_base_q24, jcm_k3B_neg_depth_q24;
-static int32_t jcm_k5B_neg_base_q24, jcm_k5B_neg_depth_q24;
-static int32_t jcm_bright_mix_prevol_q24;
-static int32_t jcm_presence_delta_q24;
-
 /* =============================== Core process ============================ */
 static inline __attribute__((always_inline)) int32_t __not_in_flash_func(process_marshall_channel)(
+    const MarshallCoefs* c,
     int32_t s,
     int32_t* pre_hpf_state,
     int32_t* cpl1_state, int32_t* bright_state,
@@ -163,86 +181,86 @@ static inline __attribute__((always_inline)) int32_t __not_in_flash_func(process
     int32_t* post_lpf_state,
     int32_t* envB_state, uint8_t* envB_decim
 ){
-    s = qmul(s, jcm_input_pad_q24);
-    s = apply_1pole_hpf(s, pre_hpf_state, jcm_pre_hpf_a_q24);
-    s = apply_1pole_hpf(s, cpl1_state, jcm_cpl1_a_q24);
+    s = qmul(s, c->input_pad_q24);
+    s = apply_1pole_hpf(s, pre_hpf_state, c->pre_hpf_a_q24);
+    s = apply_1pole_hpf(s, cpl1_state, c->cpl1_a_q24);
 
-    if (jcm_bright_mix_q24){
-        int32_t l = apply_1pole_lpf(s, bright_state, jcm_bright_a_q24);
+    if (c->bright_mix_q24){
+        int32_t l = apply_1pole_lpf(s, bright_state, c->bright_a_q24);
         int32_t h = s - l;
-        int32_t base       = qmul(s, jcm_prevol_q24);
-        int32_t bright_add = qmul(h, jcm_bright_mix_prevol_q24);
+        int32_t base       = qmul(s, c->prevol_q24);
+        int32_t bright_add = qmul(h, c->bright_mix_prevol_q24);
         s = base + bright_add;
     } else {
-        s = qmul(s, jcm_prevol_q24);
+        s = qmul(s, c->prevol_q24);
     }
 
-    s = qmul(s, jcm_stageA_gain_q24);
+    s = qmul(s, c->stageA_gain_q24);
     s = triode_ws_35_asym_fast_q24(s,
-            jcm_stageA_k3_q24, jcm_stageA_k5_q24,
-            jcm_k3A_neg_base_q24, jcm_k5A_neg_base_q24,
-            jcm_ws_x5_on_q24,
+            c->stageA_k3_q24, c->stageA_k5_q24,
+            c->k3A_neg_base_q24, c->k5A_neg_base_q24,
+            c->ws_x5_on_q24,
             JCM_USE_X5);
 
-    s = apply_1pole_hpf(s, cpl2_state, jcm_cpl2_a_q24);
+    s = apply_1pole_hpf(s, cpl2_state, c->cpl2_a_q24);
 
     int32_t envB;
     if ( ((*envB_decim)++ & (JCM_ENV_DECIM-1)) == 0 ){
         int32_t s_abs = (s >= 0) ? s : -s;
-        envB = apply_1pole_lpf(s_abs, envB_state, jcm_envB_a_q24);
+        envB = apply_1pole_lpf(s_abs, envB_state, c->envB_a_q24);
     } else {
         envB = *envB_state;
     }
 
-    int32_t k3B_neg = jcm_k3B_neg_base_q24 + qmul(jcm_k3B_neg_depth_q24, envB);
-    int32_t k5B_neg = jcm_k5B_neg_base_q24 + qmul(jcm_k5B_neg_depth_q24, envB);
+    int32_t k3B_neg = c->k3B_neg_base_q24 + qmul(c->k3B_neg_depth_q24, envB);
+    int32_t k5B_neg = c->k5B_neg_base_q24 + qmul(c->k5B_neg_depth_q24, envB);
 
-    s = qmul(s, jcm_stageB_gain_q24);
+    s = qmul(s, c->stageB_gain_q24);
     s = triode_ws_35_asym_fast_q24(s,
-            jcm_stageB_k3_q24, jcm_stageB_k5_q24,
+            c->stageB_k3_q24, c->stageB_k5_q24,
             k3B_neg,           k5B_neg,
-            jcm_ws_x5_on_q24,
+            c->ws_x5_on_q24,
             JCM_USE_X5);
 
-    s = cathode_squish_q24(s, jcm_cf_amount_q24, jcm_cf_recover_q24);
+    s = cathode_squish_q24(s, c->cf_amount_q24, c->cf_recover_q24);
 
-    int32_t low      = apply_1pole_lpf(s, bass_state,   jcm_bass_a_q24);
-    int32_t low_out  = qmul(low, jcm_bass_gain_q24);
+    int32_t low      = apply_1pole_lpf(s, bass_state,   c->bass_a_q24);
+    int32_t low_out  = qmul(low, c->bass_gain_q24);
 
-    int32_t mid_bp   = apply_1pole_lpf(apply_1pole_hpf(s, mid_hp_state, jcm_mid_a_q24),
-                                       mid_lp_state, jcm_mid_a_q24);
-    int32_t mid_out  = qmul(mid_bp, jcm_mid_gain_q24);
+    int32_t mid_bp   = apply_1pole_lpf(apply_1pole_hpf(s, mid_hp_state, c->mid_a_q24),
+                                       mid_lp_state, c->mid_a_q24);
+    int32_t mid_out  = qmul(mid_bp, c->mid_gain_q24);
 
-    int32_t high_cmp = s - apply_1pole_lpf(s, treble_state, jcm_treble_a_q24);
-    int32_t high_out = qmul(high_cmp, jcm_treble_gain_q24);
+    int32_t high_cmp = s - apply_1pole_lpf(s, treble_state, c->treble_a_q24);
+    int32_t high_out = qmul(high_cmp, c->treble_gain_q24);
 
     int32_t mix32 = (int32_t)((int64_t)low_out + (int64_t)mid_out + (int64_t)high_out);
-    mix32 = qmul(mix32, jcm_stack_makeup_q24);
+    mix32 = qmul(mix32, c->stack_makeup_q24);
 
 #if JCM_ECO_PRES
-    if (jcm_presence_gain_q24 != 0x01000000){
-        int32_t pres_delta = qmul(high_cmp, jcm_presence_delta_q24);
+    if (c->presence_gain_q24 != 0x01000000){
+        int32_t pres_delta = qmul(high_cmp, c->presence_delta_q24);
         mix32 += pres_delta;
     }
 #else
-    if (jcm_presence_gain_q24 != 0x01000000){
-        int32_t pres_high  = mix32 - apply_1pole_lpf(mix32, presence_state, jcm_presence_a_q24);
-        int32_t pres_delta = qmul(pres_high, jcm_presence_delta_q24);
+    if (c->presence_gain_q24 != 0x01000000){
+        int32_t pres_high  = mix32 - apply_1pole_lpf(mix32, presence_state, c->presence_a_q24);
+        int32_t pres_delta = qmul(pres_high, c->presence_delta_q24);
         mix32 += pres_delta;
     }
 #endif
 
 #if !JCM_ECO
-    if (jcm_post_lpf_a_q24) mix32 = apply_1pole_lpf(mix32, post_lpf_state, jcm_post_lpf_a_q24);
+    if (c->post_lpf_a_q24) mix32 = apply_1pole_lpf(mix32, post_lpf_state, c->post_lpf_a_q24);
 #endif
 
-    mix32 = qmul(mix32, jcm_master_q24);
+    mix32 = qmul(mix32, c->master_q24);
     return clamp24(mix32);
 }
 
 /* =============================== Public API ============================== */
-static inline void __not_in_flash_func(process_audio_marshall_sample)(int32_t* inout_l, int32_t* inout_r, bool stereo){
-    *inout_l = process_marshall_channel(*inout_l,
+static inline void __not_in_flash_func(process_audio_marshall_sample)(int32_t* inout_l, int32_t* inout_r, bool stereo, const MarshallCoefs* c){
+    *inout_l = process_marshall_channel(c, *inout_l,
         &jcm_pre_hpf_state_l, &jcm_cpl1_state_l, &jcm_bright_state_l, &jcm_cpl2_state_l,
         &jcm_bass_state_l, &jcm_mid_lp_state_l, &jcm_mid_hp_state_l, &jcm_treble_state_l,
         &jcm_presence_state_l, &jcm_post_lpf_state_l,
@@ -251,7 +269,7 @@ static inline void __not_in_flash_func(process_audio_marshall_sample)(int32_t* i
     if(!stereo){
         *inout_r = *inout_l;
     } else {
-        *inout_r = process_marshall_channel(*inout_r,
+        *inout_r = process_marshall_channel(c, *inout_r,
             &jcm_pre_hpf_state_r, &jcm_cpl1_state_r, &jcm_bright_state_r, &jcm_cpl2_state_r,
             &jcm_bass_state_r, &jcm_mid_lp_state_r, &jcm_mid_hp_state_r, &jcm_treble_state_r,
             &jcm_presence_state_r, &jcm_post_lpf_state_r,
@@ -260,43 +278,60 @@ static inline void __not_in_flash_func(process_audio_marshall_sample)(int32_t* i
 }
 
 static inline void __not_in_flash_func(marshall_preamp_process_block)(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo){
+    const MarshallCoefs* c = coef_live(&jcm_bank);
     for (size_t i=0;i<frames;i++){
-        process_audio_marshall_sample(&in_l[i], &in_r[i], stereo);
+        process_audio_marshall_sample(&in_l[i], &in_r[i], stereo, c);
     }
 }
 
+/* --- State reset */
+static inline void reset_marshall_state(void) {
+    jcm_pre_hpf_state_l=jcm_pre_hpf_state_r=0;
+    jcm_cpl1_state_l=jcm_cpl1_state_r=0; jcm_bright_state_l=jcm_bright_state_r=0;
+    jcm_cpl2_state_l=jcm_cpl2_state_r=0;
+    jcm_bass_state_l=jcm_bass_state_r=0;
+    jcm_mid_lp_state_l=jcm_mid_lp_state_r=0; jcm_mid_hp_state_l=jcm_mid_hp_state_r=0;
+    jcm_treble_state_l=jcm_treble_state_r=0;
+    jcm_presence_state_l=jcm_presence_state_r=0;
+    jcm_post_lpf_state_l=jcm_post_lpf_state_r=0;
+    jcm_envB_state_l=jcm_envB_state_r=0;
+    jcm_envB_decim_l=jcm_envB_decim_r=0;
+}
+
 /* =============================== Param load ============================== */
 static inline void load_marshall_params_from_memory(void){
-    jcm_input_pad_q24  = db_to_q24(JCM_INPUT_PAD_DB);
-    jcm_pre_hpf_a_q24  = alpha_from_hz(JCM_VOICE.pre_hpf_Hz);
-    jcm_cpl1_a_q24     = alpha_from_hz(JCM_VOICE.cpl1_hz);
-    jcm_cpl2_a_q24     = alpha_from_hz(JCM_VOICE.cpl2_hz);
-    jcm_bass_a_q24     = alpha_from_hz(JCM_VOICE.bass_hz);
-    jcm_mid_a_q24      = alpha_from_hz(JCM_VOICE.mid_hz);
-    jcm_treble_a_q24   = alpha_from_hz(JCM_VOICE.treble_hz);
+    MarshallCoefs* c = coef_edit(&jcm_bank);
+
+    c->input_pad_q24  = db_to_q24(JCM_INPUT_PAD_DB);
+    c->pre_hpf_a_q24  = alpha_from_hz(JCM_VOICE.pre_hpf_Hz);
+    c->cpl1_a_q24     = alpha_from_hz(JCM_VOICE.cpl1_hz);
+    c->cpl2_a_q24     = alpha_from_hz(JCM_VOICE.cpl2_hz);
+    c->bass_a_q24     = alpha_from_hz(JCM_VOICE.bass_hz);
+    c->mid_a_q24      = alpha_from_hz(JCM_VOICE.mid_hz);
+    c->treble_a_q24   = alpha_from_hz(JCM_VOICE.treble_hz);
 #if !JCM_ECO_PRES
-    jcm_presence_a_q24 = alpha_from_hz(JCM_VOICE.presence_hz);
+    c->presence_a_q24 = alpha_from_hz(JCM_VOICE.presence_hz);
 #else
-    jcm_presence_a_q24 = 0;
+    c->presence_a_q24 = 0;
 #endif
 #if !JCM_ECO
-    jcm_post_lpf_a_q24 = alpha_from_hz(JCM_VOICE.post_lpf_Hz);
+    c->post_lpf_a_q24 = alpha_from_hz(JCM_VOICE.post_lpf_Hz);
 #else
-    jcm_post_lpf_a_q24 = 0;
+    c->post_lpf_a_q24 = 0;
 #endif
 
-    jcm_envB_a_q24     = alpha_from_hz(JCM_ENVB_HZ);
+    c->envB_a_q24     = alpha_from_hz(JCM_ENVB_HZ);
 
-    jcm_stageA_gain_q24 = db_to_q24(JCM_STAGEA_GAIN);
-    jcm_stageB_gain_q24 = db_to_q24(JCM_STAGEB_GAIN);
-    jcm_stack_makeup_q24= db_to_q24(JCM_STACK_MAKEUP_DB);
+    c->stageA_gain_q24 = db_to_q24(JCM_STAGEA_GAIN);
+    c->stageB_gain_q24 = db_to_q24(JCM_STAGEB_GAIN);
+    c->stack_makeup_q24= db_to_q24(JCM_STACK_MAKEUP_DB);
 
-    jcm_stageA_k3_q24 = float_to_q24(JCM_K3A);
-    jcm_stageA_k5_q24 = float_to_q24(JCM_K5A);
-    jcm_stageB_k3_q24 = float_to_q24(JCM_K3B);
-    jcm_stageB_k5_q24 = float_to_q24(JCM_K5B);
+    c->stageA_k3_q24 = float_to_q24(JCM_K3A);
+    c->stageA_k5_q24 = float_to_q24(JCM_K5A);
+    c->stageB_k3_q24 = float_to_q24(JCM_K3B);
+    c->stageB_k5_q24 = float_to_q24(JCM_K5B);
 
-    jcm_cf_amount_q24 = float_to_q24(0.18f + 0.12f * (JCM_VOICE.stageB_asym - 1.2f));
+    c->cf_amount_q24 = float_to_q24(0.18f + 0.12f * (JCM_VOICE.stageB_asym - 1.2f));
 
     int32_t pot;
     pot = storedPreampPotValue[MARSHALL][0];
@@ -304,61 +339,48 @@ static inline void load_marshall_params_from_memory(void){
     float t = powf(p, JCM_PREVOL_TAPER);
     float prevol_db = JCM_PREVOL_MIN_DB + (0.0f - JCM_PREVOL_MIN_DB) * t;
     prevol_db += JCM_PREVOL_TOP_BOOST_DB * powf(p, 6.0f);
-    jcm_prevol_q24 = db_to_q24(prevol_db);
+    c->prevol_q24 = db_to_q24(prevol_db);
 
     int32_t prevol01 = float_to_q24(powf(p, JCM_PREVOL_TAPER));
     int32_t inv01    = 0x01000000 - prevol01;
-    jcm_bright_mix_q24 = qmul(inv01, db_to_q24(JCM_BRIGHT_MAX_DB) - 0x01000000);
+    c->bright_mix_q24 = qmul(inv01, db_to_q24(JCM_BRIGHT_MAX_DB) - 0x01000000);
 
     float bright_fc = JCM_VOICE.bright_hz_min +
                       (JCM_VOICE.bright_hz_max - JCM_VOICE.bright_hz_min                      ) * (1.0f - p);
-    jcm_bright_a_q24 = alpha_from_hz(bright_fc);
+    c->bright_a_q24 = alpha_from_hz(bright_fc);
 
     // Tone stack gains
     pot = storedPreampPotValue[MARSHALL][1];
-    jcm_bass_gain_q24   = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
+    c->bass_gain_q24   = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
     pot = storedPreampPotValue[MARSHALL][2];
-    jcm_mid_gain_q24    = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+12.0f));
+    c->mid_gain_q24    = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+12.0f));
     pot = storedPreampPotValue[MARSHALL][3];
-    jcm_treble_gain_q24 = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
+    c->treble_gain_q24 = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
 
     // Presence: 0..+8 dB
     pot = storedPreampPotValue[MARSHALL][4];
-    jcm_presence_gain_q24 = map_pot_to_q24(pot, db_to_q24(0.0f), db_to_q24(+8.0f));
+    c->presence_gain_q24 = map_pot_to_q24(pot, db_to_q24(0.0f), db_to_q24(+8.0f));
 
     // Master: −3..+22 dB
     pot = storedPreampPotValue[MARSHALL][5];
-    jcm_master_q24 = map_pot_to_q24(pot, db_to_q24(-3.0f), db_to_q24(+22.0f));
+    c->master_q24 = map_pot_to_q24(pot, db_to_q24(-3.0f), db_to_q24(+22.0f));
 
     // --- Cached constants ---
-    jcm_ws_x5_on_q24   = float_to_q24(JCM_WS_X5_ON);
-    jcm_cf_recover_q24 = float_to_q24(0.97f);
-
-    jcm_k3A_neg_base_q24 = qmul(jcm_stageA_k3_q24, float_to_q24(JCM_ASYM_A_BASE));
-    jcm_k5A_neg_base_q24 = qmul(jcm_stageA_k5_q24, float_to_q24(JCM_ASYM_A_BASE));
-
-    jcm_k3B_neg_base_q24  = qmul(jcm_stageB_k3_q24, float_to_q24(JCM_ASYM_B_BASE));
-    jcm_k3B_neg_depth_q24 = qmul(jcm_stageB_k3_q24, float_to_q24(JCM_ASYM_B_DEPTH));
-    jcm_k5B_neg_base_q24  = qmul(jcm_stageB_k5_q24, float_to_q24(JCM_ASYM_B_BASE));
-    jcm_k5B_neg_depth_q24 = qmul(jcm_stageB_k5_q24, float_to_q24(JCM_ASYM_B_DEPTH));
-
-    jcm_bright_mix_prevol_q24 = qmul(jcm_bright_mix_q24, jcm_prevol_q24);
-    jcm_presence_delta_q24    = jcm_presence_gain_q24 - 0x01000000;
+    c->ws_x5_on_q24   = float_to_q24(JCM_WS_X5_ON);
+    c->cf_recover_q24 = float_to_q24(0.97f);
 
-    // Reset states (avoid zipper)
-    jcm_pre_hpf_state_l=jcm_pre_hpf_state_r=0;
-    jcm_cpl1_state_l=jcm_cpl1_state_r=0; jcm_bright_state_l=jcm_bright_state_r=0;
-    jcm_cpl2_state_l=jcm_cpl2_state_r=0;
+    c->k3A_neg_base_q24 = qmul(c->stageA_k3_q24, float_to_q24(JCM_ASYM_A_BASE));
+    c->k5A_neg_base_q24 = qmul(c->stageA_k5_q24, float_to_q24(JCM_ASYM_A_BASE));
 
-    jcm_bass_state_l=jcm_bass_state_r=0;
-    jcm_mid_lp_state_l=jcm_mid_lp_state_r=0; jcm_mid_hp_state_l=jcm_mid_hp_state_r=0;
-    jcm_treble_state_l=jcm_treble_state_r=0;
+    c->k3B_neg_base_q24  = qmul(c->stageB_k3_q24, float_to_q24(JCM_ASYM_B_BASE));
+    c->k3B_neg_depth_q24 = qmul(c->stageB_k3_q24, float_to_q24(JCM_ASYM_B_DEPTH));
+    c->k5B_neg_base_q24  = qmul(c->stageB_k5_q24, float_to_q24(JCM_ASYM_B_BASE));
+    c->k5B_neg_depth_q24 = qmul(c->stageB_k5_q24, float_to_q24(JCM_ASYM_B_DEPTH));
 
-    jcm_presence_state_l=jcm_presence_state_r=0;
-    jcm_post_lpf_state_l=jcm_post_lpf_state_r=0;
+    c->bright_mix_prevol_q24 = qmul(c->bright_mix_q24, c->prevol_q24);
+    c->presence_delta_q24    = c->presence_gain_q24 - 0x01000000;
 
-    jcm_envB_state_l=jcm_envB_state_r=0;
-    jcm_envB_decim_l=jcm_envB_decim_r=0;
+    coef_commit(&jcm_bank);
 }
 
 #endif // MARSHALL_PREAMP_H
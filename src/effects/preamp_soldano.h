@@ -99,38 +99,63 @@ static const slo_voice_t SLO_VOICE = {
 };
 
 /* ============================ Parameters/State ============================ */
-static int32_t slo_prevol_q24        = 0x01000000;
-static int32_t slo_master_q24        = 0x01000000;
-static int32_t slo_bass_gain_q24     = 0x01000000;
-static int32_t slo_mid_gain_q24      = 0x01000000;
-static int32_t slo_treble_gain_q24   = 0x01000000;
-static int32_t slo_presence_gain_q24 = 0x01000000;
-
-static int32_t slo_input_pad_q24     = 0x01000000;
-static int32_t slo_bright_mix_q24    = 0;
-static int32_t slo_stack_makeup_q24  = 0x01000000;
-
-static int32_t slo_stageA_gain_q24   = 0x01000000;
-static int32_t slo_stageB_gain_q24   = 0x01000000;
-
-static int32_t slo_stageA_k3_q24     = 0;
-static int32_t slo_stageA_k5_q24     = 0;
-static int32_t slo_stageB_k3_q24     = 0;
-static int32_t slo_stageB_k5_q24     = 0;
-
-static int32_t slo_cf_amount_q24     = 0;
-
-static int32_t slo_pre_hpf_a_q24     = 0;
-static int32_t slo_cpl1_a_q24        = 0;
-static int32_t slo_bright_a_q24      = 0;
-static int32_t slo_cpl2_a_q24        = 0;
-static int32_t slo_bass_a_q24        = 0;
-static int32_t slo_mid_a_q24         = 0;
-static int32_t slo_treble_a_q24      = 0;
-static int32_t slo_presence_a_q24    = 0;
-static int32_t slo_post_lpf_a_q24    = 0;
-
-static int32_t slo_envB_a_q24        = 0;
+typedef struct {
+    int32_t prevol_q24;
+    int32_t master_q24;
+    int32_t bass_gain_q24;
+    int32_t mid_gain_q24;
+    int32_t treble_gain_q24;
+    int32_t presence_gain_q24;
+
+    int32_t input_pad_q24;
+    int32_t bright_mix_q24;
+    int32_t stack_makeup_q24;
+
+    int32_t stageA_gain_q24;
+    int32_t stageB_gain_q24;
+
+    int32_t stageA_k3_q24;
+    int32_t stageA_k5_q24;
+    int32_t stageB_k3_q24;
+    int32_t stageB_k5_q24;
+
+    int32_t cf_amount_q24;
+
+    int32_t pre_hpf_a_q24;
+    int32_t cpl1_a_q24;
+    int32_t bright_a_q24;
+    int32_t cpl2_a_q24;
+    int32_t bass_a_q24;
+    int32_t mid_a_q24;
+    int32_t treble_a_q24;
+    int32_t presence_a_q24;
+    int32_t post_lpf_a_q24;
+
+    int32_t envB_a_q24;
+
+    /* --- Cached constants (non-RT) */
+    int32_t ws_x5_on_q24, cf_recover_q24;
+    int32_t k3A_neg_base_q24, k5A_neg_base_q24;
+    int32_t k3B_neg_base_q24, k3B_neg_depth_q24;
+    int32_t k5B_neg_base_q24, k5B_neg_depth_q24;
+    int32_t bright_mix_prevol_q24;
+    int32_t presence_delta_q24;
+} SloCoefs;
+
+#define SLO_COEFS_DEFAULT { \
+    .prevol_q24        = 0x01000000, \
+    .master_q24        = 0x01000000, \
+    .bass_gain_q24     = 0x01000000, \
+    .mid_gain_q24      = 0x01000000, \
+    .treble_gain_q24   = 0x01000000, \
+    .presence_gain_q24 = 0x01000000, \
+    .input_pad_q24     = 0x01000000, \
+    .stack_makeup_q24  = 0x01000000, \
+    .stageA_gain_q24   = 0x01000000, \
+    .stageB_gain_q24   = 0x01000000 \
+}
+static SloCoefs slo_coefs[2] = { SLO_COEFS_DEFAULT, SLO_COEFS_DEFAULT };
+static CoefBank slo_bank = COEF_BANK(slo_coefs);
 
 static int32_t slo_pre_hpf_state_l=0, slo_pre_hpf_state_r=0;
 static int32_t slo_cpl1_state_l=0,   slo_cpl1_state_r=0;
@@ -146,16 +171,9 @@ static int32_t slo_post_lpf_state_l=0, slo_post_lpf_state_r=0;
 static int32_t slo_envB_state_l=0, slo_envB_state_r=0;
 static uint8_t slo_envB_decim_l=0, slo_envB_decim_r=0;
 
-/* --- Cached constants (non-RT) */
-static int32_t slo_ws_x5_on_q24, slo_cf_recover_q24;
-static int32_t slo_k3A_neg_base_q24, slo_k5A_neg_base_q24;
-static int32_t slo_k3B_neg_base_q24, slo_k3B_neg_depth_q24;
-static int32_t slo_k5B_neg_base_q24, slo_k5B_neg_depth_q24;
-static int32_t slo_bright_mix_prevol_q24;
-static int32_t slo_presence_delta_q24;
-
 /* =============================== Core process ============================ */
 static inline __attribute__((always_inline)) int32_t __not_in_flash_func(process_slo_channel)(
+    const SloCoefs* c,
     int32_t s,
     int32_t* pre_hpf_state,
     int32_t* cpl1_state, int32_t* bright_state,
@@ -165,84 +183,84 @@ static inline __attribute__((always_inline)) int32_t __not_in_flash_func(process
     int32_t* post_lpf_state,
     int32_t* envB_state, uint8_t* envB_decim
 ){
-    s = qmul(s, slo_input_pad_q24);
-    s = apply_1pole_hpf(s, pre_hpf_state, slo_pre_hpf_a_q24);
-    s = apply_1pole_hpf(s, cpl1_state, slo_cpl1_a_q24);
+    s = qmul(s, c->input_pad_q24);
+    s = apply_1pole_hpf(s, pre_hpf_state, c->pre_hpf_a_q24);
+    s = apply_1pole_hpf(s, cpl1_state, c->cpl1_a_q24);
 
-    if (slo_bright_mix_q24){
-        int32_t l = apply_1pole_lpf(s, bright_state, slo_bright_a_q24);
+    if (c->bright_mix_q24){
+        int32_t l = apply_1pole_lpf(s, bright_state, c->bright_a_q24);
         int32_t h = s - l;
-        int32_t base       = qmul(s, slo_prevol_q24);
-        int32_t bright_add = qmul(h, slo_bright_mix_prevol_q24);
+        int32_t base       = qmul(s, c->prevol_q24);
+        int32_t bright_add = qmul(h, c->bright_mix_prevol_q24);
         s = base + bright_add;
     } else {
-        s = qmul(s, slo_prevol_q24);
+        s = qmul(s, c->prevol_q24);
     }
 
-    s = qmul(s, slo_stageA_gain_q24);
+    s = qmul(s, c->stageA_gain_q24);
     s = triode_ws_35_asym_fast_q24(s,
-            slo_stageA_k3_q24, slo_stageA_k5_q24,
-            slo_k3A_neg_base_q24, slo_k5A_neg_base_q24,
-            slo_ws_x5_on_q24,
+            c->stageA_k3_q24, c->stageA_k5_q24,
+            c->k3A_neg_base_q24, c->k5A_neg_base_q24,
+            c->ws_x5_on_q24,
             SLO_USE_X5);
 
-    s = apply_1pole_hpf(s, cpl2_state, slo_cpl2_a_q24);
+    s = apply_1pole_hpf(s, cpl2_state, c->cpl2_a_q24);
 
     int32_t envB;
     if ( ((*envB_decim)++ & (SLO_ENV_DECIM-1)) == 0 ){
         int32_t s_abs = (s >= 0) ? s : -s;
-        envB = apply_1pole_lpf(s_abs, envB_state, slo_envB_a_q24);
+        envB = apply_1pole_lpf(s_abs, envB_state, c->envB_a_q24);
     } else {
         envB = *envB_state;
     }
 
-    int32_t k3B_neg = slo_k3B_neg_base_q24 + qmul(slo_k3B_neg_depth_q24, envB);
-    int32_t k5B_neg = slo_k5B_neg_base_q24 + qmul(slo_k5B_neg_depth_q24, envB);
+    int32_t k3B_neg = c->k3B_neg_base_q24 + qmul(c->k3B_neg_depth_q24, envB);
+    int32_t k5B_neg = c->k5B_neg_base_q24 + qmul(c->k5B_neg_depth_q24, envB);
 
-    s = qmul(s, slo_stageB_gain_q24);
+    s = qmul(s, c->stageB_gain_q24);
     s = triode_ws_35_asym_fast_q24(s,
-            slo_stageB_k3_q24, slo_stageB_k5_q24,
+            c->stageB_k3_q24, c->stageB_k5_q24,
             k3B_neg,           k5B_neg,
-            slo_ws_x5_on_q24,
+            c->ws_x5_on_q24,
             SLO_USE_X5);
 
-    s = cathode_squish_q24(s, slo_cf_amount_q24, slo_cf_recover_q24);
+    s = cathode_squish_q24(s, c->cf_amount_q24, c->cf_recover_q24);
 
-    int32_t low      = apply_1pole_lpf(s, bass_state,   slo_bass_a_q24);
-    int32_t low_out  = qmul(low, slo_bass_gain_q24);
+    int32_t low      = apply_1pole_lpf(s, bass_state,   c->bass_a_q24);
+    int32_t low_out  = qmul(low, c->bass_gain_q24);
 
-    int32_t mid_bp   = apply_1pole_lpf(apply_1pole_hpf(s, mid_hp_state, slo_mid_a_q24),
-                                       mid_lp_state, slo_mid_a_q24);
-    int32_t mid_out  = qmul(mid_bp, slo_mid_gain_q24);
+    int32_t mid_bp   = apply_1pole_lpf(apply_1pole_hpf(s, mid_hp_state, c->mid_a_q24),
+                                       mid_lp_state, c->mid_a_q24);
+    int32_t mid_out  = qmul(mid_bp, c->mid_gain_q24);
 
-    int32_t high_cmp = s - apply_1pole_lpf(s, treble_state, slo_treble_a_q24);
-    int32_t high_out = qmul(high_cmp, slo_treble_gain_q24);
+    int32_t high_cmp = s - apply_1pole_lpf(s, treble_state, c->treble_a_q24);
+    int32_t high_out = qmul(high_cmp, c->treble_gain_q24);
 
     int32_t mix32 = (int32_t)((int64_t)low_out + (int64_t)mid_out + (int64_t)high_out);
-    mix32 = qmul(mix32, slo_stack_makeup_q24);
+    mix32 = qmul(mix32, c->stack_makeup_q24);
 
 #if SLO_ECO_PRES
-    if (slo_presence_gain_q24 != 0x01000000){
-        mix32 += qmul(high_cmp, slo_presence_delta_q24);
+    if (c->presence_gain_q24 != 0x01000000){
+        mix32 += qmul(high_cmp, c->presence_delta_q24);
     }
 #else
-    if (slo_presence_gain_q24 != 0x01000000){
-        int32_t pres_high  = mix32 - apply_1pole_lpf(mix32, presence_state, slo_presence_a_q24);
-        mix32 += qmul(pres_high, slo_presence_delta_q24);
+    if (c->presence_gain_q24 != 0x01000000){
+        int32_t pres_high  = mix32 - apply_1pole_lpf(mix32, presence_state, c->presence_a_q24);
+        mix32 += qmul(pres_high, c->presence_delta_q24);
     }
 #endif
 
 #if !SLO_ECO
-    if (slo_post_lpf_a_q24) mix32 = apply_1pole_lpf(mix32, post_lpf_state, slo_post_lpf_a_q24);
+    if (c->post_lpf_a_q24) mix32 = apply_1pole_lpf(mix32, post_lpf_state, c->post_lpf_a_q24);
 #endif
 
-    mix32 = qmul(mix32, slo_master_q24);
+    mix32 = qmul(mix32, c->master_q24);
     return clamp24(mix32);
 }
 
 /* =============================== Public API ============================== */
-static inline void __not_in_flash_func(process_audio_slo_sample)(int32_t* inout_l, int32_t* inout_r, bool stereo){
-    *inout_l = process_slo_channel(*inout_l,
+static inline void __not_in_flash_func(process_audio_slo_sample)(int32_t* inout_l, int32_t* inout_r, bool stereo, const SloCoefs* c){
+    *inout_l = process_slo_channel(c, *inout_l,
         &slo_pre_hpf_state_l, &slo_cpl1_state_l, &slo_bright_state_l, &slo_cpl2_state_l,
         &slo_bass_state_l, &slo_mid_lp_state_l, &slo_mid_hp_state_l, &slo_treble_state_l,
         &slo_presence_state_l, &slo_post_lpf_state_l,
@@ -251,7 +269,7 @@ static inline void __not_in_flash_func(process_audio_slo_sample)(int32_t* inout_
     if(!stereo){
         *inout_r = *inout_l;
     } else {
-        *inout_r = process_slo_channel(*inout_r,
+        *inout_r = process_slo_channel(c, *inout_r,
             &slo_pre_hpf_state_r, &slo_cpl1_state_r, &slo_bright_state_r, &slo_cpl2_state_r,
             &slo_bass_state_r, &slo_mid_lp_state_r, &slo_mid_hp_state_r, &slo_treble_state_r,
             &slo_presence_state_r, &slo_post_lpf_state_r,
@@ -260,43 +278,60 @@ static inline void __not_in_flash_func(process_audio_slo_sample)(int32_t* inout_
 }
 
 static inline void __not_in_flash_func(slo_preamp_process_block)(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo){
+    const SloCoefs* c = coef_live(&slo_bank);
     for (size_t i=0;i<frames;i++){
-        process_audio_slo_sample(&in_l[i], &in_r[i], stereo);
+        process_audio_slo_sample(&in_l[i], &in_r[i], stereo, c);
     }
 }
 
+/* --- State reset */
+static inline void reset_slo_state(void) {
+    slo_pre_hpf_state_l=slo_pre_hpf_state_r=0;
+    slo_cpl1_state_l=slo_cpl1_state_r=0; slo_bright_state_l=slo_bright_state_r=0;
+    slo_cpl2_state_l=slo_cpl2_state_r=0;
+    slo_bass_state_l=slo_bass_state_r=0;
+    slo_mid_lp_state_l=slo_mid_lp_state_r=0; slo_mid_hp_state_l=slo_mid_hp_state_r=0;
+    slo_treble_state_l=slo_treble_state_r=0;
+    slo_presence_state_l=slo_presence_state_r=0;
+    slo_post_lpf_state_l=slo_post_lpf_state_r=0;
+    slo_envB_state_l=slo_envB_state_r=0;
+    slo_envB_decim_l=slo_envB_decim_r=0;
+}
+
 /* =============================== Param load ============================== */
 static inline void load_slo_params_from_memory(void){
-    slo_input_pad_q24  = db_to_q24(SLO_INPUT_PAD_DB);
-    slo_pre_hpf_a_q24  = alpha_from_hz(SLO_VOICE.pre_hpf_Hz);
-    slo_cpl1_a_q24     = alpha_from_hz(SLO_VOICE.cpl1_hz);
-    slo_cpl2_a_q24     = alpha_from_hz(SLO_VOICE.cpl2_hz);
-    slo_bass_a_q24     = alpha_from_hz(SLO_VOICE.bass_hz);
-    slo_mid_a_q24      = alpha_from_hz(SLO_VOICE.mid_hz);
-    slo_treble_a_q24   = alpha_from_hz(SLO_VOICE.treble_hz);
+    SloCoefs* c = coef_edit(&slo_bank);
+
+    c->input_pad_q24  = db_to_q24(SLO_INPUT_PAD_DB);
+    c->pre_hpf_a_q24  = alpha_from_hz(SLO_VOICE.pre_hpf_Hz);
+    c->cpl1_a_q24     = alpha_from_hz(SLO_VOICE.cpl1_hz);
+    c->cpl2_a_q24     = alpha_from_hz(SLO_VOICE.cpl2_hz);
+    c->bass_a_q24     = alpha_from_hz(SLO_VOICE.bass_hz);
+    c->mid_a_q24      = alpha_from_hz(SLO_VOICE.mid_hz);
+    c->treble_a_q24   = alpha_from_hz(SLO_VOICE.treble_hz);
 #if !SLO_ECO_PRES
-    slo_presence_a_q24 = alpha_from_hz(SLO_VOICE.presence_hz);
+    c->presence_a_q24 = alpha_from_hz(SLO_VOICE.presence_hz);
 #else
-    slo_presence_a_q24 = 0;
+    c->presence_a_q24 = 0;
 #endif
 #if !SLO_ECO
-    slo_post_lpf_a_q24 = alpha_from_hz(SLO_VOICE.post_lpf_Hz);
+    c->post_lpf_a_q24 = alpha_from_hz(SLO_VOICE.post_lpf_Hz);
 #else
-    slo_post_lpf_a_q24 = 0;
+    c->post_lpf_a_q24 = 0;
 #endif
 
-    slo_envB_a_q24     = alpha_from_hz(SLO_ENVB_HZ);
+    c->envB_a_q24     = alpha_from_hz(SLO_ENVB_HZ);
 
-    slo_stageA_gain_q24 = db_to_q24(SLO_STAGEA_GAIN);
-    slo_stageB_gain_q24 = db_to_q24(SLO_STAGEB_GAIN);
-    slo_stack_makeup_q24= db_to_q24(SLO_STACK_MAKEUP_DB);
+    c->stageA_gain_q24 = db_to_q24(SLO_STAGEA_GAIN);
+    c->stageB_gain_q24 = db_to_q24(SLO_STAGEB_GAIN);
+    c->stack_makeup_q24= db_to_q24(SLO_STACK_MAKEUP_DB);
 
-    slo_stageA_k3_q24 = float_to_q24(SLO_K3A);
-    slo_stageA_k5_q24 = float_to_q24(SLO_K5A);
-    slo_stageB_k3_q24 = float_to_q24(SLO_K3B);
-    slo_stageB_k5_q24 = float_to_q24(SLO_K5B);
+    c->stageA_k3_q24 = float_to_q24(SLO_K3A);
+    c->stageA_k5_q24 = float_to_q24(SLO_K5A);
+    c->stageB_k3_q24 = float_to_q24(SLO_K3B);
+    c->stageB_k5_q24 = float_to_q24(SLO_K5B);
 
-    slo_cf_amount_q24 = float_to_q24(0.20f + 0.12f * (SLO_VOICE.stageB_asym - 1.3f));
+    c->cf_amount_q24 = float_to_q24(0.20f + 0.12f * (SLO_VOICE.stageB_asym - 1.3f));
 
     int32_t pot;
     pot = storedPreampPotValue[SOLDANO][0];
@@ -304,55 +339,45 @@ static inline void load_slo_params_from_memory(void){
     float t = powf(p, SLO_PREVOL_TAPER);
     float prevol_db = SLO_PREVOL_MIN_DB + (0.0f - SLO_PREVOL_MIN_DB) * t;
     prevol_db += SLO_PREVOL_TOP_BOOST_DB * powf(p, 6.0f);
-    slo_prevol_q24 = db_to_q24(prevol_db);
+    c->prevol_q24 = db_to_q24(prevol_db);
 
     int32_t prevol01 = float_to_q24(powf(p, SLO_PREVOL_TAPER));
     int32_t inv01    = 0x01000000 - prevol01;
-    slo_bright_mix_q24 = qmul(inv01, db_to_q24(SLO_BRIGHT_MAX_DB) - 0x01000000);
+    c->bright_mix_q24 = qmul(inv01, db_to_q24(SLO_BRIGHT_MAX_DB) - 0x01000000);
 
     float bright_fc = SLO_VOICE.bright_hz_min +
                       (SLO_VOICE.bright_hz_max - SLO_VOICE.bright_hz_min) * (1.0f - p);
-    slo_bright_a_q24 = alpha_from_hz(bright_fc);
+    c->bright_a_q24 = alpha_from_hz(bright_fc);
 
     pot = storedPreampPotValue[SOLDANO][1];
-    slo_bass_gain_q24   = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
+    c->bass_gain_q24   = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
     pot = storedPreampPotValue[SOLDANO][2];
-    slo_mid_gain_q24    = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+12.0f));
+    c->mid_gain_q24    = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+12.0f));
     pot = storedPreampPotValue[SOLDANO][3];
-    slo_treble_gain_q24 = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
+    c->treble_gain_q24 = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
 
     pot = storedPreampPotValue[SOLDANO][4];
-    slo_presence_gain_q24 = map_pot_to_q24(pot, db_to_q24(0.0f), db_to_q24(+8.0f));
+    c->presence_gain_q24 = map_pot_to_q24(pot, db_to_q24(0.0f), db_to_q24(+8.0f));
 
     pot = storedPreampPotValue[SOLDANO][5];
-    slo_master_q24 = map_pot_to_q24(pot, db_to_q24(-3.0f), db_to_q24(+22.0f));
+    c->master_q24 = map_pot_to_q24(pot, db_to_q24(-3.0f), db_to_q24(+22.0f));
 
     /* --- Cached constants --- */
-    slo_ws_x5_on_q24   = float_to_q24(SLO_WS_X5_ON);
-    slo_cf_recover_q24 = float_to_q24(0.965f);
+    c->ws_x5_on_q24   = float_to_q24(SLO_WS_X5_ON);
+    c->cf_recover_q24 = float_to_q24(0.965f);
 
-    slo_k3A_neg_base_q24 = qmul(slo_stageA_k3_q24, float_to_q24(SLO_ASYM_A_BASE));
-    slo_k5A_neg_base_q24 = qmul(slo_stageA_k5_q24, float_to_q24(SLO_ASYM_A_BASE));
+    c->k3A_neg_base_q24 = qmul(c->stageA_k3_q24, float_to_q24(SLO_ASYM_A_BASE));
+    c->k5A_neg_base_q24 = qmul(c->stageA_k5_q24, float_to_q24(SLO_ASYM_A_BASE));
 
-    slo_k3B_neg_base_q24  = qmul(slo_stageB_k3_q24, float_to_q24(SLO_ASYM_B_BASE));
-    slo_k3B_neg_depth_q24 = qmul(slo_stageB_k3_q24, float_to_q24(SLO_ASYM_B_DEPTH));
-    slo_k5B_neg_base_q24  = qmul(slo_stageB_k5_q24, float_to_q24(SLO_ASYM_B_BASE));
-    slo_k5B_neg_depth_q24 = qmul(slo_stageB_k5_q24, float_to_q24(SLO_ASYM_B_DEPTH));
+    c->k3B_neg_base_q24  = qmul(c->stageB_k3_q24, float_to_q24(SLO_ASYM_B_BASE));
+    c->k3B_neg_depth_q24 = qmul(c->stageB_k3_q24, float_to_q24(SLO_ASYM_B_DEPTH));
+    c->k5B_neg_base_q24  = qmul(c->stageB_k5_q24, float_to_q24(SLO_ASYM_B_BASE));
+    c->k5B_neg_depth_q24 = qmul(c->stageB_k5_q24, float_to_q24(SLO_ASYM_B_DEPTH));
 
-    slo_bright_mix_prevol_q24 = qmul(slo_bright_mix_q24, slo_prevol_q24);
-    slo_presence_delta_q24    = slo_presence_gain_q24 - 0x01000000;
+    c->bright_mix_prevol_q24 = qmul(c->bright_mix_q24, c->prevol_q24);
+    c->presence_delta_q24    = c->presence_gain_q24 - 0x01000000;
 
-    /* Reset states */
-    slo_pre_hpf_state_l=slo_pre_hpf_state_r=0;
-    slo_cpl1_state_l=slo_cpl1_state_r=0; slo_bright_state_l=slo_bright_state_r=0;
-    slo_cpl2_state_l=slo_cpl2_state_r=0;
-    slo_bass_state_l=slo_bass_state_r=0;
-    slo_mid_lp_state_l=slo_mid_lp_state_r=0; slo_mid_hp_state_l=slo_mid_hp_state_r=0;
-    slo_treble_state_l=slo_treble_state_r=0;
-    slo_presence_state_l=slo_presence_state_r=0;
-    slo_post_lpf_state_l=slo_post_lpf_state_r=0;
-    slo_envB_state_l=slo_envB_state_r=0;
-    slo_envB_decim_l=slo_envB_decim_r=0;
+    coef_commit(&slo_bank);
 }
 
 #endif // SLO_PREAMP_H
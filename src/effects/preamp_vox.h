@@ -98,44 +98,74 @@ static const vox_voice_t VOX_VOICE = {
 };
 
 /* ============================ Parameters/State ============================ */
-static int32_t vox_prevol_q24        = 0x01000000; // pot[0]
-static int32_t vox_master_q24        = 0x01000000; // pot[5]
-static int32_t vox_bass_gain_q24     = 0x01000000; // pot[1]
-static int32_t vox_mid_gain_q24      = 0x01000000; // pot[2]
-static int32_t vox_treble_gain_q24   = 0x01000000; // pot[3]
+typedef struct {
+    int32_t prevol_q24;          // pot[0]
+    int32_t master_q24;          // pot[5]
+    int32_t bass_gain_q24;       // pot[1]
+    int32_t mid_gain_q24;        // pot[2]
+    int32_t treble_gain_q24;     // pot[3]
 
 #if VOX_USE_CUT
-static int32_t vox_cut_gain_q24      = 0x01000000; // pot[4]
-static int32_t vox_cut_delta_q24     = 0;          // (1 - cut_gain)
+    int32_t cut_gain_q24;        // pot[4]
+    int32_t cut_delta_q24;       // (1 - cut_gain)
 #else
-static int32_t vox_presence_gain_q24 = 0x01000000; // pot[4]
-static int32_t vox_presence_delta_q24= 0;          // presence_gain - 1.0
+    int32_t presence_gain_q24;   // pot[4]
+    int32_t presence_delta_q24;  // presence_gain - 1.0
 #endif
 
-static int32_t vox_input_pad_q24     = 0x01000000;
-static int32_t vox_bright_mix_q24    = 0;
-static int32_t vox_stack_makeup_q24  = 0x01000000;
+    int32_t input_pad_q24;
+    int32_t bright_mix_q24;
+    int32_t stack_makeup_q24;
+
+    int32_t stageA_gain_q24;
+    int32_t stageB_gain_q24;
+
+    int32_t stageA_k3_q24;
+    int32_t stageA_k5_q24;
+    int32_t stageB_k3_q24;
+    int32_t stageB_k5_q24;
+
+    int32_t cf_amount_q24;
 
-static int32_t vox_stageA_gain_q24   = 0x01000000;
-static int32_t vox_stageB_gain_q24   = 0x01000000;
+    int32_t pre_hpf_a_q24;
+    int32_t cpl1_a_q24;
+    int32_t bright_a_q24;
+    int32_t cpl2_a_q24;
+    int32_t bass_a_q24;
+    int32_t mid_a_q24;
+    int32_t treble_a_q24;
+    int32_t post_lpf_a_q24;
 
-static int32_t vox_stageA_k3_q24     = 0;
-static int32_t vox_stageA_k5_q24     = 0;
-static int32_t vox_stageB_k3_q24     = 0;
-static int32_t vox_stageB_k5_q24     = 0;
+    int32_t envB_a_q24;
 
-static int32_t vox_cf_amount_q24     = 0;
+    /* --- Cached constants (non-RT) */
+    int32_t ws_x5_on_q24, cf_recover_q24;
+    int32_t k3A_neg_base_q24, k5A_neg_base_q24;
+    int32_t k3B_neg_base_q24, k3B_neg_depth_q24;
+    int32_t k5B_neg_base_q24, k5B_neg_depth_q24;
+    int32_t bright_mix_prevol_q24;
+} VoxCoefs;
 
-static int32_t vox_pre_hpf_a_q24     = 0;
-static int32_t vox_cpl1_a_q24        = 0;
-static int32_t vox_bright_a_q24      = 0;
-static int32_t vox_cpl2_a_q24        = 0;
-static int32_t vox_bass_a_q24        = 0;
-static int32_t vox_mid_a_q24         = 0;
-static int32_t vox_treble_a_q24      = 0;
-static int32_t vox_post_lpf_a_q24    = 0;
+#if VOX_USE_CUT
+#define VOX_POT4_DEFAULT    .cut_gain_q24      = 0x01000000
+#else
+#define VOX_POT4_DEFAULT    .presence_gain_q24 = 0x01000000
+#endif
 
-static int32_t vox_envB_a_q24        = 0;
+#define VOX_COEFS_DEFAULT { \
+    .prevol_q24        = 0x01000000, \
+    .master_q24        = 0x01000000, \
+    .bass_gain_q24     = 0x01000000, \
+    .mid_gain_q24      = 0x01000000, \
+    .treble_gain_q24   = 0x01000000, \
+    VOX_POT4_DEFAULT, \
+    .input_pad_q24     = 0x01000000, \
+    .stack_makeup_q24  = 0x01000000, \
+    .stageA_gain_q24   = 0x01000000, \
+    .stageB_gain_q24   = 0x01000000 \
+}
+static VoxCoefs vox_coefs[2] = { VOX_COEFS_DEFAULT, VOX_COEFS_DEFAULT };
+static CoefBank vox_bank = COEF_BANK(vox_coefs);
 
 static int32_t vox_pre_hpf_state_l=0, vox_pre_hpf_state_r=0;
 static int32_t vox_cpl1_state_l=0,   vox_cpl1_state_r=0;
@@ -152,15 +182,9 @@ static int32_t vox_post_lpf_state_l=0, vox_post_lpf_state_r=0;
 static int32_t vox_envB_state_l=0, vox_envB_state_r=0;
 static uint8_t vox_envB_decim_l=0, vox_envB_decim_r=0;
 
-/* --- Cached constants (non-RT) */
-static int32_t vox_ws_x5_on_q24, vox_cf_recover_q24;
-static int32_t vox_k3A_neg_base_q24, vox_k5A_neg_base_q24;
-static int32_t vox_k3B_neg_base_q24, vox_k3B_neg_depth_q24;
-static int32_t vox_k5B_neg_base_q24, vox_k5B_neg_depth_q24;
-static int32_t vox_bright_mix_prevol_q24;
-
 /* =============================== Core process ============================ */
 static inline __attribute__((always_inline)) int32_t __not_in_flash_func(process_vox_channel)(
+    const VoxCoefs* c,
     int32_t s,
     int32_t* pre_hpf_state,
     int32_t* cpl1_state, int32_t* bright_state,
@@ -169,86 +193,86 @@ static inline __attribute__((always_inline)) int32_t __not_in_flash_func(process
     int32_t* post_lpf_state,
     int32_t* envB_state, uint8_t* envB_decim
 ){
-    s = qmul(s, vox_input_pad_q24);
-    s = apply_1pole_hpf(s, pre_hpf_state, vox_pre_hpf_a_q24);
-    s = apply_1pole_hpf(s, cpl1_state, vox_cpl1_a_q24);
+    s = qmul(s, c->input_pad_q24);
+    s = apply_1pole_hpf(s, pre_hpf_state, c->pre_hpf_a_q24);
+    s = apply_1pole_hpf(s, cpl1_state, c->cpl1_a_q24);
 
-    if (vox_bright_mix_q24){
-        int32_t l = apply_1pole_lpf(s, bright_state, vox_bright_a_q24);
+    if (c->bright_mix_q24){
+        int32_t l = apply_1pole_lpf(s, bright_state, c->bright_a_q24);
         int32_t h = s - l;
-        int32_t base       = qmul(s, vox_prevol_q24);
-        int32_t bright_add = qmul(h, vox_bright_mix_prevol_q24);
+        int32_t base       = qmul(s, c->prevol_q24);
+        int32_t bright_add = qmul(h, c->bright_mix_prevol_q24);
         s = base + bright_add;
     } else {
-        s = qmul(s, vox_prevol_q24);
+        s = qmul(s, c->prevol_q24);
     }
 
-    s = qmul(s, vox_stageA_gain_q24);
+    s = qmul(s, c->stageA_gain_q24);
     s = triode_ws_35_asym_fast_q24(s,
-            vox_stageA_k3_q24, vox_stageA_k5_q24,
-            vox_k3A_neg_base_q24, vox_k5A_neg_base_q24,
-            vox_ws_x5_on_q24,
+            c->stageA_k3_q24, c->stageA_k5_q24,
+            c->k3A_neg_base_q24, c->k5A_neg_base_q24,
+            c->ws_x5_on_q24,
             VOX_USE_X5);
 
-    s = apply_1pole_hpf(s, cpl2_state, vox_cpl2_a_q24);
+    s = apply_1pole_hpf(s, cpl2_state, c->cpl2_a_q24);
 
     int32_t envB;
     if ( ((*envB_decim)++ & (VOX_ENV_DECIM-1)) == 0 ){
         int32_t s_abs = (s >= 0) ? s : -s;
-        envB = apply_1pole_lpf(s_abs, envB_state, vox_envB_a_q24);
+        envB = apply_1pole_lpf(s_abs, envB_state, c->envB_a_q24);
     } else {
         envB = *envB_state;
     }
 
-    int32_t k3B_neg = vox_k3B_neg_base_q24 + qmul(vox_k3B_neg_depth_q24, envB);
-    int32_t k5B_neg = vox_k5B_neg_base_q24 + qmul(vox_k5B_neg_depth_q24, envB);
+    int32_t k3B_neg = c->k3B_neg_base_q24 + qmul(c->k3B_neg_depth_q24, envB);
+    int32_t k5B_neg = c->k5B_neg_base_q24 + qmul(c->k5B_neg_depth_q24, envB);
 
-    s = qmul(s, vox_stageB_gain_q24);
+    s = qmul(s, c->stageB_gain_q24);
     s = triode_ws_35_asym_fast_q24(s,
-            vox_stageB_k3_q24, vox_stageB_k5_q24,
+            c->stageB_k3_q24, c->stageB_k5_q24,
             k3B_neg,           k5B_neg,
-            vox_ws_x5_on_q24,
+            c->ws_x5_on_q24,
             VOX_USE_X5);
 
-    s = cathode_squish_q24(s, vox_cf_amount_q24, vox_cf_recover_q24);
+    s = cathode_squish_q24(s, c->cf_amount_q24, c->cf_recover_q24);
 
-    int32_t low      = apply_1pole_lpf(s, bass_state,   vox_bass_a_q24);
-    int32_t low_out  = qmul(low, vox_bass_gain_q24);
+    int32_t low      = apply_1pole_lpf(s, bass_state,   c->bass_a_q24);
+    int32_t low_out  = qmul(low, c->bass_gain_q24);
 
-    int32_t mid_bp   = apply_1pole_lpf(apply_1pole_hpf(s, mid_hp_state, vox_mid_a_q24),
-                                       mid_lp_state, vox_mid_a_q24);
-    int32_t mid_out  = qmul(mid_bp, vox_mid_gain_q24);
+    int32_t mid_bp   = apply_1pole_lpf(apply_1pole_hpf(s, mid_hp_state, c->mid_a_q24),
+                                       mid_lp_state, c->mid_a_q24);
+    int32_t mid_out  = qmul(mid_bp, c->mid_gain_q24);
 
-    int32_t high_cmp = s - apply_1pole_lpf(s, treble_state, vox_treble_a_q24);
-    int32_t high_out = qmul(high_cmp, vox_treble_gain_q24);
+    int32_t high_cmp = s - apply_1pole_lpf(s, treble_state, c->treble_a_q24);
+    int32_t high_out = qmul(high_cmp, c->treble_gain_q24);
 
     int32_t mix32 = (int32_t)((int64_t)low_out + (int64_t)mid_out + (int64_t)high_out);
-    mix32 = qmul(mix32, vox_stack_makeup_q24);
+    mix32 = qmul(mix32, c->stack_makeup_q24);
 
 #if VOX_USE_CUT
-    if (vox_cut_gain_q24 != 0x01000000){
+    if (c->cut_gain_q24 != 0x01000000){
         // CUT: attenuate highs (knob up = more cut)
-        mix32 -= qmul(high_cmp, vox_cut_delta_q24);
+        mix32 -= qmul(high_cmp, c->cut_delta_q24);
     }
 #else
-    if (vox_presence_gain_q24 != 0x01000000){
+    if (c->presence_gain_q24 != 0x01000000){
         // Presence: boost highs (knob up = more boost)
-        mix32 += qmul(high_cmp, vox_presence_delta_q24);
+        mix32 += qmul(high_cmp, c->presence_delta_q24);
     }
 #endif
 
 #if !VOX_ECO
-    if (vox_post_lpf_a_q24)
-        mix32 = apply_1pole_lpf(mix32, post_lpf_state, vox_post_lpf_a_q24);
+    if (c->post_lpf_a_q24)
+        mix32 = apply_1pole_lpf(mix32, post_lpf_state, c->post_lpf_a_q24);
 #endif
 
-    mix32 = qmul(mix32, vox_master_q24);
+    mix32 = qmul(mix32, c->master_q24);
     return clamp24(mix32);
 }
 
 /* =============================== Public API ============================== */
-static inline void __not_in_flash_func(process_audio_vox_sample)(int32_t* inout_l, int32_t* inout_r, bool stereo){
-    *inout_l = process_vox_channel(*inout_l,
+static inline void __not_in_flash_func(process_audio_vox_sample)(int32_t* inout_l, int32_t* inout_r, bool stereo, const VoxCoefs* c){
+    *inout_l = process_vox_channel(c, *inout_l,
         &vox_pre_hpf_state_l, &vox_cpl1_state_l, &vox_bright_state_l, &vox_cpl2_state_l,
         &vox_bass_state_l, &vox_mid_lp_state_l, &vox_mid_hp_state_l, &vox_treble_state_l,
         &vox_post_lpf_state_l,
@@ -257,7 +281,7 @@ static inline void __not_in_flash_func(process_audio_vox_sample)(int32_t* inout_
     if(!stereo){
         *inout_r = *inout_l;
     } else {
-        *inout_r = process_vox_channel(*inout_r,
+        *inout_r = process_vox_channel(c, *inout_r,
             &vox_pre_hpf_state_r, &vox_cpl1_state_r, &vox_bright_state_r, &vox_cpl2_state_r,
             &vox_bass_state_r, &vox_mid_lp_state_r, &vox_mid_hp_state_r, &vox_treble_state_r,
             &vox_post_lpf_state_r,
@@ -266,38 +290,54 @@ static inline void __not_in_flash_func(process_audio_vox_sample)(int32_t* inout_
 }
 
 static inline void __not_in_flash_func(vox_preamp_process_block)(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo){
+    const VoxCoefs* c = coef_live(&vox_bank);
     for (size_t i=0;i<frames;i++){
-        process_audio_vox_sample(&in_l[i], &in_r[i], stereo);
+        process_audio_vox_sample(&in_l[i], &in_r[i], stereo, c);
     }
 }
 
+/* --- State reset */
+static inline void reset_vox_state(void) {
+    vox_pre_hpf_state_l=vox_pre_hpf_state_r=0;
+    vox_cpl1_state_l=vox_cpl1_state_r=0; vox_bright_state_l=vox_bright_state_r=0;
+    vox_cpl2_state_l=vox_cpl2_state_r=0;
+    vox_bass_state_l=vox_bass_state_r=0;
+    vox_mid_lp_state_l=vox_mid_lp_state_r=0; vox_mid_hp_state_l=vox_mid_hp_state_r=0;
+    vox_treble_state_l=vox_treble_state_r=0;
+    vox_post_lpf_state_l=vox_post_lpf_state_r=0;
+    vox_envB_state_l=vox_envB_state_r=0;
+    vox_envB_decim_l=vox_envB_decim_r=0;
+}
+
 /* =============================== Param load ============================== */
 static inline void load_vox_params_from_memory(void){
-    vox_input_pad_q24  = db_to_q24(VOX_INPUT_PAD_DB);
-    vox_pre_hpf_a_q24  = alpha_from_hz(VOX_VOICE.pre_hpf_Hz);
-    vox_cpl1_a_q24     = alpha_from_hz(VOX_VOICE.cpl1_hz);
-    vox_cpl2_a_q24     = alpha_from_hz(VOX_VOICE.cpl2_hz);
-    vox_bass_a_q24     = alpha_from_hz(VOX_VOICE.bass_hz);
-    vox_mid_a_q24      = alpha_from_hz(VOX_VOICE.mid_hz);
-    vox_treble_a_q24   = alpha_from_hz(VOX_VOICE.treble_hz);
+    VoxCoefs* c = coef_edit(&vox_bank);
+
+    c->input_pad_q24  = db_to_q24(VOX_INPUT_PAD_DB);
+    c->pre_hpf_a_q24  = alpha_from_hz(VOX_VOICE.pre_hpf_Hz);
+    c->cpl1_a_q24     = alpha_from_hz(VOX_VOICE.cpl1_hz);
+    c->cpl2_a_q24     = alpha_from_hz(VOX_VOICE.cpl2_hz);
+    c->bass_a_q24     = alpha_from_hz(VOX_VOICE.bass_hz);
+    c->mid_a_q24      = alpha_from_hz(VOX_VOICE.mid_hz);
+    c->treble_a_q24   = alpha_from_hz(VOX_VOICE.treble_hz);
 #if !VOX_ECO
-    vox_post_lpf_a_q24 = alpha_from_hz(VOX_VOICE.post_lpf_Hz);
+    c->post_lpf_a_q24 = alpha_from_hz(VOX_VOICE.post_lpf_Hz);
 #else
-    vox_post_lpf_a_q24 = 0;
+    c->post_lpf_a_q24 = 0;
 #endif
 
-    vox_envB_a_q24     = alpha_from_hz(VOX_ENVB_HZ);
+    c->envB_a_q24     = alpha_from_hz(VOX_ENVB_HZ);
 
-    vox_stageA_gain_q24 = db_to_q24(VOX_STAGEA_GAIN);
-    vox_stageB_gain_q24 = db_to_q24(VOX_STAGEB_GAIN);
-    vox_stack_makeup_q24= db_to_q24(VOX_STACK_MAKEUP_DB);
+    c->stageA_gain_q24 = db_to_q24(VOX_STAGEA_GAIN);
+    c->stageB_gain_q24 = db_to_q24(VOX_STAGEB_GAIN);
+    c->stack_makeup_q24= db_to_q24(VOX_STACK_MAKEUP_DB);
 
-    vox_stageA_k3_q24 = float_to_q24(VOX_K3A);
-    vox_stageA_k5_q24 = float_to_q24(VOX_K5A);
-    vox_stageB_k3_q24 = float_to_q24(VOX_K3B);
-    vox_stageB_k5_q24 = float_to_q24(VOX_K5B);
+    c->stageA_k3_q24 = float_to_q24(VOX_K3A);
+    c->stageA_k5_q24 = float_to_q24(VOX_K5A);
+    c->stageB_k3_q24 = float_to_q24(VOX_K3B);
+    c->stageB_k5_q24 = float_to_q24(VOX_K5B);
 
-    vox_cf_amount_q24 = float_to_q24(0.16f + 0.10f * (VOX_VOICE.stageB_asym - 1.2f));
+    c->cf_amount_q24 = float_to_q24(0.16f + 0.10f * (VOX_VOICE.stageB_asym - 1.2f));
 
     int32_t pot;
     pot = storedPreampPotValue[VOX_AC][0];
@@ -305,56 +345,48 @@ static inline void load_vox_params_from_memory(void){
     float t = powf(p, VOX_PREVOL_TAPER);
     float prevol_db = VOX_PREVOL_MIN_DB + (0.0f - VOX_PREVOL_MIN_DB) * t;
     prevol_db += VOX_PREVOL_TOP_BOOST_DB * powf(p, 6.0f);
-    vox_prevol_q24 = db_to_q24(prevol_db);
+    c->prevol_q24 = db_to_q24(prevol_db);
 
     int32_t prevol01 = float_to_q24(powf(p, VOX_PREVOL_TAPER));
     int32_t inv01    = 0x01000000 - prevol01;
-    vox_bright_mix_q24 = qmul(inv01, db_to_q24(VOX_BRIGHT_MAX_DB) - 0x01000000);
-    vox_bright_a_q24   = alpha_from_hz(VOX_VOICE.bright_hz_min +
+    c->bright_mix_q24 = qmul(inv01, db_to_q24(VOX_BRIGHT_MAX_DB) - 0x01000000);
+    c->bright_a_q24   = alpha_from_hz(VOX_VOICE.bright_hz_min +
                                        (VOX_VOICE.bright_hz_max - VOX_VOICE.bright_hz_min) * (1.0f - p));
 
     pot = storedPreampPotValue[VOX_AC][1];
-    vox_bass_gain_q24   = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
+    c->bass_gain_q24   = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
     pot = storedPreampPotValue[VOX_AC][2];
-    vox_mid_gain_q24    = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+12.0f));
+    c->mid_gain_q24    = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+12.0f));
     pot = storedPreampPotValue[VOX_AC][3];
-    vox_treble_gain_q24 = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
+    c->treble_gain_q24 = map_pot_to_q24(pot, db_to_q24(-12.0f), db_to_q24(+6.0f));
 
     pot = storedPreampPotValue[VOX_AC][4];
 #if VOX_USE_CUT
-    vox_cut_gain_q24  = map_pot_to_q24(pot, db_to_q24(-10.0f), db_to_q24(0.0f));
-    vox_cut_delta_q24 = 0x01000000 - vox_cut_gain_q24;
+    c->cut_gain_q24  = map_pot_to_q24(pot, db_to_q24(-10.0f), db_to_q24(0.0f));
+    c->cut_delta_q24 = 0x01000000 - c->cut_gain_q24;
 #else
-    vox_presence_gain_q24  = map_pot_to_q24(pot, db_to_q24(0.0f), db_to_q24(+8.0f));
-    vox_presence_delta_q24 = vox_presence_gain_q24 - 0x01000000;
+    c->presence_gain_q24  = map_pot_to_q24(pot, db_to_q24(0.0f), db_to_q24(+8.0f));
+    c->presence_delta_q24 = c->presence_gain_q24 - 0x01000000;
 #endif
 
     pot = storedPreampPotValue[VOX_AC][5];
-    vox_master_q24 = map_pot_to_q24(pot, db_to_q24(-3.0f), db_to_q24(+22.0f));
-
-    vox_pre_hpf_state_l=vox_pre_hpf_state_r=0;
-    vox_cpl1_state_l=vox_cpl1_state_r=0; vox_bright_state_l=vox_bright_state_r=0;
-    vox_cpl2_state_l=vox_cpl2_state_r=0;
-    vox_bass_state_l=vox_bass_state_r=0;
-    vox_mid_lp_state_l=vox_mid_lp_state_r=0; vox_mid_hp_state_l=vox_mid_hp_state_r=0;
-    vox_treble_state_l=vox_treble_state_r=0;
-    vox_post_lpf_state_l=vox_post_lpf_state_r=0;
-    vox_envB_state_l=vox_envB_state_r=0;
-    vox_envB_decim_l=vox_envB_decim_r=0;
+    c->master_q24 = map_pot_to_q24(pot, db_to_q24(-3.0f), db_to_q24(+22.0f));
 
     /* --- Cached constants --- */
-    vox_ws_x5_on_q24   = float_to_q24(VOX_WS_X5_ON);
-    vox_cf_recover_q24 = float_to_q24(0.98f);
+    c->ws_x5_on_q24   = float_to_q24(VOX_WS_X5_ON);
+    c->cf_recover_q24 = float_to_q24(0.98f);
+
+    c->k3A_neg_base_q24 = qmul(c->stageA_k3_q24, float_to_q24(VOX_ASYM_A_BASE));
+    c->k5A_neg_base_q24 = qmul(c->stageA_k5_q24, float_to_q24(VOX_ASYM_A_BASE));
 
-    vox_k3A_neg_base_q24 = qmul(vox_stageA_k3_q24, float_to_q24(VOX_ASYM_A_BASE));
-    vox_k5A_neg_base_q24 = qmul(vox_stageA_k5_q24, float_to_q24(VOX_ASYM_A_BASE));
+    c->k3B_neg_base_q24  = qmul(c->stageB_k3_q24, float_to_q24(VOX_ASYM_B_BASE));
+    c->k3B_neg_depth_q24 = qmul(c->stageB_k3_q24, float_to_q24(VOX_ASYM_B_DEPTH));
+    c->k5B_neg_base_q24  = qmul(c->stageB_k5_q24, float_to_q24(VOX_ASYM_B_BASE));
+    c->k5B_neg_depth_q24 = qmul(c->stageB_k5_q24, float_to_q24(VOX_ASYM_B_DEPTH));
 
-    vox_k3B_neg_base_q24  = qmul(vox_stageB_k3_q24, float_to_q24(VOX_ASYM_B_BASE));
-    vox_k3B_neg_depth_q24 = qmul(vox_stageB_k3_q24, float_to_q24(VOX_ASYM_B_DEPTH));
-    vox_k5B_neg_base_q24  = qmul(vox_stageB_k5_q24, float_to_q24(VOX_ASYM_B_BASE));
-    vox_k5B_neg_depth_q24 = qmul(vox_stageB_k5_q24, float_to_q24(VOX_ASYM_B_DEPTH));
+    c->bright_mix_prevol_q24 = qmul(c->bright_mix_q24, c->prevol_q24);
 
-    vox_bright_mix_prevol_q24 = qmul(vox_bright_mix_q24, vox_prevol_q24);
+    coef_commit(&vox_bank);
 }
 
 #endif // VOX_PREAMP_H
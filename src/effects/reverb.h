@@ -24,13 +24,11 @@
 #include <string.h>
 
 // === Reverb parameters (Q8.24) ===
-static int32_t reverb_comb_feedback_q24    = 0x00A00000; // for comb filters (~0.625)
-static int32_t reverb_allpass_feedback_q24 = 0x00500000; // for all-pass (~0.3125)
-static int32_t reverb_mix_q24              = 0x00800000; // 0.5
-static int32_t reverb_damping_q24          = 0x00800000; // ~0.5
-static int32_t reverb_output_gain_q24 = Q24_ONE;
+static int32_t reverb_mix_q24         = 0x00800000; // 0.5
 static int32_t reverb_wet_gain_q24    = Q24_ONE;
 static int32_t reverb_dry_gain_q24    = Q24_ONE;
+static ParamRamp reverb_mix_ramp      = { 0x00800000, 0, 0x00800000 }; // mix target, set per block by the modulation
+static bool      reverb_wet_only      = false;   // Dry share mixed by the caller (latency split)
 
 // === Comb delays (base sizes) ===
 #define COMB1_SIZE_L 1597
@@ -50,216 +48,219 @@ static int32_t reverb_dry_gain_q24    = Q24_ONE;
 #define AP2_SIZE 701
 #define AP3_SIZE 499
 
-// === Comb buffers and states ===
-static int32_t comb_buf1_l[COMB1_SIZE_L] = {0};
-static int32_t comb_buf2_l[COMB2_SIZE_L] = {0};
-static int32_t comb_buf3_l[COMB3_SIZE_L] = {0};
-static int32_t comb_buf4_l[COMB4_SIZE_L] = {0};
-static int32_t comb_buf5_l[COMB5_SIZE_L] = {0};
-static int32_t comb_buf1_r[COMB1_SIZE_R] = {0};
-static int32_t comb_buf2_r[COMB2_SIZE_R] = {0};
-static int32_t comb_buf3_r[COMB3_SIZE_R] = {0};
-static int32_t comb_buf4_r[COMB4_SIZE_R] = {0};
-static int32_t comb_buf5_r[COMB5_SIZE_R] = {0};
-
-static uint32_t comb_idx_l[5] = {0};
-static uint32_t comb_idx_r[5] = {0};
-static int32_t comb_damp_state_l[5] = {0};
-static int32_t comb_damp_state_r[5] = {0};
-
-// Virtual sizes (adjustable room size)
-static uint32_t comb_size_l_virtual[5] = {
-    COMB1_SIZE_L, COMB2_SIZE_L, COMB3_SIZE_L, COMB4_SIZE_L, COMB5_SIZE_L
+// === Delay lines ===
+//
+// Each channel's combs share one power-of-two ring, every all-pass has a
+// power-of-two ring of its own. All lines rotate with one write index that
+// counts stereo samples:
+//
+//   comb    write ring[(w + base) & mask], read ring[(w + base - delay) & mask]
+//   ap      write ring[w & mask],          read ring[(w - delay) & mask]
+//
+// so the per-line index, its increment and its wrap branch are gone, and
+// both channels run in the same loop iteration. A comb slice takes its
+// longest length + 1 words, the room size only moves the read offset.
+//
+// The wet path plays DEFER_LATENCY_FRAMES late (deferred.h), so each comb
+// has a second read, its output tap, that much closer to the write index
+// than the loop read: the tail starts where the room size puts it and the
+// comb loops keep their lengths.
+// The comb rings fill a bank each, both all-pass halves sit in BANK2
+// (mem_layout.h).
+
+#define REVERB_COMBS        5
+#define REVERB_APS          3
+#define REVERB_MIN_SIZE     100                 // Shortest comb at the smallest room
+
+#define REVERB_COMB_RING    8192                // Words per channel (>= sum of comb slices)
+#define REVERB_COMB_MASK    (REVERB_COMB_RING - 1)
+#define REVERB_AP1_RING     1024                // Words per line and channel (> line length)
+#define REVERB_AP2_RING     1024
+#define REVERB_AP3_RING     512
+#define REVERB_AP_WORDS     (REVERB_AP1_RING + REVERB_AP2_RING + REVERB_AP3_RING)
+
+_Static_assert(COMB1_SIZE_L + COMB2_SIZE_L + COMB3_SIZE_L + COMB4_SIZE_L + COMB5_SIZE_L + REVERB_COMBS
+               <= REVERB_COMB_RING, "reverb combs L exceed the comb ring");
+_Static_assert(COMB1_SIZE_R + COMB2_SIZE_R + COMB3_SIZE_R + COMB4_SIZE_R + COMB5_SIZE_R + REVERB_COMBS
+               <= REVERB_COMB_RING, "reverb combs R exceed the comb ring");
+_Static_assert(AP1_SIZE < REVERB_AP1_RING && AP2_SIZE < REVERB_AP2_RING && AP3_SIZE < REVERB_AP3_RING,
+               "reverb all-pass longer than its ring");
+_Static_assert((REVERB_AP1_RING & (REVERB_AP1_RING - 1)) == 0 && (REVERB_AP2_RING & (REVERB_AP2_RING - 1)) == 0
+               && (REVERB_AP3_RING & (REVERB_AP3_RING - 1)) == 0, "reverb all-pass rings must be powers of two");
+
+static PLACE_REVERB_L    int32_t reverb_comb_l[REVERB_COMB_RING];
+static PLACE_REVERB_R    int32_t reverb_comb_r[REVERB_COMB_RING];
+static PLACE_REVERB_AP_L int32_t reverb_ap_l[REVERB_AP_WORDS];
+static PLACE_REVERB_AP_R int32_t reverb_ap_r[REVERB_AP_WORDS];
+
+// Longest lengths, [channel][line]
+static const uint32_t reverb_comb_size[2][REVERB_COMBS] = {
+    { COMB1_SIZE_L, COMB2_SIZE_L, COMB3_SIZE_L, COMB4_SIZE_L, COMB5_SIZE_L },
+    { COMB1_SIZE_R, COMB2_SIZE_R, COMB3_SIZE_R, COMB4_SIZE_R, COMB5_SIZE_R },
 };
-static uint32_t comb_size_r_virtual[5] = {
-    COMB1_SIZE_R, COMB2_SIZE_R, COMB3_SIZE_R, COMB4_SIZE_R, COMB5_SIZE_R
-};
-
-// === All-pass buffers and states ===
-static int32_t ap_buf1_l[AP1_SIZE] = {0};
-static int32_t ap_buf2_l[AP2_SIZE] = {0};
-static int32_t ap_buf3_l[AP3_SIZE] = {0};
-static int32_t ap_buf1_r[AP1_SIZE] = {0};
-static int32_t ap_buf2_r[AP2_SIZE] = {0};
-static int32_t ap_buf3_r[AP3_SIZE] = {0};
-
-static uint32_t ap_idx_l[3] = {0};
-static uint32_t ap_idx_r[3] = {0};
-
-// Reusable pointer tables (no per-sample stack work)
-static int32_t* comb_bufs_l_p[5] = { comb_buf1_l, comb_buf2_l, comb_buf3_l, comb_buf4_l, comb_buf5_l };
-static int32_t* comb_bufs_r_p[5] = { comb_buf1_r, comb_buf2_r, comb_buf3_r, comb_buf4_r, comb_buf5_r };
-
-static int32_t* ap_bufs_l_p[3] = { ap_buf1_l, ap_buf2_l, ap_buf3_l };
-static int32_t* ap_bufs_r_p[3] = { ap_buf1_r, ap_buf2_r, ap_buf3_r };
+static const uint32_t reverb_ap_size[REVERB_APS] = { AP1_SIZE, AP2_SIZE, AP3_SIZE };
+
+// All-pass rings inside reverb_ap_l / _r
+static const uint32_t reverb_ap_start[REVERB_APS] = { 0, REVERB_AP1_RING, REVERB_AP1_RING + REVERB_AP2_RING };
+static const uint32_t reverb_ap_mask[REVERB_APS]  = { REVERB_AP1_RING - 1, REVERB_AP2_RING - 1, REVERB_AP3_RING - 1 };
+
+// Gains and line offsets, [channel][line] (coefficient bank, SoA)
+typedef struct {
+    int32_t  comb_feedback_q24;                 // Comb filters
+    int32_t  allpass_feedback_q24;
+    int32_t  damping_q24;
+    int32_t  output_gain_q24;
+    uint32_t comb_wr[2][REVERB_COMBS];          // Slice base
+    uint32_t comb_rd[2][REVERB_COMBS];          // Slice base - delay (room size)
+    uint32_t comb_out[2][REVERB_COMBS];         // comb_rd + latency lead, the output tap
+    uint32_t ap_rd[REVERB_APS];                 // -delay, same in both channels
+} ReverbCoefs;
+
+#define REVERB_COEFS_DEFAULT { 0x00A00000, 0x00500000, 0x00800000, Q24_ONE }  // ~0.625 / ~0.3125 / ~0.5
+static ReverbCoefs reverb_coefs[2] = { REVERB_COEFS_DEFAULT, REVERB_COEFS_DEFAULT };
+static CoefBank    reverb_bank     = COEF_BANK(reverb_coefs);
+
+// Line states
+typedef struct {
+    uint32_t w;                                 // Shared write index, +1 per stereo sample
+    int32_t  comb_damp[2][REVERB_COMBS];
+} ReverbLines;
+
+static ReverbLines reverb_lines;
+
+// Slices and delays; the combs at room_scale (1.0 = longest)
+static inline void reverb_set_room(ReverbCoefs* rc, float room_scale) {
+    for (int c = 0; c < 2; c++) {
+        uint32_t base = 0;
+        for (int k = 0; k < REVERB_COMBS; k++) {
+            uint32_t size = reverb_comb_size[c][k];
+            uint32_t len  = (uint32_t)(size * room_scale);
+            if (len < REVERB_MIN_SIZE) len = REVERB_MIN_SIZE;
+            if (len > size)            len = size;
+
+            // Slice (base - size - 1, base]: reads reach back size words at most
+            base += size + 1;
+            rc->comb_wr[c][k] = base;
+            rc->comb_rd[c][k] = base - len;
+
+            // Output tap: at least one sample behind the write
+            uint32_t lead = DEFER_LATENCY_FRAMES < len ? DEFER_LATENCY_FRAMES : len - 1;
+            rc->comb_out[c][k] = base - len + lead;
+        }
+    }
 
-static uint32_t ap_sizes_p[3] = { AP1_SIZE, AP2_SIZE, AP3_SIZE };
+    for (int k = 0; k < REVERB_APS; k++) {
+        rc->ap_rd[k] = 0u - reverb_ap_size[k];
+    }
+}
 
 // === Comb filter with damping ===
-static inline int32_t process_comb_damped(int32_t in, int32_t *buf, uint32_t size, uint32_t *idx, int32_t *damp_state) {
-    int32_t delayed = buf[*idx];
+static inline __attribute__((always_inline))
+int32_t process_comb_damped(const ReverbCoefs* rc, int32_t in, int32_t* ring, uint32_t wr, uint32_t rd, uint32_t out, int32_t* damp_state) {
+    int32_t delayed = ring[rd & REVERB_COMB_MASK];
 
-    *damp_state += ((int64_t)(delayed - *damp_state) * reverb_damping_q24) >> 24;
+    *damp_state += ((int64_t)(delayed - *damp_state) * rc->damping_q24) >> 24;
     int32_t damped = *damp_state;
 
-    int64_t fb = ((int64_t)damped * reverb_comb_feedback_q24) >> 24;
-    int64_t sum = (int64_t)in + fb;
-
-    buf[*idx] = (int32_t)sum;
+    int64_t fb = ((int64_t)damped * rc->comb_feedback_q24) >> 24;
+    ring[wr & REVERB_COMB_MASK] = (int32_t)((int64_t)in + fb);
 
-    (*idx)++;
-    if (*idx >= size) *idx = 0;
-
-    return delayed;
+    return DEFER_LATENCY_FRAMES ? ring[out & REVERB_COMB_MASK] : delayed;
 }
 
 // === All-pass filter ===
-static inline int32_t process_reverb_allpass(int32_t in, int32_t *buf, uint32_t size, uint32_t *idx) {
-    int32_t buf_out = buf[*idx];
-
-    buf[*idx] = in + (int32_t)(((int64_t)buf_out * reverb_allpass_feedback_q24) >> 24);
+static inline __attribute__((always_inline))
+int32_t process_reverb_allpass(int32_t in, int32_t* ring, uint32_t mask, uint32_t wr, uint32_t rd, int32_t fb_q24) {
+    int32_t buf_out = ring[rd & mask];
 
-    int32_t out = buf_out - (int32_t)(((int64_t)buf[*idx] * reverb_allpass_feedback_q24) >> 24);
+    int32_t buf_in = in + (int32_t)(((int64_t)buf_out * fb_q24) >> 24);
+    ring[wr & mask] = buf_in;
 
-    (*idx)++;
-    if (*idx >= size) *idx = 0;
-
-    return out;
+    return buf_out - (int32_t)(((int64_t)buf_in * fb_q24) >> 24);
 }
 
-// === Process one channel ===
-static inline int32_t process_reverb(int32_t in,
-                                     int32_t *comb_bufs[5], uint32_t comb_sizes[5], uint32_t comb_idxs[5], int32_t damp_states[5],
-                                     int32_t *ap_bufs[3], uint32_t ap_sizes[3], uint32_t ap_idxs[3]) {
-    int32_t comb_input = in >> 4;  // Reduce input energy
-    int32_t comb_sum = 0;
-    for (int i = 0; i < 5; i++) {
-        comb_sum += process_comb_damped(comb_input, comb_bufs[i], comb_sizes[i], &comb_idxs[i], &damp_states[i]);
-    }
-    comb_sum >>= 2;
-
-    int32_t ap_out = process_reverb_allpass(comb_sum, ap_bufs[0], ap_sizes[0], &ap_idxs[0]);
-    ap_out = process_reverb_allpass(ap_out, ap_bufs[1], ap_sizes[1], &ap_idxs[1]);
-    ap_out = process_reverb_allpass(ap_out, ap_bufs[2], ap_sizes[2], &ap_idxs[2]);
-    
-    //int32_t ap_out = comb_sum;
-
+// === Dry / wet mix of one channel ===
+static inline __attribute__((always_inline)) int32_t reverb_mix(int32_t in, int32_t ap_out, int32_t out_gain_q24) {
     int64_t wet = ((int64_t)ap_out * reverb_wet_gain_q24) >> 24;
     int64_t dry = ((int64_t)in * reverb_dry_gain_q24) >> 24;
 
-    int64_t mix = (int64_t)(dry + wet) * reverb_output_gain_q24;
-    int32_t out = clamp24((int32_t)(mix >> 24));
-
-    return out;
+    int64_t mix = (int64_t)(dry + wet) * out_gain_q24;
+    return clamp24((int32_t)(mix >> 24));
 }
 
-// === Stereo wrapper ===
-static inline void process_audio_reverb_sample(int32_t *inout_l, int32_t *inout_r) {
-    *inout_l = process_reverb(*inout_l, comb_bufs_l_p, comb_size_l_virtual, comb_idx_l, comb_damp_state_l,
-                              ap_bufs_l_p, ap_sizes_p, ap_idx_l);
-    *inout_r = process_reverb(*inout_r, comb_bufs_r_p, comb_size_r_virtual, comb_idx_r, comb_damp_state_r,
-                              ap_bufs_r_p, ap_sizes_p, ap_idx_r);
+// === One stereo sample, both channels per line ===
+static inline __attribute__((always_inline)) void process_audio_reverb_sample(int32_t* inout_l, int32_t* inout_r, uint32_t w, const ReverbCoefs* rc) {
+    ReverbLines* rv = &reverb_lines;
+
+    int32_t comb_in_l = *inout_l >> 4;          // Reduce input energy
+    int32_t comb_in_r = *inout_r >> 4;
+    int32_t sum_l = 0;
+    int32_t sum_r = 0;
+    for (int k = 0; k < REVERB_COMBS; k++) {
+        sum_l += process_comb_damped(rc, comb_in_l, reverb_comb_l, w + rc->comb_wr[0][k], w + rc->comb_rd[0][k],
+                                     w + rc->comb_out[0][k], &rv->comb_damp[0][k]);
+        sum_r += process_comb_damped(rc, comb_in_r, reverb_comb_r, w + rc->comb_wr[1][k], w + rc->comb_rd[1][k],
+                                     w + rc->comb_out[1][k], &rv->comb_damp[1][k]);
+    }
+    int32_t ap_l = sum_l >> 2;
+    int32_t ap_r = sum_r >> 2;
+
+    for (int k = 0; k < REVERB_APS; k++) {
+        const uint32_t rd = w + rc->ap_rd[k];
+        ap_l = process_reverb_allpass(ap_l, reverb_ap_l + reverb_ap_start[k], reverb_ap_mask[k], w, rd, rc->allpass_feedback_q24);
+        ap_r = process_reverb_allpass(ap_r, reverb_ap_r + reverb_ap_start[k], reverb_ap_mask[k], w, rd, rc->allpass_feedback_q24);
+    }
+
+    *inout_l = reverb_mix(*inout_l, ap_l, rc->output_gain_q24);
+    *inout_r = reverb_mix(*inout_r, ap_r, rc->output_gain_q24);
 }
 
 static inline void clear_reverb_memory(void) {
-    // Clear comb buffers
-    memset(comb_buf1_l, 0, sizeof(comb_buf1_l));
-    memset(comb_buf2_l, 0, sizeof(comb_buf2_l));
-    memset(comb_buf3_l, 0, sizeof(comb_buf3_l));
-    memset(comb_buf4_l, 0, sizeof(comb_buf4_l));
-    memset(comb_buf5_l, 0, sizeof(comb_buf5_l));
-    memset(comb_buf1_r, 0, sizeof(comb_buf1_r));
-    memset(comb_buf2_r, 0, sizeof(comb_buf2_r));
-    memset(comb_buf3_r, 0, sizeof(comb_buf3_r));
-    memset(comb_buf4_r, 0, sizeof(comb_buf4_r));
-    memset(comb_buf5_r, 0, sizeof(comb_buf5_r));
-
-    // Clear all-pass buffers
-    memset(ap_buf1_l, 0, sizeof(ap_buf1_l));
-    memset(ap_buf2_l, 0, sizeof(ap_buf2_l));
-    memset(ap_buf3_l, 0, sizeof(ap_buf3_l));
-    memset(ap_buf1_r, 0, sizeof(ap_buf1_r));
-    memset(ap_buf2_r, 0, sizeof(ap_buf2_r));
-    memset(ap_buf3_r, 0, sizeof(ap_buf3_r));
-
-    // Clear damping states
-    memset(comb_damp_state_l, 0, sizeof(comb_damp_state_l));
-    memset(comb_damp_state_r, 0, sizeof(comb_damp_state_r));
-
-    for (int i = 0; i < 5; i++) {
-        comb_idx_l[i] = comb_idx_r[i] = 0;
-    }
-    for (int i = 0; i < 3; i++) {
-        ap_idx_l[i] = ap_idx_r[i] = 0;
-    }
+    memset(reverb_comb_l, 0, sizeof(reverb_comb_l));
+    memset(reverb_comb_r, 0, sizeof(reverb_comb_r));
+    memset(reverb_ap_l, 0, sizeof(reverb_ap_l));
+    memset(reverb_ap_r, 0, sizeof(reverb_ap_r));
+    memset(reverb_lines.comb_damp, 0, sizeof(reverb_lines.comb_damp));
+    reverb_lines.w = 0;
 }
 
 // === Init ===
 static inline void reverb_init(void) {
     clear_reverb_memory();
+    reverb_set_room(coef_edit(&reverb_bank), 1.0f);
+    coef_commit(&reverb_bank);
 }
 
 // === Load parameters ===
 static inline void load_reverb_parms_from_memory(void) {
+    ReverbCoefs* c = coef_edit(&reverb_bank);
     int32_t pot;
 
-    // Mix: 0 to 1
-    pot = storedPotValue[REVB_EFFECT_INDEX][0];
-    reverb_mix_q24 = map_pot_to_q24(pot, 0x00000000, Q24_ONE);
+    // Mix (pot 0) is picked up per block by the modulation and ramped in reverb_process_block
 
     // Decay (feedback): 0.80 to 0.95
     pot = storedPotValue[REVB_EFFECT_INDEX][1];
-    reverb_comb_feedback_q24 = map_pot_to_q24(pot, float_to_q24(0.80f), float_to_q24(0.96f));
+    c->comb_feedback_q24 = map_pot_to_q24(pot, float_to_q24(0.80f), float_to_q24(0.96f));
 
     // All-pass feedback (diffusion): 0.25 to 0.80
     pot = storedPotValue[REVB_EFFECT_INDEX][2];
-    reverb_allpass_feedback_q24 = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(0.80));
+    c->allpass_feedback_q24 = map_pot_to_q24(pot, float_to_q24(0.25f), float_to_q24(0.80));
 
     // Damping: 0.20 tp 0.90
     pot = storedPotValue[REVB_EFFECT_INDEX][3];
-    reverb_damping_q24 = map_pot_to_q24(pot, float_to_q24(0.20f), float_to_q24(0.90f));
+    c->damping_q24 = map_pot_to_q24(pot, float_to_q24(0.20f), float_to_q24(0.90f));
 
     // Room size scaling: 0.8 to 1.02 (clamp)
     pot = storedPotValue[REVB_EFFECT_INDEX][4];
     float room_scale = 0.52f + ((float)pot / POT_MAX) * 0.5f;  // 0.5 to 1.0
 
-    // Update comb virtual lengths
-    comb_size_l_virtual[0] = (uint32_t)(COMB1_SIZE_L * room_scale);
-    comb_size_l_virtual[1] = (uint32_t)(COMB2_SIZE_L * room_scale);
-    comb_size_l_virtual[2] = (uint32_t)(COMB3_SIZE_L * room_scale);
-    comb_size_l_virtual[3] = (uint32_t)(COMB4_SIZE_L * room_scale);
-    comb_size_l_virtual[4] = (uint32_t)(COMB5_SIZE_L * room_scale);
-
-    comb_size_r_virtual[0] = (uint32_t)(COMB1_SIZE_R * room_scale);
-    comb_size_r_virtual[1] = (uint32_t)(COMB2_SIZE_R * room_scale);
-    comb_size_r_virtual[2] = (uint32_t)(COMB3_SIZE_R * room_scale);
-    comb_size_r_virtual[3] = (uint32_t)(COMB4_SIZE_R * room_scale);
-    comb_size_r_virtual[4] = (uint32_t)(COMB5_SIZE_R * room_scale);
-
-    // Clamp low
-    for (int i = 0; i < 5; i++) {
-        if (comb_size_l_virtual[i] < 100) comb_size_l_virtual[i] = 100;
-        if (comb_size_r_virtual[i] < 100) comb_size_r_virtual[i] = 100;
-    }
-
-    // Clamp high - individual limits
-    if (comb_size_l_virtual[0] > COMB1_SIZE_L) comb_size_l_virtual[0] = COMB1_SIZE_L;
-    if (comb_size_r_virtual[0] > COMB1_SIZE_R) comb_size_r_virtual[0] = COMB1_SIZE_R;
-    if (comb_size_l_virtual[1] > COMB2_SIZE_L) comb_size_l_virtual[1] = COMB2_SIZE_L;
-    if (comb_size_r_virtual[1] > COMB2_SIZE_R) comb_size_r_virtual[1] = COMB2_SIZE_R;
-    if (comb_size_l_virtual[2] > COMB3_SIZE_L) comb_size_l_virtual[2] = COMB3_SIZE_L;
-    if (comb_size_r_virtual[2] > COMB3_SIZE_R) comb_size_r_virtual[2] = COMB3_SIZE_R;    
-    if (comb_size_l_virtual[3] > COMB4_SIZE_L) comb_size_l_virtual[3] = COMB4_SIZE_L;
-    if (comb_size_r_virtual[3] > COMB4_SIZE_R) comb_size_r_virtual[3] = COMB4_SIZE_R;
-    if (comb_size_l_virtual[4] > COMB5_SIZE_L) comb_size_l_virtual[4] = COMB5_SIZE_L;
-    if (comb_size_r_virtual[4] > COMB5_SIZE_R) comb_size_r_virtual[4] = COMB5_SIZE_R;
+    reverb_set_room(c, room_scale);
 
     // Output gain: 0.1 to 4.0
     pot = storedPotValue[REVB_EFFECT_INDEX][5];
-    reverb_output_gain_q24 = map_pot_to_q24(pot, float_to_q24(0.1f), float_to_q24(4.0f));
+    c->output_gain_q24 = map_pot_to_q24(pot, float_to_q24(0.1f), float_to_q24(4.0f));
 
-    reverb_wet_gain_q24 = (int32_t)(((int64_t)Q24_ONE * reverb_mix_q24) >> 24) << 2; // Wet gain is boosted
-    reverb_dry_gain_q24 = Q24_ONE - reverb_mix_q24;
+    coef_commit(&reverb_bank);
 }
 
 static inline void update_reverb_params_from_pots(int changed_pot) {
@@ -268,10 +269,21 @@ static inline void update_reverb_params_from_pots(int changed_pot) {
     load_reverb_parms_from_memory();
 }
 
-void reverb_process_block(int32_t* in_l, int32_t* in_r, size_t frames) {
+// Mix ticked from the given ramp (the deferred lane brings its own)
+static inline void reverb_process_block_mix(int32_t* in_l, int32_t* in_r, size_t frames, ParamRamp* mix) {
+    const ReverbCoefs* c = coef_live(&reverb_bank);
+    uint32_t w = reverb_lines.w;
     for (size_t i = 0; i < frames; i++) {
-        process_audio_reverb_sample(&in_l[i], &in_r[i]);
+        reverb_mix_q24      = ramp_tick(mix);
+        reverb_wet_gain_q24 = reverb_mix_q24 << 2;      // Wet gain is boosted
+        reverb_dry_gain_q24 = reverb_wet_only ? 0 : Q24_ONE - reverb_mix_q24;
+        process_audio_reverb_sample(&in_l[i], &in_r[i], w++, c);
     }
+    reverb_lines.w = w;
+}
+
+void reverb_process_block(int32_t* in_l, int32_t* in_r, size_t frames) {
+    reverb_process_block_mix(in_l, in_r, frames, &reverb_mix_ramp);
 }
 
 #endif // REVERB_H
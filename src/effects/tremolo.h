@@ -23,15 +23,23 @@
 
 // Tremolo effect processing function
 static uint32_t tremolo_phase_q16 = 0;     // Q16 phase accumulator
-static uint32_t tremolo_speed_q16 = 0;     // Q16 speed (LFO rate)
 static uint32_t tremolo_depth_q16 = 0;     // Q16 depth (0 = no tremolo, 65536 = full depth)
+static ParamRamp tremolo_depth_ramp = { 0, 0, 0 }; // depth target, set per block by the modulation
+
+// Parameters (coefficient bank)
+typedef struct {
+    uint32_t speed_q16;                    // Q16 speed (LFO rate)
+} TremoloCoefs;
+
+static TremoloCoefs tremolo_coefs[2];
+static CoefBank     tremolo_bank = COEF_BANK(tremolo_coefs);
 
 // LFOs (Q16)
 uint32_t lfo_l_q16 = 0;
 uint32_t lfo_r_q16 = 0;
 
 // ---- Tremolo: per-sample processing with mono/stereo LFO
-void process_audio_tremolo_sample(int32_t* inout_l, int32_t* inout_r, FXmode mode) {
+void process_audio_tremolo_sample(int32_t* inout_l, int32_t* inout_r, FXmode mode, uint32_t speed_q16) {
     // Derive phases
     uint32_t phase_l = tremolo_phase_q16;
     uint32_t phase_r = phase_l + (mode == FX_STEREO ? 0x80000000u : 0u); // 180° in stereo, same in mono
@@ -50,37 +58,36 @@ void process_audio_tremolo_sample(int32_t* inout_l, int32_t* inout_r, FXmode mod
     *inout_r = multiply_q16(*inout_r, amp_r_q16);
 
     // Advance once
-    tremolo_phase_q16 += tremolo_speed_q16;
+    tremolo_phase_q16 += speed_q16;
 }
 
 
 void load_tremolo_parms_from_memory(void) {
     // Speed (simple linear; keep your scaling)
+    TremoloCoefs* c = coef_edit(&tremolo_bank);
     uint16_t sp = storedPotValue[TREM_EFFECT_INDEX][0];
-    tremolo_speed_q16 = (sp < 20) ? (20u * 250u) : ((uint32_t)sp * 250u);
+    c->speed_q16 = (sp < 20) ? (20u * 250u) : ((uint32_t)sp * 250u);
+    coef_commit(&tremolo_bank);
 
-    // Depth 0..1
-    uint16_t dp = storedPotValue[TREM_EFFECT_INDEX][1];
-    tremolo_depth_q16 = (dp < 20) ? 20u : ((uint32_t)dp * Q16_ONE) / POT_MAX;
+    // Depth 0..1 (pot 1) is picked up per block by the modulation
 }
 
 void update_tremolo_params_from_pots(int changed_pot) {
     if (changed_pot < 0) return;
 
     if (changed_pot == 0) { // Speed
-        uint16_t v = pot_value[0];
-        tremolo_speed_q16 = (v < 20) ? (20u * 250u) : ((uint32_t)v * 250u);
-        storedPotValue[TREM_EFFECT_INDEX][0] = v;
-    } else if (changed_pot == 1) { // Depth
-        uint16_t v = pot_value[1];
-        tremolo_depth_q16 = (v < 20) ? 20u : ((uint32_t)v * Q16_ONE) / POT_MAX;
-        storedPotValue[TREM_EFFECT_INDEX][1] = v;
+        storedPotValue[TREM_EFFECT_INDEX][0] = pot_value[0];
+        load_tremolo_parms_from_memory();
+    } else if (changed_pot == 1) { // Depth (ramped in the block)
+        storedPotValue[TREM_EFFECT_INDEX][1] = pot_value[1];
     }
 }
 
 void tremolo_process_block(int32_t* in_l, int32_t* in_r, size_t frames, FXmode mode) {
+    const TremoloCoefs* c = coef_live(&tremolo_bank);
     for (size_t i = 0; i < frames; i++) {
-        process_audio_tremolo_sample(&in_l[i], &in_r[i], mode);
+        tremolo_depth_q16 = (uint32_t)ramp_tick(&tremolo_depth_ramp);
+        process_audio_tremolo_sample(&in_l[i], &in_r[i], mode, c->speed_q16);
     }
 
     // LED (only update when selected)
@@ -20,8 +20,14 @@
 #ifndef VIBRATO_H
 #define VIBRATO_H
 
-static uint32_t vibrato_depth_q16 = 0;
-static uint32_t vibrato_speed_q16 = 0;
+// Parameters (coefficient bank)
+typedef struct {
+    uint32_t depth_q16;
+    uint32_t speed_q16;
+} VibratoCoefs;
+
+static VibratoCoefs vibrato_coefs[2];
+static CoefBank     vibrato_bank = COEF_BANK(vibrato_coefs);
 
 static float vibrato_lfo_phase = 0.0f;
 
@@ -30,32 +36,24 @@ static inline void init_vibrato(void) {
 }
 
 static inline void load_vibrato_parms_from_memory(void) {
-    vibrato_depth_q16 = ((float)storedPotValue[VIBR_EFFECT_INDEX][0] / POT_MAX) * Q16_ONE;
-    vibrato_speed_q16 = ((float)storedPotValue[VIBR_EFFECT_INDEX][1] / POT_MAX) * Q16_ONE;
+    VibratoCoefs* c = coef_edit(&vibrato_bank);
+    c->depth_q16 = ((float)storedPotValue[VIBR_EFFECT_INDEX][0] / POT_MAX) * Q16_ONE;
+    c->speed_q16 = ((float)storedPotValue[VIBR_EFFECT_INDEX][1] / POT_MAX) * Q16_ONE;
+    coef_commit(&vibrato_bank);
 }
 
 static inline void update_vibrato_params_from_pots(int changed_pot) {
-    if (changed_pot < 0) return;
-
-    float norm = (float)pot_value[changed_pot] / POT_MAX;
-    if (norm < 0.0f) norm = 0.0f;
-    if (norm > 1.0f) norm = 1.0f;
-
-    if (changed_pot == 0) {
-        vibrato_depth_q16 = norm * Q16_ONE;
-        storedPotValue[VIBR_EFFECT_INDEX][0] = pot_value[0];
-    } else if (changed_pot == 1) {
-        vibrato_speed_q16 = norm * Q16_ONE;
-        storedPotValue[VIBR_EFFECT_INDEX][1] = pot_value[1];
-    }
+    if (changed_pot < 0 || changed_pot > 1) return;
+    storedPotValue[VIBR_EFFECT_INDEX][changed_pot] = pot_value[changed_pot];
+    load_vibrato_parms_from_memory();
 }
 
-static inline void process_audio_vibrato_sample(int32_t* inout_l, int32_t* inout_r, FXmode mode) {
+static inline void process_audio_vibrato_sample(int32_t* inout_l, int32_t* inout_r, FXmode mode, const VibratoCoefs* c) {
     float in_l = *inout_l / 8388608.0f;
     float in_r = *inout_r / 8388608.0f;
 
-    float depth = (float)vibrato_depth_q16 / Q16_ONE * 5.0f; // max ~5 ms modulation
-    float speed = (float)vibrato_speed_q16 / Q16_ONE * 5.0f; // max ~5 Hz
+    float depth = (float)c->depth_q16 / Q16_ONE * 5.0f; // max ~5 ms modulation
+    float speed = (float)c->speed_q16 / Q16_ONE * 5.0f; // max ~5 Hz
 
     vibrato_lfo_phase += speed / 48000.0f;
     if (vibrato_lfo_phase >= 1.0f)
@@ -72,8 +70,9 @@ static inline void process_audio_vibrato_sample(int32_t* inout_l, int32_t* inout
 }
 
 void vibrato_process_block(int32_t* in_l, int32_t* in_r, size_t frames, FXmode mode) {
+    const VibratoCoefs* c = coef_live(&vibrato_bank);
     for (size_t i = 0; i < frames; i++) {
-        process_audio_vibrato_sample(&in_l[i], &in_r[i], mode);
+        process_audio_vibrato_sample(&in_l[i], &in_r[i], mode, c);
     }
 }
 
@@ -0,0 +1,222 @@
+/* wah.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef WAH_H
+#define WAH_H
+
+#include <stdint.h>
+#include <math.h>
+
+// ============================================================================
+// === Wah (Auto / LFO / Expression) ==========================================
+// ============================================================================
+//
+// Resonant band-pass on a Chamberlin state-variable filter (3 multiplies per
+// sample). The sweep position is worked out once per block from the selected
+// source, mapped through a small exponential table and then ramped linearly
+// across the block, so nothing is recomputed per sample.
+//
+// Pots: Sens | Range | Q | Attack | Mix | Volume
+// In LFO mode Sens sets the sweep depth and Attack the LFO rate.
+
+#define WAH_F_LOW_HZ        350.0f          // Bottom of the sweep
+#define WAH_F_HIGH_MIN_HZ   800.0f          // Top of the sweep, Range pot at 0
+#define WAH_F_HIGH_MAX_HZ   3500.0f         // Top of the sweep, Range pot at max
+#define WAH_TABLE_BITS      5               // 32 segments over the sweep
+#define WAH_TABLE_SIZE      ((1 << WAH_TABLE_BITS) + 1)
+#define WAH_HEADROOM_SHIFT  4               // Room for the resonance inside the filter
+
+// Parameters (coefficient bank)
+typedef struct {
+    int32_t  f_table_q24[WAH_TABLE_SIZE];           // SVF f = 2*sin(pi*fc/fs) along the sweep
+    int32_t  damp_q24;                              // 1/Q
+    int32_t  bp_gain_q24;                           // Normalises the resonant peak
+    uint32_t sens_q8;                               // Envelope -> position gain (Q8)
+    uint32_t lfo_depth_q16;                         // LFO sweep depth
+    uint32_t lfo_inc;                               // Per-block LFO phase increment
+    uint32_t mix_q16;
+    uint32_t dry_q16;
+    int32_t  volume_q24;
+    EnvTimes times;
+} WahCoefs;
+
+#define WAH_COEFS_DEFAULT { .damp_q24 = Q24_ONE / 2, .bp_gain_q24 = Q24_ONE, .sens_q8 = 256, \
+                            .lfo_depth_q16 = Q16_ONE, .mix_q16 = Q16_ONE, .volume_q24 = Q24_ONE }
+static WahCoefs wah_coefs[2] = { WAH_COEFS_DEFAULT, WAH_COEFS_DEFAULT };
+static CoefBank wah_bank     = COEF_BANK(wah_coefs);
+
+// State
+static EnvFollower wah_env;
+static uint32_t wah_lfo_phase = 0;
+static uint32_t wah_pos_q16   = 0;                  // Current sweep position (0..1)
+static int32_t  wah_f_q24     = 0;                  // Coefficient reached at the end of the last block
+static int32_t  wah_low_l = 0, wah_band_l = 0;
+static int32_t  wah_low_r = 0, wah_band_r = 0;
+
+extern bool lfo_led_state;
+
+// ============================================================================
+// === Parameters =============================================================
+// ============================================================================
+
+void init_wah(void) {
+    wah_low_l = wah_band_l = 0;
+    wah_low_r = wah_band_r = 0;
+    wah_lfo_phase = 0;
+    env_follower_reset(&wah_env);
+}
+
+void load_wah_parms_from_memory(void) {
+    WahCoefs* c = coef_edit(&wah_bank);
+    int pot;
+
+    // Sensitivity: envelope gain x1..x32 (log), or LFO depth 0..1
+    pot = storedPotValue[WAH_EFFECT_INDEX][0];
+    c->sens_q8 = (uint32_t)(256.0f * powf(2.0f, 5.0f * (float)pot / POT_MAX));
+    c->lfo_depth_q16 = ((uint32_t)pot * Q16_ONE) / POT_MAX;
+
+    // Range: top of the sweep, table is exponential in frequency
+    pot = storedPotValue[WAH_EFFECT_INDEX][1];
+    float f_high = WAH_F_HIGH_MIN_HZ + ((float)pot / POT_MAX) * (WAH_F_HIGH_MAX_HZ - WAH_F_HIGH_MIN_HZ);
+    for (int i = 0; i < WAH_TABLE_SIZE; i++) {
+        float p  = (float)i / (WAH_TABLE_SIZE - 1);
+        float fc = WAH_F_LOW_HZ * powf(f_high / WAH_F_LOW_HZ, p);
+        c->f_table_q24[i] = fc_to_q24((uint32_t)fc, SAMPLE_RATE);
+    }
+
+    // Q: 1.5 .. 12
+    pot = storedPotValue[WAH_EFFECT_INDEX][2];
+    float q = 1.5f + ((float)pot / POT_MAX) * 10.5f;
+    c->damp_q24    = float_to_q24(1.0f / q);
+    c->bp_gain_q24 = float_to_q24(2.0f / q);       // ~+6 dB at the peak, independent of Q
+
+    // Attack 2..100 ms (release follows at 4x), or LFO rate 0.1..5 Hz
+    pot = storedPotValue[WAH_EFFECT_INDEX][3];
+    float attack_ms = 2.0f + ((float)pot / POT_MAX) * 98.0f;
+    env_follower_set_times(&c->times, attack_ms, 4.0f * attack_ms + 30.0f);
+    float rate_hz = 0.1f + ((float)pot / POT_MAX) * 4.9f;
+    c->lfo_inc = (uint32_t)(rate_hz / ENV_BLOCK_RATE * 4294967296.0f);
+
+    // Mix
+    pot = storedPotValue[WAH_EFFECT_INDEX][4];
+    c->mix_q16 = ((uint32_t)pot * Q16_ONE) / POT_MAX;
+    c->dry_q16 = Q16_ONE - c->mix_q16;
+
+    // Volume: 0 .. 2x
+    pot = storedPotValue[WAH_EFFECT_INDEX][5];
+    c->volume_q24 = map_pot_to_q24(pot, 0, 2 * Q24_ONE);
+
+    coef_commit(&wah_bank);
+}
+
+void update_wah_params_from_pots(int changed_pot) {
+    if (changed_pot < 0) return;
+    storedPotValue[WAH_EFFECT_INDEX][changed_pot] = pot_value[changed_pot];
+    load_wah_parms_from_memory();
+}
+
+// ============================================================================
+// === Processing =============================================================
+// ============================================================================
+
+// Sweep position (Q16) from the selected source, once per block
+static inline uint32_t wah_position_q16(const WahCoefs* c) {
+    uint32_t pos;
+
+    switch (selected_wah_mode) {
+        case WAH_LFO: {
+            wah_lfo_phase += c->lfo_inc;
+            uint32_t lfo = lfo_q16_shape(wah_lfo_phase, LFO_SINE);
+            pos = (uint32_t)(((uint64_t)lfo * c->lfo_depth_q16) >> 16);
+        } break;
+
+        case WAH_EXPRESSION:
+            pos = exp_value_q16;        // Smoothed EXP-2 input
+            break;
+
+        case WAH_ENVELOPE:
+        default: {
+            const EnvTap* tap = env_get(env_slot_tap);
+            env_request(env_slot_tap);
+            int32_t env = env_follower_tap(&wah_env, &c->times, env_slot_tap, tap->peak_l);
+            pos = ((uint32_t)env >> 15) * c->sens_q8 >> 8;
+        } break;
+    }
+
+    return (pos > Q16_ONE) ? Q16_ONE : pos;
+}
+
+// Position -> SVF coefficient (table lerp, exponential in Hz)
+static inline int32_t wah_f_from_pos(const WahCoefs* c, uint32_t pos_q16) {
+    uint32_t idx  = pos_q16 >> (16 - WAH_TABLE_BITS);
+    uint32_t frac = (pos_q16 << WAH_TABLE_BITS) & 0xFFFF;
+    if (idx >= WAH_TABLE_SIZE - 1) return c->f_table_q24[WAH_TABLE_SIZE - 1];
+    return lerp_fixed(c->f_table_q24[idx], c->f_table_q24[idx + 1], frac);
+}
+
+// One SVF step, returns the normalised band-pass (can exceed 32 bit at the peak)
+static inline __attribute__((always_inline))
+int64_t wah_svf_bp(const WahCoefs* c, int32_t x, int32_t f_q24, int32_t* low, int32_t* band) {
+    int32_t in   = x >> WAH_HEADROOM_SHIFT;
+    *low        += qmul(f_q24, *band);
+    int32_t high = in - *low - qmul(c->damp_q24, *band);
+    *band       += qmul(f_q24, high);
+    return (int64_t)qmul(*band, c->bp_gain_q24) << WAH_HEADROOM_SHIFT;
+}
+
+// Dry/wet mix and output volume
+static inline __attribute__((always_inline)) int32_t wah_mix_out(const WahCoefs* c, int32_t dry, int64_t wet) {
+    int64_t y = ((int64_t)dry * c->dry_q16 + wet * c->mix_q16) >> 16;
+    return clamp24(clamp32((y * c->volume_q24) >> 24));
+}
+
+void wah_process_block(int32_t* in_l, int32_t* in_r, size_t frames, bool stereo) {
+    const WahCoefs* c = coef_live(&wah_bank);
+    wah_pos_q16 = wah_position_q16(c);
+
+    // Ramp the coefficient from where the last block ended
+    int32_t f_target = wah_f_from_pos(c, wah_pos_q16);
+    int32_t f_step   = (f_target - wah_f_q24) / (int32_t)frames;
+    int32_t f        = wah_f_q24;
+
+    for (size_t i = 0; i < frames; i++) {
+        f += f_step;
+
+        int64_t wet_l = wah_svf_bp(c, in_l[i], f, &wah_low_l, &wah_band_l);
+        in_l[i] = wah_mix_out(c, in_l[i], wet_l);
+
+        if (!stereo) {
+            in_r[i] = in_l[i];          // Process MONO
+        } else {
+            int64_t wet_r = wah_svf_bp(c, in_r[i], f, &wah_low_r, &wah_band_r);
+            in_r[i] = wah_mix_out(c, in_r[i], wet_r);
+        }
+    }
+    wah_f_q24 = f_target;
+
+    // LED follows the sweep (only update when selected)
+    if (lfo_update_led_flag) {
+        if (selectedEffects[selected_slot] == WAH_EFFECT_INDEX) {
+            lfo_led_state = (wah_pos_q16 > Q16_ONE / 2);
+            lfo_update_led_flag = false;
+        }
+    }
+}
+
+#endif // WAH_H
@@ -0,0 +1,201 @@
+/* envelope.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef ENVELOPE_H
+#define ENVELOPE_H
+
+// ============================================================================
+// === Envelope Service =======================================================
+// ============================================================================
+//
+// One peak / RMS measurement per audio block for each tap in the chain.
+// Taps are only measured when someone asked for them in the previous block
+// (or earlier in this one, before env_begin_block), so unused taps cost nothing.
+//
+// Consumers then run their own ballistics at block rate with an EnvFollower,
+// one multiply per block instead of a 64-bit follower per sample. A tap
+// that was not measured in this or the previous block holds an old value:
+// env_follower_tap() holds the follower until the tap has a fresh
+// measurement and then starts it at that level.
+//
+// Taps:
+//   ENV_TAP_INPUT = chain input
+//   ENV_TAP_PRE_SLOT(s) = in front of slot s (0-based), wherever the
+//                         routing graph puts it
+//   ENV_TAP_CHAIN_OUT = end of the chain, before the master volume
+//   ENV_TAP_OUTPUT = after the master volume
+
+#define ENV_NUM_SLOT_TAPS       ROUTE_MAX_SLOTS
+#define ENV_TAP_INPUT           0
+#define ENV_TAP_PRE_SLOT(s)     ((s) + 1)
+#define ENV_TAP_CHAIN_OUT       (ENV_NUM_SLOT_TAPS + 1)
+#define ENV_TAP_OUTPUT          (ENV_NUM_SLOT_TAPS + 2)
+#define ENV_NUM_TAPS            (ENV_NUM_SLOT_TAPS + 3)
+
+// Block rate the followers run at
+#define ENV_BLOCK_RATE          ((float)SAMPLE_RATE / AUDIO_BUFFER_FRAMES)
+
+// Per-tap block measurement (sample units, same scale as the audio)
+typedef struct {
+    int32_t peak_l, peak_r;     // max |x| over the block
+    int32_t rms_l,  rms_r;      // sqrt(mean(x^2)) over the block
+} EnvTap;
+
+// Attack / release of a follower (per-block coefficients, kept with the
+// owner's other coefficients)
+typedef struct {
+    int32_t attack_a_q24;
+    int32_t release_a_q24;
+} EnvTimes;
+
+// Block-rate attack / release follower
+typedef struct {
+    int32_t env;                // Current envelope (sample units)
+    bool    primed;             // Started from a fresh measurement
+} EnvFollower;
+
+static EnvTap env_taps[ENV_NUM_TAPS];
+static uint32_t env_request_mask = 0;   // Taps wanted for the next block
+static uint32_t env_active_mask  = 0;   // Taps measured in this block
+static uint32_t env_fresh_mask   = 0;   // Taps measured in this or the previous block
+static uint32_t env_done_mask    = 0;   // Taps measured so far in this block
+static uint8_t  env_slot_tap     = 0;   // Tap feeding the slot currently processed
+
+// ============================================================================
+// === Helpers ================================================================
+// ============================================================================
+
+// Integer square root (used once per tap per block)
+static inline uint32_t env_isqrt32(uint32_t x) {
+    uint32_t res = 0;
+    uint32_t bit = 1u << 30;
+    while (bit > x) bit >>= 2;
+    while (bit) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+// |x| saturated to INT32_MAX (-INT32_MIN does not fit)
+static inline __attribute__((always_inline)) int32_t env_abs_sat(int32_t x) {
+    if (x >= 0) return x;
+    return (x == INT32_MIN) ? INT32_MAX : -x;
+}
+
+// ============================================================================
+// === Core 0: measurement ====================================================
+// ============================================================================
+
+// Ask for a tap to be measured (takes effect from the next block)
+static inline __attribute__((always_inline)) void env_request(uint8_t tap) {
+    env_request_mask |= (1u << tap);
+}
+
+// Call once at the start of every audio block
+static inline __attribute__((always_inline)) void env_begin_block(void) {
+    env_active_mask  = env_request_mask;
+    env_request_mask = 0;
+    env_fresh_mask   = env_done_mask;
+    env_done_mask    = 0;
+}
+
+// Measure one tap if it was requested
+static inline __attribute__((always_inline))
+void env_tap_block(uint8_t tap, const int32_t* in_l, const int32_t* in_r, size_t frames) {
+    if (!(env_active_mask & (1u << tap))) return;
+
+    int32_t pk_l = 0, pk_r = 0;
+    uint64_t sq_l = 0, sq_r = 0;
+
+    for (size_t i = 0; i < frames; i++) {
+        int32_t a_l = env_abs_sat(in_l[i]);
+        int32_t a_r = env_abs_sat(in_r[i]);
+        if (a_l > pk_l) pk_l = a_l;
+        if (a_r > pk_r) pk_r = a_r;
+
+        // 16-bit precision is plenty for the RMS (keeps the square in 32 bit)
+        int32_t h_l = in_l[i] >> 16;
+        int32_t h_r = in_r[i] >> 16;
+        sq_l += (uint32_t)(h_l * h_l);
+        sq_r += (uint32_t)(h_r * h_r);
+    }
+
+    EnvTap* t = &env_taps[tap];
+    t->peak_l = pk_l;
+    t->peak_r = pk_r;
+    t->rms_l  = (int32_t)(env_isqrt32((uint32_t)(sq_l / frames)) << 16);
+    t->rms_r  = (int32_t)(env_isqrt32((uint32_t)(sq_r / frames)) << 16);
+
+    env_done_mask  |= (1u << tap);
+    env_fresh_mask |= (1u << tap);
+}
+
+// Read the latest measurement of a tap
+static inline __attribute__((always_inline)) const EnvTap* env_get(uint8_t tap) {
+    return &env_taps[tap];
+}
+
+// Measurement of this or the previous block (false: only just requested)
+static inline __attribute__((always_inline)) bool env_fresh(uint8_t tap) {
+    return (env_fresh_mask & (1u << tap)) != 0;
+}
+
+// ============================================================================
+// === Followers ==============================================================
+// ============================================================================
+
+// Set attack / release in ms (float, run only on param updates)
+static inline void env_follower_set_times(EnvTimes* t, float attack_ms, float release_ms) {
+    t->attack_a_q24  = ms_to_coeff_q24(attack_ms,  ENV_BLOCK_RATE);
+    t->release_a_q24 = ms_to_coeff_q24(release_ms, ENV_BLOCK_RATE);
+}
+
+// Advance the follower by one block towards the measured level
+static inline __attribute__((always_inline)) int32_t env_follower_block(EnvFollower* f, const EnvTimes* t, int32_t level) {
+    int32_t a = (level > f->env) ? t->attack_a_q24 : t->release_a_q24;
+    f->env = level + qmul(f->env - level, a);
+    return f->env;
+}
+
+// Follower on a tap: holds while the tap is stale, the first fresh level primes it
+static inline __attribute__((always_inline)) int32_t env_follower_tap(EnvFollower* f, const EnvTimes* t, uint8_t tap, int32_t level) {
+    if (!env_fresh(tap)) {
+        f->primed = false;
+        return f->env;
+    }
+    if (!f->primed) {
+        f->primed = true;
+        f->env = level;
+        return f->env;
+    }
+    return env_follower_block(f, t, level);
+}
+
+static inline void env_follower_reset(EnvFollower* f) {
+    f->env = 0;
+    f->primed = false;
+}
+
+#endif // ENVELOPE_H
@@ -0,0 +1,70 @@
+/* expression.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+// ============================================================================
+// === Expression Pedal (EXP-2) ===============================================
+// ============================================================================
+//
+// EXP-2 is the last pot in the scan, so the 4051 mux is already parked on its
+// channel whenever read_all_pots() is not running. Core 1 samples it between
+// scans at EXP_SAMPLE_RATE_HZ and smooths it with a fixed-point one-pole.
+//
+// The result is published as one 32-bit word (atomic on the M0+) and picked
+// up by core 0 once per audio block, where it is routed to a parameter.
+
+#define EXP_POT_INDEX           7                       // pot_value[7] = EXP-2
+#define EXP_SAMPLE_INTERVAL_US  250                     // 4 kHz sampling
+#define EXP_SMOOTH_SHIFT        5                       // ~8 ms time constant at 4 kHz
+#define EXP_DEADBAND            48                      // Raw counts ignored at heel and toe
+
+// Smoothed pedal position (Q16, 0 = heel, 65535 = toe)
+volatile uint32_t exp_value_q16 = 0;
+
+// Smoother state (Q16 with 8 extra fraction bits)
+static uint32_t exp_state_q24 = 0;
+static uint64_t exp_last_sample_us = 0;
+
+// Raw ADC count (0..POT_MAX) -> Q16 with heel/toe deadband
+static inline uint32_t exp_raw_to_q16(uint32_t raw) {
+    if (raw <= EXP_DEADBAND) return 0;
+    if (raw >= POT_MAX - EXP_DEADBAND) return Q16_ONE - 1;
+    return ((raw - EXP_DEADBAND) * (Q16_ONE - 1)) / (POT_MAX - 2 * EXP_DEADBAND);
+}
+
+// Seed the smoother from the scanned pot value (no slew at boot)
+void init_expression(void) {
+    exp_state_q24 = exp_raw_to_q16(pot_value[EXP_POT_INDEX]) << 8;
+    exp_value_q16 = exp_state_q24 >> 8;
+    exp_last_sample_us = time_us_64();
+}
+
+// Call from the core 1 loop; the mux must be left on the EXP-2 channel
+void expression_poll(uint64_t now_us) {
+    if (now_us - exp_last_sample_us < EXP_SAMPLE_INTERVAL_US) return;
+    exp_last_sample_us = now_us;
+
+    uint32_t x = exp_raw_to_q16(adc_read()) << 8;
+    exp_state_q24 += (int32_t)(x - exp_state_q24) >> EXP_SMOOTH_SHIFT;
+    exp_value_q16 = exp_state_q24 >> 8;
+}
+
+#endif // EXPRESSION_H
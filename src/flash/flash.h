@@ -54,7 +54,7 @@ extern uint8_t __flash_binary_end;
 
 // Program page size MUST be a multiple of 256
 #ifndef SETTINGS_SLOT_SIZE
-#define SETTINGS_SLOT_SIZE     256u      // set to 512u if your record > 256 B
+#define SETTINGS_SLOT_SIZE     1024u     // record holds the two morph presets
 #endif
 
 #define SETTINGS_AREA_SIZE     (SETTINGS_SECTORS * SETTINGS_SECTOR_SIZE)
@@ -98,6 +98,8 @@ const uint16_t defaultPotValue[NUM_EFFECTS][NUM_FUNC_POTS] = {
     { 2000, 3000, 1800, 2000, 2500, 2000 },   // 11 CAB SIM
     { 2000, 2000,    0,    0,    0,    0 },   // 12 TREMOLO
     { 2000, 2000, 2000,    0,    0,    0 },   // 13 VIBRATO
+    { 2500, 2500, 2500, 1000, POT_MAX, 2000 }, // 14 WAH
+    { 2000, 2000, 2500, 1500, 1500,    0 },   // 15 MB COMP
 };
 const uint16_t defaultPreampPotValue[NUM_PREAMPS][NUM_FUNC_POTS] = {
     { 2000, 2000, 2000, 2000, 2000, 2000 },   // 0 FENDER
@@ -115,10 +117,26 @@ const bool default_tap_tempo_active_l = false;
 const bool default_tap_tempo_active_r = false;  
 
 // ------------------------------ Record type ----------------------------------
+//
+// The record starts with a format header (magic, version, size of the record
+// that wrote it); the checksum covers that size. New fields go at the end
+// and bump SETTINGS_VERSION: a record of another version loads the fields
+// both know, the ones behind keep their defaults. A change in front of the
+// end (a new effect grows pot[]) needs its own case in settings_load_record().
+//
+// The firmware before the header wrote SettingsRecordV0 into 256 B slots.
+// Such a record is migrated on boot and replaced by the next save.
+
+#define SETTINGS_MAGIC      0x5352u      // "SR", above any pot value a V0 record has there
+#define SETTINGS_VERSION    1u
 
 typedef struct {
     uint32_t seq;                        // monotonically increasing
-    uint32_t crc;                        // checksum excluding 'crc' bytes
+    uint32_t crc;                        // checksum over 'size' bytes excluding 'crc' bytes
+    uint16_t magic;                      // SETTINGS_MAGIC
+    uint8_t  version;                    // SETTINGS_VERSION of the writer
+    uint8_t  reserved;
+    uint16_t size;                       // sizeof(SettingsRecord) of the writer
     uint16_t pot[NUM_EFFECTS][NUM_FUNC_POTS];
     uint16_t preamp[NUM_PREAMPS][NUM_FUNC_POTS];
     uint8_t  selectedEffects[3];
@@ -128,8 +146,47 @@ typedef struct {
     uint32_t tap_interval_ms;
     uint8_t  delay_time_fraction_l;
     uint8_t  delay_time_fraction_r; 
+    uint8_t  exp_target;                 // ModDest controlled by EXP-2
+    ModRoute mod_routes[MOD_MAX_ROUTES]; // Modulation matrix
+
+    uint8_t  preset_valid;               // Morph snapshots stored (bit 0 = A, bit 1 = B)
+    uint8_t  morph_source;
+    uint8_t  morph_time_index;
+    uint8_t  power_amp;                  // Power amp stage after the preamp
+    int8_t   dual_amp_style;             // Second preamp (-1 = off)
+    uint8_t  dual_amp_blend;
+    uint8_t  dual_amp_pan;
+    uint8_t  route_num_tokens;           // Routing graph (0 = default serial chain)
+    RouteToken route_tokens[ROUTE_MAX_TOKENS];
+    int8_t   route_extra_effect[ROUTE_EXTRA_SLOTS];
+    uint8_t  route_dual_mono;            // Extra slots run the right input
+    PresetSnapshot preset_a;
+    PresetSnapshot preset_b;
 } SettingsRecord;
 
+// Baseline firmware layout (14 effects, 4 preamps, no header)
+#define SETTINGS_V0_EFFECTS     14
+#define SETTINGS_V0_PREAMPS     4
+#define SETTINGS_V0_SLOT_SIZE   256u
+
+typedef struct {
+    uint32_t seq;
+    uint32_t crc;                        // checksum over the record excluding 'crc' bytes
+    uint16_t pot[SETTINGS_V0_EFFECTS][NUM_FUNC_POTS];
+    uint16_t preamp[SETTINGS_V0_PREAMPS][NUM_FUNC_POTS];
+    uint8_t  selectedEffects[3];
+    uint8_t  default_led_state;
+    uint8_t  selected_slot;
+    uint32_t tap_interval_ms;
+    uint8_t  delay_time_fraction_l;
+    uint8_t  delay_time_fraction_r;
+} SettingsRecordV0;
+
+_Static_assert(offsetof(SettingsRecord, magic) == offsetof(SettingsRecordV0, pot),
+               "the header must overlay pot[0][0] of a V0 record");
+_Static_assert(SETTINGS_V0_EFFECTS <= NUM_EFFECTS && SETTINGS_V0_PREAMPS <= NUM_PREAMPS,
+               "effects and preamps are only ever appended");
+_Static_assert(SETTINGS_SLOT_SIZE % SETTINGS_V0_SLOT_SIZE == 0, "V0 slots must tile the record slots");
 _Static_assert(SETTINGS_SLOT_SIZE % 256u == 0, "SETTINGS_SLOT_SIZE must be a multiple of 256");
 _Static_assert(sizeof(SettingsRecord) <= SETTINGS_SLOT_SIZE,
                "SettingsRecord must fit in SETTINGS_SLOT_SIZE (raise to 512 if needed)");
@@ -140,9 +197,8 @@ static SettingsRecord last_saved_settings;   // zero-init (BSS)
 
 // ------------------------------ CRC helper -----------------------------------
 
-static inline uint32_t settings_crc(const SettingsRecord* rec) {
+static inline uint32_t settings_crc_len(const void* rec, size_t len) {
     const uint8_t* p   = (const uint8_t*)rec;
-    const size_t   len = sizeof(SettingsRecord);
     const size_t   off = offsetof(SettingsRecord, crc);
     uint32_t s = 0;
     for (size_t i = 0; i < len; ++i) {
@@ -152,6 +208,21 @@ static inline uint32_t settings_crc(const SettingsRecord* rec) {
     return s;
 }
 
+static inline uint32_t settings_crc(const SettingsRecord* rec) {
+    return settings_crc_len(rec, rec->size);
+}
+
+// Header present, size inside the slot, checksum over that size
+static inline bool settings_record_valid(const SettingsRecord* r) {
+    if (r->magic != SETTINGS_MAGIC || r->version == 0) return false;
+    if (r->size < offsetof(SettingsRecord, pot) || r->size > SETTINGS_SLOT_SIZE) return false;
+    return r->crc == settings_crc(r);
+}
+
+static inline bool settings_record_v0_valid(const SettingsRecordV0* r) {
+    return r->crc == settings_crc_len(r, sizeof(SettingsRecordV0));
+}
+
 // -------------------------- Flash view helpers --------------------------------
 
 static inline const uint8_t* settings_flash_base(void) {
@@ -167,7 +238,7 @@ static inline const SettingsRecord* find_latest_record(uint32_t* out_max_seq) {
     const SettingsRecord* best = NULL;
     for (int i = 0; i < (int)SETTINGS_NUM_SLOTS; ++i) {
         const SettingsRecord* r = slot_ptr(i);
-        if (r->crc == settings_crc(r)) {
+        if (settings_record_valid(r)) {
             if (r->seq >= max_seq) { // >= so last wins on ties
                 max_seq = r->seq;
                 best = r;
@@ -178,13 +249,27 @@ static inline const SettingsRecord* find_latest_record(uint32_t* out_max_seq) {
     return best;
 }
 
+// Latest record of the baseline firmware (its 256 B slots)
+static inline const SettingsRecordV0* find_latest_record_v0(void) {
+    uint32_t max_seq = 0;
+    const SettingsRecordV0* best = NULL;
+    for (size_t off = 0; off < SETTINGS_AREA_SIZE; off += SETTINGS_V0_SLOT_SIZE) {
+        const SettingsRecordV0* r = (const SettingsRecordV0*)(settings_flash_base() + off);
+        if (settings_record_v0_valid(r) && r->seq >= max_seq) {
+            max_seq = r->seq;
+            best = r;
+        }
+    }
+    return best;
+}
+
 // Next slot + whether we must erase (wrap)
 static inline void plan_next_slot(int* out_slot_index, bool* out_need_erase) {
     uint32_t max_seq = 0;
     int last_slot = -1;
     for (int i = 0; i < (int)SETTINGS_NUM_SLOTS; ++i) {
         const SettingsRecord* r = slot_ptr(i);
-        if (r->crc == settings_crc(r)) {
+        if (settings_record_valid(r)) {
             if (r->seq >= max_seq) {
                 max_seq = r->seq;
                 last_slot = i;
@@ -220,32 +305,71 @@ static __not_in_flash_func(void settings_flash_commit)(
 
 // ------------------------------- Public API -----------------------------------
 
+// Fields of the stored record over 'out' (holding the defaults)
+static inline void settings_load_record(SettingsRecord* out, const SettingsRecord* r) {
+    switch (r->version) {
+        case SETTINGS_VERSION:
+        default: {
+            // Same layout, or one that differs only behind the fields both know
+            size_t n = (r->size < sizeof(SettingsRecord)) ? r->size : sizeof(SettingsRecord);
+            memcpy(out, r, n);
+        } break;
+    }
+}
+
+static inline void settings_migrate_v0(SettingsRecord* out, const SettingsRecordV0* r) {
+    out->seq = r->seq;
+    memcpy(out->pot,    r->pot,    sizeof(r->pot));
+    memcpy(out->preamp, r->preamp, sizeof(r->preamp));
+    memcpy(out->selectedEffects, r->selectedEffects, sizeof(r->selectedEffects));
+    out->default_led_state     = r->default_led_state;
+    out->selected_slot         = r->selected_slot;
+    out->tap_interval_ms       = r->tap_interval_ms;
+    out->delay_time_fraction_l = r->delay_time_fraction_l;
+    out->delay_time_fraction_r = r->delay_time_fraction_r;
+}
+
+// Over the defaults in 'out': false = nothing stored
 static inline bool load_settings_from_flash(SettingsRecord* out) {
-    uint32_t max_seq = 0;
-    const SettingsRecord* best = find_latest_record(&max_seq);
-    if (!best) return false;
-    memcpy(out, best, sizeof(SettingsRecord));
-    return (out->crc == settings_crc(out));
+    const SettingsRecord* best = find_latest_record(NULL);
+    if (best) {
+        settings_load_record(out, best);
+        return true;
+    }
+
+    const SettingsRecordV0* v0 = find_latest_record_v0();
+    if (v0) {
+        if (DEBUG) printf("Settings: migrating the record of the previous firmware\n");
+        settings_migrate_v0(out, v0);
+        return true;
+    }
+    return false;
 }
 
+// One slot image, static: too big for the 4 kB core 0 stack
+static uint8_t settings_slot_image[SETTINGS_SLOT_SIZE] __attribute__((aligned(4)));
+
 // Journaled save (prepares image, then commits)
 static inline void save_settings_to_flash(const SettingsRecord* rec_in) {
     int  slot_index;
     bool need_erase;
     plan_next_slot(&slot_index, &need_erase);
 
-    SettingsRecord tmp = *rec_in;
-    uint32_t max_seq = 0; (void)find_latest_record(&max_seq);
-    tmp.seq = max_seq + 1;
-    tmp.crc = settings_crc(&tmp);
+    // Build the slot image in place (record, padded to slot size with 0xFF)
+    memset(settings_slot_image, 0xFF, sizeof(settings_slot_image));
+    memcpy(settings_slot_image, rec_in, sizeof(SettingsRecord));
 
-    // Build one slot image (pad to slot size with 0xFF)
-    uint8_t slot_image[SETTINGS_SLOT_SIZE];
-    memset(slot_image, 0xFF, sizeof(slot_image));
-    memcpy(slot_image, &tmp, sizeof(tmp));
+    SettingsRecord* rec = (SettingsRecord*)settings_slot_image;
+    uint32_t max_seq = 0; (void)find_latest_record(&max_seq);
+    rec->seq      = max_seq + 1;
+    rec->magic    = SETTINGS_MAGIC;
+    rec->version  = SETTINGS_VERSION;
+    rec->reserved = 0;
+    rec->size     = (uint16_t)sizeof(SettingsRecord);
+    rec->crc      = settings_crc(rec);
 
     // Do the critical section (erase/program) from SRAM
-    settings_flash_commit(slot_index, slot_image, need_erase);
+    settings_flash_commit(slot_index, settings_slot_image, need_erase);
 }
 
 // helper to validate
@@ -254,21 +378,37 @@ static inline DelayFraction validate_fraction(uint8_t value) {
     return (DelayFraction)value;
 }
 
+// Drop routes that do not point at a known source / destination
+static inline void validate_mod_routes(ModRoute* routes) {
+    for (int i = 0; i < MOD_MAX_ROUTES; i++) {
+        if (routes[i].src >= NUM_MOD_SRCS || routes[i].dest >= NUM_MOD_DESTS ||
+            routes[i].depth < -100 || routes[i].depth > 100) {
+            routes[i] = (ModRoute){ MOD_SRC_NONE, MOD_DEST_NONE, 0 };
+        }
+    }
+}
+
 // Initialize working state from flash or defaults
 static inline void init_settings_from_flash(void) {
-    if (!load_settings_from_flash(&g_settings)) {
-        memset(&g_settings, 0, sizeof(g_settings));
-        memcpy(g_settings.pot,    defaultPotValue,       sizeof(g_settings.pot));
-        memcpy(g_settings.preamp, defaultPreampPotValue, sizeof(g_settings.preamp));
-        memcpy(g_settings.selectedEffects, defaultSelectedEffects, sizeof(g_settings.selectedEffects));
-        g_settings.default_led_state = default_led_state_const;
-
-        // NEW defaults
-        g_settings.selected_slot            = default_selected_slot;
-        g_settings.tap_interval_ms          = default_tap_interval_ms;
-        g_settings.delay_time_fraction_l    = QUARTER;
-        g_settings.delay_time_fraction_r    = QUARTER;
-    }
+    // Defaults first: a stored record only covers the fields its firmware knew
+    memset(&g_settings, 0, sizeof(g_settings));
+    memcpy(g_settings.pot,    defaultPotValue,       sizeof(g_settings.pot));
+    memcpy(g_settings.preamp, defaultPreampPotValue, sizeof(g_settings.preamp));
+    memcpy(g_settings.selectedEffects, defaultSelectedEffects, sizeof(g_settings.selectedEffects));
+    g_settings.default_led_state = default_led_state_const;
+
+    // NEW defaults
+    g_settings.selected_slot            = default_selected_slot;
+    g_settings.tap_interval_ms          = default_tap_interval_ms;
+    g_settings.delay_time_fraction_l    = QUARTER;
+    g_settings.delay_time_fraction_r    = QUARTER;
+    g_settings.exp_target               = MOD_DEST_NONE;
+    g_settings.dual_amp_style           = -1;
+    g_settings.dual_amp_blend           = 5;
+    g_settings.dual_amp_pan             = 5;
+    memset(g_settings.route_extra_effect, -1, sizeof(g_settings.route_extra_effect));
+
+    load_settings_from_flash(&g_settings);
 
     // Push to live working vars
     memcpy(storedPotValue,       g_settings.pot,    sizeof(g_settings.pot));
@@ -281,6 +421,30 @@ static inline void init_settings_from_flash(void) {
     tap_interval_ms          = g_settings.tap_interval_ms;
     delay_time_fraction_l    = validate_fraction(g_settings.delay_time_fraction_l);
     delay_time_fraction_r    = validate_fraction(g_settings.delay_time_fraction_r);
+    exp_target               = (g_settings.exp_target < NUM_MOD_DESTS) ? (ModDest)g_settings.exp_target : MOD_DEST_NONE;
+    memcpy(mod_routes, g_settings.mod_routes, sizeof(mod_routes));
+    validate_mod_routes(mod_routes);
+
+    preset_valid     = g_settings.preset_valid & 0x03;
+    morph_source     = (g_settings.morph_source < NUM_MORPH_SRCS) ? (MorphSource)g_settings.morph_source : MORPH_SRC_OFF;
+    morph_time_index = (g_settings.morph_time_index < NUM_MORPH_TIMES) ? g_settings.morph_time_index : 2;
+    power_amp_enabled = (g_settings.power_amp != 0);
+    dual_amp_style    = (g_settings.dual_amp_style >= 0 && g_settings.dual_amp_style < (int8_t)NUM_PREAMPS) ? g_settings.dual_amp_style : -1;
+    dual_amp_blend    = (g_settings.dual_amp_blend <= 10) ? g_settings.dual_amp_blend : 5;
+    dual_amp_pan      = (g_settings.dual_amp_pan   <= 10) ? g_settings.dual_amp_pan   : 5;
+
+    // Routing graph (checked by route_init) and the effects of the extra slots
+    if (g_settings.route_num_tokens > 0 && g_settings.route_num_tokens <= ROUTE_MAX_TOKENS) {
+        memcpy(route_tokens, g_settings.route_tokens, sizeof(route_tokens));
+        route_num_tokens = g_settings.route_num_tokens;
+    }
+    for (int i = 0; i < ROUTE_EXTRA_SLOTS; i++) {
+        int8_t e = g_settings.route_extra_effect[i];
+        route_extra_effect[i] = (e >= 0 && e < (int8_t)NUM_EFFECTS && !effect_in_other_slot(e, i + 3)) ? e : -1;
+    }
+    route_dual_mono  = (g_settings.route_dual_mono != 0);
+    preset_a         = g_settings.preset_a;
+    preset_b         = g_settings.preset_b;
 
 }
 
@@ -297,6 +461,22 @@ static __not_in_flash_func(void save_all_settings_to_flash)(void) {
     g_settings.tap_interval_ms         = tap_interval_ms;
     g_settings.delay_time_fraction_l   =  (uint8_t)delay_time_fraction_l;
     g_settings.delay_time_fraction_r   =  (uint8_t)delay_time_fraction_r;
+    g_settings.exp_target              =  (uint8_t)exp_target;
+    memcpy(g_settings.mod_routes, mod_routes, sizeof(g_settings.mod_routes));
+
+    g_settings.preset_valid            =  preset_valid;
+    g_settings.morph_source            =  (uint8_t)morph_source;
+    g_settings.morph_time_index        =  morph_time_index;
+    g_settings.power_amp               =  power_amp_enabled ? 1 : 0;
+    g_settings.dual_amp_style          =  dual_amp_style;
+    g_settings.dual_amp_blend          =  dual_amp_blend;
+    g_settings.dual_amp_pan            =  dual_amp_pan;
+    g_settings.route_num_tokens        =  route_num_tokens;
+    memcpy(g_settings.route_tokens, route_tokens, sizeof(g_settings.route_tokens));
+    memcpy(g_settings.route_extra_effect, route_extra_effect, sizeof(g_settings.route_extra_effect));
+    g_settings.route_dual_mono         =  route_dual_mono ? 1 : 0;
+    g_settings.preset_a                =  preset_a;
+    g_settings.preset_b                =  preset_b;
 
     if (memcmp(&g_settings, &last_saved_settings, sizeof(SettingsRecord)) == 0) return;
 
@@ -0,0 +1,344 @@
+/* host_control.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef HOST_CONTROL_H
+#define HOST_CONTROL_H
+
+#include "tusb.h"
+#include "host_proto.h"
+
+// ============================================================================
+// === Host Control (USB CDC 1) ===============================================
+// ============================================================================
+//
+// Binary control port next to the printf console (CDC 0). Runs on core 1
+// like the pot scan: parameter writes go to the stored pot arrays and are
+// published through effect_publish, so the audio core takes the new
+// coefficients as one set at its next block (coef_bank.h).
+//
+// Bulk regions use the PresetSnapshot layout (effect pots, then preamp pots):
+//   0 = preset A, 1 = preset B, 2 = live pots.
+// Uploads are staged, checked against a CRC-32 of the whole image and only
+// then applied.
+
+#define HOST_CDC_ITF            1
+#define HOST_POT_MAX            4095
+
+#define HOST_REGION_PRESET_A    0
+#define HOST_REGION_PRESET_B    1
+#define HOST_REGION_LIVE        2
+#define HOST_NUM_REGIONS        3
+
+static HostParser     host_parser;
+static uint8_t        host_tx[HOST_MAX_FRAME];
+static uint8_t        host_resp[HOST_MAX_PAYLOAD];
+static uint16_t       host_tx_len     = 0;      // Response frame queued in host_tx
+static uint16_t       host_tx_pos     = 0;      // Bytes of it handed to the CDC FIFO
+static uint32_t       host_tx_dropped = 0;      // Responses lost (host went away)
+static uint8_t        host_rx[64];              // Request bytes read, not parsed yet
+static uint8_t        host_rx_len     = 0;
+static uint8_t        host_rx_pos     = 0;
+
+static PresetSnapshot host_stage;               // Upload image
+static PresetSnapshot host_live;                // Download copy of the live pots
+static int8_t         host_bulk_region = -1;    // Open upload (-1 = none)
+static uint32_t       host_bulk_len    = 0;
+
+// ============================================================================
+// === Helpers ================================================================
+// ============================================================================
+
+// Stored pot behind effect / pot (the preamp uses the selected style)
+static uint16_t* host_param_ptr(uint8_t effect, uint8_t pot) {
+    if (effect >= NUM_EFFECTS || pot >= NUM_FUNC_POTS) return NULL;
+    if (effect == PREAMP_EFFECT_INDEX) return &storedPreampPotValue[selected_preamp_style][pot];
+    return &storedPotValue[effect][pot];
+}
+
+static const uint8_t* host_region_ptr(int region) {
+    switch (region) {
+        case HOST_REGION_PRESET_A: return (const uint8_t*)&preset_a;
+        case HOST_REGION_PRESET_B: return (const uint8_t*)&preset_b;
+        case HOST_REGION_LIVE:     return (const uint8_t*)&host_live;
+        default:                   return NULL;
+    }
+}
+
+// Apply a checked upload image
+static void host_commit_region(int region) {
+    uint16_t* v = (uint16_t*)&host_stage;
+    for (size_t i = 0; i < sizeof(host_stage) / sizeof(uint16_t); i++) {
+        if (v[i] > HOST_POT_MAX) v[i] = HOST_POT_MAX;
+    }
+
+    switch (region) {
+        case HOST_REGION_PRESET_A:
+            preset_a = host_stage;
+            preset_valid |= 0x01;
+            break;
+
+        case HOST_REGION_PRESET_B:
+            preset_b = host_stage;
+            preset_valid |= 0x02;
+            break;
+
+        case HOST_REGION_LIVE:
+            memcpy(storedPotValue,       host_stage.pot,    sizeof(host_stage.pot));
+            memcpy(storedPreampPotValue, host_stage.preamp, sizeof(host_stage.preamp));
+            for (int slot = 0; slot < ROUTE_MAX_SLOTS; slot++) effect_publish(slot_effect(slot));
+            break;
+    }
+}
+
+// ============================================================================
+// === Commands ===============================================================
+// ============================================================================
+
+// Handle one request, returns the response payload length (status included)
+static uint16_t host_dispatch(uint8_t cmd, const uint8_t* in, uint16_t len, uint8_t* out) {
+    uint8_t* p = out + 1;
+    out[0] = HOST_OK;
+
+    switch (cmd) {
+        case HOST_CMD_PING:
+            *p++ = HOST_PROTO_VERSION;
+            *p++ = NUM_EFFECTS;
+            *p++ = NUM_FUNC_POTS;
+            *p++ = NUM_PREAMPS;
+            *p++ = AUDIO_BUFFER_FRAMES;
+            p = host_put_u32(p, SAMPLE_RATE);
+            p = host_put_u16(p, sizeof(PresetSnapshot));
+            break;
+
+        case HOST_CMD_GET_PARAM: {
+            uint16_t* v = (len == 2) ? host_param_ptr(in[0], in[1]) : NULL;
+            if (!v) { out[0] = HOST_ERR_ARG; break; }
+            p = host_put_u16(p, *v);
+            break;
+        }
+
+        case HOST_CMD_SET_PARAM: {
+            // Validate everything first, then write and reload each effect once
+            if (len == 0 || len % 4) { out[0] = HOST_ERR_ARG; break; }
+            for (uint16_t i = 0; i < len; i += 4) {
+                if (!host_param_ptr(in[i], in[i + 1]) || host_get_u16(&in[i + 2]) > HOST_POT_MAX) {
+                    out[0] = HOST_ERR_ARG;
+                    break;
+                }
+            }
+            if (out[0] != HOST_OK) break;
+
+            uint32_t reload = 0;
+            for (uint16_t i = 0; i < len; i += 4) {
+                *host_param_ptr(in[i], in[i + 1]) = host_get_u16(&in[i + 2]);
+                reload |= 1u << in[i];
+            }
+            for (int e = 0; e < NUM_EFFECTS; e++) {
+                if (reload & (1u << e)) effect_publish(e);
+            }
+            break;
+        }
+
+        case HOST_CMD_TELEMETRY:
+            p = host_put_u16(p, (uint16_t)CPU_BLOCK_PERIOD_US);
+            p = host_put_u16(p, (uint16_t)cpu0_peak_us);
+            p = host_put_u16(p, (uint16_t)cpu1_peak_us);
+            p = host_put_u32(p, cpu0_xruns);
+            p = host_put_u32(p, audio_block_seq);
+            p = host_put_u32(p, midi_queue.dropped);
+            p = host_put_u32(p, host_parser.crc_errors);
+            *p++ = CPU_HIST_BINS + 1;
+            for (int i = 0; i <= CPU_HIST_BINS; i++) p = host_put_u32(p, cpu0_hist[i]);
+            *p++ = I2S_RING_BUFFERS;
+            *p++ = i2s_depth;
+            p = host_put_u16(p, (uint16_t)(i2s_depth * AUDIO_BUFFER_FRAMES));
+            p = host_put_u16(p, i2s_slack_frames);
+            p = host_put_u16(p, i2s_min_slack_frames);
+            p = host_put_u32(p, i2s_grows);
+            p = host_put_u32(p, i2s_underruns);
+            p = host_put_u32(p, defer_overruns);
+            p = host_put_u32(p, gov_levels[gov_level].sys_hz);
+            p = host_put_u32(p, gov_switches);
+            p = host_put_u32(p, host_tx_dropped);
+            break;
+
+        case HOST_CMD_TELEMETRY_RST:
+            for (int i = 0; i <= CPU_HIST_BINS; i++) cpu0_hist[i] = 0;
+            cpu0_xruns = 0;
+            host_parser.crc_errors = 0;
+            i2s_min_slack_frames = 0xFFFF;
+            i2s_grows = i2s_underruns = 0;
+            defer_overruns = 0;
+            host_tx_dropped = 0;
+            break;
+
+        case HOST_CMD_BULK_READ: {
+            // region, offset (u32), length (u8)
+            if (len != 6 || in[0] >= HOST_NUM_REGIONS) { out[0] = HOST_ERR_ARG; break; }
+            uint32_t off = host_get_u32(&in[1]);
+            uint32_t n   = in[5];
+            if (off > sizeof(PresetSnapshot) || n > sizeof(PresetSnapshot) - off || n > HOST_MAX_PAYLOAD - 1) {
+                out[0] = HOST_ERR_ARG;
+                break;
+            }
+            if (in[0] == HOST_REGION_LIVE && off == 0) {
+                memcpy(host_live.pot,    storedPotValue,       sizeof(host_live.pot));
+                memcpy(host_live.preamp, storedPreampPotValue, sizeof(host_live.preamp));
+            }
+            memcpy(p, host_region_ptr(in[0]) + off, n);
+            p += n;
+            break;
+        }
+
+        case HOST_CMD_BULK_BEGIN:
+            // region, total length (u32, must match the image)
+            if (len != 5 || in[0] >= HOST_NUM_REGIONS || host_get_u32(&in[1]) != sizeof(PresetSnapshot)) {
+                out[0] = HOST_ERR_ARG;
+                break;
+            }
+            host_bulk_region = (int8_t)in[0];
+            host_bulk_len    = host_get_u32(&in[1]);
+            memset(&host_stage, 0, sizeof(host_stage));
+            break;
+
+        case HOST_CMD_BULK_WRITE: {
+            // offset (u32), data
+            if (host_bulk_region < 0) { out[0] = HOST_ERR_STATE; break; }
+            if (len < 4) { out[0] = HOST_ERR_ARG; break; }
+            uint32_t off = host_get_u32(in);
+            uint32_t n   = len - 4u;
+            if (off > host_bulk_len || n > host_bulk_len - off) { out[0] = HOST_ERR_ARG; break; }
+            memcpy((uint8_t*)&host_stage + off, in + 4, n);
+            break;
+        }
+
+        case HOST_CMD_BULK_COMMIT:
+            // crc32 (u32) of the whole image
+            if (host_bulk_region < 0) { out[0] = HOST_ERR_STATE; break; }
+            if (len != 4) { out[0] = HOST_ERR_ARG; break; }
+            if (host_crc32_update(0, (const uint8_t*)&host_stage, host_bulk_len) != host_get_u32(in)) {
+                out[0] = HOST_ERR_CRC;
+            } else {
+                host_commit_region(host_bulk_region);
+            }
+            host_bulk_region = -1;
+            break;
+
+        case HOST_CMD_SAVE:
+            save_request = true;                // Core 0 parks us and writes flash
+            break;
+
+        case HOST_CMD_GET_ROUTE:
+            *p++ = route_num_tokens;
+            for (int i = 0; i < route_num_tokens; i++) {
+                *p++ = route_tokens[i].kind;
+                *p++ = route_tokens[i].arg;
+            }
+            for (int i = 0; i < ROUTE_EXTRA_SLOTS; i++) *p++ = (uint8_t)route_extra_effect[i];
+            *p++ = route_dual_mono ? HOST_ROUTE_DUAL_MONO : 0;
+            break;
+
+        case HOST_CMD_SET_ROUTE: {
+            // Extra slot effects are checked against each other and the footswitch slots.
+            // The flags byte is optional (keeps the current mode).
+            uint8_t n = (len > 0) ? in[0] : 0xFF;
+            uint16_t base = 1u + 2u * n + ROUTE_EXTRA_SLOTS;
+            if (n > ROUTE_MAX_TOKENS || (len != base && len != base + 1u)) { out[0] = HOST_ERR_ARG; break; }
+            bool dual = (len > base) ? (in[base] & HOST_ROUTE_DUAL_MONO) != 0 : route_dual_mono;
+
+            const uint8_t* extra = in + 1 + 2 * n;
+            int8_t old_extra[ROUTE_EXTRA_SLOTS];
+            memcpy(old_extra, route_extra_effect, sizeof(old_extra));
+            for (int i = 0; i < ROUTE_EXTRA_SLOTS; i++) route_extra_effect[i] = -1;
+            for (int i = 0; i < ROUTE_EXTRA_SLOTS && out[0] == HOST_OK; i++) {
+                int8_t e = (int8_t)extra[i];
+                if (e != -1 && (e < 0 || e >= (int8_t)NUM_EFFECTS || effect_in_other_slot(e, i + 3))) out[0] = HOST_ERR_ARG;
+                else route_extra_effect[i] = e;
+            }
+
+            RouteToken t[ROUTE_MAX_TOKENS];
+            for (int i = 0; i < n; i++) t[i] = (RouteToken){ in[1 + 2 * i], in[2 + 2 * i] };
+            if (out[0] != HOST_OK || !route_set(t, n, dual)) {
+                memcpy(route_extra_effect, old_extra, sizeof(old_extra));
+                out[0] = HOST_ERR_ARG;
+            }
+            break;
+        }
+
+        default:
+            out[0] = HOST_ERR_CMD;
+            break;
+    }
+    return (uint16_t)(p - out);
+}
+
+// ============================================================================
+// === Core 1: transport ======================================================
+// ============================================================================
+
+// Hand as much of the queued response to the CDC FIFO as fits
+static void host_flush_tx(void) {
+    if (host_tx_pos >= host_tx_len) return;
+
+    uint32_t room = tud_cdc_n_write_available(HOST_CDC_ITF);
+    uint32_t left = (uint32_t)(host_tx_len - host_tx_pos);
+    uint32_t n    = (room < left) ? room : left;
+    if (n == 0) return;
+
+    host_tx_pos += (uint16_t)tud_cdc_n_write(HOST_CDC_ITF, host_tx + host_tx_pos, n);
+    tud_cdc_n_write_flush(HOST_CDC_ITF);
+}
+
+// Queue a response; the next request is only parsed once it is out
+static void host_send(uint8_t cmd, uint8_t seq, const uint8_t* payload, uint16_t len) {
+    host_tx_len = (uint16_t)host_frame_encode(host_tx, cmd, seq, payload, len);
+    host_tx_pos = 0;
+    host_flush_tx();
+}
+
+// Call from the core 1 loop, right after tud_task()
+void host_poll(void) {
+    // A response still queued: drop it if the host closed the port, else keep sending
+    if (host_tx_pos < host_tx_len) {
+        if (!tud_cdc_n_connected(HOST_CDC_ITF)) {
+            host_tx_dropped++;
+            host_tx_pos = host_tx_len;
+        } else {
+            host_flush_tx();
+            if (host_tx_pos < host_tx_len) return;      // Requests wait in the CDC RX FIFO
+        }
+    }
+
+    if (host_rx_pos >= host_rx_len) {
+        if (!tud_cdc_n_available(HOST_CDC_ITF)) return;
+        host_rx_len = (uint8_t)tud_cdc_n_read(HOST_CDC_ITF, host_rx, sizeof(host_rx));
+        host_rx_pos = 0;
+    }
+
+    // Up to one request per call: its response has to go out before the next
+    while (host_rx_pos < host_rx_len) {
+        if (host_parse_byte(&host_parser, host_rx[host_rx_pos++])) {
+            uint16_t len = host_dispatch(host_parser.cmd, host_parser.payload, host_parser.len, host_resp);
+            host_send(host_parser.cmd | HOST_RESPONSE, host_parser.seq, host_resp, len);
+            break;
+        }
+    }
+}
+
+#endif // HOST_CONTROL_H
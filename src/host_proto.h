@@ -0,0 +1,232 @@
+/* host_proto.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef HOST_PROTO_H
+#define HOST_PROTO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================================
+// === Host Control Protocol: framing =========================================
+// ============================================================================
+//
+// Plain C, no SDK dependencies (the host tool in tools/ implements the same
+// format). Every request and response is one frame:
+//
+//   0xA5 | cmd | seq | len (u16 LE) | payload[len] | crc16 (u16 LE)
+//
+// crc16 is CRC-16/CCITT-FALSE over cmd..payload. A response echoes seq,
+// sets bit 7 of cmd and starts its payload with a status byte. Frames
+// with a bad CRC are dropped, the host retries on timeout. All multi-byte
+// values are little endian.
+
+#define HOST_PROTO_VERSION      2
+#define HOST_SOF                0xA5
+#define HOST_MAX_PAYLOAD        256
+#define HOST_FRAME_OVERHEAD     7               // SOF, cmd, seq, len(2), crc(2)
+#define HOST_MAX_FRAME          (HOST_MAX_PAYLOAD + HOST_FRAME_OVERHEAD)
+#define HOST_RESPONSE           0x80
+
+// Commands
+#define HOST_CMD_PING           0x01            // -> version, layout info
+#define HOST_CMD_GET_PARAM      0x10            // effect, pot -> value
+#define HOST_CMD_SET_PARAM      0x11            // { effect, pot, value } x N
+#define HOST_CMD_TELEMETRY      0x20            // -> CPU, histogram, xruns, I2S ring latency / slack
+#define HOST_CMD_TELEMETRY_RST  0x21
+#define HOST_CMD_BULK_READ      0x30            // region, offset, len -> data
+#define HOST_CMD_BULK_BEGIN     0x31            // region, total length
+#define HOST_CMD_BULK_WRITE     0x32            // offset, data
+#define HOST_CMD_BULK_COMMIT    0x33            // crc32 of the whole image
+#define HOST_CMD_SAVE           0x40            // Store settings to flash
+#define HOST_CMD_GET_ROUTE      0x50            // -> n, { kind, arg } x n, extra slot effects, flags
+#define HOST_CMD_SET_ROUTE      0x51            // n, { kind, arg } x n, extra slot effects [, flags]
+
+// Route flags (GET/SET_ROUTE)
+#define HOST_ROUTE_DUAL_MONO    0x01            // Extra slots run the right input
+
+// Status codes (first response byte)
+#define HOST_OK                 0x00
+#define HOST_ERR_CMD            0x01            // Unknown command
+#define HOST_ERR_ARG            0x02            // Bad length / index / range
+#define HOST_ERR_CRC            0x03            // Bulk image CRC mismatch
+#define HOST_ERR_STATE          0x04            // No bulk transfer open
+
+typedef enum {
+    HOST_RX_SOF,
+    HOST_RX_CMD,
+    HOST_RX_SEQ,
+    HOST_RX_LEN_LO,
+    HOST_RX_LEN_HI,
+    HOST_RX_PAYLOAD,
+    HOST_RX_CRC_LO,
+    HOST_RX_CRC_HI
+} HostRxState;
+
+typedef struct {
+    uint8_t  state;                             // HostRxState
+    uint8_t  cmd;
+    uint8_t  seq;
+    uint16_t len;
+    uint16_t pos;
+    uint16_t crc;                               // Running CRC
+    uint16_t rx_crc;
+    uint32_t crc_errors;
+    uint8_t  payload[HOST_MAX_PAYLOAD];
+} HostParser;
+
+// ============================================================================
+// === Checksums ==============================================================
+// ============================================================================
+
+static inline uint16_t host_crc16_update(uint16_t crc, uint8_t b) {
+    crc ^= (uint16_t)b << 8;
+    for (int i = 0; i < 8; i++) {
+        crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+// CRC-32 (IEEE, same as zlib.crc32); start with 0, feed chunks in order
+static inline uint32_t host_crc32_update(uint32_t crc, const uint8_t* p, size_t n) {
+    crc = ~crc;
+    while (n--) {
+        crc ^= *p++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+// ============================================================================
+// === Little endian helpers ==================================================
+// ============================================================================
+
+static inline uint16_t host_get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t host_get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint8_t* host_put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static inline uint8_t* host_put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+// ============================================================================
+// === Parser / encoder =======================================================
+// ============================================================================
+
+static inline void host_parser_reset(HostParser* p) {
+    p->state      = HOST_RX_SOF;
+    p->crc_errors = 0;
+}
+
+// Feed one byte, returns true when a complete, CRC-checked frame is in *p
+static inline bool host_parse_byte(HostParser* p, uint8_t b) {
+    switch (p->state) {
+        case HOST_RX_SOF:
+            if (b == HOST_SOF) {
+                p->crc   = 0xFFFF;
+                p->state = HOST_RX_CMD;
+            }
+            return false;
+
+        case HOST_RX_CMD:
+            p->cmd   = b;
+            p->crc   = host_crc16_update(p->crc, b);
+            p->state = HOST_RX_SEQ;
+            return false;
+
+        case HOST_RX_SEQ:
+            p->seq   = b;
+            p->crc   = host_crc16_update(p->crc, b);
+            p->state = HOST_RX_LEN_LO;
+            return false;
+
+        case HOST_RX_LEN_LO:
+            p->len   = b;
+            p->crc   = host_crc16_update(p->crc, b);
+            p->state = HOST_RX_LEN_HI;
+            return false;
+
+        case HOST_RX_LEN_HI:
+            p->len  |= (uint16_t)b << 8;
+            p->crc   = host_crc16_update(p->crc, b);
+            p->pos   = 0;
+            if (p->len > HOST_MAX_PAYLOAD) {
+                p->state = HOST_RX_SOF;         // Resync on the next SOF
+            } else {
+                p->state = p->len ? HOST_RX_PAYLOAD : HOST_RX_CRC_LO;
+            }
+            return false;
+
+        case HOST_RX_PAYLOAD:
+            p->payload[p->pos++] = b;
+            p->crc = host_crc16_update(p->crc, b);
+            if (p->pos == p->len) p->state = HOST_RX_CRC_LO;
+            return false;
+
+        case HOST_RX_CRC_LO:
+            p->rx_crc = b;
+            p->state  = HOST_RX_CRC_HI;
+            return false;
+
+        case HOST_RX_CRC_HI:
+        default:
+            p->rx_crc |= (uint16_t)b << 8;
+            p->state   = HOST_RX_SOF;
+            if (p->rx_crc != p->crc) {
+                p->crc_errors++;
+                return false;
+            }
+            return true;
+    }
+}
+
+// Build a frame into out (HOST_MAX_FRAME bytes), returns its length
+static inline size_t host_frame_encode(uint8_t* out, uint8_t cmd, uint8_t seq,
+                                       const uint8_t* payload, uint16_t len) {
+    uint8_t* p = out;
+    *p++ = HOST_SOF;
+    *p++ = cmd;
+    *p++ = seq;
+    p = host_put_u16(p, len);
+    for (uint16_t i = 0; i < len; i++) *p++ = payload[i];
+
+    uint16_t crc = 0xFFFF;
+    for (uint8_t* q = out + 1; q < p; q++) crc = host_crc16_update(crc, *q);
+    p = host_put_u16(p, crc);
+    return (size_t)(p - out);
+}
+
+#endif // HOST_PROTO_H
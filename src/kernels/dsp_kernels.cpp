@@ -0,0 +1,37 @@
+/* dsp_kernels.cpp
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "pico/platform.h"
+
+#include "dsp_kernels.hpp"
+
+// Coefficients of the C ABI are Q8.24
+#define DSP_COEF_FRAC   24
+
+// Called from the audio ISR: in RAM like the preamp and power amp kernels,
+// which inline into process_audio (.time_critical)
+extern "C" void __not_in_flash_func(dsp_eq_block)(const DspEqCoefs* c, DspEqState st[2], int32_t* in_l, int32_t* in_r,
+                                                 size_t frames, DspLayout layout, DspQuality quality) {
+    dsp::dispatch<dsp::Eq, DSP_COEF_FRAC>(c, st, in_l, in_r, frames, layout, quality);
+}
+
+extern "C" void __not_in_flash_func(dsp_cab_block)(const DspCabCoefs* c, DspCabState st[2], int32_t* in_l, int32_t* in_r,
+                                                  size_t frames, DspLayout layout, DspQuality quality) {
+    dsp::dispatch<dsp::Cab, DSP_COEF_FRAC>(c, st, in_l, in_r, frames, layout, quality);
+}
@@ -0,0 +1,95 @@
+/* dsp_kernels.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef DSP_KERNELS_H
+#define DSP_KERNELS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// === Block kernels (C ABI) ==================================================
+// ============================================================================
+//
+// C entry points of the C++ kernel layer (dsp_kernels.hpp). The effect keeps
+// its coefficients (Q8.24) and per-channel state in these structs and passes
+// them in once per block. The entry point picks the template instance for
+// the channel layout and quality once, the sample loop has no mode checks.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    DSP_MONO,                       // Left processed, copied to the right
+    DSP_STEREO                      // Both channels, own state each
+} DspLayout;
+
+typedef enum {
+    DSP_Q_EXACT,                    // Rounding multiplies, bit-exact with the former C code
+    DSP_Q_FAST                      // Truncating multiplies, no unity shortcuts (< 1 LSB at 24 bit)
+} DspQuality;
+
+// === 3-band EQ (eq.h) ===
+typedef struct {
+    int32_t low_a_q24;                          // Shelf corners
+    int32_t high_a_q24;
+    int32_t low_gain_q24;
+    int32_t mid_gain_q24;
+    int32_t mid_a_q24;
+    int32_t high_gain_q24;
+    int32_t lpf_a_q24;
+    int32_t volume_q24;
+} DspEqCoefs;
+
+typedef struct {
+    int32_t low, mid_lp, mid_hp, high, lpf;
+} DspEqState;
+
+void dsp_eq_block(const DspEqCoefs* c, DspEqState st[2], int32_t* in_l, int32_t* in_r,
+                  size_t frames, DspLayout layout, DspQuality quality);
+
+// === Cabinet simulation (speaker_sim.h) ===
+#define DSP_CAB_BANDS   3
+
+typedef struct {
+    int32_t hpf_a_q24;                          // Low cut
+    int32_t bpf_hp_a_q24[DSP_CAB_BANDS];        // Parallel band-passes
+    int32_t bpf_lp_a_q24[DSP_CAB_BANDS];
+    int32_t bpf_gain_q24[DSP_CAB_BANDS];
+    int32_t lpf4_a_q24;                         // 5 kHz
+    int32_t lpf5_a_q24;                         // Air
+    int32_t out_gain_q24;
+} DspCabCoefs;
+
+typedef struct {
+    int32_t hpf;
+    int32_t bpf_hp[DSP_CAB_BANDS];
+    int32_t bpf_lp[DSP_CAB_BANDS];
+    int32_t lpf4, lpf5;
+} DspCabState;
+
+void dsp_cab_block(const DspCabCoefs* c, DspCabState st[2], int32_t* in_l, int32_t* in_r,
+                   size_t frames, DspLayout layout, DspQuality quality);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DSP_KERNELS_H
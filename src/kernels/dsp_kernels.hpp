@@ -0,0 +1,196 @@
+/* dsp_kernels.hpp
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef DSP_KERNELS_HPP
+#define DSP_KERNELS_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#include "dsp_kernels.h"
+
+// ============================================================================
+// === C++ kernel layer =======================================================
+// ============================================================================
+//
+// Header-only templates behind the C entry points of dsp_kernels.h:
+//
+//   Layout    Mono / Stereo: the right channel is a copy or a second pass,
+//             decided at compile time instead of per sample
+//   Frac      fractional bits the kernel computes in (24 = Q8.24); the
+//             Q8.24 coefficients of the C structs go through from_q24(),
+//             which is a no-op at 24
+//   Quality   Exact rounds like qmul() in var_conversion.h, Fast truncates
+//             and drops the unity-gain shortcuts (branch-free)
+//
+// A kernel is a struct with process(coefs, state, x) for one channel;
+// run_block() copies the state into locals for the block, so it stays in
+// registers instead of being reloaded around every sample store.
+
+namespace dsp {
+
+enum class Layout  { Mono, Stereo };
+enum class Quality { Exact, Fast };
+
+constexpr int32_t kPeakMax = 0x7FFFFF00;        // PEAK_MAX / PEAK_MIN (audio.h)
+constexpr int32_t kPeakMin = -0x7FFFFF00;
+
+static inline __attribute__((always_inline)) int32_t clamp_peak(int32_t x) {
+    if (x > kPeakMax) x = kPeakMax;
+    if (x < kPeakMin) x = kPeakMin;
+    return x;
+}
+
+// === Fixed point in Q(31 - Frac).Frac ===
+template <int Frac, Quality Q>
+struct Fixed {
+    static_assert(Frac > 0 && Frac < 31, "Frac out of range");
+
+    static constexpr int32_t one = (int32_t)1 << Frac;
+
+    // Coefficient given in Q8.24
+    static constexpr int32_t from_q24(int32_t v) {
+        return (Frac <= 24) ? (v >> (24 - Frac)) : (int32_t)((uint32_t)v << (Frac - 24));
+    }
+
+    // a * b, rounded to nearest (away from zero on .5) or truncated
+    static inline __attribute__((always_inline)) int32_t mul(int32_t a, int32_t b) {
+        int64_t p = (int64_t)a * b;
+        if constexpr (Q == Quality::Exact) {
+            p += ((int64_t)1 << (Frac - 1)) - ((p >> 63) & ((int64_t)1 << Frac));
+        }
+        return (int32_t)(p >> Frac);
+    }
+
+    // a * b truncated in both tiers (where the C code always truncated)
+    static inline __attribute__((always_inline)) int32_t mul_trunc(int64_t a, int32_t b) {
+        return (int32_t)((a * b) >> Frac);
+    }
+
+    // Gain that skips unity in the exact tier (qmul(x, 1.0) is 1 LSB off for x < 0)
+    static inline __attribute__((always_inline)) int32_t gain(int32_t x, int32_t g) {
+        if constexpr (Q == Quality::Exact) {
+            if (g == one) return x;
+        }
+        return mul(x, g);
+    }
+
+    // One-pole low-pass / high-pass (apply_1pole_lpf / _hpf in audio.h)
+    static inline __attribute__((always_inline)) int32_t lpf(int32_t x, int32_t& s, int32_t a) {
+        s += mul(x - s, a);
+        return s;
+    }
+
+    static inline __attribute__((always_inline)) int32_t hpf(int32_t x, int32_t& s, int32_t a) {
+        s += mul(x - s, a);
+        return x - s;
+    }
+};
+
+// === Block loop ===
+template <Layout L, typename K, typename C, typename S>
+static inline __attribute__((always_inline))
+void run_block(const C& c, S* st, int32_t* in_l, int32_t* in_r, size_t frames) {
+    S sl = st[0];
+    if constexpr (L == Layout::Stereo) {
+        S sr = st[1];
+        for (size_t i = 0; i < frames; i++) {
+            in_l[i] = K::process(c, sl, in_l[i]);
+            in_r[i] = K::process(c, sr, in_r[i]);
+        }
+        st[1] = sr;
+    } else {
+        for (size_t i = 0; i < frames; i++) {
+            const int32_t y = K::process(c, sl, in_l[i]);
+            in_l[i] = y;
+            in_r[i] = y;
+        }
+    }
+    st[0] = sl;
+}
+
+// === 3-band EQ: shelves + mid band-pass, volume, output low-pass ===
+template <int Frac, Quality Q>
+struct Eq {
+    using F = Fixed<Frac, Q>;
+
+    static inline __attribute__((always_inline))
+    int32_t process(const DspEqCoefs& c, DspEqState& s, int32_t x) {
+        x >>= 2;                                            // -12 dB headroom
+
+        const int32_t mid_a = F::from_q24(c.mid_a_q24);
+
+        int32_t low  = F::mul_trunc(F::lpf(x, s.low, F::from_q24(c.low_a_q24)), F::from_q24(c.low_gain_q24));
+        int32_t band = F::lpf(F::hpf(x, s.mid_hp, mid_a), s.mid_lp, mid_a);
+        int32_t mid  = F::mul_trunc(band, F::from_q24(c.mid_gain_q24));
+        int32_t high = F::mul_trunc(x - F::lpf(x, s.high, F::from_q24(c.high_a_q24)), F::from_q24(c.high_gain_q24));
+
+        int64_t y = low + mid + high;
+        y = (y * F::from_q24(c.volume_q24)) >> Frac;
+        return clamp_peak(F::lpf((int32_t)y, s.lpf, F::from_q24(c.lpf_a_q24)));
+    }
+};
+
+// === Cabinet: low cut + three parallel band-passes, two low-passes ===
+template <int Frac, Quality Q>
+struct Cab {
+    using F = Fixed<Frac, Q>;
+
+    static constexpr int32_t kMakeup = F::from_q24(0x1420000);   // ~2 dB
+
+    static inline __attribute__((always_inline))
+    int32_t band(const DspCabCoefs& c, DspCabState& s, int k, int32_t x) {
+        int32_t hp = F::hpf(x, s.bpf_hp[k], F::from_q24(c.bpf_hp_a_q24[k]));
+        return F::gain(F::lpf(hp, s.bpf_lp[k], F::from_q24(c.bpf_lp_a_q24[k])), F::from_q24(c.bpf_gain_q24[k]));
+    }
+
+    static inline __attribute__((always_inline))
+    int32_t process(const DspCabCoefs& c, DspCabState& s, int32_t x) {
+        int32_t y = F::hpf(x, s.hpf, F::from_q24(c.hpf_a_q24)) >> 1;
+
+        int32_t p1 = band(c, s, 0, x);
+        int32_t p2 = band(c, s, 1, x);
+        int32_t p3 = band(c, s, 2, x);
+        y += ((p1 >> 1) + (p2 >> 1) + (p3 >> 1)) >> 1;
+
+        y = F::lpf(y, s.lpf4, F::from_q24(c.lpf4_a_q24));
+        y = F::lpf(y, s.lpf5, F::from_q24(c.lpf5_a_q24));
+
+        y = F::mul(y, kMakeup);
+        return clamp_peak(F::mul(y, F::from_q24(c.out_gain_q24)));
+    }
+};
+
+// === C entry point: one switch per block ===
+template <template <int, Quality> class K, int Frac, typename C, typename S>
+static inline void dispatch(const C* c, S* st, int32_t* in_l, int32_t* in_r, size_t frames,
+                            DspLayout layout, DspQuality quality) {
+    const bool fast = (quality == DSP_Q_FAST);
+    if (layout == DSP_STEREO) {
+        if (fast) run_block<Layout::Stereo, K<Frac, Quality::Fast>>(*c, st, in_l, in_r, frames);
+        else      run_block<Layout::Stereo, K<Frac, Quality::Exact>>(*c, st, in_l, in_r, frames);
+    } else {
+        if (fast) run_block<Layout::Mono, K<Frac, Quality::Fast>>(*c, st, in_l, in_r, frames);
+        else      run_block<Layout::Mono, K<Frac, Quality::Exact>>(*c, st, in_l, in_r, frames);
+    }
+}
+
+} // namespace dsp
+
+#endif // DSP_KERNELS_HPP
@@ -0,0 +1,183 @@
+/* limiter.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef LIMITER_H
+#define LIMITER_H
+
+// ============================================================================
+// === Output Limiter =========================================================
+// ============================================================================
+//
+// Fixed brickwall limiter after the master volume, 1 ms lookahead. The gain
+// is computed once per sub-block of LIM_DECIM samples and interpolated
+// linearly in between:
+//   - every sub-block gets a target gain (threshold / peak)
+//   - the target stays in a window until its samples leave the delay line,
+//     and the gain is ramped so it reaches each target just in time
+//     (attack spread over the lookahead, no overshoot)
+//   - release is a one-pole move towards the smallest target in the window
+// Cost: one divide per loud sub-block (its target), the ramps use a
+// reciprocal table; one Q16 multiply per sample.
+//
+// Stereo-linked on the peak of both channels. In dual mono routing the
+// channels carry two separate chains, so each one gets its own targets and
+// gain there: a peak on one side does not duck the other.
+
+#define LIM_DECIM           8                               // Samples per gain point
+#define LIM_LOOKAHEAD       48                              // 1 ms at 48 kHz
+#define LIM_SUBBLOCKS       (LIM_LOOKAHEAD / LIM_DECIM)     // 6
+#define LIM_WINDOW          (LIM_SUBBLOCKS + 1)             // Targets still ahead of the output
+#define LIM_RING            64                              // Delay line (power of two)
+#define LIM_THRESHOLD       0x78000000u                     // -0.56 dBFS (MSB-aligned samples)
+#define LIM_RELEASE_SHIFT   8                               // ~40 ms release
+
+#if (AUDIO_BUFFER_FRAMES % LIM_DECIM) != 0
+#error "AUDIO_BUFFER_FRAMES must be a multiple of LIM_DECIM"
+#endif
+
+// Gain path of one channel (or of both, linked)
+typedef struct {
+    uint32_t target_q16[LIM_WINDOW];                        // Newest at Limiter.tpos
+    uint32_t gain_q16;                                      // Gain at the end of the last sub-block
+} LimGain;
+
+typedef struct {
+    int32_t  ring_l[LIM_RING];
+    int32_t  ring_r[LIM_RING];
+    uint32_t widx;
+    uint32_t tpos;
+    LimGain  ch[2];                                         // Left (linked: both), right (unlinked only)
+    bool     linked;
+} Limiter;
+
+static Limiter limiter;
+
+// ceil(2^16 / n): (g0 - t) <= Q16_ONE, so the product stays below 2^31 for n >= 2.
+// Rounded up, a ramp step ducks at most 1 LSB more than the exact quotient.
+static const uint32_t lim_recip_q16[LIM_SUBBLOCKS + 1] = {
+    0, 0, 32768, 21846, 16384, 13108, 10923,
+};
+_Static_assert(LIM_SUBBLOCKS == 6, "lim_recip_q16 covers 2..6 sub-blocks");
+
+void limiter_reset(void) {
+    memset(&limiter, 0, sizeof(limiter));
+    for (int c = 0; c < 2; c++) {
+        for (int i = 0; i < LIM_WINDOW; i++) limiter.ch[c].target_q16[i] = Q16_ONE;
+        limiter.ch[c].gain_q16 = Q16_ONE;
+    }
+    limiter.linked = true;
+}
+
+// Linked <-> unlinked: the right channel starts from the linked path, the
+// linked path from the lower of both (never less ducking than before)
+static void limiter_set_linked(bool linked) {
+    LimGain* a = &limiter.ch[0];
+    LimGain* b = &limiter.ch[1];
+    if (linked) {
+        for (int i = 0; i < LIM_WINDOW; i++) {
+            if (b->target_q16[i] < a->target_q16[i]) a->target_q16[i] = b->target_q16[i];
+        }
+        if (b->gain_q16 < a->gain_q16) a->gain_q16 = b->gain_q16;
+    } else {
+        *b = *a;
+    }
+    limiter.linked = linked;
+}
+
+static inline __attribute__((always_inline)) uint32_t lim_abs(int32_t x) {
+    return (x < 0) ? 0u - (uint32_t)x : (uint32_t)x;
+}
+
+// Target gain of a sub-block peak
+static inline uint32_t limiter_target(uint32_t peak) {
+    return (peak > LIM_THRESHOLD) ? LIM_THRESHOLD / ((peak >> 16) + 1) : Q16_ONE;
+}
+
+// Gain at the end of the next sub-block
+static inline uint32_t limiter_next_gain(const LimGain* c) {
+    uint32_t g0   = c->gain_q16;
+    uint32_t g1   = g0;
+    uint32_t tmin = Q16_ONE;
+
+    for (uint32_t age = 0; age < LIM_WINDOW; age++) {
+        uint32_t t = c->target_q16[(limiter.tpos + LIM_WINDOW - age) % LIM_WINDOW];
+        if (t < tmin) tmin = t;
+        if (t < g0) {
+            // Sub-blocks left before this target's samples reach the output
+            uint32_t left = LIM_SUBBLOCKS - age;
+            uint32_t g    = (left <= 1) ? t : g0 - (((g0 - t) * lim_recip_q16[left]) >> 16);
+            if (g < g1) g1 = g;
+        }
+    }
+
+    // Nothing to duck for: release
+    if (g1 == g0 && tmin > g0) g1 = g0 + ((tmin - g0 + (1u << LIM_RELEASE_SHIFT) - 1) >> LIM_RELEASE_SHIFT);
+    return g1;
+}
+
+// linked = false in dual mono routing (route_block_dual)
+static inline void limiter_process_block(int32_t* l, int32_t* r, size_t frames, bool linked) {
+    if (linked != limiter.linked) limiter_set_linked(linked);
+    LimGain* gl = &limiter.ch[0];
+    LimGain* gr = linked ? gl : &limiter.ch[1];
+
+    for (size_t s = 0; s < frames; s += LIM_DECIM) {
+        // Peaks of the incoming sub-block -> their target gains
+        uint32_t peak_l = 0, peak_r = 0;
+        for (size_t i = s; i < s + LIM_DECIM; i++) {
+            uint32_t a = lim_abs(l[i]);
+            uint32_t b = lim_abs(r[i]);
+            if (a > peak_l) peak_l = a;
+            if (b > peak_r) peak_r = b;
+        }
+
+        limiter.tpos = (limiter.tpos + 1) % LIM_WINDOW;
+        if (linked) {
+            gl->target_q16[limiter.tpos] = limiter_target((peak_l > peak_r) ? peak_l : peak_r);
+        } else {
+            gl->target_q16[limiter.tpos] = limiter_target(peak_l);
+            gr->target_q16[limiter.tpos] = limiter_target(peak_r);
+        }
+
+        uint32_t g0l   = gl->gain_q16;
+        uint32_t g0r   = gr->gain_q16;
+        uint32_t g1l   = limiter_next_gain(gl);
+        uint32_t g1r   = linked ? g1l : limiter_next_gain(gr);
+        int32_t  diffl = (int32_t)g1l - (int32_t)g0l;
+        int32_t  diffr = (int32_t)g1r - (int32_t)g0r;
+
+        // Delay and apply the interpolated gains
+        for (size_t i = 0; i < LIM_DECIM; i++) {
+            uint32_t w  = limiter.widx & (LIM_RING - 1);
+            uint32_t rd = (limiter.widx - LIM_LOOKAHEAD) & (LIM_RING - 1);
+            limiter.ring_l[w] = l[s + i];
+            limiter.ring_r[w] = r[s + i];
+            limiter.widx++;
+
+            uint32_t gla = (uint32_t)((int32_t)g0l + diffl * (int32_t)(i + 1) / LIM_DECIM);
+            uint32_t gra = linked ? gla : (uint32_t)((int32_t)g0r + diffr * (int32_t)(i + 1) / LIM_DECIM);
+            l[s + i] = multiply_q16(limiter.ring_l[rd], gla);
+            r[s + i] = multiply_q16(limiter.ring_r[rd], gra);
+        }
+        gl->gain_q16 = g1l;
+        gr->gain_q16 = g1r;
+    }
+}
+
+#endif // LIMITER_H
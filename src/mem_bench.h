@@ -0,0 +1,146 @@
+/* mem_bench.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MEM_BENCH_H
+#define MEM_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// ============================================================================
+// === SRAM contention benchmark ==============================================
+// ============================================================================
+//
+// Runs at the start of main() (MEM_BENCH), before core 1 is launched and
+// before mem_layout_init() zeroes the banks, so the bank regions are free
+// to scribble on. Core 0 times a delay-line style read-modify-write loop
+// while core 1 runs the same loop on another buffer, once per placement:
+//
+//   alone       core 1 idle (reference)
+//   striped     both buffers striped: the layout without the bank table
+//   same bank   both in bank 0: the worst case
+//   own banks   core 0 in bank 0, core 1 in bank 3: the bank table
+//
+// Code and stacks of both loops sit in the scratch banks (core 0: Y,
+// core 1: X), so only the data placement differs between the runs.
+// The result is printed once USB is connected (core 1 debug output).
+//
+// Expected, not yet measured on a board: the loop is 12 cycles and 2 SRAM
+// accesses per word (tools/m0sim.py on a hand-assembled copy of it). An
+// access that collides with the other core waits one cycle, so:
+//
+//   alone       12.0
+//   striped     <= 14.0 (+17%), collides when both are on the same bank
+//   same bank   <= 14.0 (+17%)
+//   own banks      12.0 (+0%)
+//
+// The emulator does not model the second core; the measured row comes from
+// a boot with MEM_BENCH 1.
+
+#define MEM_BENCH_WORDS     1024                // 4 kB per buffer
+#define MEM_BENCH_PASSES    64
+
+// Striped addresses past the end of RAM (memmap_banked.ld): the same cells
+// as the bank regions, spread over all four banks
+#define MEM_BENCH_STRIPED_A 0x20020000u
+#define MEM_BENCH_STRIPED_B 0x20030000u
+
+typedef struct {
+    const char* name;
+    uint32_t    core0_buf;
+    uint32_t    core1_buf;                      // 0 = core 1 idle
+    uint32_t    cycles_x100;                    // Core 0 cycles per word x 100
+} MemBenchCase;
+
+static MemBenchCase mem_bench_cases[] = {
+    { "alone",     MEM_BANK_BASE(0),    0,                          0 },
+    { "striped",   MEM_BENCH_STRIPED_A, MEM_BENCH_STRIPED_B,        0 },
+    { "same bank", MEM_BANK_BASE(0),    MEM_BANK_BASE(0) + 0x4000u, 0 },
+    { "own banks", MEM_BANK_BASE(0),    MEM_BANK_BASE(3),           0 },
+};
+
+#define MEM_BENCH_NUM_CASES (sizeof(mem_bench_cases) / sizeof(mem_bench_cases[0]))
+
+static volatile uint32_t __scratch_x("mem_bench") mem_bench_load = 0;     // Core 1 buffer, 0 = idle
+static volatile bool     __scratch_x("mem_bench") mem_bench_core1_up = false;
+static bool mem_bench_done = false;
+
+static inline __attribute__((always_inline)) void mem_bench_kernel(int32_t* buf, uint32_t passes) {
+    for (uint32_t p = 0; p < passes; p++) {
+        for (uint32_t i = 0; i < MEM_BENCH_WORDS; i++) {
+            int32_t x = buf[i];
+            buf[i] = x - (x >> 3) + (int32_t)i;
+        }
+    }
+}
+
+static void __scratch_y("mem_bench") __attribute__((noinline)) mem_bench_core0_kernel(int32_t* buf, uint32_t passes) {
+    mem_bench_kernel(buf, passes);
+}
+
+static void __scratch_x("mem_bench") __attribute__((noinline)) mem_bench_core1(void) {
+    mem_bench_core1_up = true;
+    while (true) {
+        uint32_t buf = mem_bench_load;
+        if (buf) mem_bench_kernel((int32_t*)(uintptr_t)buf, 1);
+    }
+}
+
+// Core 0, core 1 must not be running yet (it is reset afterwards)
+static void mem_bench_run(void) {
+    const uint32_t sys_mhz = clock_get_hz(clk_sys) / 1000000;
+
+    multicore_launch_core1(mem_bench_core1);
+    while (!mem_bench_core1_up) tight_loop_contents();
+
+    for (uint32_t c = 0; c < MEM_BENCH_NUM_CASES; c++) {
+        MemBenchCase* bc = &mem_bench_cases[c];
+        mem_bench_load = bc->core1_buf;
+        busy_wait_us_32(100);                   // Core 1 in its loop
+
+        uint64_t start = time_us_64();
+        mem_bench_core0_kernel((int32_t*)(uintptr_t)bc->core0_buf, MEM_BENCH_PASSES);
+        uint64_t us = time_us_64() - start;
+
+        mem_bench_load = 0;
+        bc->cycles_x100 = (uint32_t)((us * sys_mhz * 100) / (MEM_BENCH_PASSES * MEM_BENCH_WORDS));
+    }
+
+    multicore_reset_core1();
+    mem_bench_done = true;
+}
+
+// Core 1 debug output, once
+static void mem_bench_print(void) {
+    static bool printed = false;
+    if (!mem_bench_done || printed || !stdio_usb_connected()) return;
+    printed = true;
+
+    const uint32_t ref = mem_bench_cases[0].cycles_x100;
+    printf("SRAM contention (core 0 cycles per word):\n");
+    for (uint32_t c = 0; c < MEM_BENCH_NUM_CASES; c++) {
+        const MemBenchCase* bc = &mem_bench_cases[c];
+        uint32_t extra = (ref && bc->cycles_x100 > ref) ? ((bc->cycles_x100 - ref) * 100) / ref : 0;
+        printf("  %-9s : %lu.%02lu (+%lu%%)\n", bc->name, (unsigned long)(bc->cycles_x100 / 100),
+               (unsigned long)(bc->cycles_x100 % 100), (unsigned long)extra);
+    }
+}
+
+#endif // MEM_BENCH_H
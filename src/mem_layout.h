@@ -0,0 +1,125 @@
+/* mem_layout.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MEM_LAYOUT_H
+#define MEM_LAYOUT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+// === SRAM bank placement ====================================================
+// ============================================================================
+//
+// Two bus masters only wait for each other when they hit the same SRAM bank
+// in the same cycle. Striped RAM spreads every buffer over all four banks,
+// so core 0 (audio), core 1 (UI, spectrum) and the DMA collide on any bank.
+// memmap_banked.ld keeps the upper half of each bank (32 kB) out of the
+// striped map. The table below puts each hot buffer group into one of them:
+//
+//   bank        user            buffers                                   ~kB
+//   BANK0       core 0          reverb comb ring L                        32
+//   BANK1       core 0          reverb comb ring R                        32
+//   BANK2       core 0, DMA     reverb all-pass rings L and R, chorus,    30
+//                               flanger, compressor look-ahead, MBC
+//                               bands, routing buffers, I2S DMA ring,
+//                               spectrum tap ring
+//   BANK3       core 1          spectrum window, twiddles, FFT buffers     6
+//   SCRATCH_Y   core 0          stack, chain buffers buffer_l / _r
+//   SCRATCH_X   core 1          stack
+//
+// The only place where both cores meet is the spectrum tap ring: core 0
+// writes it every block, core 1 copies a frame out of it every SPECTRUM_HOP
+// samples (512 reads per 10.7 ms). It sits with its writer.
+//
+// Both all-pass halves need BANK2 (20 kB), so the deferred lanes (6 kB,
+// copied in and out once per sample) moved to the striped RAM: core 0 there
+// only waits for core 1's UI code, never for the FFT.
+//
+// Code in RAM (.time_critical), effect states, the deferred lanes and
+// everything else stay striped. Moving an effect to core 1 = pointing its
+// entry at a core 1 bank.
+// The bank sections are not loaded: only zero-initialised buffers, zeroed
+// by mem_layout_init() before anything else runs.
+
+#define MEM_BANK_SIZE       0x8000u                                 // Upper half of a bank
+#define MEM_BANK_BASE(n)    (0x21008000u + (uint32_t)(n) * 0x10000u) // Non-striped alias
+
+#define MEM_BANK0           __attribute__((section(".sram_bank0")))
+#define MEM_BANK1           __attribute__((section(".sram_bank1")))
+#define MEM_BANK2           __attribute__((section(".sram_bank2")))
+#define MEM_BANK3           __attribute__((section(".sram_bank3")))
+#define MEM_CORE0_SCRATCH   __scratch_y("audio")                    // With the core 0 stack
+#define MEM_STRIPED                                                 // Plain .bss
+
+// === Placement table ===
+#define PLACE_REVERB_L          MEM_BANK0
+#define PLACE_REVERB_R          MEM_BANK1
+#define PLACE_REVERB_AP_L       MEM_BANK2
+#define PLACE_REVERB_AP_R       MEM_BANK2
+#define PLACE_CHORUS            MEM_BANK2
+#define PLACE_FLANGER           MEM_BANK2
+#define PLACE_COMPRESSOR        MEM_BANK2
+#define PLACE_MB_COMPRESSOR     MEM_BANK2
+#define PLACE_DEFERRED          MEM_STRIPED
+#define PLACE_ROUTING           MEM_BANK2
+#define PLACE_SPECTRUM_TAP      MEM_BANK2
+#define PLACE_SPECTRUM          MEM_BANK3
+#define PLACE_I2S_DMA           MEM_BANK2
+#define PLACE_CHAIN             MEM_CORE0_SCRATCH
+
+// Linker symbols (memmap_banked.ld)
+extern uint8_t __sram_bank0_start__, __sram_bank0_end__;
+extern uint8_t __sram_bank1_start__, __sram_bank1_end__;
+extern uint8_t __sram_bank2_start__, __sram_bank2_end__;
+extern uint8_t __sram_bank3_start__, __sram_bank3_end__;
+
+typedef struct {
+    const char* name;
+    const char* user;
+    uint8_t*    start;
+    uint8_t*    end;
+} MemBank;
+
+static const MemBank mem_banks[] = {
+    { "bank0", "core 0",      &__sram_bank0_start__, &__sram_bank0_end__ },
+    { "bank1", "core 0",      &__sram_bank1_start__, &__sram_bank1_end__ },
+    { "bank2", "core 0, DMA", &__sram_bank2_start__, &__sram_bank2_end__ },
+    { "bank3", "core 1",      &__sram_bank3_start__, &__sram_bank3_end__ },
+};
+
+#define MEM_NUM_BANKS   (sizeof(mem_banks) / sizeof(mem_banks[0]))
+
+// Zero the bank sections (start of main, before any of their users)
+static void mem_layout_init(void) {
+    for (uint32_t b = 0; b < MEM_NUM_BANKS; b++) {
+        memset(mem_banks[b].start, 0, (size_t)(mem_banks[b].end - mem_banks[b].start));
+    }
+}
+
+static void mem_layout_print(void) {
+    for (uint32_t b = 0; b < MEM_NUM_BANKS; b++) {
+        uint32_t used = (uint32_t)(mem_banks[b].end - mem_banks[b].start);
+        printf("%s : %5lu / %lu bytes (%s)\n", mem_banks[b].name,
+               (unsigned long)used, (unsigned long)MEM_BANK_SIZE, mem_banks[b].user);
+    }
+}
+
+#endif // MEM_LAYOUT_H
@@ -0,0 +1,220 @@
+/* midi.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MIDI_H
+#define MIDI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================================
+// === MIDI Parser and Event Queue ============================================
+// ============================================================================
+//
+// Plain C, no SDK dependencies: bytes come in through a read function
+// (TinyUSB on the device, anything on a host), the parser turns them into
+// events and a single-producer / single-consumer ring hands them from
+// core 1 (producer) to the audio block loop on core 0 (consumer).
+//
+// Only what the firmware uses is decoded: Program Change, Control Change
+// and the real-time clock messages. Everything else is skipped.
+
+#ifndef MIDI_QUEUE_SIZE
+#define MIDI_QUEUE_SIZE         64              // Power of two
+#endif
+
+// Publish barrier between the cores (defaults to the Cortex-M0+ DMB)
+#ifndef MIDI_MEMORY_BARRIER
+#define MIDI_MEMORY_BARRIER()   __dmb()
+#endif
+
+typedef enum {
+    MIDI_EV_CONTROL_CHANGE,
+    MIDI_EV_PROGRAM_CHANGE,
+    MIDI_EV_CLOCK,
+    MIDI_EV_START,
+    MIDI_EV_CONTINUE,
+    MIDI_EV_STOP
+} MidiEventType;
+
+typedef struct {
+    uint8_t  type;                              // MidiEventType
+    uint8_t  channel;                           // 0..15 (channel messages)
+    uint8_t  data1;                             // CC number / program
+    uint8_t  data2;                             // CC value
+    uint32_t time_us;                           // Arrival time (clock averaging)
+} MidiEvent;
+
+typedef struct {
+    uint8_t status;                             // Running status (0 = none)
+    uint8_t data[2];
+    uint8_t count;                              // Data bytes collected
+    bool    in_sysex;
+} MidiParser;
+
+typedef struct {
+    MidiEvent ev[MIDI_QUEUE_SIZE];
+    volatile uint32_t head;                     // Written by the producer
+    volatile uint32_t tail;                     // Written by the consumer
+    uint32_t dropped;                           // Events lost on a full queue
+} MidiQueue;
+
+// Byte source: copy the bytes of one arrival (up to max) into buf, set
+// *time_us to when they arrived and return the count (0 = nothing left)
+typedef size_t (*MidiReadFn)(uint8_t* buf, size_t max, uint32_t* time_us);
+
+// ============================================================================
+// === Parser =================================================================
+// ============================================================================
+
+static inline void midi_parser_reset(MidiParser* p) {
+    p->status   = 0;
+    p->count    = 0;
+    p->in_sysex = false;
+}
+
+// Data bytes a channel status needs
+static inline uint8_t midi_data_len(uint8_t status) {
+    switch (status & 0xF0) {
+        case 0xC0:
+        case 0xD0: return 1;
+        default:   return 2;
+    }
+}
+
+// Feed one byte, returns true when *out holds a complete event
+static inline bool midi_parse_byte(MidiParser* p, uint8_t b, uint32_t now_us, MidiEvent* out) {
+    // Real-time: single byte, may appear anywhere (even inside other messages)
+    if (b >= 0xF8) {
+        out->channel = 0;
+        out->data1   = 0;
+        out->data2   = 0;
+        out->time_us = now_us;
+        switch (b) {
+            case 0xF8: out->type = MIDI_EV_CLOCK;    return true;
+            case 0xFA: out->type = MIDI_EV_START;    return true;
+            case 0xFB: out->type = MIDI_EV_CONTINUE; return true;
+            case 0xFC: out->type = MIDI_EV_STOP;     return true;
+            default:   return false;
+        }
+    }
+
+    // System exclusive / common: skip, and cancel running status
+    if (b >= 0xF0) {
+        p->in_sysex = (b == 0xF0);
+        p->status   = 0;
+        p->count    = 0;
+        return false;
+    }
+
+    // New channel status
+    if (b & 0x80) {
+        p->in_sysex = false;
+        p->status   = b;
+        p->count    = 0;
+        return false;
+    }
+
+    // Data byte
+    if (p->in_sysex || p->status == 0) return false;
+
+    p->data[p->count++] = b;
+    if (p->count < midi_data_len(p->status)) return false;
+    p->count = 0;                               // Keep status (running status)
+
+    out->channel = p->status & 0x0F;
+    out->data1   = p->data[0];
+    out->data2   = (midi_data_len(p->status) == 2) ? p->data[1] : 0;
+    out->time_us = now_us;
+
+    switch (p->status & 0xF0) {
+        case 0xB0: out->type = MIDI_EV_CONTROL_CHANGE; return true;
+        case 0xC0: out->type = MIDI_EV_PROGRAM_CHANGE; return true;
+        default:   return false;                // Notes etc. are not used
+    }
+}
+
+// ============================================================================
+// === Queue (SPSC) ===========================================================
+// ============================================================================
+
+static inline void midi_queue_init(MidiQueue* q) {
+    q->head = 0;
+    q->tail = 0;
+    q->dropped = 0;
+}
+
+// Producer side
+static inline bool midi_queue_push(MidiQueue* q, const MidiEvent* e) {
+    uint32_t head = q->head;
+    if (head - q->tail >= MIDI_QUEUE_SIZE) {
+        q->dropped++;
+        return false;
+    }
+    q->ev[head & (MIDI_QUEUE_SIZE - 1)] = *e;
+    MIDI_MEMORY_BARRIER();                      // Event visible before the index
+    q->head = head + 1;
+    return true;
+}
+
+// Consumer side
+static inline bool midi_queue_pop(MidiQueue* q, MidiEvent* e) {
+    uint32_t tail = q->tail;
+    if (tail == q->head) return false;
+    MIDI_MEMORY_BARRIER();                      // Index read before the event
+    *e = q->ev[tail & (MIDI_QUEUE_SIZE - 1)];
+    MIDI_MEMORY_BARRIER();                      // Event read before the slot is released
+    q->tail = tail + 1;
+    return true;
+}
+
+// ============================================================================
+// === Transport ==============================================================
+// ============================================================================
+
+// MIDI bytes in a USB-MIDI event packet, by its code index number (low nibble of byte 0)
+static inline size_t midi_usb_packet_len(uint8_t cin) {
+    switch (cin & 0x0F) {
+        case 0x5: case 0xF:                     return 1;   // Single byte, SysEx end with 1
+        case 0x2: case 0x6: case 0xC: case 0xD: return 2;
+        case 0x0: case 0x1:                     return 0;   // Reserved
+        default:                                return 3;
+    }
+}
+
+// Pull everything the transport has, parse it and queue the events
+static inline size_t midi_poll(MidiParser* p, MidiQueue* q, MidiReadFn read) {
+    uint8_t buf[32];
+    size_t queued = 0;
+    size_t n;
+    uint32_t time_us;
+
+    while ((n = read(buf, sizeof(buf), &time_us)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            MidiEvent e;
+            if (midi_parse_byte(p, buf[i], time_us, &e) && midi_queue_push(q, &e)) {
+                queued++;
+            }
+        }
+    }
+    return queued;
+}
+
+#endif // MIDI_H
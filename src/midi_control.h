@@ -0,0 +1,202 @@
+/* midi_control.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MIDI_CONTROL_H
+#define MIDI_CONTROL_H
+
+#include "tusb.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/structs/usb.h"
+#include "midi.h"
+
+// ============================================================================
+// === MIDI Control (USB-MIDI -> audio block loop) ============================
+// ============================================================================
+//
+// Core 1 polls TinyUSB and parses into the event queue (midi.h), core 0
+// drains it at the start of every audio block, so all MIDI changes land
+// on a block boundary. The events carry the time their USB transfer
+// arrived, taken in the USB interrupt (midi_usb_irq), not when the core 1
+// loop gets to them (the OLED update alone holds it for milliseconds):
+//   - Clock:   tempo from the span of 24 ticks (one beat) drives
+//              tap_interval_ms, and each beat re-aligns the LFO phase
+//   - Start:   restarts the beat / bar position (clock without a
+//              Start, e.g. a stopped DAW, still sets the tempo)
+//   - CC:      MIDI_MOD_CC feeds the MIDI modulation source
+//   - Program: handed back to core 1 (preset recall runs the loaders)
+
+#define MIDI_MOD_CC             1               // Mod wheel
+#define MIDI_CLOCK_PPQN         24
+#define MIDI_TEMPO_MIN_MS       100             // 600 BPM
+#define MIDI_TEMPO_MAX_MS       2000            // 30 BPM
+#define MIDI_USB_OUT_EP         3               // EPNUM_MIDI_OUT (usb_descriptors.c)
+#define MIDI_STAMP_SLOTS        16              // Power of two
+
+static MidiParser midi_parser;
+static MidiQueue  midi_queue;
+
+// Core 0 state
+static uint32_t midi_clock_count    = 0;        // Ticks since the last beat
+static uint32_t midi_beat_start_us  = 0;
+static bool     midi_beat_valid     = false;    // midi_beat_start_us is a real beat
+
+// Core 0 -> core 1, under midi_program_lock
+static int16_t      midi_pending_program = -1;
+static spin_lock_t* midi_program_lock    = NULL;
+
+// Arrival of the USB transfers not read yet: USB IRQ -> core 1 loop
+typedef struct {
+    uint32_t time_us;
+    uint32_t packets;                           // USB-MIDI event packets (4 bytes) left
+} MidiStamp;
+
+static MidiStamp         midi_stamps[MIDI_STAMP_SLOTS];
+static volatile uint32_t midi_stamp_head = 0;   // Written by the IRQ
+static volatile uint32_t midi_stamp_tail = 0;   // Written by the loop
+
+// ============================================================================
+// === Core 1: transport ======================================================
+// ============================================================================
+
+// Shared USBCTRL handler, in front of TinyUSB's: stamp each MIDI OUT transfer
+static void __not_in_flash_func(midi_usb_irq)(void) {
+    const uint32_t bit = 1u << (MIDI_USB_OUT_EP * 2 + 1);
+    if (!(usb_hw->buf_status & bit)) return;
+
+    uint32_t len  = usb_dpram->ep_buf_ctrl[MIDI_USB_OUT_EP].out & USB_BUF_CTRL_LEN_MASK;
+    uint32_t head = midi_stamp_head;
+    if (len < 4 || head - midi_stamp_tail >= MIDI_STAMP_SLOTS) return;   // Full: poll time instead
+
+    midi_stamps[head & (MIDI_STAMP_SLOTS - 1)] = (MidiStamp){ time_us_32(), len / 4 };
+    midi_stamp_head = head + 1;
+}
+
+// One USB-MIDI event packet, stamped with the arrival of its transfer
+static size_t midi_usb_read(uint8_t* buf, size_t max, uint32_t* time_us) {
+    uint8_t packet[4];
+    size_t  n;
+    if (max < 3) return 0;
+
+    do {                                        // Reserved packets carry no bytes
+        if (!tud_midi_packet_read(packet)) return 0;
+
+        uint32_t tail = midi_stamp_tail;
+        if (tail != midi_stamp_head) {
+            MidiStamp* s = &midi_stamps[tail & (MIDI_STAMP_SLOTS - 1)];
+            *time_us = s->time_us;
+            if (--s->packets == 0) midi_stamp_tail = tail + 1;
+        } else {
+            *time_us = time_us_32();
+        }
+        n = midi_usb_packet_len(packet[0]);
+    } while (n == 0);
+
+    memcpy(buf, &packet[1], n);
+    return n;
+}
+
+// Core 1, after tusb_init (the USB interrupt runs on the core that set it up)
+void init_midi(void) {
+    midi_parser_reset(&midi_parser);
+    midi_queue_init(&midi_queue);
+    midi_program_lock = spin_lock_instance((uint)spin_lock_claim_unused(true));
+
+    // Added after TinyUSB's handler with the same order priority, so it runs first
+    irq_add_shared_handler(USBCTRL_IRQ, midi_usb_irq, PICO_SHARED_IRQ_HANDLER_HIGHEST_ORDER_PRIORITY);
+}
+
+// Call from the core 1 loop, right after tud_task()
+void midi_poll_usb(void) {
+    midi_poll(&midi_parser, &midi_queue, midi_usb_read);
+}
+
+// Program change received since the last call, or -1
+static inline int midi_take_program(void) {
+    uint32_t irq = spin_lock_blocking(midi_program_lock);
+    int pc = midi_pending_program;
+    midi_pending_program = -1;
+    spin_unlock(midi_program_lock, irq);
+    return pc;
+}
+
+// ============================================================================
+// === Core 0: block start ====================================================
+// ============================================================================
+
+static inline void midi_handle_clock(uint32_t time_us) {
+    if (++midi_clock_count < MIDI_CLOCK_PPQN) return;
+    midi_clock_count = 0;
+
+    // One beat: tempo from 24 tick timestamps (averages out the USB frame jitter)
+    if (midi_beat_valid) {
+        uint32_t span_ms = (time_us - midi_beat_start_us + 500u) / 1000u;
+        if (span_ms >= MIDI_TEMPO_MIN_MS && span_ms <= MIDI_TEMPO_MAX_MS && span_ms != tap_interval_ms) {
+            tap_interval_ms   = span_ms;
+            activate_tap_flag = true;           // Core 1 reloads the delay times
+        }
+    }
+    midi_beat_start_us = time_us;
+    midi_beat_valid    = true;
+
+    // Re-align the beat LFOs (count the beat unless the phase has just wrapped)
+    if (mod_beat_phase >= 0x80000000u) mod_beat_count++;
+    mod_beat_phase = 0;
+}
+
+static inline void midi_process_block(void) {
+    MidiEvent e;
+    while (midi_queue_pop(&midi_queue, &e)) {
+        switch (e.type) {
+            case MIDI_EV_CLOCK:
+                midi_handle_clock(e.time_us);
+                break;
+
+            case MIDI_EV_START:
+                midi_clock_count   = MIDI_CLOCK_PPQN - 1;   // Next clock is the downbeat
+                midi_beat_valid    = false;
+                mod_beat_phase     = 0;
+                mod_beat_count     = 0;
+                break;
+
+            case MIDI_EV_CONTINUE:
+            case MIDI_EV_STOP:
+                midi_beat_valid    = false;     // Clock may pause, skip one measurement
+                break;
+
+            case MIDI_EV_CONTROL_CHANGE:
+                if (e.data1 == MIDI_MOD_CC) {
+                    mod_src_q16[MOD_SRC_MIDI] = (int32_t)(((uint32_t)e.data2 * Q16_ONE) / 127u);
+                }
+                break;
+
+            case MIDI_EV_PROGRAM_CHANGE: {
+                uint32_t irq = spin_lock_blocking(midi_program_lock);
+                midi_pending_program = e.data1;
+                spin_unlock(midi_program_lock, irq);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
+#endif // MIDI_CONTROL_H
@@ -0,0 +1,217 @@
+/* modulation.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MODULATION_H
+#define MODULATION_H
+
+// ============================================================================
+// === Block-rate Parameter Modulation ========================================
+// ============================================================================
+//
+// A destination is a parameter that has a ramped fast path in its kernel.
+// Its value is looked up once per block from a position (0..1, Q16) through a
+// small curve table built on core 1, and the kernel ramps to it sample by
+// sample. The position normally follows the pot the parameter belongs to,
+// unless the expression pedal is assigned to it.
+//
+// On top of that a small matrix adds modulation: each route scales one
+// source (shared LFOs, input envelope, pedal, tap clock, MIDI CC) by a depth and adds
+// it to the position of one destination. Sources are also evaluated once per
+// block, so no effect needs per-sample modulation code of its own.
+//
+// Only parameters whose kernel reads a ParamRamp can be destinations, five
+// today (volume, delay mix, preamp drive trim, reverb mix, tremolo depth).
+// The others change through their loaders and coefficient banks, a block
+// at a time, which is too coarse for an LFO. A new destination takes a
+// ParamRamp in its kernel, a ModDest entry with its name (ui_variables.h)
+// and a row in mod_dests; init_modulation builds its curve from the row.
+
+#define MOD_CURVE_BITS      4                           // 16 segments
+#define MOD_CURVE_POINTS    ((1 << MOD_CURVE_BITS) + 1)
+#define MOD_MAX_ROUTES      4
+#define MOD_ENV_GAIN_SHIFT  2                           // Envelope x4 before it saturates
+
+typedef enum {
+    MOD_CURVE_LINEAR,                                   // min..max in native units
+    MOD_CURVE_DB                                        // min..max in dB, Q8.24 gain
+} ModCurveShape;
+
+// Parameter descriptor (indexed by ModDest, names live with the UI)
+typedef struct {
+    const uint16_t* base_pot;                           // Pot it follows (NULL = fixed base)
+    uint16_t        fixed_base;                         // Base position in pot units if no pot
+    ParamRamp*      ramp;                               // Read by the kernel
+    ModCurveShape   shape;                              // Same mapping as the load_* function
+    float           min, max;
+    int32_t         curve[MOD_CURVE_POINTS];            // Native value along the position
+} ModDestDesc;
+
+// Preamp drive trim (applied in front of the preamp kernels, unity at rest)
+static ParamRamp preamp_drive_ramp = { Q24_ONE, 0, Q24_ONE };
+
+static ModDestDesc mod_dests[NUM_MOD_DESTS] = {
+    [MOD_DEST_NONE]         = { NULL,                                   0,       NULL },
+    [MOD_DEST_VOLUME]       = { &pot_value[6],                          0,       &volume_ramp,        MOD_CURVE_LINEAR, 0, Q16_ONE },     // volume_q16
+    [MOD_DEST_DELAY_MIX]    = { &storedPotValue[DELAY_EFFECT_INDEX][3], 0,       &delay_mix_ramp,     MOD_CURVE_LINEAR, 0, Q16_ONE },     // delay_mix_q16
+    [MOD_DEST_PREAMP_DRIVE] = { NULL,                                   POT_MAX, &preamp_drive_ramp,  MOD_CURVE_DB,     -24.0f, 0.0f },   // input trim
+    [MOD_DEST_REVERB_MIX]   = { &storedPotValue[REVB_EFFECT_INDEX][0],  0,       &reverb_mix_ramp,    MOD_CURVE_LINEAR, 0, Q24_ONE },     // reverb_mix_q24
+    [MOD_DEST_TREM_DEPTH]   = { &storedPotValue[TREM_EFFECT_INDEX][1],  0,       &tremolo_depth_ramp, MOD_CURVE_LINEAR, 0, Q16_ONE },     // tremolo_depth_q16
+};
+
+// Matrix route (bytes only, so core 1 can edit them while core 0 reads)
+typedef struct {
+    uint8_t src;                                        // ModSource
+    uint8_t dest;                                       // ModDest
+    int8_t  depth;                                      // -100..+100 %
+} ModRoute;
+
+static ModRoute mod_routes[MOD_MAX_ROUTES];
+
+// Shared sources (block rate)
+static EnvFollower mod_env;
+static EnvTimes    mod_env_times;                       // Fixed, set once by init_modulation
+static uint32_t mod_beat_phase  = 0;                    // One cycle per beat
+static uint32_t mod_beat_count  = 0;                    // Beats elapsed (bar position)
+static uint32_t mod_beat_inc    = 0;
+static uint32_t mod_beat_tap_ms = 0;                    // Tempo the increment was computed for
+static int32_t  mod_src_q16[NUM_MOD_SRCS];              // Latest source values (LFOs bipolar)
+
+// ============================================================================
+// === Core 1: curves =========================================================
+// ============================================================================
+
+static inline void mod_fill_linear(ModDestDesc* d, int32_t min, int32_t max) {
+    for (int i = 0; i < MOD_CURVE_POINTS; i++) {
+        d->curve[i] = min + (int32_t)(((int64_t)(max - min) * i) / (MOD_CURVE_POINTS - 1));
+    }
+}
+
+static inline void mod_fill_db(ModDestDesc* d, float min_db, float max_db) {
+    for (int i = 0; i < MOD_CURVE_POINTS; i++) {
+        float db = min_db + (max_db - min_db) * (float)i / (MOD_CURVE_POINTS - 1);
+        d->curve[i] = db_to_q24(db);
+    }
+}
+
+// Build the curves from the descriptor rows
+void init_modulation(void) {
+    for (int i = MOD_DEST_NONE + 1; i < NUM_MOD_DESTS; i++) {
+        ModDestDesc* d = &mod_dests[i];
+        if (d->shape == MOD_CURVE_DB) mod_fill_db(d, d->min, d->max);
+        else                          mod_fill_linear(d, (int32_t)d->min, (int32_t)d->max);
+    }
+
+    env_follower_set_times(&mod_env_times, 5.0f, 200.0f);
+    env_follower_reset(&mod_env);
+}
+
+// ============================================================================
+// === Core 0: block update ===================================================
+// ============================================================================
+
+// Pot units -> Q16 position (4095 -> 65535 without a divide)
+static inline __attribute__((always_inline)) uint32_t mod_pot_to_q16(uint32_t pot) {
+    return (pot << 4) + (pot >> 8);
+}
+
+// Position -> native value (curve lerp)
+static inline __attribute__((always_inline)) int32_t mod_curve_lookup(const ModDestDesc* d, uint32_t pos_q16) {
+    if (pos_q16 >= Q16_ONE) return d->curve[MOD_CURVE_POINTS - 1];
+    uint32_t idx  = pos_q16 >> (16 - MOD_CURVE_BITS);
+    uint32_t frac = (pos_q16 << MOD_CURVE_BITS) & 0xFFFF;
+    return lerp_fixed(d->curve[idx], d->curve[idx + 1], frac);
+}
+
+// Advance the shared sources by one block (only the ones a route uses)
+static inline void mod_update_sources(uint32_t used, size_t frames) {
+    // Tempo -> per-block phase increment, divide only when the tempo changes
+    if (mod_beat_tap_ms != tap_interval_ms && tap_interval_ms > 0) {
+        mod_beat_tap_ms = tap_interval_ms;
+        mod_beat_inc = (uint32_t)((4294967296ull * frames * 1000u) / ((uint64_t)SAMPLE_RATE * tap_interval_ms));
+    }
+    uint32_t prev_phase = mod_beat_phase;
+    mod_beat_phase += mod_beat_inc;
+    if (mod_beat_phase < prev_phase) mod_beat_count++;
+
+    if (used & (1u << MOD_SRC_LFO1)) {
+        mod_src_q16[MOD_SRC_LFO1] = (int32_t)lfo_q16_shape(mod_beat_phase, LFO_SINE) - Q16_ONE / 2;
+    }
+    if (used & (1u << MOD_SRC_LFO2)) {
+        // Bar phase: beat count in the top 2 bits
+        uint32_t bar_phase = ((mod_beat_count & 3u) << 30) | (mod_beat_phase >> 2);
+        mod_src_q16[MOD_SRC_LFO2] = (int32_t)lfo_q16_shape(bar_phase, LFO_TRIANGLE) - Q16_ONE / 2;
+    }
+    if (used & (1u << MOD_SRC_ENV)) {
+        const EnvTap* tap = env_get(ENV_TAP_INPUT);
+        env_request(ENV_TAP_INPUT);
+        uint32_t env = ((uint32_t)env_follower_tap(&mod_env, &mod_env_times, ENV_TAP_INPUT, tap->peak_l) >> 15) << MOD_ENV_GAIN_SHIFT;
+        mod_src_q16[MOD_SRC_ENV] = (env > Q16_ONE) ? Q16_ONE : (int32_t)env;
+    }
+    mod_src_q16[MOD_SRC_EXP] = (int32_t)exp_value_q16;
+    mod_src_q16[MOD_SRC_TAP] = (int32_t)(mod_beat_phase >> 16);
+}
+
+// Once per audio block, before the slots run.
+// The expression pedal (if assigned) replaces the position of its target,
+// then the matrix routes add their offsets.
+static inline void modulation_process_block(size_t frames) {
+    int32_t  offset_q16[NUM_MOD_DESTS] = { 0 };
+    uint32_t used = 0;
+
+    for (int r = 0; r < MOD_MAX_ROUTES; r++) {
+        if (mod_routes[r].src != MOD_SRC_NONE && mod_routes[r].dest != MOD_DEST_NONE) {
+            used |= 1u << mod_routes[r].src;
+        }
+    }
+    mod_update_sources(used, frames);
+
+    for (int r = 0; r < MOD_MAX_ROUTES; r++) {
+        const ModRoute* rt = &mod_routes[r];
+        if (!(used & (1u << rt->src)) || rt->dest >= NUM_MOD_DESTS) continue;
+        int32_t depth_q16 = (int32_t)rt->depth * 655;   // % -> Q16 (655.36)
+        offset_q16[rt->dest] += (int32_t)(((int64_t)mod_src_q16[rt->src] * depth_q16) >> 16);
+    }
+
+    for (int i = MOD_DEST_NONE + 1; i < NUM_MOD_DESTS; i++) {
+        const ModDestDesc* d = &mod_dests[i];
+        int32_t pos = (int32_t)mod_pot_to_q16(d->base_pot ? *d->base_pot : d->fixed_base);
+        if (exp_target == i) pos = (int32_t)mod_src_q16[MOD_SRC_EXP];
+        pos += offset_q16[i];
+        if (pos < 0) pos = 0;
+        ramp_begin_block(d->ramp, mod_curve_lookup(d, (uint32_t)pos), frames);
+    }
+}
+
+// ============================================================================
+// === Kernels ================================================================
+// ============================================================================
+
+// Preamp drive trim, skipped while it sits at unity
+static inline __attribute__((always_inline))
+void preamp_drive_trim_block(int32_t* in_l, int32_t* in_r, size_t frames) {
+    if (preamp_drive_ramp.value == Q24_ONE && preamp_drive_ramp.step == 0) return;
+
+    for (size_t i = 0; i < frames; i++) {
+        int32_t g = ramp_tick(&preamp_drive_ramp);
+        in_l[i] = qmul(in_l[i], g);
+        in_r[i] = qmul(in_r[i], g);
+    }
+}
+
+#endif // MODULATION_H
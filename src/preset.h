@@ -0,0 +1,156 @@
+/* preset.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef PRESET_H
+#define PRESET_H
+
+// ============================================================================
+// === Preset Morphing ========================================================
+// ============================================================================
+//
+// Two snapshots (A / B) of the stored pot arrays. Core 1 interpolates the
+// pots of the effects in the current chain at the control rate and re-runs
+// their load_* functions, which no longer reset filter states, so a morph
+// glides instead of clicking.
+//
+// The loaders write the inactive copy of the effect's coefficient bank
+// (coef_bank.h), core 0 switches to it at the start of the effect's next
+// block: every block runs with one consistent coefficient set per effect,
+// and core 0 never waits for a morph step.
+//
+// Position sources: EXP-2, the encoder (morph screen) or a timed glide to
+// the other snapshot started with the TAP footswitch.
+
+#define MORPH_MIN_STEP_Q16      64              // Ignore moves below ~0.1 %
+
+typedef struct {
+    uint16_t pot[NUM_EFFECTS][NUM_FUNC_POTS];
+    uint16_t preamp[NUM_PREAMPS][NUM_FUNC_POTS];
+} PresetSnapshot;
+
+static PresetSnapshot preset_a;
+static PresetSnapshot preset_b;
+static uint8_t preset_valid = 0;                // bit 0 = A stored, bit 1 = B stored
+
+static uint32_t morph_pos_q16     = 0;          // 0 = A, Q16_ONE = B
+static uint32_t morph_applied_q16 = UINT32_MAX; // Position the pots were last set to
+static uint32_t morph_glide_target_q16 = 0;
+static bool     morph_gliding     = false;
+
+static const uint16_t morph_time_ms[NUM_MORPH_TIMES] = { 500, 1000, 2000, 4000, 8000 };
+
+// ============================================================================
+// === Snapshots ==============================================================
+// ============================================================================
+
+// Capture the live pots into A (0) or B (1)
+void preset_store(int which) {
+    PresetSnapshot* p = which ? &preset_b : &preset_a;
+    memcpy(p->pot,    storedPotValue,       sizeof(p->pot));
+    memcpy(p->preamp, storedPreampPotValue, sizeof(p->preamp));
+    preset_valid     |= which ? 0x02 : 0x01;
+    morph_pos_q16     = which ? Q16_ONE : 0;    // We are sitting on that snapshot now
+    morph_applied_q16 = morph_pos_q16;
+}
+
+static inline uint16_t morph_lerp_pot(uint16_t a, uint16_t b, uint32_t pos_q16) {
+    return (uint16_t)(a + (((int32_t)b - (int32_t)a) * (int32_t)(pos_q16 >> 1) >> 15));
+}
+
+// Interpolate the chain's pots and reload the affected effects
+static void morph_apply(uint32_t pos_q16) {
+    // Interpolate first (UI values only, core 0 does not read them)
+    for (int slot = 0; slot < ROUTE_MAX_SLOTS; slot++) {
+        int e = slot_effect(slot);
+        if (e < 0 || e >= NUM_EFFECTS) continue;
+        for (int k = 0; k < NUM_FUNC_POTS; k++) {
+            storedPotValue[e][k] = morph_lerp_pot(preset_a.pot[e][k], preset_b.pot[e][k], pos_q16);
+        }
+        if (e == PREAMP_EFFECT_INDEX) {
+            for (int k = 0; k < NUM_FUNC_POTS; k++) {
+                storedPreampPotValue[selected_preamp_style][k] =
+                    morph_lerp_pot(preset_a.preamp[selected_preamp_style][k],
+                                   preset_b.preamp[selected_preamp_style][k], pos_q16);
+            }
+        }
+    }
+
+    // Then publish the coefficients
+    for (int slot = 0; slot < ROUTE_MAX_SLOTS; slot++) {
+        effect_publish(slot_effect(slot));
+    }
+    morph_applied_q16 = pos_q16;
+}
+
+// Jump to A (0) or B (1), e.g. from a MIDI program change
+void preset_recall(int which) {
+    if (!(preset_valid & (which ? 0x02 : 0x01))) return;
+    morph_gliding = false;
+    morph_pos_q16 = which ? Q16_ONE : 0;
+    morph_apply(morph_pos_q16);
+}
+
+// ============================================================================
+// === Core 1: control rate ===================================================
+// ============================================================================
+
+// TAP footswitch in FOOT mode: glide to the snapshot we are furthest from
+void morph_trigger_glide(void) {
+    morph_glide_target_q16 = (morph_pos_q16 < Q16_ONE / 2) ? Q16_ONE : 0;
+    morph_gliding = true;
+}
+
+// Call every control tick (CONTROL_INTERVAL_US)
+void morph_tick(uint32_t interval_us) {
+    switch (morph_source) {
+        case MORPH_SRC_EXP:
+            morph_pos_q16 = exp_value_q16;
+            break;
+
+        case MORPH_SRC_FOOT:
+            if (morph_gliding) {
+                uint32_t step = (uint32_t)(((uint64_t)Q16_ONE * interval_us) /
+                                           ((uint32_t)morph_time_ms[morph_time_index] * 1000u));
+                if (step == 0) step = 1;
+                if (morph_glide_target_q16 > morph_pos_q16) {
+                    morph_pos_q16 = (Q16_ONE - morph_pos_q16 <= step) ? Q16_ONE : morph_pos_q16 + step;
+                } else {
+                    morph_pos_q16 = (morph_pos_q16 <= step) ? 0 : morph_pos_q16 - step;
+                }
+                if (morph_pos_q16 == morph_glide_target_q16) morph_gliding = false;
+            }
+            break;
+
+        case MORPH_SRC_ENCODER:         // Set from the morph screen
+        case MORPH_SRC_OFF:
+        default:
+            break;
+    }
+
+    if (morph_source == MORPH_SRC_OFF || preset_valid != 0x03) return;
+
+    uint32_t d = (morph_pos_q16 > morph_applied_q16) ? morph_pos_q16 - morph_applied_q16
+                                                      : morph_applied_q16 - morph_pos_q16;
+    bool at_end = (morph_pos_q16 == 0 || morph_pos_q16 == Q16_ONE) && d != 0;
+    if (d >= MORPH_MIN_STEP_Q16 || at_end) {
+        morph_apply(morph_pos_q16);
+    }
+}
+
+#endif // PRESET_H
@@ -0,0 +1,226 @@
+/* routing.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef ROUTING_H
+#define ROUTING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// === Routing Graph ==========================================================
+// ============================================================================
+//
+// The chain is described as a short token list (core 1 side):
+//
+//   FX s         run slot s
+//   SPLIT        copy the signal, branch A continues on it, B gets the copy
+//   SPLIT_LR     branch A gets the left channel, B the right (both as mono)
+//   BRANCH       continue with branch B
+//   JOIN m       merge B into A: m % of B (after SPLIT) or A left / B right
+//                (after SPLIT_LR)
+//
+// An empty B branch is the dry signal, so "SPLIT FX 0 JOIN 30" is slot 0
+// at 70 % wet. Splits nest up to ROUTE_NUM_BUFS - 1 deep.
+//
+// Dual mono: the left input runs the graph (chain A), the right input runs
+// the extra slots 3..5 in series (chain B), each as a mono chain. It is the
+// graph wrapped in "SPLIT_LR <graph> BRANCH FX 3 FX 4 FX 5 JOIN", so the
+// graph itself can't use the extra slots and only nests one split deep.
+//
+// route_compile() turns the tokens into a flat op list with the buffer of
+// every op already assigned; the ISR just walks it (see route_process_block
+// in Main.c). Programs are double buffered: core 1 compiles into the one
+// core 0 is not using and publishes it once core 0 acknowledged the last one.
+
+#define ROUTE_MAX_TOKENS        16
+#define ROUTE_MAX_OPS           24
+#define ROUTE_NUM_BUFS          3               // Buffer 0 = main chain buffer
+
+typedef enum {
+    ROUTE_FX,
+    ROUTE_SPLIT,
+    ROUTE_SPLIT_LR,
+    ROUTE_BRANCH,
+    ROUTE_JOIN,
+    ROUTE_NUM_TOKEN_KINDS
+} RouteTokenKind;
+
+typedef struct {
+    uint8_t kind;                               // RouteTokenKind
+    uint8_t arg;                                // Slot (FX) or B share in % (JOIN)
+} RouteToken;
+
+typedef enum {
+    ROUTE_OP_FX,                                // Slot on buffer dst
+    ROUTE_OP_COPY,                              // src -> dst
+    ROUTE_OP_SPLIT_LR,                          // dst = src right, src = src left
+    ROUTE_OP_MIX,                               // dst = lerp(dst, src, mix)
+    ROUTE_OP_MERGE_LR                           // dst right = src right
+} RouteOpKind;
+
+typedef struct {
+    uint8_t  op;                                // RouteOpKind
+    uint8_t  slot;
+    uint8_t  dst;                               // Buffer indices
+    uint8_t  src;
+    uint32_t mix_q16;
+} RouteOp;
+
+typedef struct {
+    RouteOp  ops[ROUTE_MAX_OPS];
+    uint8_t  num_ops;
+    uint8_t  slot_mask;                         // Slots the program runs
+    bool     dual_mono;                         // Read the right input (chain B)
+} RouteProgram;
+
+// Graph (core 1). Default: the three footswitch slots in series.
+static RouteToken route_tokens[ROUTE_MAX_TOKENS] = {
+    { ROUTE_FX, 0 }, { ROUTE_FX, 1 }, { ROUTE_FX, 2 }
+};
+static uint8_t route_num_tokens = 3;
+static uint8_t route_slot_mask  = 0x07;         // Slots in route_tokens
+static bool    route_dual_mono  = false;        // Chain B on the right input
+static bool    route_pending    = true;         // Tokens not compiled yet
+
+// Programs (core 1 writes the inactive one)
+static RouteProgram     route_prog[2];
+static volatile uint8_t route_active  = 0;      // Core 1 -> core 0
+static volatile uint8_t route_running = 0;      // Core 0 -> core 1 (ack)
+static bool             route_block_dual = false;  // Core 0: this block's program is dual mono
+
+// ============================================================================
+// === Core 1: compile ========================================================
+// ============================================================================
+
+static inline bool route_emit(RouteProgram* p, uint8_t op, uint8_t slot, uint8_t dst, uint8_t src, uint32_t mix) {
+    if (p->num_ops >= ROUTE_MAX_OPS) return false;
+    p->ops[p->num_ops++] = (RouteOp){ op, slot, dst, src, mix };
+    return true;
+}
+
+// Build a program from tokens, false if the graph is malformed (count checked by route_build)
+static bool route_compile(const RouteToken* t, int n, RouteProgram* p) {
+    struct { uint8_t parent, b, kind; bool in_b; } stack[ROUTE_NUM_BUFS - 1];
+    int depth = 0;
+    uint8_t cur = 0;
+
+    p->num_ops   = 0;
+    p->slot_mask = 0;
+
+    for (int i = 0; i < n; i++) {
+        switch (t[i].kind) {
+            case ROUTE_FX:
+                if (t[i].arg >= ROUTE_MAX_SLOTS || (p->slot_mask & (1u << t[i].arg))) return false;
+                p->slot_mask |= (uint8_t)(1u << t[i].arg);
+                if (!route_emit(p, ROUTE_OP_FX, t[i].arg, cur, cur, 0)) return false;
+                break;
+
+            case ROUTE_SPLIT:
+            case ROUTE_SPLIT_LR: {
+                if (depth >= ROUTE_NUM_BUFS - 1) return false;
+                uint8_t b = (uint8_t)(depth + 1);      // Next free buffer (stack order)
+                uint8_t op = (t[i].kind == ROUTE_SPLIT) ? ROUTE_OP_COPY : ROUTE_OP_SPLIT_LR;
+                if (!route_emit(p, op, 0, b, cur, 0)) return false;
+                stack[depth].parent = cur;
+                stack[depth].b      = b;
+                stack[depth].kind   = t[i].kind;
+                stack[depth].in_b   = false;
+                depth++;
+                break;
+            }
+
+            case ROUTE_BRANCH:
+                if (depth == 0 || stack[depth - 1].in_b) return false;
+                stack[depth - 1].in_b = true;
+                cur = stack[depth - 1].b;
+                break;
+
+            case ROUTE_JOIN: {
+                if (depth == 0 || t[i].arg > 100) return false;
+                depth--;
+                cur = stack[depth].parent;
+                bool ok = (stack[depth].kind == ROUTE_SPLIT)
+                    ? route_emit(p, ROUTE_OP_MIX, 0, cur, stack[depth].b, ((uint32_t)t[i].arg * Q16_ONE) / 100)
+                    : route_emit(p, ROUTE_OP_MERGE_LR, 0, cur, stack[depth].b, 0);
+                if (!ok) return false;
+                break;
+            }
+
+            default:
+                return false;
+        }
+    }
+    return depth == 0;
+}
+
+// Compile the graph, wrapped into the two mono chains if dual
+static bool route_build(const RouteToken* t, int n, bool dual, RouteProgram* p) {
+    p->dual_mono = dual;
+    if (n < 0 || n > ROUTE_MAX_TOKENS) return false;
+    if (!dual) return route_compile(t, n, p);
+
+    RouteToken w[ROUTE_MAX_TOKENS + ROUTE_EXTRA_SLOTS + 3];
+    int k = 0;
+    w[k++] = (RouteToken){ ROUTE_SPLIT_LR, 0 };
+    for (int i = 0; i < n; i++) w[k++] = t[i];
+    w[k++] = (RouteToken){ ROUTE_BRANCH, 0 };
+    for (int s = 0; s < ROUTE_EXTRA_SLOTS; s++) w[k++] = (RouteToken){ ROUTE_FX, (uint8_t)(3 + s) };
+    w[k++] = (RouteToken){ ROUTE_JOIN, 0 };
+    return route_compile(w, k, p);
+}
+
+// Replace the graph (validated now, published by route_poll)
+static bool route_set(const RouteToken* t, int n, bool dual) {
+    static RouteProgram check;
+    if (!route_build(t, n, dual, &check)) return false;
+
+    memmove(route_tokens, t, (size_t)n * sizeof(RouteToken));
+    route_num_tokens = (uint8_t)n;
+    route_dual_mono  = dual;
+    route_slot_mask  = check.slot_mask;
+    route_pending    = true;
+    return true;
+}
+
+// Compile the stored graph straight into the active program (before audio starts)
+static void route_init(void) {
+    if (!route_set(route_tokens, route_num_tokens, route_dual_mono)) {
+        static const RouteToken serial[3] = { { ROUTE_FX, 0 }, { ROUTE_FX, 1 }, { ROUTE_FX, 2 } };
+        route_set(serial, 3, false);
+    }
+    route_build(route_tokens, route_num_tokens, route_dual_mono, &route_prog[route_active]);
+    route_pending = false;
+}
+
+// Call from the core 1 loop: publish a new program once core 0 took the last one
+static void route_poll(void) {
+    if (!route_pending || route_running != route_active) return;
+
+    uint8_t next = route_active ^ 1;
+    if (!route_build(route_tokens, route_num_tokens, route_dual_mono, &route_prog[next])) {
+        route_pending = false;                  // Validated in route_set, can't happen
+        return;
+    }
+    __dmb();                                    // Program before the switch
+    route_active  = next;
+    route_pending = false;
+}
+
+#endif // ROUTING_H
@@ -0,0 +1,241 @@
+/* spectrum.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// ============================================================================
+// === Spectrum Analyzer (RTA) ================================================
+// ============================================================================
+//
+// Core 0 only pushes a decimated mono copy of the selected tap into a ring
+// (a few adds per sample, and only while the spectrum screen is shown).
+// Core 1 does all the heavy work at display rate: window, FFT, log bars.
+//
+// The ring is single-producer / single-consumer: core 0 is the only writer of
+// spectrum_write_idx, core 1 only reads it. No locks needed.
+
+#define SPECTRUM_FFT_BITS     9                             // 512-point FFT
+#define SPECTRUM_FFT_SIZE     (1 << SPECTRUM_FFT_BITS)
+#define SPECTRUM_DECIMATION   2                             // 48 kHz -> 24 kHz analysis rate
+#define SPECTRUM_RATE         (SAMPLE_RATE / SPECTRUM_DECIMATION)
+#define SPECTRUM_RING_SIZE    (SPECTRUM_FFT_SIZE * 2)       // Power of two, one frame of slack
+#define SPECTRUM_RING_MASK    (SPECTRUM_RING_SIZE - 1)
+#define SPECTRUM_HOP          (SPECTRUM_FFT_SIZE / 2)       // 50% overlap between frames
+
+#define SPECTRUM_BARS         32                            // 4 px per bar on 128 px
+#define SPECTRUM_F_LOW_HZ     60.0f
+#define SPECTRUM_F_HIGH_HZ    11000.0f
+#define SPECTRUM_RANGE_Q4     (20 * 16)                     // 20 * 3 dB = 60 dB shown (log2 power, Q4)
+#define SPECTRUM_FLOOR_Q4     (6 * 16)                      // Bottom of the display (log2 power, Q4)
+#define SPECTRUM_DECAY_Q4     10                            // Bar fall per frame
+#define SPECTRUM_PEAK_HOLD    12                            // Frames a peak dot is held
+
+// Tap selection
+typedef enum {
+    SPECTRUM_TAP_INPUT,
+    SPECTRUM_TAP_OUTPUT
+} SpectrumTap;
+
+volatile SpectrumTap spectrum_tap = SPECTRUM_TAP_OUTPUT;
+
+// Decimated tap (written by core 0)
+static PLACE_SPECTRUM_TAP int16_t spectrum_ring[SPECTRUM_RING_SIZE];
+static volatile uint32_t spectrum_write_idx = 0;
+static int32_t spectrum_decim_acc = 0;
+static uint8_t spectrum_decim_count = 0;
+
+// Analysis tables and work buffers (core 1 only)
+static PLACE_SPECTRUM int16_t spectrum_window_q15[SPECTRUM_FFT_SIZE];      // Hann window
+static PLACE_SPECTRUM int16_t spectrum_cos_q14[SPECTRUM_FFT_SIZE / 2];     // Twiddles (Q14 keeps the butterfly in 32 bit)
+static PLACE_SPECTRUM int16_t spectrum_sin_q14[SPECTRUM_FFT_SIZE / 2];
+static PLACE_SPECTRUM int32_t spectrum_re[SPECTRUM_FFT_SIZE];
+static PLACE_SPECTRUM int32_t spectrum_im[SPECTRUM_FFT_SIZE];
+static uint16_t spectrum_bar_lo[SPECTRUM_BARS];             // First FFT bin of each bar
+static uint16_t spectrum_bar_hi[SPECTRUM_BARS];             // Last FFT bin of each bar
+static uint32_t spectrum_read_idx = 0;
+
+// Output for the UI (log2 power in Q4, decayed)
+static int16_t spectrum_level_q4[SPECTRUM_BARS];
+static int16_t spectrum_peak_q4[SPECTRUM_BARS];
+static uint8_t spectrum_peak_age[SPECTRUM_BARS];
+
+// ============================================================================
+// === Core 0: decimated tap ==================================================
+// ============================================================================
+
+// Push one block into the ring: mono sum and 2:1 box decimation, Q15 out
+static inline __attribute__((always_inline))
+void spectrum_tap_block(const int32_t* in_l, const int32_t* in_r, size_t frames) {
+    uint32_t w = spectrum_write_idx;
+    int32_t acc = spectrum_decim_acc;
+    uint8_t count = spectrum_decim_count;
+
+    for (size_t i = 0; i < frames; i++) {
+        // 4 terms (L+R, two samples) each scaled to 1/4 of Q15 full scale
+        acc += (in_l[i] >> 18) + (in_r[i] >> 18);
+        if (++count == SPECTRUM_DECIMATION) {
+            spectrum_ring[w & SPECTRUM_RING_MASK] = (int16_t)acc;
+            w++;
+            acc = 0;
+            count = 0;
+        }
+    }
+
+    spectrum_decim_acc = acc;
+    spectrum_decim_count = count;
+
+    // Publish the samples before the index
+    __dmb();
+    spectrum_write_idx = w;
+}
+
+// ============================================================================
+// === Core 1: analysis =======================================================
+// ============================================================================
+
+// Build window, twiddles and bar edges (floats are fine here, runs once)
+void spectrum_init(void) {
+    for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        float w = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / (SPECTRUM_FFT_SIZE - 1));
+        spectrum_window_q15[i] = (int16_t)(w * 32767.0f);
+    }
+
+    for (int i = 0; i < SPECTRUM_FFT_SIZE / 2; i++) {
+        float a = 2.0f * (float)M_PI * i / SPECTRUM_FFT_SIZE;
+        spectrum_cos_q14[i] = (int16_t)lrintf(cosf(a) * 16384.0f);
+        spectrum_sin_q14[i] = (int16_t)lrintf(sinf(a) * 16384.0f);
+    }
+
+    // Log-spaced bars; low bars may share a bin, higher bars span many
+    const float bin_hz = (float)SPECTRUM_RATE / SPECTRUM_FFT_SIZE;
+    const float ratio  = SPECTRUM_F_HIGH_HZ / SPECTRUM_F_LOW_HZ;
+    for (int b = 0; b < SPECTRUM_BARS; b++) {
+        float f0 = SPECTRUM_F_LOW_HZ * powf(ratio, (float)b / SPECTRUM_BARS);
+        float f1 = SPECTRUM_F_LOW_HZ * powf(ratio, (float)(b + 1) / SPECTRUM_BARS);
+        int lo = (int)(f0 / bin_hz + 0.5f);
+        int hi = (int)(f1 / bin_hz + 0.5f) - 1;
+        if (lo < 1) lo = 1;
+        if (hi < lo) hi = lo;
+        if (hi > SPECTRUM_FFT_SIZE / 2 - 1) hi = SPECTRUM_FFT_SIZE / 2 - 1;
+        spectrum_bar_lo[b] = (uint16_t)lo;
+        spectrum_bar_hi[b] = (uint16_t)hi;
+    }
+
+    for (int b = 0; b < SPECTRUM_BARS; b++) {
+        spectrum_level_q4[b] = 0;
+        spectrum_peak_q4[b]  = 0;
+        spectrum_peak_age[b] = 0;
+    }
+}
+
+// In-place radix-2 DIT FFT, Q15 data, scaled by 1/2 per stage (result = X/N)
+static void spectrum_fft(int32_t* re, int32_t* im) {
+    // Bit reversal
+    for (uint32_t i = 1, j = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        uint32_t bit = SPECTRUM_FFT_SIZE >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) {
+            int32_t t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    // Butterflies (products stay within 32 bit: |x| <= 2^15, |w| <= 2^14)
+    for (uint32_t len = 2, step = SPECTRUM_FFT_SIZE / 2; len <= SPECTRUM_FFT_SIZE; len <<= 1, step >>= 1) {
+        uint32_t half = len >> 1;
+        for (uint32_t i = 0; i < SPECTRUM_FFT_SIZE; i += len) {
+            for (uint32_t k = 0; k < half; k++) {
+                int32_t wr = spectrum_cos_q14[k * step];
+                int32_t wi = -spectrum_sin_q14[k * step];
+                uint32_t a = i + k;
+                uint32_t b = a + half;
+
+                int32_t tr = (wr * re[b] - wi * im[b]) >> 14;
+                int32_t ti = (wr * im[b] + wi * re[b]) >> 14;
+
+                re[b] = (re[a] - tr) >> 1;
+                im[b] = (im[a] - ti) >> 1;
+                re[a] = (re[a] + tr) >> 1;
+                im[a] = (im[a] + ti) >> 1;
+            }
+        }
+    }
+}
+
+// log2(x) in Q4 (16 steps per 3 dB of power), 0 for x == 0
+static inline int32_t spectrum_log2_q4(uint32_t x) {
+    if (x == 0) return 0;
+    int32_t e = 31 - __builtin_clz(x);
+    uint32_t frac = (e >= 4) ? (x >> (e - 4)) & 0x0F : (x << (4 - e)) & 0x0F;
+    return (e << 4) | (int32_t)frac;
+}
+
+// Run one analysis frame if enough new samples arrived; returns true if bars changed
+bool spectrum_update(void) {
+    uint32_t w = spectrum_write_idx;
+    __dmb();
+
+    if ((uint32_t)(w - spectrum_read_idx) < SPECTRUM_HOP) return false;
+    spectrum_read_idx = w;
+
+    // Copy the newest frame through the window
+    uint32_t start = w - SPECTRUM_FFT_SIZE;
+    for (uint32_t i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        int32_t x = spectrum_ring[(start + i) & SPECTRUM_RING_MASK];
+        spectrum_re[i] = (x * spectrum_window_q15[i]) >> 15;
+        spectrum_im[i] = 0;
+    }
+
+    spectrum_fft(spectrum_re, spectrum_im);
+
+    // Peak power per bar, then fast rise / slow fall
+    for (int b = 0; b < SPECTRUM_BARS; b++) {
+        uint32_t p_max = 0;
+        for (uint32_t k = spectrum_bar_lo[b]; k <= spectrum_bar_hi[b]; k++) {
+            uint32_t p = (uint32_t)(spectrum_re[k] * spectrum_re[k]) + (uint32_t)(spectrum_im[k] * spectrum_im[k]);
+            if (p > p_max) p_max = p;
+        }
+
+        int32_t lvl = spectrum_log2_q4(p_max) - SPECTRUM_FLOOR_Q4;
+        if (lvl < 0) lvl = 0;
+        if (lvl > SPECTRUM_RANGE_Q4) lvl = SPECTRUM_RANGE_Q4;
+
+        int32_t shown = spectrum_level_q4[b] - SPECTRUM_DECAY_Q4;
+        spectrum_level_q4[b] = (int16_t)((lvl > shown) ? lvl : ((shown > 0) ? shown : 0));
+
+        if (lvl >= spectrum_peak_q4[b]) {
+            spectrum_peak_q4[b] = (int16_t)lvl;
+            spectrum_peak_age[b] = 0;
+        } else if (++spectrum_peak_age[b] > SPECTRUM_PEAK_HOLD) {
+            int32_t pk = spectrum_peak_q4[b] - SPECTRUM_DECAY_Q4 / 2;
+            spectrum_peak_q4[b] = (int16_t)((pk > 0) ? pk : 0);
+        }
+    }
+    return true;
+}
+
+// Flush stale history when the screen is (re-)entered or the tap changes
+void spectrum_reset(void) {
+    spectrum_read_idx = spectrum_write_idx;
+    for (int b = 0; b < SPECTRUM_BARS; b++) {
+        spectrum_level_q4[b] = 0;
+        spectrum_peak_q4[b]  = 0;
+        spectrum_peak_age[b] = 0;
+    }
+}
@@ -0,0 +1,131 @@
+/* ui_amp.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef UI_AMP_H
+#define UI_AMP_H
+
+// ============================================================================
+// === UI - Amp Setup =========================================================
+// ============================================================================
+//
+// Reached from the last row of the preamp menu. Click a row to edit it with
+// the encoder (applied live), click again to go back to the list.
+
+typedef enum {
+    AMP_UI_POWER_AMP,
+    AMP_UI_SECOND_AMP,
+    AMP_UI_BLEND,
+    AMP_UI_PAN,
+    AMP_UI_BACK,
+    AMP_UI_COUNT
+} AmpUiRow;
+
+static int amp_setup_cursor = 0;                // Row being edited
+
+static const char* const amp_ui_labels[AMP_UI_BACK] = {
+    "POWER AMP",
+    "2ND AMP",
+    "BLEND",
+    "PAN"
+};
+
+// Number of values a row can take (edit screen wraps on this)
+static inline int ampUiFieldCount(int row) {
+    switch (row) {
+        case AMP_UI_POWER_AMP:  return 2;
+        case AMP_UI_SECOND_AMP: return NUM_PREAMPS + 1;         // OFF + styles
+        default:                return DUAL_AMP_STEPS + 1;
+    }
+}
+
+// Current value of a row as an encoder position
+static inline int ampUiFieldValue(int row) {
+    switch (row) {
+        case AMP_UI_POWER_AMP:  return power_amp_enabled ? 1 : 0;
+        case AMP_UI_SECOND_AMP: return dual_amp_style + 1;
+        case AMP_UI_BLEND:      return dual_amp_blend;
+        case AMP_UI_PAN:        return dual_amp_pan;
+        default:                return 0;
+    }
+}
+
+// Write an encoder position back into a row (live update)
+static inline void ampUiSetField(int row, int value) {
+    switch (row) {
+        case AMP_UI_POWER_AMP:
+            power_amp_enabled = (value != 0);       // Core 0 crossfades and resets the stage
+            break;
+        case AMP_UI_SECOND_AMP:
+            dual_amp_style = (int8_t)(value - 1);
+            break;
+        case AMP_UI_BLEND:
+            dual_amp_blend = (uint8_t)value;
+            load_dual_amp_params();
+            break;
+        case AMP_UI_PAN:
+            dual_amp_pan = (uint8_t)value;
+            load_dual_amp_params();
+            break;
+    }
+}
+
+// selected: hovered row, editing: its value is being changed
+void drawAmpSetupScreen(int selected, bool editing) {
+    SSD1306_FillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, false);
+
+    drawMenuTitleBar(editing ? "EDIT AMP" : "AMP SETUP");
+
+    const int rowH = 10;
+    const int startY = 12;
+
+    for (int i = 0; i < AMP_UI_COUNT; ++i) {
+        int y = startY + i * rowH;
+        char line[24];
+
+        switch (i) {
+            case AMP_UI_POWER_AMP:
+                snprintf(line, sizeof(line), "%-10s%s", amp_ui_labels[i], power_amp_enabled ? "ON" : "OFF");
+                break;
+            case AMP_UI_SECOND_AMP:
+                snprintf(line, sizeof(line), "%-10s%s", amp_ui_labels[i],
+                         (dual_amp_style == DUAL_AMP_OFF) ? "OFF" : preamp_names[dual_amp_style]);
+                break;
+            case AMP_UI_BLEND:
+            case AMP_UI_PAN:
+                snprintf(line, sizeof(line), "%-10s%d%%", amp_ui_labels[i],
+                         ((i == AMP_UI_BLEND) ? dual_amp_blend : dual_amp_pan) * (100 / DUAL_AMP_STEPS));
+                break;
+            default:
+                snprintf(line, sizeof(line), "< BACK");
+                break;
+        }
+
+        if (i == selected) {
+            SSD1306_FillRect(0, y, 128, rowH, 1);
+            SSD1306_DrawString(2, y + 1, line, true);
+        } else {
+            SSD1306_DrawString(2, y + 1, line, false);
+        }
+    }
+
+    // Mark the row being edited
+    if (editing) SSD1306_DrawString(120, startY + selected * rowH + 1, "*", true);
+}
+
+#endif // UI_AMP_H
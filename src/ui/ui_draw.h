@@ -96,13 +96,83 @@ void drawUI(int changed_pot_index) {
 
         case UI_PREAMP_SELECTION: // [NEW]
             // Wrap encoder
-            if (encoder_position < 0) encoder_position = NUM_PREAMPS - 1;
-            if (encoder_position >= NUM_PREAMPS) encoder_position = 0;
+            if (encoder_position < 0) encoder_position = NUM_PREAMPS;     // Last row: amp setup
+            if (encoder_position > NUM_PREAMPS) encoder_position = 0;
 
             preamp_select_menu_index = encoder_position;
             drawPreampSelectMenu(preamp_select_menu_index);
             break;
 
+        case UI_WAH_MODE_MENU:
+            // Wrap encoder
+            if (encoder_position < 0) encoder_position = NUM_WAH_MODES - 1;
+            if (encoder_position >= NUM_WAH_MODES) encoder_position = 0;
+
+            wah_mode_menu_index = encoder_position;
+            drawWahModeMenu(wah_mode_menu_index);
+            break;
+
+        case UI_EXP_TARGET_MENU:
+            // Wrap encoder
+            if (encoder_position < 0) encoder_position = NUM_MOD_DESTS - 1;
+            if (encoder_position >= NUM_MOD_DESTS) encoder_position = 0;
+
+            exp_target_menu_index = encoder_position;
+            drawExpTargetMenu(exp_target_menu_index);
+            break;
+
+        case UI_MOD_MATRIX:
+            // Wrap encoder over the arrows and the route fields
+            if (encoder_position < 0) encoder_position = MOD_UI_FIRST_FIELD + MOD_UI_NUM_FIELDS - 1;
+            if (encoder_position >= MOD_UI_FIRST_FIELD + MOD_UI_NUM_FIELDS) encoder_position = 0;
+
+            drawModMatrixScreen(encoder_position, false);
+            break;
+
+        case UI_MOD_EDIT: {
+            // Wrap encoder over the values of the field being edited
+            int count = modUiFieldCount(modUiField(mod_matrix_cursor));
+            if (encoder_position < 0) encoder_position = count - 1;
+            if (encoder_position >= count) encoder_position = 0;
+
+            modUiSetField(mod_matrix_cursor, encoder_position);  // live update
+            drawModMatrixScreen(mod_matrix_cursor, true);
+        } break;
+
+        case UI_AMP_SETUP:
+            if (encoder_position < 0) encoder_position = AMP_UI_COUNT - 1;
+            if (encoder_position >= AMP_UI_COUNT) encoder_position = 0;
+
+            drawAmpSetupScreen(encoder_position, false);
+            break;
+
+        case UI_AMP_SETUP_EDIT: {
+            // Wrap encoder over the values of the row being edited
+            int count = ampUiFieldCount(amp_setup_cursor);
+            if (encoder_position < 0) encoder_position = count - 1;
+            if (encoder_position >= count) encoder_position = 0;
+
+            ampUiSetField(amp_setup_cursor, encoder_position);  // live update
+            drawAmpSetupScreen(amp_setup_cursor, true);
+        } break;
+
+        case UI_MORPH:
+            // Wrap encoder over the morph screen items
+            if (encoder_position < 0) encoder_position = MORPH_UI_COUNT - 1;
+            if (encoder_position >= MORPH_UI_COUNT) encoder_position = 0;
+
+            drawMorphScreen(encoder_position, false);
+            break;
+
+        case UI_MORPH_EDIT:
+            // Clamp (no wrap, the ends are the presets)
+            if (encoder_position < 0) encoder_position = 0;
+            if (encoder_position > MORPH_UI_STEPS) encoder_position = MORPH_UI_STEPS;
+
+            morph_pos_q16 = ((uint32_t)encoder_position * Q16_ONE) / MORPH_UI_STEPS;  // applied by morph_tick
+            drawMorphScreen(MORPH_UI_POS, true);
+            break;
+
         case UI_STEREO_MODE_MENU:
             // Wrap encoder
             if (encoder_position < 0) encoder_position = NUM_STEREO_MODES - 1;
@@ -179,6 +249,16 @@ void drawUI(int changed_pot_index) {
             drawVUMeterScreen(peak_left_block, peak_right_block, encoder_position, VU_GAIN);
             break;
 
+        case UI_SPECTRUM:
+            // Wrap encoder: left arrow, right arrow, tap source
+            if (encoder_position < 0) encoder_position = 2;
+            if (encoder_position > 2) encoder_position = 0;
+
+            // FFT runs here at display rate, core 0 only feeds the ring
+            spectrum_update();
+            drawSpectrumScreen(encoder_position);
+            break;
+
     }
 
     SSD1306_UpdateScreen();
@@ -227,14 +227,7 @@ void drawEffectListScreen(int selectedIndex) {
 
     // --- LIVE UPDATE: assign hovered effect to active slot if it's unique ---
     if (selectedIndex >= 0 && selectedIndex < NUM_EFFECTS) {
-        bool taken = false;
-        for (int j = 0; j < 3; ++j) {
-            if (j != selected_slot && selectedEffects[j] == selectedIndex) {
-                taken = true;
-                break;
-            }
-        }
-        if (!taken) {
+        if (!effect_in_other_slot(selectedIndex, selected_slot)) {
             // selectedIndex is the hovered effect — use it as the effectListIndex
             selectedEffects[selected_slot] = selectedIndex;
         }
@@ -452,6 +445,58 @@ void drawStereoModeMenu(int selectedIndex) {
     }
 }
 
+// ============================================================================
+// === UI - Wah Mode Screen ===================================================
+// ============================================================================
+
+void drawWahModeMenu(int selectedIndex) {
+    SSD1306_FillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, false);
+
+    drawMenuTitleBar(allEffects[effectListIndex]);
+
+    const int rowH = 10;
+    const int startY = 12;
+
+    for (int i = 0; i < NUM_WAH_MODES; ++i) {
+        int y = startY + i * rowH;
+        const char* name = wah_mode_names[i];
+
+        if (i == selectedIndex) {
+            SSD1306_FillRect(0, y, 128, rowH, 1);
+            SSD1306_DrawString(2, y + 1, name, true);
+            selected_wah_mode = (WahMode)i;  // live update
+        } else {
+            SSD1306_DrawString(2, y + 1, name, false);
+        }
+    }
+}
+
+// ============================================================================
+// === UI - Expression Target Screen ==========================================
+// ============================================================================
+
+void drawExpTargetMenu(int selectedIndex) {
+    SSD1306_FillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, false);
+
+    drawMenuTitleBar("EXP-2 TARGET");
+
+    const int rowH = 10;
+    const int startY = 12;
+
+    for (int i = 0; i < NUM_MOD_DESTS; ++i) {
+        int y = startY + i * rowH;
+        const char* name = mod_dest_names[i];
+
+        if (i == selectedIndex) {
+            SSD1306_FillRect(0, y, 128, rowH, 1);
+            SSD1306_DrawString(2, y + 1, name, true);
+            exp_target = (ModDest)i;  // live update
+        } else {
+            SSD1306_DrawString(2, y + 1, name, false);
+        }
+    }
+}
+
 // ============================================================================
 // === UI - Preamp selection screen ===========================================
 // ============================================================================
@@ -483,6 +528,15 @@ void drawPreampSelectMenu(int selectedIndex) {  // [NEW]
             SSD1306_DrawString(2, y + 1, name, false);
         }
     }
+
+    // Power amp / dual amp setup below the styles (click opens it, see actions.h)
+    int y = startY + NUM_PREAMPS * rowH;
+    if (selectedIndex == NUM_PREAMPS) {
+        SSD1306_FillRect(0, y, 128, rowH, 1);
+        SSD1306_DrawString(2, y + 1, "AMP SETUP >", true);
+    } else {
+        SSD1306_DrawString(2, y + 1, "AMP SETUP >", false);
+    }
 }
 
 // ============================================================================
@@ -505,9 +559,9 @@ void drawPotScreen(uint8_t pot_index, uint16_t selected) {
     else if (pot_index == NUM_FUNC_POTS){
         label = "Volume";
     }
-    // Last pot is always the EXP2
+    // Last pot is always the EXP2 (show where it is routed, click to change)
     else{
-        label = "EXP-2";
+        label = (exp_target == MOD_DEST_NONE) ? "EXP-2" : mod_dest_names[exp_target];
     }
 
     int labelX = (128 - strlen(label) * 8) / 2;
@@ -0,0 +1,95 @@
+/* ui_modulation.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// ============================================================================
+// === UI - Modulation Matrix =================================================
+// ============================================================================
+
+#define MOD_UI_FIRST_FIELD  2                   // 0 = left arrow, 1 = right arrow
+#define MOD_UI_NUM_FIELDS   (MOD_MAX_ROUTES * 3)
+#define MOD_UI_ROW_Y(r)     (12 + (r) * 13)
+#define MOD_UI_SRC_X        0
+#define MOD_UI_DEST_X       28
+#define MOD_UI_DEPTH_X      104
+
+// Encoder position <-> route / field (0 = source, 1 = destination, 2 = depth)
+static inline int modUiRoute(int pos) { return (pos - MOD_UI_FIRST_FIELD) / 3; }
+static inline int modUiField(int pos) { return (pos - MOD_UI_FIRST_FIELD) % 3; }
+
+// Number of values a field can take (edit screen wraps on this)
+static inline int modUiFieldCount(int field) {
+    if (field == 0) return NUM_MOD_SRCS;
+    if (field == 1) return NUM_MOD_DESTS;
+    return NUM_MOD_DEPTHS;
+}
+
+// Current value of a field as an encoder position
+static inline int modUiFieldValue(int pos) {
+    const ModRoute* rt = &mod_routes[modUiRoute(pos)];
+    int field = modUiField(pos);
+    if (field == 0) return rt->src;
+    if (field == 1) return rt->dest;
+    return (rt->depth + 100) / MOD_DEPTH_STEP;
+}
+
+// Write an encoder position back into a field (live update)
+static inline void modUiSetField(int pos, int value) {
+    ModRoute* rt = &mod_routes[modUiRoute(pos)];
+    int field = modUiField(pos);
+    if (field == 0)      rt->src   = (uint8_t)value;
+    else if (field == 1) rt->dest  = (uint8_t)value;
+    else                 rt->depth = (int8_t)(value * MOD_DEPTH_STEP - 100);
+}
+
+// Draw one field, inverted when it is hovered / being edited
+static void drawModField(int x, int y, int w, const char* text, bool highlight) {
+    if (highlight) {
+        SSD1306_FillRect(x, y - 1, w, 10, true);
+        SSD1306_DrawString(x + 1, y, text, true);
+    } else {
+        SSD1306_DrawString(x + 1, y, text, false);
+    }
+}
+
+// selected: encoder position on the matrix, editing: field is being changed
+void drawModMatrixScreen(int selected, bool editing) {
+    SSD1306_FillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, false);
+    SetFont(&Font6x8);
+
+    const char* title = editing ? "EDIT ROUTE" : "MOD MATRIX";
+    SSD1306_DrawString((SCREEN_WIDTH - (int)strlen(title) * 6) / 2, 1, title, false);
+
+    if (!editing) {
+        if (selected == 0)      SSD1306_DrawTriangle(0, 4, 5, 0, 5, 8, 1);
+        else if (selected == 1) SSD1306_DrawTriangle(127, 4, 122, 0, 122, 8, 1);
+    }
+
+    for (int r = 0; r < MOD_MAX_ROUTES; r++) {
+        const ModRoute* rt = &mod_routes[r];
+        int y = MOD_UI_ROW_Y(r);
+        int base = MOD_UI_FIRST_FIELD + r * 3;
+        char depth[8];
+        snprintf(depth, sizeof(depth), "%+d", rt->depth);
+
+        drawModField(MOD_UI_SRC_X,   y, MOD_UI_DEST_X - MOD_UI_SRC_X - 2,   mod_src_names[rt->src],   selected == base);
+        drawModField(MOD_UI_DEST_X,  y, MOD_UI_DEPTH_X - MOD_UI_DEST_X - 2, mod_dest_names[rt->dest], selected == base + 1);
+        drawModField(MOD_UI_DEPTH_X, y, SCREEN_WIDTH - MOD_UI_DEPTH_X,      depth,                    selected == base + 2);
+    }
+}
@@ -0,0 +1,85 @@
+/* ui_preset.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// ============================================================================
+// === UI - Preset Morph ======================================================
+// ============================================================================
+
+// Encoder positions on the morph screen
+#define MORPH_UI_LEFT       0
+#define MORPH_UI_RIGHT      1
+#define MORPH_UI_STORE_A    2
+#define MORPH_UI_STORE_B    3
+#define MORPH_UI_SOURCE     4
+#define MORPH_UI_TIME       5
+#define MORPH_UI_POS        6
+#define MORPH_UI_COUNT      7
+
+#define MORPH_UI_BAR_X      10
+#define MORPH_UI_BAR_W      (SCREEN_WIDTH - 2 * MORPH_UI_BAR_X)
+#define MORPH_UI_BAR_Y      44
+#define MORPH_UI_BAR_H      10
+
+static void drawMorphField(int x, int y, const char* text, bool highlight) {
+    int w = (int)strlen(text) * 6 + 2;
+    if (highlight) {
+        SSD1306_FillRect(x, y - 1, w, 10, true);
+        SSD1306_DrawString(x + 1, y, text, true);
+    } else {
+        SSD1306_DrawString(x + 1, y, text, false);
+    }
+}
+
+// selected: encoder position, editing: encoder moves the position bar
+void drawMorphScreen(int selected, bool editing) {
+    SSD1306_FillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, false);
+    SetFont(&Font6x8);
+
+    const char* title = "PRESET MORPH";
+    SSD1306_DrawString((SCREEN_WIDTH - (int)strlen(title) * 6) / 2, 1, title, false);
+
+    if (selected == MORPH_UI_LEFT)       SSD1306_DrawTriangle(0, 4, 5, 0, 5, 8, 1);
+    else if (selected == MORPH_UI_RIGHT) SSD1306_DrawTriangle(127, 4, 122, 0, 122, 8, 1);
+
+    // Store buttons (* = snapshot stored)
+    drawMorphField(0,  14, (preset_valid & 0x01) ? "STORE A*" : "STORE A", selected == MORPH_UI_STORE_A);
+    drawMorphField(70, 14, (preset_valid & 0x02) ? "STORE B*" : "STORE B", selected == MORPH_UI_STORE_B);
+
+    // Source and glide time
+    char text[16];
+    snprintf(text, sizeof(text), "SRC %s", morph_src_names[morph_source]);
+    drawMorphField(0, 27, text, selected == MORPH_UI_SOURCE);
+    snprintf(text, sizeof(text), "TIME %.1fs", morph_time_ms[morph_time_index] / 1000.0f);
+    drawMorphField(70, 27, text, selected == MORPH_UI_TIME);
+
+    // Position bar between A and B
+    bool bar_sel = (selected == MORPH_UI_POS);
+    drawMorphField(0, MORPH_UI_BAR_Y + 1, "A", bar_sel && !editing);
+    drawMorphField(SCREEN_WIDTH - 8, MORPH_UI_BAR_Y + 1, "B", bar_sel && !editing);
+
+    SSD1306_DrawRect(MORPH_UI_BAR_X, MORPH_UI_BAR_Y, MORPH_UI_BAR_W, MORPH_UI_BAR_H, true);
+    int fill = (int)(((uint64_t)morph_pos_q16 * (MORPH_UI_BAR_W - 4)) >> 16);
+    if (fill > 0) {
+        SSD1306_FillRect(MORPH_UI_BAR_X + 2, MORPH_UI_BAR_Y + 2, fill, MORPH_UI_BAR_H - 4, true);
+    }
+    if (editing) {
+        SSD1306_DrawRect(MORPH_UI_BAR_X - 2, MORPH_UI_BAR_Y - 2, MORPH_UI_BAR_W + 4, MORPH_UI_BAR_H + 4, true);
+    }
+}
@@ -0,0 +1,60 @@
+/* ui_spectrum.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// ============================================================================
+// === UI - Spectrum Screen ===================================================
+// ============================================================================
+
+#define SPECTRUM_TOP_Y      10                  // Below the label row
+#define SPECTRUM_HEIGHT     (SCREEN_HEIGHT - SPECTRUM_TOP_Y)
+#define SPECTRUM_BAR_W      (SCREEN_WIDTH / SPECTRUM_BARS)
+
+// Encoder positions: 0 = left arrow, 1 = right arrow, 2 = tap source (IN / OUT)
+void drawSpectrumScreen(uint16_t selected) {
+    SSD1306_FillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, false);
+
+    // Label row
+    SetFont(&Font6x8);
+    const char* label = (spectrum_tap == SPECTRUM_TAP_INPUT) ? "RTA INPUT" : "RTA OUTPUT";
+    int labelX = (SCREEN_WIDTH - (int)strlen(label) * 6) / 2;
+    if (selected == 2) {
+        SSD1306_FillRect(labelX - 2, 0, (int)strlen(label) * 6 + 4, 9, true);
+        SSD1306_DrawString(labelX, 1, label, true);
+    } else {
+        SSD1306_DrawString(labelX, 1, label, false);
+    }
+
+    if (selected == 0)      SSD1306_DrawTriangle(0, 4, 5, 0, 5, 8, 1);
+    else if (selected == 1) SSD1306_DrawTriangle(127, 4, 122, 0, 122, 8, 1);
+
+    // Bars (only the bar area changes per frame, so only those pages are resent)
+    for (int b = 0; b < SPECTRUM_BARS; b++) {
+        int x = b * SPECTRUM_BAR_W;
+        int h = (spectrum_level_q4[b] * SPECTRUM_HEIGHT) / SPECTRUM_RANGE_Q4;
+        if (h > 0) {
+            SSD1306_FillRect(x, SCREEN_HEIGHT - h, SPECTRUM_BAR_W - 1, h, true);
+        }
+
+        int p = (spectrum_peak_q4[b] * SPECTRUM_HEIGHT) / SPECTRUM_RANGE_Q4;
+        if (p > h) {
+            SSD1306_FillRect(x, SCREEN_HEIGHT - p, SPECTRUM_BAR_W - 1, 1, true);
+        }
+    }
+}
@@ -25,13 +25,22 @@ typedef enum {
     UI_VU_IN,
     UI_VU_OUT,
     UI_VU_GAIN,
+    UI_SPECTRUM,
     UI_EFFECT_LIST,
     UI_DELAY_MODE_MENU,
     UI_DELAY_FRACTION_L_MENU,
     UI_DELAY_FRACTION_R_MENU,
     UI_STEREO_MODE_MENU,
     UI_CHORUS_MODE_MENU,
-    UI_PREAMP_SELECTION
+    UI_PREAMP_SELECTION,
+    UI_WAH_MODE_MENU,
+    UI_EXP_TARGET_MENU,
+    UI_MOD_MATRIX,
+    UI_MOD_EDIT,
+    UI_MORPH,
+    UI_MORPH_EDIT,
+    UI_AMP_SETUP,
+    UI_AMP_SETUP_EDIT
 } UIState;
 
 // VU state enumeration
@@ -96,18 +105,105 @@ const char* chorus_mode_names[] = {
     "1-MONO"
 };
 
+// Wah sweep sources
+typedef enum {
+    WAH_ENVELOPE,
+    WAH_LFO,
+    WAH_EXPRESSION
+} WahMode;
+
+const char* wah_mode_names[] = {
+    "AUTO (ENVELOPE)",
+    "LFO",
+    "EXPRESSION"
+};
+
+// Modulation destinations (parameters with a ramped fast path)
+typedef enum {
+    MOD_DEST_NONE,
+    MOD_DEST_VOLUME,
+    MOD_DEST_DELAY_MIX,
+    MOD_DEST_PREAMP_DRIVE,
+    MOD_DEST_REVERB_MIX,
+    MOD_DEST_TREM_DEPTH,
+    NUM_MOD_DESTS
+} ModDest;
+
+const char* mod_dest_names[] = {
+    "NONE",
+    "VOLUME",
+    "DELAY MIX",
+    "PREAMP DRIVE",
+    "REVERB MIX",
+    "TREM DEPTH"
+};
+
+// Modulation sources
+typedef enum {
+    MOD_SRC_NONE,
+    MOD_SRC_LFO1,       // Sine, one cycle per beat
+    MOD_SRC_LFO2,       // Triangle, one cycle per bar (4 beats)
+    MOD_SRC_ENV,        // Input envelope
+    MOD_SRC_EXP,        // EXP-2 pedal
+    MOD_SRC_TAP,        // Ramp over one beat of the tap tempo
+    MOD_SRC_MIDI,       // USB-MIDI CC (mod wheel)
+    NUM_MOD_SRCS
+} ModSource;
+
+const char* mod_src_names[] = {
+    "-",
+    "LFO1",
+    "LFO2",
+    "ENV",
+    "EXP",
+    "TAP",
+    "MIDI"
+};
+
+// Preset morph position sources
+typedef enum {
+    MORPH_SRC_OFF,
+    MORPH_SRC_EXP,
+    MORPH_SRC_ENCODER,
+    MORPH_SRC_FOOT
+} MorphSource;
+
+const char* morph_src_names[] = {
+    "OFF",
+    "EXP",
+    "ENC",
+    "FOOT"
+};
+
+#define NUM_MORPH_SRCS   (sizeof(morph_src_names) / sizeof(morph_src_names[0]))
+#define NUM_MORPH_TIMES  5
+#define MORPH_UI_STEPS   32                     // Encoder steps across A..B
+
+// Route depth steps shown in the matrix (-100..+100 %)
+#define MOD_DEPTH_STEP      10
+#define NUM_MOD_DEPTHS      (2 * 100 / MOD_DEPTH_STEP + 1)
+
 #define NUM_DELAY_MODES  (sizeof(delay_mode_names) / sizeof(delay_mode_names[0]))
 #define NUM_STEREO_MODES (sizeof(stereo_mode_names) / sizeof(stereo_mode_names[0]))
 #define NUM_CHORUS_MODES (sizeof(chorus_mode_names) / sizeof(chorus_mode_names[0]))
 #define NUM_PREAMPS      (sizeof(preamp_names) / sizeof(preamp_names[0]))
+#define NUM_WAH_MODES    (sizeof(wah_mode_names) / sizeof(wah_mode_names[0]))
 
 static DelayMode selected_delay_mode = DELAY_MODE_PARALLEL;
 static preamp selected_preamp_style  = MARSHALL;
+static bool power_amp_enabled        = false;   // Power amp + sag after the preamp
+static int8_t dual_amp_style         = -1;      // Second preamp in parallel (-1 = off)
+static uint8_t dual_amp_blend        = 5;       // A -> B, 0..10
+static uint8_t dual_amp_pan          = 5;       // Spread A left / B right, 0..10
 static FXmode selected_chorus_mode   = STEREO_3;
 static FXmode selected_phaser_mode   = FX_STEREO;
 static FXmode selected_flanger_mode  = FX_STEREO;
 static FXmode selected_tremolo_mode  = FX_STEREO;
 static FXmode selected_vibrato_mode  = FX_STEREO;
+static WahMode selected_wah_mode     = WAH_ENVELOPE;
+static ModDest exp_target            = MOD_DEST_NONE;
+static MorphSource morph_source      = MORPH_SRC_OFF;
+static uint8_t morph_time_index      = 2;       // Glide time (FOOT), index into morph_time_ms
 
 // Delay Fractions
 typedef enum {
@@ -159,7 +255,9 @@ static const char* allEffects[] = {
     "REVERB",       // REVB_EFFECT_INDEX
     "CAB SIM",      // CAB_SIM_EFFECT_INDEX
     "TREMOLO",      // TREM_EFFECT_INDEX
-    "VIBRATO"       // VIBR_EFFECT_INDEX
+    "VIBRATO",      // VIBR_EFFECT_INDEX
+    "WAH",          // WAH_EFFECT_INDEX
+    "MB COMP"       // MBC_EFFECT_INDEX
 };
 
 enum {
@@ -177,7 +275,9 @@ enum {
     CAB_SIM_EFFECT_INDEX,   // 11 CABINET SIMULATION
     TREM_EFFECT_INDEX,      // 12 TREMOLO
     VIBR_EFFECT_INDEX,      // 13 VIBRATO
-    NUM_EFFECTS             // 14 Total number of effects
+    WAH_EFFECT_INDEX,       // 14 WAH
+    MBC_EFFECT_INDEX,       // 15 MULTIBAND COMPRESSOR
+    NUM_EFFECTS             // 16 Total number of effects
 };
 
 #define NUM_EFFECTS (sizeof(allEffects) / sizeof(allEffects[0]))
@@ -186,7 +286,7 @@ enum {
 static const char potLabelSets[NUM_EFFECTS][NUM_FUNC_POTS][10] = {
     // Example pot labels for each effect
     { "Speed",      "Depth",    "-",        "Mix",      "LPF",      "Volume" },   // 0  CHORUS      [V]
-    { "Threshold",  "Ratio",    "Attack",   "Release",  "-",        "Volume" },   // 1  COMPRESSOR  [V]
+    { "Threshold",  "Ratio",    "Attack",   "Release",  "Lookahead","Volume" },   // 1  COMPRESSOR  [V]
     { "L Delay",    "R Delay",  "Feedback", "Mix",      "LPF",      "Volume" },   // 2  DELAY       [V]
     { "Gain",       "Bass",     "Mid",      "Frequency","Treble",   "Volume" },   // 3  DISTORTION  [V]
     { "Bass",       "Mid",      "Frequency","Treble",   "LPF",      "Volume" },   // 4  EQ          [V]
@@ -198,7 +298,9 @@ static const char potLabelSets[NUM_EFFECTS][NUM_FUNC_POTS][10] = {
     { "Mix",        "Decay",    "Diffuse",  "Dampig",   "Size",     "Volume" },   // 10 REVERB      [V]
     { "Low",        "Body",     "Mid",      "Presence", "Air-Freq", "Volume" },   // 11 CAB-SIM     [V]
     { "Speed",      "Depth",    "-",        "-",        "-",        "-"      },   // 12 TREMOLO     [V]
-    { "Speed",      "Depth",    "Mix",      "-",        "-",        "-"      }    // 13 VIBRATO     [ ]
+    { "Speed",      "Depth",    "Mix",      "-",        "-",        "-"      },   // 13 VIBRATO     [ ]
+    { "Sens",       "Range",    "Q",        "Attack",   "Mix",      "Volume" },   // 14 WAH         [V]
+    { "Low Freq",   "High Freq","Threshold","Ratio",    "Speed",    "Volume" }    // 15 MB COMP     [V]
 };
 
 uint16_t storedPotValue[NUM_EFFECTS][NUM_FUNC_POTS];
@@ -207,11 +309,36 @@ uint16_t storedPreampPotValue[NUM_PREAMPS][NUM_FUNC_POTS];
 bool param_selected = true; 
 uint8_t selectedEffects[3]; 
 
+// Slots in the routing graph: 0..2 follow the footswitches / LEDs,
+// the rest are set from the host (see routing.h)
+#define ROUTE_MAX_SLOTS     6
+#define ROUTE_EXTRA_SLOTS   (ROUTE_MAX_SLOTS - 3)
+int8_t route_extra_effect[ROUTE_EXTRA_SLOTS] = { -1, -1, -1 };     // -1 = empty
+
+// Effect of a slot, footswitch or extra (-1 = empty)
+static inline int slot_effect(int slot) {
+    return (slot < 3) ? (int)selectedEffects[slot] : route_extra_effect[slot - 3];
+}
+
+// Effect already used by another slot (effects have one state each)
+static inline bool effect_in_other_slot(int effect, int slot) {
+    for (int j = 0; j < 3; ++j) {
+        if (j != slot && selectedEffects[j] == effect) return true;
+    }
+    for (int j = 0; j < ROUTE_EXTRA_SLOTS; ++j) {
+        if (j + 3 != slot && route_extra_effect[j] == effect) return true;
+    }
+    return false;
+}
+
 int effectListIndex = 0;                 // Hovered item in effect list
 int delay_mode_menu_index = 0;           // Selected delay mode in menu
 int chorus_mode_menu_index = 0;          // Selected chorus mode in menu
 int stereo_mode_menu_index = 0;          // Selected stereo mode in menu
 int preamp_select_menu_index = 0;        // Selected preamp in menu
+int wah_mode_menu_index = 0;             // Selected wah source in menu
+int exp_target_menu_index = 0;           // Selected expression pedal target in menu
+int mod_matrix_cursor = 2;               // Field being edited in the modulation matrix
 
 // One cursor per menu so they don't fight other menus
 static int delay_fraction_menu_index_l = 0;
@@ -116,9 +116,11 @@ static inline int32_t qmul(int32_t a, int32_t b){
 
 // === Lerp and multiply helpers ===
 
-// Linear interpolation between a and b with frac in Q16
+// Linear interpolation between a and b with frac in Q16 (0..Q16_ONE). The
+// difference is taken in 64 bit: full-scale samples of opposite sign
+// overflow b - a in int32
 static inline int32_t lerp_fixed(int32_t a, int32_t b, uint32_t frac_q16) {
-    return a + ((int64_t)(b - a) * frac_q16 >> 16);
+    return (int32_t)(a + ((((int64_t)b - a) * frac_q16) >> 16));
 }
 
 // Fixed-point multiplication: a * b in Q16
@@ -140,4 +142,44 @@ static inline int32_t fc_to_q24(uint32_t fc, uint32_t fs) {
     double normalized = (double)fc / fs;
     double coeff = 2.0 * sin(M_PI * normalized);
     return (int32_t)(coeff * (1 << 24) + 0.5);
-}
\ No newline at end of file
+}
+// === Log2 domain (gain computers) ===
+
+// log2(1 + i/32) and 2^(i/32) in Q16, 33 points each
+static const uint32_t log2_frac_q16[33] = {
+    0, 2909, 5732, 8473, 11136, 13727, 16248, 18704, 21098, 23433, 25711, 27936, 30109, 32234, 34312, 36346,
+    38336, 40286, 42196, 44068, 45904, 47705, 49472, 51207, 52911, 54584, 56229, 57845, 59434, 60997, 62534, 64047,
+    65536
+};
+static const uint32_t exp2_frac_q16[33] = {
+    65536, 66971, 68438, 69936, 71468, 73032, 74632, 76266, 77936, 79642, 81386, 83169, 84990, 86851, 88752, 90696,
+    92682, 94711, 96785, 98905, 101070, 103283, 105545, 107856, 110218, 112631, 115098, 117618, 120194, 122825, 125515, 128263,
+    131072
+};
+
+// Decibels to log2 units in Q16 (1 log2 unit = 6.02 dB)
+static inline int32_t db_to_log2_q16(float db) {
+    return (int32_t)(db * (65536.0f / 6.0206f));
+}
+
+// log2(x) in Q16 (x = 0 returns log2 of 1)
+static inline int32_t log2_q16(uint32_t x) {
+    if (x == 0) return 0;
+    int e = 31 - __builtin_clz(x);
+    uint32_t m = (e >= 16) ? (x >> (e - 16)) : (x << (16 - e));    // 1.16 mantissa
+    uint32_t f = m & 0xFFFF;
+    uint32_t i = f >> 11;
+    return (e << 16) + lerp_fixed((int32_t)log2_frac_q16[i], (int32_t)log2_frac_q16[i + 1], (f & 0x7FF) << 5);
+}
+
+// 2^(x / 65536) as Q8.24, saturating
+static inline int32_t exp2_q24(int32_t x_q16) {
+    int32_t  e = x_q16 >> 16;                                       // floor
+    uint32_t f = (uint32_t)x_q16 & 0xFFFF;
+    uint32_t i = f >> 11;
+    uint32_t m = (uint32_t)lerp_fixed((int32_t)exp2_frac_q16[i], (int32_t)exp2_frac_q16[i + 1], (f & 0x7FF) << 5);
+    int sh = 8 + e;                                                 // Q16 mantissa -> Q24
+    if (sh > 14)   return INT32_MAX;
+    if (sh <= -17) return 0;
+    return (int32_t)((sh >= 0) ? (m << sh) : (m >> -sh));
+}
@@ -0,0 +1,161 @@
+/* mbc_apply.s
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Gain pass of the multiband compressor (src/effects/mb_compressor.h), one
+   channel, hand-compiled to ARMv6-M Thumb the way GCC -O2 lays it out: per
+   sample three ramped band gains, three 32x32->64 multiplies through an
+   __aeabi_lmul equivalent, the sum >> 23 and the clamps.
+
+   Backs the cost figure in mb_compressor.h; tests/test_m0sim.py runs it in
+   tools/m0sim.py and checks output and cycles. Reassemble with
+       llvm-mc -triple=thumbv6m-none-eabi -mcpu=cortex-m0plus -filetype=obj
+   and paste the .text bytes into MBC_APPLY there. */
+
+    .syntax unified
+    .cpu cortex-m0plus
+    .thumb
+    .text
+    .global apply
+    .thumb_func
+@ r0 = bands (3 x 24 int32, band stride 96), r1 = out, r2 = {g0,g1,g2,s0,s1,s2}, r3 = frames
+apply:
+    push {r4, r5, r6, r7, lr}
+    mov r4, r8
+    mov r5, r9
+    mov r6, r10
+    mov r7, r11
+    push {r4, r5, r6, r7}
+    mov r8, r0
+    mov r9, r1
+    mov r10, r2
+    mov r11, r3
+loop:
+    mov r2, r10
+    ldr r3, [r2, #0]
+    ldr r1, [r2, #12]
+    adds r3, r1
+    str r3, [r2, #0]
+    movs r2, r3
+    asrs r3, r2, #31
+    mov r0, r8
+    ldr r0, [r0, #0]
+    asrs r1, r0, #31
+    bl lmul
+    movs r6, r0
+    movs r7, r1
+
+    mov r2, r10
+    ldr r3, [r2, #4]
+    ldr r1, [r2, #16]
+    adds r3, r1
+    str r3, [r2, #4]
+    movs r2, r3
+    asrs r3, r2, #31
+    mov r0, r8
+    ldr r0, [r0, #96]
+    asrs r1, r0, #31
+    bl lmul
+    adds r6, r0
+    adcs r7, r1
+
+    mov r2, r10
+    ldr r3, [r2, #8]
+    ldr r1, [r2, #20]
+    adds r3, r1
+    str r3, [r2, #8]
+    movs r2, r3
+    asrs r3, r2, #31
+    mov r0, r8
+    adds r0, #192
+    ldr r0, [r0, #0]
+    asrs r1, r0, #31
+    bl lmul
+    adds r6, r0
+    adcs r7, r1
+
+    @ y >> 23, clamp32, clamp24
+    lsrs r6, r6, #23
+    lsls r0, r7, #9
+    orrs r6, r0
+    asrs r7, r7, #23
+    asrs r0, r6, #31
+    cmp r0, r7
+    beq 1f
+    ldr r6, =0x7FFFFF00
+    cmp r7, #0
+    bge 1f
+    rsbs r6, r6, #0
+1:  ldr r0, =0x7FFFFF00
+    cmp r6, r0
+    ble 2f
+    movs r6, r0
+2:  rsbs r0, r0, #0
+    cmp r6, r0
+    bge 3f
+    movs r6, r0
+3:  mov r0, r9
+    stmia r0!, {r6}
+    mov r9, r0
+    mov r0, r8
+    adds r0, #4
+    mov r8, r0
+    mov r0, r11
+    subs r0, #1
+    mov r11, r0
+    bne loop
+
+    pop {r4, r5, r6, r7}
+    mov r8, r4
+    mov r9, r5
+    mov r10, r6
+    mov r11, r7
+    pop {r4, r5, r6, r7, pc}
+
+@ r1:r0 * r3:r2 -> r1:r0 (low 64 bits)
+    .thumb_func
+lmul:
+    muls r1, r2
+    muls r3, r0
+    adds r1, r3
+    mov ip, r1
+    push {r4, r5}
+    lsrs r1, r0, #16
+    uxth r0, r0
+    lsrs r3, r2, #16
+    uxth r2, r2
+    movs r4, r0
+    muls r4, r2
+    muls r0, r3
+    muls r2, r1
+    muls r1, r3
+    movs r5, #0
+    adds r0, r2
+    adcs r5, r5
+    lsls r5, r5, #16
+    adds r1, r5
+    lsls r2, r0, #16
+    lsrs r0, r0, #16
+    adds r4, r2
+    adcs r1, r0
+    add r1, ip
+    movs r0, r4
+    pop {r4, r5}
+    bx lr
+    .ltorg
@@ -0,0 +1,44 @@
+#!/bin/sh
+# run_tests.sh
+# Author: Milan Wendt
+# Date:   2026-10-18
+#
+# Copyright (c) 2025 Milan Wendt
+#
+# This file is part of the RP2040-DSP project.
+#
+# This project (in the current state) is free software: you can redistribute it and/or modify it under
+# the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+#
+# RP2040 DSP is distributed in the hope that it will
+# be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this project.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# Host tests: the plain C modules built with the host compiler, then the
+# Python tools (tests/test_*.py) when python3 is there.
+#   tests/run_tests.sh            (CC to pick the compiler)
+
+set -e
+cd "$(dirname "$0")/.."
+
+CC=${CC:-cc}
+OUT=${TMPDIR:-/tmp}/rp2040dsp_tests
+mkdir -p "$OUT"
+
+for t in tests/test_*.c; do
+    name=$(basename "$t" .c)
+    $CC -std=gnu11 -O1 -Wall -Wextra -Werror -Isrc -Itests -o "$OUT/$name" "$t"
+    "$OUT/$name"
+done
+
+if command -v python3 >/dev/null 2>&1; then
+    for t in tests/test_*.py; do
+        python3 "$t"
+    done
+else
+    echo "python3 not found, skipping the tool tests"
+fi
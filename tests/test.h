@@ -0,0 +1,53 @@
+/* test.h
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+// Minimal checks for the host tests (tests/run_tests.sh)
+
+static int test_checks = 0;
+static int test_failures = 0;
+
+#define CHECK(cond) do {                                                        \
+    test_checks++;                                                              \
+    if (!(cond)) {                                                              \
+        test_failures++;                                                        \
+        printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);        \
+    }                                                                           \
+} while (0)
+
+#define CHECK_EQ(a, b) do {                                                     \
+    long long va_ = (long long)(a), vb_ = (long long)(b);                      \
+    test_checks++;                                                              \
+    if (va_ != vb_) {                                                           \
+        test_failures++;                                                        \
+        printf("%s:%d: %s == %s failed (%lld != %lld)\n", __FILE__, __LINE__,  \
+               #a, #b, va_, vb_);                                               \
+    }                                                                           \
+} while (0)
+
+static inline int test_report(const char* name) {
+    printf("%s: %d checks, %d failed\n", name, test_checks, test_failures);
+    return test_failures ? 1 : 0;
+}
+
+#endif // TEST_H
@@ -0,0 +1,161 @@
+/* test_host_proto.c
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host test of the host-control frame codec (src/host_proto.h): frames built
+// by host_frame_encode go back through host_parse_byte, plus the CRC check
+// values and the resync paths.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host_proto.h"
+
+#include "test.h"
+
+// Feed n bytes, returns how many complete frames came out
+static int feed(HostParser* p, const uint8_t* bytes, size_t n) {
+    int frames = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (host_parse_byte(p, bytes[i])) frames++;
+    }
+    return frames;
+}
+
+// === Tests ===
+static void test_crc_check_values(void) {
+    static const uint8_t check[] = "123456789";
+
+    uint16_t crc16 = 0xFFFF;                    // CRC-16/CCITT-FALSE
+    for (size_t i = 0; i < 9; i++) crc16 = host_crc16_update(crc16, check[i]);
+    CHECK_EQ(crc16, 0x29B1);
+
+    CHECK_EQ(host_crc32_update(0, check, 9), 0xCBF43926u);
+
+    // Chunked CRC-32 as in BULK_WRITE / BULK_COMMIT
+    uint32_t crc32 = host_crc32_update(0, check, 4);
+    CHECK_EQ(host_crc32_update(crc32, check + 4, 5), 0xCBF43926u);
+}
+
+static void test_put_get(void) {
+    uint8_t buf[6];
+    CHECK(host_put_u16(buf, 0xBEEF) == buf + 2);
+    CHECK(host_put_u32(buf + 2, 0x12345678u) == buf + 6);
+    CHECK_EQ(buf[0], 0xEF);                     // Little endian on the wire
+    CHECK_EQ(buf[2], 0x78);
+    CHECK_EQ(host_get_u16(buf), 0xBEEF);
+    CHECK_EQ(host_get_u32(buf + 2), 0x12345678u);
+}
+
+static void test_round_trip(void) {
+    static const uint16_t lens[] = { 0, 1, 2, 63, 64, 200, HOST_MAX_PAYLOAD };
+    static uint8_t payload[HOST_MAX_PAYLOAD];
+    static uint8_t frame[HOST_MAX_FRAME];
+    HostParser p;
+    host_parser_reset(&p);
+
+    for (size_t t = 0; t < sizeof(lens) / sizeof(lens[0]); t++) {
+        uint16_t len = lens[t];
+        for (uint16_t i = 0; i < len; i++) payload[i] = (uint8_t)(i * 7 + t);
+        // SOF bytes inside the payload must not resync the parser
+        if (len > 1) payload[1] = HOST_SOF;
+
+        size_t n = host_frame_encode(frame, HOST_CMD_SET_PARAM, (uint8_t)(0x40 + t), payload, len);
+        CHECK_EQ(n, len + HOST_FRAME_OVERHEAD);
+        CHECK_EQ(feed(&p, frame, n), 1);
+        CHECK_EQ(p.cmd, HOST_CMD_SET_PARAM);
+        CHECK_EQ(p.seq, 0x40 + t);
+        CHECK_EQ(p.len, len);
+        CHECK(memcmp(p.payload, payload, len) == 0);
+    }
+    CHECK_EQ(p.crc_errors, 0);
+}
+
+static void test_back_to_back_and_noise(void) {
+    static const uint8_t a[] = { 1, 2, 3 };
+    static const uint8_t b[] = { 0x10, 0x01 };
+    uint8_t stream[2 * HOST_MAX_FRAME + 8];
+    uint8_t* s = stream;
+    HostParser p;
+    host_parser_reset(&p);
+
+    // Line noise before the first SOF, then two frames without a gap
+    *s++ = 0x00;
+    *s++ = 0xFF;
+    *s++ = 0x13;
+    s += host_frame_encode(s, HOST_CMD_PING, 1, a, sizeof(a));
+    s += host_frame_encode(s, HOST_CMD_GET_PARAM, 2, b, sizeof(b));
+
+    CHECK_EQ(feed(&p, stream, (size_t)(s - stream)), 2);
+    CHECK_EQ(p.cmd, HOST_CMD_GET_PARAM);        // Last frame stays in the parser
+    CHECK_EQ(p.seq, 2);
+    CHECK_EQ(p.len, sizeof(b));
+    CHECK_EQ(p.crc_errors, 0);
+}
+
+static void test_corrupt_frame(void) {
+    static const uint8_t data[] = { 0xAA, 0x55, 0x00, 0x7F };
+    uint8_t frame[HOST_MAX_FRAME];
+    HostParser p;
+    host_parser_reset(&p);
+
+    // Each byte after SOF is covered by the CRC
+    size_t n = host_frame_encode(frame, HOST_CMD_BULK_WRITE, 9, data, sizeof(data));
+    for (size_t i = 1; i < n; i++) {
+        if (i == 3 || i == 4) continue;         // Length bytes: see below
+        frame[i] ^= 0x01;
+        CHECK_EQ(feed(&p, frame, n), 0);
+        frame[i] ^= 0x01;
+    }
+    CHECK_EQ(p.crc_errors, n - 3);
+
+    // Parser recovers right away
+    CHECK_EQ(feed(&p, frame, n), 1);
+    CHECK_EQ(p.seq, 9);
+}
+
+static void test_oversize_resync(void) {
+    static const uint8_t data[] = { 0x42 };
+    uint8_t frame[HOST_MAX_FRAME];
+    HostParser p;
+    host_parser_reset(&p);
+
+    // Length above HOST_MAX_PAYLOAD: header dropped, no CRC error counted
+    static const uint8_t bad[] = { HOST_SOF, HOST_CMD_BULK_WRITE, 3, 0x01, 0x01 };
+    CHECK_EQ(feed(&p, bad, sizeof(bad)), 0);
+    CHECK_EQ(p.crc_errors, 0);
+
+    // Next frame comes through
+    size_t n = host_frame_encode(frame, HOST_CMD_PING, 4, data, sizeof(data));
+    CHECK_EQ(feed(&p, frame, n), 1);
+    CHECK_EQ(p.seq, 4);
+    CHECK_EQ(p.payload[0], 0x42);
+}
+
+int main(void) {
+    test_crc_check_values();
+    test_put_get();
+    test_round_trip();
+    test_back_to_back_and_noise();
+    test_corrupt_frame();
+    test_oversize_resync();
+    return test_report("test_host_proto");
+}
@@ -0,0 +1,353 @@
+#!/usr/bin/env python3
+# test_m0sim.py
+# Author: Milan Wendt
+# Date:   2026-10-18
+#
+# Copyright (c) 2025 Milan Wendt
+#
+# This file is part of the RP2040-DSP project.
+#
+# This project (in the current state) is free software: you can redistribute it and/or modify it under
+# the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+#
+# RP2040 DSP is distributed in the hope that it will
+# be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this project.
+# If not, see <https://www.gnu.org/licenses/>.
+"""Host tests of tools/m0sim.py: decoder, flags and cycle timing on
+hand-assembled Thumb snippets, the XIP cache and SIO divider models, and the
+bench subcommand end to end on a synthetic ELF with its baseline check.
+
+The machine code was assembled with llvm-mc (thumbv6m, cortex-m0plus); the
+source is next to each blob.
+
+    python3 tests/test_m0sim.py     (also run by tests/run_tests.sh)
+"""
+
+import contextlib
+import io
+import json
+import os
+import random
+import struct
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "tools"))
+import m0sim  # noqa: E402
+
+SRAM = 0x20000000
+DATA = 0x20001000
+FLASH = 0x10000000
+
+N, Z, C, V = 1 << 31, 1 << 30, 1 << 29, 1 << 28
+
+# movs r0, #5 / subs r0, #6 / mrs r1, apsr / movs r2, #0 / mvns r2, r2
+# adds r2, #1 / mrs r3, apsr / bx lr
+ALU_FLAGS = "05200638eff300810022d2430132eff300837047"
+
+# movs r0, #1 / lsls r0, r0, #31 / subs r0, #1 / adds r0, #1 / mrs r1, apsr / bx lr
+OVERFLOW = "0120c00701380130eff300817047"
+
+# adds r0, r2 / adcs r1, r3 / bx lr                     (r1:r0 += r3:r2)
+CARRY_CHAIN = "801859417047"
+
+# asrs r1, r0, #32 / lsrs r2, r0, #32 / movs r3, #4 / rors r0, r3 / bx lr
+SHIFTS = "011002080423d8417047"
+
+# push {r4, lr} / movs r4, #0x80 / strh r1, [r0, #2] / ldrsh r2, [r0, r4]
+# ldrh r3, [r0, #2] / ldr r4, [r0, #4] / sxtb r4, r4 / str r4, [r0, #8]
+# movs r0, r3 / pop {r4, pc}
+MEMORY = "10b580244180025f4388446864b28460180010bd"
+
+# movs r1, #1 / movs r2, #2 / movs r3, #3 / stmia r0!, {r1-r3} / subs r0, #12
+# ldmia r0!, {r1-r3} / adds r0, r1, r2 / adds r0, r3 / bx lr
+LDM_STM = "0121022203230ec00c380ec88818c0187047"
+
+# push {r4, lr} 3 / ldr r4, [r0] 2 / str r4, [r0, #4] 2 / muls r4, r4 1
+# b 1f 2 / nop / 1: cmp r4, #0 1 / beq 1b 1 (not taken, r4 != 0) / bl 2f 3 / pop {r4, pc} 4
+# 2: bx lr 2
+TIMING = "10b504684460644300e000bf002cfdd000f001f810bd7047"
+TIMING_CYCLES = 3 + 2 + 2 + 1 + 2 + 1 + 1 + 3 + 2 + 4
+
+# lsls r0, r0, #4 / beq 2f / 1: subs r0, #1 / bne 1b / 2: bx lr
+COUNT_LOOP = "000101d00138fdd17047"
+
+# ldr r2, =0xd0000000 / str r0, [r2, #0x68] / str r1, [r2, #0x6c]
+# ldr r0, [r2, #0x70] / ldr r1, [r2, #0x74] / bx lr
+SIO_DIVIDE = "024a9066d166106f516f7047000000d0"
+
+# __aeabi_lmul style 64-bit multiply, r1:r0 * r3:r2 -> r1:r0
+LMUL = ("51434343c9188c4630b4010c80b2130c92b20400544358434a435943002580186d41"
+        "2d0449190204000ca41841416144200030bc7047")
+
+# Multiband compressor gain pass, one channel: tests/kernels/mbc_apply.s
+# apply(bands, out, gains_and_steps, frames)
+MBC_APPLY = ("f0b544464d4656465f46f0b48046894692469b4652461368d1685b1813601a00d3174046"
+             "0068c11700f042f806000f005246536811695b1853601a00d3174046006ec11700f034f8"
+             "36184f415246936851695b1893601a00d3174046c0300068c11700f025f836184f41f60d"
+             "78020643ff15f017b84203d01b4e002f00da76421948864200dd06004042864200da0600"
+             "484640c08146404604308046584601388346b7d1f0bca046a946b246bb46f0bd51434343"
+             "c9188c4630b4010c80b2130c92b20400544358434a435943002580186d412d0449190204"
+             "000ca41841416144200030bc7047000000ffff7f")
+MBC_APPLY_CYCLES = 4454                      # 24 frames, the mb_compressor.h figure
+
+# Kernel bench entry points (offsets into the blob):
+#   +0x00 kernel_bench_name:    lsls r0, r0, #3 / adr r1, names / adds r0, r1 / bx lr
+#   +0x08 kernel_bench_prepare: movs r0, #1 / bx lr
+#   +0x0c kernel_bench_block:   adds r0, #1 / lsls r0, r0, #4 / beq 2f
+#                               1: subs r0, #1 / bne 1b / 2: bx lr
+#   +0x1c names:                "alpha", "beta" in 8-byte slots
+BENCH = ("c00005a140187047012070470130000101d00138fdd17047"
+         "616c7068610000006265746100000000")
+
+
+def emulator(blob, addr=SRAM, **bus_args):
+    emu = m0sim.M0Plus(m0sim.Bus(None, **bus_args))
+    emu.bus.load(addr, bytes.fromhex(blob))
+    return emu
+
+
+def s32(x):
+    return x - (1 << 32) if x & (1 << 31) else x
+
+
+class Decoder(unittest.TestCase):
+    def test_flags(self):
+        emu = emulator(ALU_FLAGS)
+        emu.call(SRAM | 1)
+        self.assertEqual(emu.r[0], 0xFFFFFFFF)
+        self.assertEqual(emu.r[1] & (N | Z | C | V), N)         # Borrow: C clear
+        self.assertEqual(emu.r[2], 0)
+        self.assertEqual(emu.r[3] & (N | Z | C | V), Z | C)
+
+    def test_overflow(self):
+        emu = emulator(OVERFLOW)
+        emu.call(SRAM | 1)
+        self.assertEqual(emu.r[0], 0x80000000)
+        self.assertEqual(emu.r[1] & (N | Z | C | V), N | V)
+
+    def test_carry_chain(self):
+        rng = random.Random(1)
+        emu = emulator(CARRY_CHAIN)
+        for _ in range(200):
+            a, b = rng.getrandbits(64), rng.getrandbits(64)
+            emu.call(SRAM | 1, [a & m0sim.M32, a >> 32, b & m0sim.M32, b >> 32])
+            self.assertEqual(emu.r[0] | (emu.r[1] << 32), (a + b) & ((1 << 64) - 1))
+
+    def test_shifts(self):
+        emu = emulator(SHIFTS)
+        emu.call(SRAM | 1, [0x80000012])
+        self.assertEqual(emu.r[1], 0xFFFFFFFF)
+        self.assertEqual(emu.r[2], 0)
+        self.assertEqual(emu.r[0], 0x28000001)
+
+    def test_memory(self):
+        emu = emulator(MEMORY)
+        emu.bus.load(DATA, struct.pack("<II", 0, 0x123456F0))
+        emu.bus.load(DATA + 0x80, struct.pack("<h", -2))
+        ret, _ = emu.call(SRAM | 1, [DATA, 0xBEEF])
+        self.assertEqual(ret, 0xBEEF)
+        self.assertEqual(emu.r[2], 0xFFFFFFFE)                   # LDRSH sign-extends
+        self.assertEqual(emu.bus.read(DATA + 8, 4), 0xFFFFFFF0)  # SXTB
+        self.assertEqual(emu.r[13], emu.stack_top)               # PUSH / POP balanced
+
+    def test_ldm_stm(self):
+        emu = emulator(LDM_STM)
+        ret, cycles = emu.call(SRAM | 1, [DATA])
+        self.assertEqual(ret, 6)
+        self.assertEqual([emu.bus.read(DATA + 4 * i, 4) for i in range(3)], [1, 2, 3])
+
+    def test_lmul(self):
+        rng = random.Random(2)
+        emu = emulator(LMUL)
+        for _ in range(500):
+            a = rng.randint(-(1 << 31), (1 << 31) - 1)
+            b = rng.randint(-(1 << 31), (1 << 31) - 1)
+            # Sign-extended operands, like the compiler passes them
+            emu.call(SRAM | 1, [a, -1 if a < 0 else 0, b, -1 if b < 0 else 0])
+            got = emu.r[0] | (emu.r[1] << 32)
+            self.assertEqual(got, (a * b) & ((1 << 64) - 1))
+
+
+class Timing(unittest.TestCase):
+    def test_instruction_cycles(self):
+        emu = emulator(TIMING)
+        emu.bus.load(DATA, struct.pack("<I", 3))                # Non-zero: beq not taken
+        _, cycles = emu.call(SRAM | 1, [DATA])
+        self.assertEqual(cycles, TIMING_CYCLES)
+
+    def test_loop(self):
+        emu = emulator(COUNT_LOOP)
+        for turns in (1, 2, 10):
+            _, cycles = emu.call(SRAM | 1, [turns])
+            n = 16 * turns
+            # lsls 1, beq not taken 1, n x subs 1, n - 1 taken bne 2, last bne 1, bx 2
+            self.assertEqual(cycles, 1 + 1 + n + 2 * (n - 1) + 1 + 2)
+
+    def test_xip_cache(self):
+        emu = emulator(COUNT_LOOP, FLASH, xip_miss=50)
+        _, cold = emu.call(FLASH | 1, [1])
+        _, warm = emu.call(FLASH | 1, [1])
+        # 10 bytes of code = 2 cache lines of 8 bytes, missed once
+        self.assertEqual(cold - warm, 2 * 50)
+
+    def test_sio_divider(self):
+        emu = emulator(SIO_DIVIDE)
+        for n, d in ((100, 7), (-100, 7), (100, -7), (5, 0)):
+            emu.call(SRAM | 1, [n, d])
+            if d:
+                q = abs(n) // abs(d) * (1 if (n < 0) == (d < 0) else -1)
+                self.assertEqual((s32(emu.r[0]), s32(emu.r[1])), (q, n - q * d))
+            else:
+                self.assertEqual((emu.r[0], emu.r[1]), (0xFFFFFFFF, n))
+
+
+class Kernels(unittest.TestCase):
+    def test_mbc_apply(self):
+        frames = 24
+        bands_at, out_at, gains_at = DATA, DATA + 0x400, DATA + 0x800
+        rng = random.Random(1)
+        bands = [[rng.randint(-0x40000000, 0x3FFFFFFF) for _ in range(frames)] for _ in range(3)]
+        gains = [rng.randint(0x400000, 0x2000000) for _ in range(3)]
+        steps = [rng.randint(-2000, 2000) for _ in range(3)]
+
+        emu = emulator(MBC_APPLY)
+        emu.bus.load(bands_at, struct.pack("<%di" % (3 * frames), *[v for b in bands for v in b]))
+        emu.bus.load(gains_at, struct.pack("<6i", *(gains + steps)))
+        _, cycles = emu.call(SRAM | 1, [bands_at, out_at, gains_at, frames])
+
+        out = [s32(emu.bus.read(out_at + 4 * i, 4)) for i in range(frames)]
+        ref = []
+        for i in range(frames):
+            gains = [g + d for g, d in zip(gains, steps)]
+            y = sum(bands[b][i] * gains[b] for b in range(3)) >> 23
+            y = max(-(1 << 31), min((1 << 31) - 1, y))
+            ref.append(max(-0x7FFFFF00, min(0x7FFFFF00, y)))
+        self.assertEqual(out, ref)
+        self.assertEqual(cycles, MBC_APPLY_CYCLES)
+
+
+def make_elf(base, blob, symbols):
+    """Minimal ET_EXEC ELF32: .text at base plus a symbol table"""
+    shstr = b"\0.text\0.symtab\0.strtab\0.shstrtab\0"
+    strtab = b"\0"
+    syms = struct.pack("<IIIBBH", 0, 0, 0, 0, 0, 0)
+    for name, (off, size) in symbols.items():
+        syms += struct.pack("<IIIBBH", len(strtab), base + off, size, 0x10, 0, 1)   # Global
+        strtab += name.encode() + b"\0"
+
+    text_off = 52
+    sym_off = text_off + len(blob)
+    sym_off += (-sym_off) & 3
+    str_off = sym_off + len(syms)
+    shs_off = str_off + len(strtab)
+    sh_off = shs_off + len(shstr)
+    sh_off += (-sh_off) & 3
+
+    def sh(name, typ, flags, addr, off, size, link=0, info=0, align=1, entsize=0):
+        return struct.pack("<10I", name, typ, flags, addr, off, size, link, info, align, entsize)
+
+    shdrs = (sh(0, 0, 0, 0, 0, 0)
+             + sh(1, 1, 6, base, text_off, len(blob), align=4)                  # .text, AX
+             + sh(7, 2, 0, 0, sym_off, len(syms), 3, 1, 4, 16)                  # .symtab
+             + sh(15, 3, 0, 0, str_off, len(strtab))                            # .strtab
+             + sh(23, 3, 0, 0, shs_off, len(shstr)))                            # .shstrtab
+
+    ehdr = (b"\x7fELF\x01\x01\x01" + bytes(9)
+            + struct.pack("<HHIIIIIHHHHHH", 2, 40, 1, base | 1, 0, sh_off, 0x5000200, 52, 0, 0, 40, 5, 4))
+    out = bytearray(ehdr)
+    out += blob
+    out += bytes(sym_off - len(out)) + syms + strtab + shstr
+    out += bytes(sh_off - len(out)) + shdrs
+    return bytes(out)
+
+
+class Bench(unittest.TestCase):
+    def setUp(self):
+        blob = bytes.fromhex(BENCH) + struct.pack("<BxHI", 2, 24, 48000)
+        consts = len(bytes.fromhex(BENCH))
+        self.dir = tempfile.TemporaryDirectory()
+        self.elf = os.path.join(self.dir.name, "bench.elf")
+        with open(self.elf, "wb") as f:
+            f.write(make_elf(SRAM, blob, {
+                "kernel_bench_name": (0x01, 8),
+                "kernel_bench_prepare": (0x09, 4),
+                "kernel_bench_block": (0x0D, 16),
+                "kernel_bench_num_effects": (consts, 1),
+                "kernel_bench_frames": (consts + 2, 2),
+                "kernel_bench_rate": (consts + 4, 4),
+            }))
+
+    def tearDown(self):
+        self.dir.cleanup()
+
+    def bench(self, *extra):
+        out, err = io.StringIO(), io.StringIO()
+        with contextlib.redirect_stdout(out), contextlib.redirect_stderr(err):
+            code = m0sim.main(["bench", self.elf, "--blocks", "3", "--warmup", "1"] + list(extra))
+        return code, out.getvalue()
+
+    def test_elf_symbols(self):
+        with open(self.elf, "rb") as f:
+            elf = m0sim.Elf(f.read())
+        self.assertEqual(elf.symbol("kernel_bench_block"), SRAM | 0x0D)
+        with self.assertRaises(m0sim.EmuError):
+            elf.symbol("missing")
+
+    def test_committed_baseline(self):
+        # tests/m0sim_bench_baseline.json: the numbers the timing model gives this
+        # fixture, a change to the model shows up here first
+        path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "m0sim_bench_baseline.json")
+        code, out = self.bench("--baseline", path, "--threshold", "0")
+        self.assertEqual(code, 0, out)
+        with open(path) as f:
+            self.assertEqual(json.load(f)["effects"], {"alpha": 46, "beta": 94})
+
+    def test_cycles_and_baseline(self):
+        path = os.path.join(self.dir.name, "base.json")
+        code, out = self.bench("--write-baseline", path)
+        self.assertEqual(code, 0, out)
+        with open(path) as f:
+            base = json.load(f)
+
+        # Effect e runs 16 (e + 1) loop turns; the -1 overhead block skips the loop
+        # (beq taken 2 vs not taken 1): 3 n - 2 cycles on top
+        self.assertEqual(base["frames"], 24)
+        self.assertEqual(base["effects"], {"alpha": 3 * 16 - 2, "beta": 3 * 32 - 2})
+        self.assertIn("alpha", out)
+
+        # Same code against its own baseline passes, a faster baseline flags a regression
+        self.assertEqual(self.bench("--baseline", path)[0], 0)
+        base["effects"]["beta"] = 80
+        with open(path, "w") as f:
+            json.dump(base, f)
+        code, out = self.bench("--baseline", path, "--threshold", "3")
+        self.assertEqual(code, 1)
+        self.assertIn("REGRESSION beta", out)
+
+    def test_incomplete_baseline(self):
+        # An effect without a baseline entry, a baseline entry nobody measured and
+        # a baseline taken at another block size all fail instead of passing
+        path = os.path.join(self.dir.name, "base.json")
+        for base, flag in (({"alpha": 46}, "UNBASED beta"),
+                           ({"alpha": 46, "beta": 94, "gamma": 10}, "MISSING gamma")):
+            with open(path, "w") as f:
+                json.dump({"frames": 24, "xip_miss": 50, "effects": base}, f)
+            code, out = self.bench("--baseline", path)
+            self.assertEqual(code, 1, out)
+            self.assertIn(flag, out)
+
+        with open(path, "w") as f:
+            json.dump({"frames": 32, "xip_miss": 50, "effects": {"alpha": 46, "beta": 94}}, f)
+        code, out = self.bench("--baseline", path)
+        self.assertEqual(code, 1, out)
+        self.assertIn("BASELINE frames", out)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,186 @@
+/* test_midi.c
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host test of the MIDI parser and event queue (src/midi.h) through a fake
+// transport that hands out byte chunks with arrival times, like the USB
+// packets on the device.
+
+#include <stdio.h>
+#include <string.h>
+
+#define MIDI_MEMORY_BARRIER()   __sync_synchronize()
+#define MIDI_QUEUE_SIZE         8
+#include "midi.h"
+
+#include "test.h"
+
+// === Fake transport ===
+typedef struct {
+    const uint8_t* bytes;
+    size_t         len;
+    uint32_t       time_us;
+} Chunk;
+
+static const Chunk* fake_chunks;
+static size_t       fake_count;
+static size_t       fake_next;
+
+static size_t fake_read(uint8_t* buf, size_t max, uint32_t* time_us) {
+    if (fake_next >= fake_count) return 0;
+    const Chunk* c = &fake_chunks[fake_next++];
+    size_t n = c->len < max ? c->len : max;
+    memcpy(buf, c->bytes, n);
+    *time_us = c->time_us;
+    return n;
+}
+
+static void fake_start(const Chunk* chunks, size_t count) {
+    fake_chunks = chunks;
+    fake_count  = count;
+    fake_next   = 0;
+}
+
+// === Tests ===
+static void test_channel_messages(void) {
+    MidiParser p;
+    MidiQueue  q;
+    MidiEvent  e = { 0 };
+    midi_parser_reset(&p);
+    midi_queue_init(&q);
+
+    // CC 1 = 64 on channel 3, running status CC 1 = 65, note on (ignored), PC 1
+    static const uint8_t a[] = { 0xB2, 0x01, 0x40, 0x01 };
+    static const uint8_t b[] = { 0x41, 0x90, 0x3C, 0x7F, 0xC0, 0x01 };
+    const Chunk chunks[] = { { a, sizeof(a), 1000 }, { b, sizeof(b), 2000 } };
+    fake_start(chunks, 2);
+
+    CHECK_EQ(midi_poll(&p, &q, fake_read), 3);
+
+    CHECK(midi_queue_pop(&q, &e));
+    CHECK_EQ(e.type, MIDI_EV_CONTROL_CHANGE);
+    CHECK_EQ(e.channel, 2);
+    CHECK_EQ(e.data1, 1);
+    CHECK_EQ(e.data2, 64);
+    CHECK_EQ(e.time_us, 1000);
+
+    // Running status, completed by the second chunk: stamped with its arrival
+    CHECK(midi_queue_pop(&q, &e));
+    CHECK_EQ(e.type, MIDI_EV_CONTROL_CHANGE);
+    CHECK_EQ(e.data2, 65);
+    CHECK_EQ(e.time_us, 2000);
+
+    CHECK(midi_queue_pop(&q, &e));
+    CHECK_EQ(e.type, MIDI_EV_PROGRAM_CHANGE);
+    CHECK_EQ(e.data1, 1);
+    CHECK_EQ(e.data2, 0);
+
+    CHECK(!midi_queue_pop(&q, &e));
+}
+
+static void test_realtime_and_sysex(void) {
+    MidiParser p;
+    MidiQueue  q;
+    MidiEvent  e = { 0 };
+    midi_parser_reset(&p);
+    midi_queue_init(&q);
+
+    // Clock in the middle of a CC, SysEx with a clock inside, data after SysEx dropped
+    static const uint8_t a[] = { 0xB0, 0x01, 0xF8, 0x7F, 0xF0, 0x7E, 0xF8, 0x01, 0xF7, 0x10, 0xFA, 0xFC };
+    const Chunk chunks[] = { { a, sizeof(a), 500 } };
+    fake_start(chunks, 1);
+
+    CHECK_EQ(midi_poll(&p, &q, fake_read), 5);
+
+    static const uint8_t want[] = { MIDI_EV_CLOCK, MIDI_EV_CONTROL_CHANGE, MIDI_EV_CLOCK, MIDI_EV_START, MIDI_EV_STOP };
+    for (size_t i = 0; i < sizeof(want); i++) {
+        CHECK(midi_queue_pop(&q, &e));
+        CHECK_EQ(e.type, want[i]);
+        CHECK_EQ(e.time_us, 500);
+    }
+    CHECK(!midi_queue_pop(&q, &e));
+}
+
+static void test_clock_timestamps(void) {
+    MidiParser p;
+    MidiQueue  q;
+    MidiEvent  e = { 0 };
+    midi_parser_reset(&p);
+    midi_queue_init(&q);
+
+    // 120 BPM: one tick every 20833 us, each in its own transfer
+    static const uint8_t tick[] = { 0xF8 };
+    Chunk chunks[4];
+    for (int i = 0; i < 4; i++) chunks[i] = (Chunk){ tick, 1, 100000u + (uint32_t)i * 20833u };
+    fake_start(chunks, 4);
+
+    CHECK_EQ(midi_poll(&p, &q, fake_read), 4);
+    for (int i = 0; i < 4; i++) {
+        CHECK(midi_queue_pop(&q, &e));
+        CHECK_EQ(e.time_us, 100000u + (uint32_t)i * 20833u);
+    }
+}
+
+static void test_queue_full(void) {
+    MidiParser p;
+    MidiQueue  q;
+    MidiEvent  e = { 0 };
+    midi_parser_reset(&p);
+    midi_queue_init(&q);
+
+    uint8_t ticks[MIDI_QUEUE_SIZE + 3];
+    memset(ticks, 0xF8, sizeof(ticks));
+    const Chunk chunks[] = { { ticks, sizeof(ticks), 0 } };
+    fake_start(chunks, 1);
+
+    CHECK_EQ(midi_poll(&p, &q, fake_read), MIDI_QUEUE_SIZE);
+    CHECK_EQ(q.dropped, 3);
+
+    // Drain, then the ring wraps and works again
+    for (int i = 0; i < MIDI_QUEUE_SIZE; i++) CHECK(midi_queue_pop(&q, &e));
+    CHECK(!midi_queue_pop(&q, &e));
+
+    static const uint8_t pc[] = { 0xC5, 0x00 };
+    const Chunk again[] = { { pc, sizeof(pc), 7 } };
+    fake_start(again, 1);
+    CHECK_EQ(midi_poll(&p, &q, fake_read), 1);
+    CHECK(midi_queue_pop(&q, &e));
+    CHECK_EQ(e.type, MIDI_EV_PROGRAM_CHANGE);
+    CHECK_EQ(e.channel, 5);
+}
+
+static void test_usb_packet_len(void) {
+    CHECK_EQ(midi_usb_packet_len(0x0F), 1);     // Single byte (clock)
+    CHECK_EQ(midi_usb_packet_len(0x0B), 3);     // Control change
+    CHECK_EQ(midi_usb_packet_len(0x0C), 2);     // Program change
+    CHECK_EQ(midi_usb_packet_len(0x04), 3);     // SysEx start / continue
+    CHECK_EQ(midi_usb_packet_len(0x05), 1);     // SysEx end with 1 byte
+    CHECK_EQ(midi_usb_packet_len(0x06), 2);
+    CHECK_EQ(midi_usb_packet_len(0x07), 3);
+    CHECK_EQ(midi_usb_packet_len(0x10), 0);     // Reserved (cable 1, CIN 0)
+}
+
+int main(void) {
+    test_channel_messages();
+    test_realtime_and_sysex();
+    test_clock_timestamps();
+    test_queue_full();
+    test_usb_packet_len();
+    return test_report("test_midi");
+}
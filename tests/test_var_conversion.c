@@ -0,0 +1,96 @@
+/* test_var_conversion.c
+ * Author: Milan Wendt
+ * Date:   2026-10-18
+ *
+ * Copyright (c) 2025 Milan Wendt
+ *
+ * This file is part of the RP2040-DSP project.
+ *
+ * This project (in the current state) is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+ *
+ * RP2040 DSP is distributed in the hope that it will
+ * be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this project.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host test of the fixed-point helpers in src/var_conversion.h.
+
+#include <stdint.h>
+#include <math.h>
+
+#define POT_MAX     4095                    // io.h
+#define SAMPLE_RATE 48000                   // i2s.h
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmisleading-indentation"
+#include "var_conversion.h"
+#pragma GCC diagnostic pop
+
+#include "test.h"
+
+// Every step of a crossfade stays between its end points
+static int lerp_in_range(int32_t a, int32_t b) {
+    int32_t lo = a < b ? a : b;
+    int32_t hi = a < b ? b : a;
+    for (uint32_t f = 0; f <= Q16_ONE; f += 64) {
+        int32_t y = lerp_fixed(a, b, f);
+        if (y < lo || y > hi) return 0;
+    }
+    return 1;
+}
+
+static void test_lerp(void) {
+    CHECK_EQ(lerp_fixed(100, 200, 0), 100);
+    CHECK_EQ(lerp_fixed(100, 200, Q16_ONE), 200);
+    CHECK_EQ(lerp_fixed(100, 200, Q16_ONE / 2), 150);
+    CHECK_EQ(lerp_fixed(-200, 200, Q16_ONE / 4), -100);
+
+    // b - a overflows int32
+    CHECK_EQ(lerp_fixed(0x60000000, -0x60000000, 0x8000), 0);
+    CHECK_EQ(lerp_fixed(INT32_MIN, INT32_MAX, Q16_ONE), INT32_MAX);
+    CHECK_EQ(lerp_fixed(INT32_MAX, INT32_MIN, Q16_ONE), INT32_MIN);
+    CHECK(lerp_in_range(0x7FFFFF00, -0x7FFFFF00));
+    CHECK(lerp_in_range(INT32_MIN, INT32_MAX));
+}
+
+// ROUTE_OP_MIX and the dropped-slot fade (Main.c): two loud branches in
+// opposite phase, every sample, at any mix
+static void test_parallel_mix(void) {
+    int ok = 1;
+    for (uint32_t mix = 0; mix <= Q16_ONE; mix += 257) {
+        for (int32_t x = 0x00100000; x <= 0x7FFFFF00 - 0x00100000; x += 0x00100000) {
+            int32_t y = lerp_fixed(x, -x, mix);
+            int32_t expect = (int32_t)(((int64_t)x * (int32_t)(Q16_ONE - 2 * mix)) >> 16);
+            if (y < -x || y > x || y - expect > 1 || expect - y > 1) ok = 0;
+        }
+    }
+    CHECK(ok);
+    CHECK_EQ(lerp_fixed(0x7FFFFF00, -0x7FFFFF00, Q16_ONE / 2), 0);
+}
+
+// Elastic ring shrink splice (Main.c): the block it drops fades into the
+// next one over AUDIO_BUFFER_FRAMES, ending on the new block
+static void test_splice(void) {
+    const size_t frames = 24;
+    int ok = 1;
+    int32_t last = 0;
+    for (size_t i = 0; i < frames; i++) {
+        uint32_t g = (uint32_t)(((i + 1) * Q16_ONE) / frames);
+        int32_t y = lerp_fixed(-0x7FFFFF00, 0x7FFFFF00, g);
+        if (y < last && i > 0) ok = 0;              // Rises monotonically
+        last = y;
+    }
+    CHECK(ok);
+    CHECK_EQ(last, 0x7FFFFF00);
+}
+
+int main(void) {
+    test_lerp();
+    test_parallel_mix();
+    test_splice();
+    return test_report("test_var_conversion");
+}
@@ -0,0 +1,53 @@
+#!/bin/sh
+# ci_bench.sh
+# Author: Milan Wendt
+# Date:   2026-10-18
+#
+# Copyright (c) 2025 Milan Wendt
+#
+# This file is part of the RP2040-DSP project.
+#
+# This project (in the current state) is free software: you can redistribute it and/or modify it under
+# the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+#
+# RP2040 DSP is distributed in the hope that it will
+# be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this project.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# Kernel cycle check for CI: builds the firmware with the bench entry points
+# and compares every effect against tools/kernel_bench_baseline.json.
+#   PICO_SDK_PATH=... BOOTROM=b2.bin tools/ci_bench.sh
+#
+# BOOTROM is the RP2040 B2 boot ROM image (tools/m0sim.py needs it for the
+# ROM float and memcpy routines). The check fails on a missing BOOTROM, a
+# missing baseline, an effect without a baseline entry and a baseline entry
+# that was not measured. WRITE_BASELINE=1 stores this build's numbers
+# instead: run it on a reviewed build and commit the file.
+
+set -e
+cd "$(dirname "$0")/.."
+
+: "${PICO_SDK_PATH:?PICO_SDK_PATH not set}"
+: "${BOOTROM:?BOOTROM not set (RP2040 B2 boot ROM image)}"
+[ -f "$BOOTROM" ] || { echo "BOOTROM $BOOTROM: no such file" >&2; exit 1; }
+
+BUILD=${BUILD:-build_bench}
+BASELINE=tools/kernel_bench_baseline.json
+THRESHOLD=${THRESHOLD:-3}
+
+cmake -S . -B "$BUILD" -DKERNEL_BENCH=ON -DCMAKE_BUILD_TYPE=Release
+cmake --build "$BUILD" -j"$(nproc)"
+
+if [ "${WRITE_BASELINE:-0}" = 1 ]; then
+    python3 tools/m0sim.py bench "$BUILD/Main.elf" --rom "$BOOTROM" --write-baseline "$BASELINE"
+    echo "Wrote $BASELINE, commit it"
+    exit 0
+fi
+
+[ -f "$BASELINE" ] || { echo "$BASELINE missing: WRITE_BASELINE=1 $0, then commit it" >&2; exit 1; }
+python3 tools/m0sim.py bench "$BUILD/Main.elf" --rom "$BOOTROM" \
+    --baseline "$BASELINE" --threshold "$THRESHOLD"
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""I2S clock planner for the RP2040 (same search as src/clock_plan.h).
+
+Lists the system clocks whose SCK PIO divider is exact in 8.8 fixed point
+for a sample rate, fastest first, with the length of the fractional
+divider pattern (1 = integer divider, no jitter).
+
+Examples:
+    clock_plan.py                      # 48 kHz, 256 fs SCK, up to 250 MHz
+    clock_plan.py --fs 44100 --max-mhz 270 --all
+
+No dependencies.
+"""
+
+import argparse
+import sys
+
+XOSC_HZ = 12000000
+VCO_MIN_HZ = 750000000
+VCO_MAX_HZ = 1600000000
+SCK_PIO_MULT = 2            # Must match i2s.pio
+MAX_PATTERN = 8             # CLOCK_PLAN_MAX_PATTERN
+
+
+def pattern(frac):
+    """Pattern length of an 8.8 divider's fractional part"""
+    if frac == 0:
+        return 1
+    n = 256
+    while frac & 1 == 0:
+        frac >>= 1
+        n >>= 1
+    return n
+
+
+def plans(fs, sck_mult, max_hz):
+    """Every exact plan up to max_hz: (sys, vco, pd1, pd2, div_x256, pattern), fastest first"""
+    sck_pio_hz = fs * sck_mult * SCK_PIO_MULT
+    seen = {}
+    for fbdiv in range(16, 321):
+        vco = XOSC_HZ * fbdiv
+        if not VCO_MIN_HZ <= vco <= VCO_MAX_HZ:
+            continue
+        for pd1 in range(1, 8):
+            for pd2 in range(1, pd1 + 1):
+                if vco % (pd1 * pd2):
+                    continue
+                sys_hz = vco // (pd1 * pd2)
+                if sys_hz > max_hz or sys_hz in seen:
+                    continue
+                if (sys_hz * 256) % sck_pio_hz:
+                    continue
+                div_x256 = sys_hz * 256 // sck_pio_hz
+                if not 256 <= div_x256 < 1 << 24:
+                    continue
+                seen[sys_hz] = (sys_hz, vco, pd1, pd2, div_x256, pattern(div_x256 & 0xFF))
+    return sorted(seen.values(), reverse=True)
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description="RP2040 I2S clock planner")
+    ap.add_argument("--fs", type=int, default=48000, help="sample rate in Hz")
+    ap.add_argument("--sck-mult", type=int, default=256, help="SCK as a multiple of fs")
+    ap.add_argument("--max-mhz", type=float, default=250.0, help="highest clk_sys allowed")
+    ap.add_argument("--max-pattern", type=int, default=MAX_PATTERN, help="longest divider pattern accepted")
+    ap.add_argument("--all", action="store_true", help="also list plans over the pattern limit")
+    args = ap.parse_args(argv)
+
+    found = plans(args.fs, args.sck_mult, int(args.max_mhz * 1e6))
+    ok = [p for p in found if p[5] <= args.max_pattern]
+
+    print("fs %d Hz, SCK %d fs, clk_sys <= %.2f MHz" % (args.fs, args.sck_mult, args.max_mhz))
+    print("%10s %10s %4s %4s %14s %8s" % ("sys MHz", "VCO MHz", "pd1", "pd2", "SCK divider", "pattern"))
+    for sys_hz, vco, pd1, pd2, div, pat in (found if args.all else ok):
+        mark = " <" if ok and (sys_hz, vco, pd1, pd2, div, pat) == ok[0] else ""
+        print("%10.3f %10.1f %4d %4d %8d+%3d/256 %8d%s" % (sys_hz / 1e6, vco / 1e6, pd1, pd2, div >> 8, div & 0xFF, pat, mark))
+    if not ok:
+        print("no plan within the pattern limit, the firmware falls back to SYSTEM_CLOCK_MHZ")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,870 @@
+#!/usr/bin/env python3
+# m0sim.py
+# Author: Milan Wendt
+# Date:   2026-10-18
+#
+# Copyright (c) 2025 Milan Wendt
+#
+# This file is part of the RP2040-DSP project.
+#
+# This project (in the current state) is free software: you can redistribute it and/or modify it under
+# the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+#
+# RP2040 DSP is distributed in the hope that it will
+# be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this project.
+# If not, see <https://www.gnu.org/licenses/>.
+"""Cortex-M0+ cycle-counting emulator for the RP2040 effect kernels.
+
+Runs functions of the ARM-compiled firmware ELF instruction by instruction
+(ARMv6-M Thumb) and counts core 0 cycles with the RP2040 timing:
+
+    - Cortex-M0+ instruction timing (single-cycle multiplier, loads 2 cycles,
+      taken branches 2, BL 3, LDM/STM/PUSH 1+N, POP {..pc} 3+N, ...)
+    - SRAM, boot ROM and XIP-SRAM: no wait states
+    - XIP flash: 16 kB 2-way cache with 8-byte lines, a miss costs --xip-miss
+    - SIO (divider, spinlocks) single cycle over the IOPORT, APB peripherals
+      --apb-wait extra cycles
+    - SIO hardware divider, the 64-bit timer (from the cycle count)
+
+Not modelled: bus contention with core 1 / DMA, interrupts.
+
+The SDK takes memcpy / float routines from the boot ROM, so pass a ROM
+image (--rom, the RP2040 B2 bootrom from the pico-bootrom releases).
+
+Kernel bench (firmware built with cmake -DKERNEL_BENCH=ON, see Main.c):
+    m0sim.py bench build/Main.elf --rom b2.bin
+    m0sim.py bench build/Main.elf --rom b2.bin --write-baseline kernels.json
+    m0sim.py bench build/Main.elf --rom b2.bin --baseline kernels.json --threshold 3
+
+With --baseline the exit code is 1 when an effect got more than --threshold
+percent slower, so a CI job can run it on every change.
+
+Any function:
+    m0sim.py call build/Main.elf some_function 1 2
+
+No dependencies.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+M32 = 0xFFFFFFFF
+RETURN_ADDR = 0xF0000000            # LR of a call from the host, unmapped
+
+ROM_SIZE = 0x4000
+SRAM_SIZE = 0x42000                 # Striped banks + scratch X / Y
+XIP_SRAM_SIZE = 0x4000
+CACHE_SETS = 1024                   # 16 kB / 2 ways / 8-byte lines
+
+SIO_BASE = 0xD0000000
+TIMER_BASE = 0x40054000
+
+BOOTROM_INITS = ("__aeabi_bits_init", "__aeabi_mem_init", "__aeabi_float_init", "__aeabi_double_init")
+
+
+class EmuError(Exception):
+    pass
+
+
+def sext(value, bits):
+    sign = 1 << (bits - 1)
+    return (value & (sign - 1)) - (value & sign)
+
+
+# ============================================================================
+# === ELF ====================================================================
+# ============================================================================
+
+class Elf:
+    """Sections and symbols of a 32-bit little-endian ELF"""
+
+    def __init__(self, data):
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise EmuError("not a 32-bit little-endian ELF")
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+
+        raw = [struct.unpack_from("<10I", data, shoff + i * shentsize) for i in range(shnum)]
+        names = raw[shstrndx]
+
+        def cstr(table, off):
+            start = table[4] + off
+            return data[start:data.index(b"\0", start)].decode("ascii", "replace")
+
+        self.data = data
+        self.sections = []
+        for s in raw:
+            self.sections.append(dict(name=cstr(names, s[0]), type=s[1], flags=s[2], addr=s[3],
+                                      offset=s[4], size=s[5], link=s[6], entsize=s[9]))
+
+        self.symbols = {}
+        for s in raw:
+            if s[1] != 2:                       # SHT_SYMTAB
+                continue
+            strtab = raw[s[6]]
+            for off in range(s[4], s[4] + s[5], 16):
+                name, value, size, info, _, shndx = struct.unpack_from("<IIIBBH", data, off)
+                if not name or shndx == 0:
+                    continue
+                sym = cstr(strtab, name)
+                bind = info >> 4
+                if sym not in self.symbols or bind == 1:    # Globals win over locals
+                    self.symbols[sym] = (value, size)
+
+    def symbol(self, name):
+        if name not in self.symbols:
+            raise EmuError("symbol %s not in the ELF" % name)
+        return self.symbols[name][0]
+
+
+# ============================================================================
+# === RP2040 bus =============================================================
+# ============================================================================
+
+class Bus:
+    """Memory map with wait states, self.wait collects the extra cycles"""
+
+    def __init__(self, rom=None, xip_miss=50, apb_wait=3, clk_hz=230400000):
+        self.rom = bytearray(ROM_SIZE)
+        if rom:
+            self.rom[:len(rom)] = rom[:ROM_SIZE]
+        self.flash = bytearray(0x200000)
+        self.sram = bytearray(SRAM_SIZE)
+        self.xip_sram = bytearray(XIP_SRAM_SIZE)
+        self.periph = {}
+        self.xip_miss = xip_miss
+        self.apb_wait = apb_wait
+        self.clk_hz = clk_hz
+        self.cpu = None
+        self.wait = 0
+        self.cache = [[-1, -1, 0] for _ in range(CACHE_SETS)]   # tag way 0, way 1, LRU way
+        self.last_uncached = -1
+        self.div = dict(udividend=0, udivisor=0, quotient=0, remainder=0)
+
+    # --- Backing store -----------------------------------------------------
+
+    def _locate(self, addr, size):
+        """(bytearray, offset) of plain memory, None for registers"""
+        region = addr >> 24
+        if region == 0x00 and addr + size <= ROM_SIZE:
+            return self.rom, addr
+        if 0x10 <= region <= 0x13:
+            off = addr & 0xFFFFFF
+            if off + size > len(self.flash):
+                self.flash.extend(bytes(off + size - len(self.flash)))
+            return self.flash, off
+        if region == 0x15 and (addr & 0xFFFFFF) + size <= XIP_SRAM_SIZE:
+            return self.xip_sram, addr & 0xFFFFFF
+        if region == 0x20 and (addr & 0xFFFFFF) + size <= SRAM_SIZE:
+            return self.sram, addr & 0xFFFFFF
+        if region == 0x21:
+            # Non-striped alias: bank n at n * 64 kB, same cells as the striped map
+            off = addr & 0xFFFFFF
+            if off < 0x40000:
+                bank, word = off >> 16, (off & 0xFFFF) >> 2
+                return self.sram, (word << 4) | (bank << 2) | (off & 3)
+            if off < SRAM_SIZE:
+                return self.sram, off
+        return None
+
+    def load(self, addr, blob):
+        loc = self._locate(addr, len(blob))
+        if loc is None:
+            raise EmuError("can't load %d bytes at 0x%08x" % (len(blob), addr))
+        mem, off = loc
+        mem[off:off + len(blob)] = blob
+
+    # --- Timing ------------------------------------------------------------
+
+    def _xip_access(self, addr, fetch):
+        region = addr >> 24
+        if region >= 0x12:                      # Uncached aliases
+            word = addr >> 2
+            if not fetch or word != self.last_uncached:
+                self.wait += self.xip_miss
+            self.last_uncached = word
+            return
+        line = (addr & 0xFFFFFF) >> 3
+        index = line % CACHE_SETS
+        tag = line // CACHE_SETS
+        s = self.cache[index]
+        if s[0] == tag:
+            s[2] = 1
+        elif s[1] == tag:
+            s[2] = 0
+        else:
+            self.wait += self.xip_miss
+            if region == 0x10:                  # 0x11 = no allocate
+                victim = s[2]
+                s[victim] = tag
+                s[2] = victim ^ 1
+
+    # --- Registers ---------------------------------------------------------
+
+    def _reg_read(self, addr):
+        if addr >> 28 == 0xD:
+            self.wait -= 1                      # IOPORT: single cycle
+            off = addr - SIO_BASE
+            if off == 0x000:
+                return 0                        # CPUID: core 0
+            if off == 0x070:
+                return self.div["quotient"]
+            if off == 0x074:
+                return self.div["remainder"]
+            if off == 0x078:
+                return 1                        # CSR: ready, not dirty
+            if 0x100 <= off < 0x180:
+                return 1 << ((off - 0x100) >> 2)   # Spinlock claimed
+            return self.periph.get(addr, 0)
+        if addr >> 28 in (0x4, 0x5):
+            self.wait += self.apb_wait
+            if TIMER_BASE <= addr < TIMER_BASE + 0x30:
+                us = self.cpu.cycles * 1000000 // self.clk_hz
+                off = addr - TIMER_BASE
+                if off in (0x08, 0x24):
+                    return (us >> 32) & M32
+                if off in (0x0C, 0x28):
+                    return us & M32
+        if addr >> 28 in (0x4, 0x5, 0xD, 0xE):
+            return self.periph.get(addr & ~0x3000 if addr >> 28 == 0x4 else addr, 0)
+        raise EmuError("read of unmapped 0x%08x" % addr)
+
+    def _reg_write(self, addr, value):
+        if addr >> 28 == 0xD:
+            self.wait -= 1
+            off = addr - SIO_BASE
+            d = self.div
+            if off in (0x060, 0x068):
+                d["udividend"] = value
+            elif off in (0x064, 0x06C):
+                d["udivisor"] = value
+            elif off == 0x070:
+                d["quotient"] = value
+            elif off == 0x074:
+                d["remainder"] = value
+            if off in (0x060, 0x064):
+                self._divide(False)
+            elif off in (0x068, 0x06C):
+                self._divide(True)
+            self.periph[addr] = value
+            return
+        if addr >> 28 in (0x4, 0x5):
+            self.wait += self.apb_wait
+            if addr >> 28 == 0x4:
+                alias = (addr >> 12) & 3        # 1 = XOR, 2 = set, 3 = clear
+                base = addr & ~0x3000
+                old = self.periph.get(base, 0)
+                value = [value, old ^ value, old | value, old & ~value][alias]
+                addr = base
+            self.periph[addr] = value
+            return
+        if addr >> 28 == 0xE:
+            self.periph[addr] = value
+            return
+        raise EmuError("write to unmapped 0x%08x" % addr)
+
+    def _divide(self, signed):
+        d = self.div
+        n, m = d["udividend"], d["udivisor"]
+        if signed:
+            n, m = sext(n, 32), sext(m, 32)
+        if m == 0:
+            q = (1 if n < 0 else M32) if signed else M32
+            r = n
+        elif signed:
+            q = abs(n) // abs(m)
+            if (n < 0) != (m < 0):
+                q = -q
+            r = n - q * m
+        else:
+            q, r = n // m, n % m
+        d["quotient"], d["remainder"] = q & M32, r & M32
+
+    # --- Access ------------------------------------------------------------
+
+    def fetch16(self, addr):
+        if addr >> 28 == 1 and (addr >> 24) != 0x15:
+            self._xip_access(addr, True)
+        loc = self._locate(addr, 2)
+        if loc is None:
+            raise EmuError("instruction fetch from 0x%08x" % addr)
+        mem, off = loc
+        return mem[off] | (mem[off + 1] << 8)
+
+    def read(self, addr, size):
+        if addr & (size - 1):
+            raise EmuError("unaligned %d-byte read at 0x%08x" % (size, addr))
+        if addr >> 28 == 1 and (addr >> 24) != 0x15:
+            self._xip_access(addr, False)
+        loc = self._locate(addr, size)
+        if loc is None:
+            word = self._reg_read(addr & ~3)
+            return (word >> ((addr & 3) * 8)) & ((1 << (size * 8)) - 1)
+        mem, off = loc
+        return int.from_bytes(mem[off:off + size], "little")
+
+    def write(self, addr, size, value):
+        if addr & (size - 1):
+            raise EmuError("unaligned %d-byte write at 0x%08x" % (size, addr))
+        region = addr >> 24
+        if 0x10 <= region <= 0x13:
+            raise EmuError("write to XIP flash at 0x%08x" % addr)
+        loc = self._locate(addr, size)
+        if loc is None:
+            if size != 4:
+                value = (value & ((1 << (size * 8)) - 1)) * (0x01010101 if size == 1 else 0x00010001)
+            self._reg_write(addr & ~3, value & M32)
+            return
+        mem, off = loc
+        mem[off:off + size] = (value & ((1 << (size * 8)) - 1)).to_bytes(size, "little")
+
+    def cstring(self, addr, limit=64):
+        out = bytearray()
+        while len(out) < limit:
+            b = self.read(addr + len(out), 1)
+            if b == 0:
+                break
+            out.append(b)
+        return out.decode("ascii", "replace")
+
+
+# ============================================================================
+# === Cortex-M0+ core ========================================================
+# ============================================================================
+
+class M0Plus:
+    def __init__(self, bus):
+        self.bus = bus
+        bus.cpu = self
+        self.r = [0] * 16
+        self.n = self.z = self.c = self.v = 0
+        self.primask = 0
+        self.control = 0
+        self.cycles = 0
+        self.steps = 0
+        self.stack_top = 0x20042000
+
+    def load_elf(self, elf):
+        for s in elf.sections:
+            if not (s["flags"] & 2) or s["size"] == 0:      # SHF_ALLOC
+                continue
+            if s["type"] == 8:                              # SHT_NOBITS
+                self.bus.load(s["addr"], bytes(s["size"]))
+            else:
+                self.bus.load(s["addr"], elf.data[s["offset"]:s["offset"] + s["size"]])
+        if "__StackTop" in elf.symbols:
+            self.stack_top = elf.symbol("__StackTop")
+
+    def call(self, addr, args=(), max_steps=50000000):
+        """Run a function until it returns: (r0, cycles)"""
+        r = self.r
+        for i, a in enumerate(args):
+            r[i] = a & M32
+        r[13] = self.stack_top
+        r[14] = RETURN_ADDR | 1
+        r[15] = addr & ~1
+        start = self.cycles
+        self.run(RETURN_ADDR, max_steps)
+        return r[0], self.cycles - start
+
+    def _cond(self, cond):
+        n, z, c, v = self.n, self.z, self.c, self.v
+        if cond == 0:  return z
+        if cond == 1:  return not z
+        if cond == 2:  return c
+        if cond == 3:  return not c
+        if cond == 4:  return n
+        if cond == 5:  return not n
+        if cond == 6:  return v
+        if cond == 7:  return not v
+        if cond == 8:  return c and not z
+        if cond == 9:  return (not c) or z
+        if cond == 10: return n == v
+        if cond == 11: return n != v
+        if cond == 12: return (not z) and n == v
+        if cond == 13: return z or n != v
+        return True
+
+    def _nz(self, res):
+        self.n = res >> 31
+        self.z = int(res == 0)
+        return res
+
+    def _add(self, x, y, carry):
+        u = x + y + carry
+        res = u & M32
+        self.n = res >> 31
+        self.z = int(res == 0)
+        self.c = int(u > M32)
+        self.v = (((x ^ res) & (y ^ res)) >> 31) & 1
+        return res
+
+    def _sub(self, x, y):
+        return self._add(x, (~y) & M32, 1)
+
+    def _special_read(self, sysm):
+        if sysm <= 7:
+            return (self.n << 31) | (self.z << 30) | (self.c << 29) | (self.v << 28)
+        if sysm in (8, 9):
+            return self.r[13]
+        if sysm == 16:
+            return self.primask
+        if sysm == 20:
+            return self.control
+        return 0
+
+    def _special_write(self, sysm, value):
+        if sysm <= 3:
+            self.n, self.z, self.c, self.v = (value >> 31) & 1, (value >> 30) & 1, (value >> 29) & 1, (value >> 28) & 1
+        elif sysm in (8, 9):
+            self.r[13] = value & ~3
+        elif sysm == 16:
+            self.primask = value & 1
+        elif sysm == 20:
+            self.control = value & 3
+
+    def run(self, stop_pc, max_steps):
+        r = self.r
+        bus = self.bus
+        rd_mem = bus.read
+        wr_mem = bus.write
+        steps = 0
+
+        while r[15] != stop_pc:
+            steps += 1
+            if steps > max_steps:
+                raise EmuError("no return after %d instructions (pc 0x%08x), polling hardware?" % (max_steps, r[15]))
+
+            pc = r[15]
+            h = bus.fetch16(pc)
+            nxt = pc + 2
+            cyc = 1
+            top = h >> 11
+
+            if top <= 2:
+                # LSLS / LSRS / ASRS (immediate)
+                imm = (h >> 6) & 31
+                x = r[(h >> 3) & 7]
+                if top == 0:
+                    if imm:
+                        self.c = (x >> (32 - imm)) & 1
+                        x = (x << imm) & M32
+                elif top == 1:
+                    imm = imm or 32
+                    self.c = (x >> (imm - 1)) & 1
+                    x = x >> imm if imm < 32 else 0
+                else:
+                    imm = imm or 32
+                    sx = sext(x, 32)
+                    self.c = (sx >> (imm - 1)) & 1 if imm < 32 else x >> 31
+                    x = (sx >> min(imm, 31)) & M32
+                r[h & 7] = self._nz(x)
+
+            elif top == 3:
+                # ADDS / SUBS (register or 3-bit immediate)
+                y = (h >> 6) & 7 if h & 0x400 else r[(h >> 6) & 7]
+                x = r[(h >> 3) & 7]
+                r[h & 7] = self._sub(x, y) if h & 0x200 else self._add(x, y, 0)
+
+            elif top <= 7:
+                # MOVS / CMP / ADDS / SUBS (8-bit immediate)
+                rdn = (h >> 8) & 7
+                imm = h & 0xFF
+                if top == 4:
+                    r[rdn] = self._nz(imm)
+                elif top == 5:
+                    self._sub(r[rdn], imm)
+                elif top == 6:
+                    r[rdn] = self._add(r[rdn], imm, 0)
+                else:
+                    r[rdn] = self._sub(r[rdn], imm)
+
+            elif top == 8:
+                if not h & 0x400:
+                    # Data processing
+                    op = (h >> 6) & 15
+                    rdn = h & 7
+                    x = r[rdn]
+                    y = r[(h >> 3) & 7]
+                    if op == 0:
+                        r[rdn] = self._nz(x & y)
+                    elif op == 1:
+                        r[rdn] = self._nz(x ^ y)
+                    elif op in (2, 3, 4, 7):
+                        s = y & 0xFF
+                        if s == 0:
+                            res = x
+                        elif op == 2:
+                            self.c = (x >> (32 - s)) & 1 if s <= 32 else 0
+                            res = (x << s) & M32 if s < 32 else 0
+                        elif op == 3:
+                            self.c = (x >> (s - 1)) & 1 if s <= 32 else 0
+                            res = x >> s if s < 32 else 0
+                        elif op == 4:
+                            sx = sext(x, 32)
+                            self.c = (sx >> (s - 1)) & 1 if s < 32 else x >> 31
+                            res = (sx >> min(s, 31)) & M32
+                        else:
+                            rot = s & 31
+                            res = ((x >> rot) | (x << (32 - rot))) & M32 if rot else x
+                            self.c = res >> 31
+                        r[rdn] = self._nz(res)
+                    elif op == 5:
+                        r[rdn] = self._add(x, y, self.c)
+                    elif op == 6:
+                        r[rdn] = self._add(x, (~y) & M32, self.c)
+                    elif op == 8:
+                        self._nz(x & y)
+                    elif op == 9:
+                        r[rdn] = self._sub(0, y)
+                    elif op == 10:
+                        self._sub(x, y)
+                    elif op == 11:
+                        self._add(x, y, 0)
+                    elif op == 12:
+                        r[rdn] = self._nz(x | y)
+                    elif op == 13:
+                        r[rdn] = self._nz((x * y) & M32)     # Single-cycle multiplier
+                    elif op == 14:
+                        r[rdn] = self._nz(x & ~y & M32)
+                    else:
+                        r[rdn] = self._nz((~y) & M32)
+                else:
+                    # High register ADD / CMP / MOV, BX / BLX
+                    op = (h >> 8) & 3
+                    rm = (h >> 3) & 15
+                    y = pc + 4 if rm == 15 else r[rm]
+                    if op == 3:
+                        if h & 0x80:
+                            r[14] = (pc + 2) | 1
+                        nxt = y & ~1
+                        cyc = 2
+                    else:
+                        rdn = ((h >> 4) & 8) | (h & 7)
+                        x = pc + 4 if rdn == 15 else r[rdn]
+                        if op == 1:
+                            self._sub(x, y)
+                        else:
+                            res = (x + y) & M32 if op == 0 else y
+                            if rdn == 15:
+                                nxt = res & ~1
+                                cyc = 2
+                            else:
+                                r[rdn] = res
+
+            elif top == 9:
+                # LDR (literal)
+                r[(h >> 8) & 7] = rd_mem(((pc + 4) & ~3) + (h & 0xFF) * 4, 4)
+                cyc = 2
+
+            elif top <= 11:
+                # Load / store (register offset)
+                op = (h >> 9) & 7
+                addr = (r[(h >> 3) & 7] + r[(h >> 6) & 7]) & M32
+                rt = h & 7
+                if op == 0:
+                    wr_mem(addr, 4, r[rt])
+                elif op == 1:
+                    wr_mem(addr, 2, r[rt])
+                elif op == 2:
+                    wr_mem(addr, 1, r[rt])
+                elif op == 3:
+                    r[rt] = sext(rd_mem(addr, 1), 8) & M32
+                elif op == 4:
+                    r[rt] = rd_mem(addr, 4)
+                elif op == 5:
+                    r[rt] = rd_mem(addr, 2)
+                elif op == 6:
+                    r[rt] = rd_mem(addr, 1)
+                else:
+                    r[rt] = sext(rd_mem(addr, 2), 16) & M32
+                cyc = 2
+
+            elif top <= 17:
+                # STR / LDR / STRB / LDRB / STRH / LDRH (immediate)
+                imm = (h >> 6) & 31
+                if top <= 13:
+                    size = 4
+                elif top <= 15:
+                    size = 1
+                else:
+                    size = 2
+                addr = (r[(h >> 3) & 7] + imm * size) & M32
+                if top & 1:
+                    r[h & 7] = rd_mem(addr, size)
+                else:
+                    wr_mem(addr, size, r[h & 7])
+                cyc = 2
+
+            elif top <= 19:
+                # STR / LDR (SP relative)
+                addr = (r[13] + (h & 0xFF) * 4) & M32
+                if top & 1:
+                    r[(h >> 8) & 7] = rd_mem(addr, 4)
+                else:
+                    wr_mem(addr, 4, r[(h >> 8) & 7])
+                cyc = 2
+
+            elif top == 20:
+                r[(h >> 8) & 7] = (((pc + 4) & ~3) + (h & 0xFF) * 4) & M32     # ADR
+
+            elif top == 21:
+                r[(h >> 8) & 7] = (r[13] + (h & 0xFF) * 4) & M32              # ADD rd, SP, #imm
+
+            elif top <= 23:
+                # Miscellaneous
+                sub = (h >> 8) & 15
+                if sub == 0:
+                    imm = (h & 0x7F) * 4
+                    r[13] = (r[13] - imm if h & 0x80 else r[13] + imm) & M32
+                elif sub == 2:
+                    x = r[(h >> 3) & 7]
+                    op = (h >> 6) & 3
+                    r[h & 7] = [sext(x, 16) & M32, sext(x, 8) & M32, x & 0xFFFF, x & 0xFF][op]
+                elif sub in (4, 5):
+                    regs = [i for i in range(8) if h & (1 << i)] + ([14] if h & 0x100 else [])
+                    addr = (r[13] - 4 * len(regs)) & M32
+                    r[13] = addr
+                    for i in regs:
+                        wr_mem(addr, 4, r[i])
+                        addr += 4
+                    cyc = 1 + len(regs)
+                elif sub == 6:
+                    if (h & 0xFFEF) == 0xB662:
+                        self.primask = (h >> 4) & 1         # CPSID / CPSIE i
+                    else:
+                        raise EmuError("undefined 0x%04x at 0x%08x" % (h, pc))
+                elif sub == 10:
+                    x = r[(h >> 3) & 7]
+                    op = (h >> 6) & 3
+                    if op == 0:
+                        res = int.from_bytes(x.to_bytes(4, "little"), "big")
+                    elif op == 1:
+                        res = ((x & 0x00FF00FF) << 8) | ((x >> 8) & 0x00FF00FF)
+                    elif op == 3:
+                        res = sext(((x & 0xFF) << 8) | ((x >> 8) & 0xFF), 16) & M32
+                    else:
+                        raise EmuError("undefined 0x%04x at 0x%08x" % (h, pc))
+                    r[h & 7] = res
+                elif sub in (12, 13):
+                    regs = [i for i in range(8) if h & (1 << i)]
+                    addr = r[13]
+                    for i in regs:
+                        r[i] = rd_mem(addr, 4)
+                        addr += 4
+                    cyc = 1 + len(regs)
+                    if h & 0x100:
+                        nxt = rd_mem(addr, 4) & ~1
+                        addr += 4
+                        cyc = 3 + len(regs)
+                    r[13] = addr & M32
+                elif sub == 14:
+                    raise EmuError("BKPT #%d at 0x%08x" % (h & 0xFF, pc))
+                elif sub == 15:
+                    hint = (h >> 4) & 15
+                    if h & 15:
+                        raise EmuError("undefined 0x%04x at 0x%08x" % (h, pc))
+                    cyc = 2 if hint in (2, 3) else 1        # WFE / WFI: no events here, fall through
+                else:
+                    raise EmuError("undefined 0x%04x at 0x%08x" % (h, pc))
+
+            elif top <= 25:
+                # STM / LDM
+                rn = (h >> 8) & 7
+                regs = [i for i in range(8) if h & (1 << i)]
+                addr = r[rn]
+                for i in regs:
+                    if top == 24:
+                        wr_mem(addr, 4, r[i])
+                    else:
+                        r[i] = rd_mem(addr, 4)
+                    addr += 4
+                if top == 24 or rn not in regs:
+                    r[rn] = addr & M32
+                cyc = 1 + len(regs)
+
+            elif top <= 27:
+                cond = (h >> 8) & 15
+                if cond == 15:
+                    raise EmuError("SVC #%d at 0x%08x" % (h & 0xFF, pc))
+                if cond == 14:
+                    raise EmuError("UDF #%d at 0x%08x" % (h & 0xFF, pc))
+                if self._cond(cond):
+                    nxt = (pc + 4 + sext(h & 0xFF, 8) * 2) & M32
+                    cyc = 2
+
+            elif top == 28:
+                nxt = (pc + 4 + sext(h & 0x7FF, 11) * 2) & M32         # B
+                cyc = 2
+
+            elif top >= 30:
+                # 32-bit: BL, MSR, MRS, barriers
+                h2 = bus.fetch16(pc + 2)
+                nxt = pc + 4
+                if (h2 & 0xD000) == 0xD000 and top == 30:
+                    s = (h >> 10) & 1
+                    i1 = 1 ^ (((h2 >> 13) & 1) ^ s)
+                    i2 = 1 ^ (((h2 >> 11) & 1) ^ s)
+                    imm = (s << 24) | (i1 << 23) | (i2 << 22) | ((h & 0x3FF) << 12) | ((h2 & 0x7FF) << 1)
+                    r[14] = (pc + 4) | 1
+                    nxt = (pc + 4 + sext(imm, 25)) & M32
+                    cyc = 3
+                elif (h & 0xFFF0) == 0xF380 and (h2 & 0xFF00) == 0x8800:
+                    self._special_write(h2 & 0xFF, r[h & 15])
+                    cyc = 3
+                elif h == 0xF3EF and (h2 & 0xF000) == 0x8000:
+                    r[(h2 >> 8) & 15] = self._special_read(h2 & 0xFF)
+                    cyc = 3
+                elif h == 0xF3BF and (h2 & 0xFF80) == 0x8F00:
+                    cyc = 3                                          # DSB / DMB / ISB
+                else:
+                    raise EmuError("undefined 0x%04x %04x at 0x%08x" % (h, h2, pc))
+
+            else:
+                raise EmuError("undefined 0x%04x at 0x%08x" % (h, pc))
+
+            r[15] = nxt
+            self.cycles += cyc + bus.wait
+            bus.wait = 0
+
+        self.steps += steps
+
+
+# ============================================================================
+# === Kernel bench ===========================================================
+# ============================================================================
+
+def make_emulator(args):
+    with open(args.elf, "rb") as f:
+        elf = Elf(f.read())
+    rom = None
+    if args.rom:
+        with open(args.rom, "rb") as f:
+            rom = f.read()
+    emu = M0Plus(Bus(rom, args.xip_miss, args.apb_wait, int(args.clk_mhz * 1e6)))
+    emu.load_elf(elf)
+
+    # The SDK looks its memcpy / float routines up in the boot ROM
+    if rom:
+        for name in BOOTROM_INITS:
+            if name in elf.symbols:
+                emu.call(elf.symbol(name))
+    else:
+        print("warning: no --rom, code using memcpy or floats will fail", file=sys.stderr)
+    return elf, emu
+
+
+def bench(args):
+    elf, emu = make_emulator(args)
+    bus = emu.bus
+
+    count = bus.read(elf.symbol("kernel_bench_num_effects"), 1)
+    frames = bus.read(elf.symbol("kernel_bench_frames"), 2)
+    rate = bus.read(elf.symbol("kernel_bench_rate"), 4)
+    name_fn = elf.symbol("kernel_bench_name")
+    prepare = elf.symbol("kernel_bench_prepare")
+    block = elf.symbol("kernel_bench_block")
+    budget = args.clk_mhz * 1e6 * frames / rate
+
+    def run_blocks(effect):
+        # The first blocks warm the XIP cache, the rest are measured
+        cycles = [emu.call(block, [effect])[1] for _ in range(args.warmup + args.blocks)]
+        return cycles[args.warmup:]
+
+    overhead = min(run_blocks(-1))
+
+    results = {}
+    print("%d frames @ %d Hz, %.1f MHz: %d cycles per block" % (frames, rate, args.clk_mhz, budget))
+    print("%-12s %10s %10s %8s %7s" % ("effect", "cycles", "max", "/sample", "load"))
+    for effect in range(count):
+        name = bus.cstring(emu.call(name_fn, [effect])[0])
+        if not emu.call(prepare, [effect])[0]:
+            print("%-12s %10s" % (name, "skipped (needs hardware)"))
+            continue
+        cycles = [c - overhead for c in run_blocks(effect)]
+        mean = sum(cycles) // len(cycles)
+        results[name] = mean
+        print("%-12s %10d %10d %8.1f %6.1f%%" % (name, mean, max(cycles), mean / frames, 100.0 * mean / budget))
+
+    if args.write_baseline:
+        with open(args.write_baseline, "w") as f:
+            json.dump({"frames": frames, "xip_miss": args.xip_miss, "effects": results}, f, indent=2, sort_keys=True)
+            f.write("\n")
+
+    if not args.baseline:
+        return 0
+
+    with open(args.baseline) as f:
+        stored = json.load(f)
+    base = stored["effects"]
+    failed = False
+    for key, value in (("frames", frames), ("xip_miss", args.xip_miss)):
+        if stored.get(key) != value:
+            print("BASELINE %s is %s, this run %s: regenerate it" % (key, stored.get(key), value))
+            failed = True
+    for name in sorted(set(base) - set(results)):
+        print("MISSING %s: in the baseline, not measured" % name)
+        failed = True
+    for name, mean in sorted(results.items()):
+        if name not in base:
+            print("UNBASED %s: %d cycles, no baseline entry" % (name, mean))
+            failed = True
+            continue
+        change = 100.0 * (mean - base[name]) / base[name]
+        if change > args.threshold:
+            print("REGRESSION %s: %d -> %d cycles (%+.1f%%)" % (name, base[name], mean, change))
+            failed = True
+        elif change < -args.threshold:
+            print("%s: %d -> %d cycles (%+.1f%%), update the baseline" % (name, base[name], mean, change))
+    return 1 if failed else 0
+
+
+def call(args):
+    elf, emu = make_emulator(args)
+    ret, cycles = emu.call(elf.symbol(args.symbol), [int(a, 0) for a in args.args])
+    print("r0 = 0x%08x, %d cycles, %d instructions" % (ret, cycles, emu.steps))
+    return 0
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description="Cortex-M0+ cycle-counting emulator (RP2040 timing)")
+    sub = ap.add_subparsers(dest="cmd", required=True)
+
+    def common(p):
+        p.add_argument("elf", help="firmware ELF")
+        p.add_argument("--rom", help="RP2040 boot ROM image")
+        p.add_argument("--clk-mhz", type=float, default=230.4, help="clk_sys for the budget and the timer")
+        p.add_argument("--xip-miss", type=int, default=50, help="cycles per XIP cache miss")
+        p.add_argument("--apb-wait", type=int, default=3, help="extra cycles per peripheral access")
+
+    p = sub.add_parser("bench", help="cycles per block of every effect (firmware built with KERNEL_BENCH)")
+    common(p)
+    p.add_argument("--blocks", type=int, default=8, help="measured blocks per effect")
+    p.add_argument("--warmup", type=int, default=2, help="blocks run before measuring")
+    p.add_argument("--baseline", help="JSON from --write-baseline to compare against")
+    p.add_argument("--threshold", type=float, default=3.0, help="allowed slowdown in percent")
+    p.add_argument("--write-baseline", help="store the results as a baseline")
+    p.set_defaults(func=bench)
+
+    p = sub.add_parser("call", help="run one function and count its cycles")
+    common(p)
+    p.add_argument("symbol")
+    p.add_argument("args", nargs="*", help="integer arguments (r0..r3)")
+    p.set_defaults(func=call)
+
+    args = ap.parse_args(argv)
+    try:
+        return args.func(args)
+    except EmuError as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+# rp2040dsp.py
+# Author: Milan Wendt
+# Date:   2026-10-18
+#
+# Copyright (c) 2025 Milan Wendt
+#
+# This file is part of the RP2040-DSP project.
+#
+# This project (in the current state) is free software: you can redistribute it and/or modify it under
+# the terms of the GNU General Public License, version 3 as published by the Free Software Foundation.
+#
+# RP2040 DSP is distributed in the hope that it will
+# be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this project.
+# If not, see <https://www.gnu.org/licenses/>.
+"""Host library and CLI for the RP2040-DSP control port (second USB CDC).
+
+Frame format (see src/host_proto.h):
+    0xA5 | cmd | seq | len (u16 LE) | payload | crc16-ccitt (u16 LE)
+
+Library use:
+    with Device("/dev/ttyACM1") as dev:
+        dev.set_params([(effect, pot, value), ...])
+
+CLI examples:
+    rp2040dsp.py -p /dev/ttyACM1 ping
+    rp2040dsp.py -p /dev/ttyACM1 set 2 0 2048
+    rp2040dsp.py -p /dev/ttyACM1 telemetry
+    rp2040dsp.py -p /dev/ttyACM1 download a preset_a.bin
+    rp2040dsp.py -p /dev/ttyACM1 upload b preset_b.bin
+    rp2040dsp.py -p /dev/ttyACM1 route "0 [ 1 | 3 ]40 2" --extra 3=10
+    rp2040dsp.py -p /dev/ttyACM1 route "0 1 2" --extra 3=10 --dual-mono on
+
+Requires pyserial.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+SOF = 0xA5
+RESPONSE = 0x80
+MAX_PAYLOAD = 256
+
+CMD_PING = 0x01
+CMD_GET_PARAM = 0x10
+CMD_SET_PARAM = 0x11
+CMD_TELEMETRY = 0x20
+CMD_TELEMETRY_RST = 0x21
+CMD_BULK_READ = 0x30
+CMD_BULK_BEGIN = 0x31
+CMD_BULK_WRITE = 0x32
+CMD_BULK_COMMIT = 0x33
+CMD_SAVE = 0x40
+CMD_GET_ROUTE = 0x50
+CMD_SET_ROUTE = 0x51
+
+STATUS = {0: "OK", 1: "unknown command", 2: "bad argument", 3: "CRC mismatch", 4: "no transfer open"}
+REGIONS = {"a": 0, "b": 1, "live": 2}
+
+# Routing graph tokens (see src/routing.h) and their text form
+ROUTE_FX, ROUTE_SPLIT, ROUTE_SPLIT_LR, ROUTE_BRANCH, ROUTE_JOIN = range(5)
+ROUTE_EXTRA_SLOTS = 3
+ROUTE_DUAL_MONO = 0x01      # Flag: extra slots run the right input as chain B
+
+
+def parse_route(text):
+    """'0 [ 1 | 3 ]40 2' -> tokens. N = slot, [ = split, [lr = L/R split,
+    | = branch B, ]M = join with M % of B (default 50)"""
+    tokens = []
+    for word in text.split():
+        if word.isdigit():
+            tokens.append((ROUTE_FX, int(word)))
+        elif word == "[":
+            tokens.append((ROUTE_SPLIT, 0))
+        elif word == "[lr":
+            tokens.append((ROUTE_SPLIT_LR, 0))
+        elif word == "|":
+            tokens.append((ROUTE_BRANCH, 0))
+        elif word.startswith("]"):
+            tokens.append((ROUTE_JOIN, int(word[1:] or 50)))
+        else:
+            raise ValueError("bad route token %r" % word)
+    return tokens
+
+
+def format_route(tokens):
+    names = {ROUTE_SPLIT: "[", ROUTE_SPLIT_LR: "[lr", ROUTE_BRANCH: "|"}
+    out = []
+    for kind, arg in tokens:
+        if kind == ROUTE_FX:
+            out.append(str(arg))
+        elif kind == ROUTE_JOIN:
+            out.append("]%d" % arg)
+        else:
+            out.append(names.get(kind, "?"))
+    return " ".join(out)
+
+
+class ProtocolError(Exception):
+    pass
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE"""
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def encode_frame(cmd, seq, payload=b""):
+    body = struct.pack("<BBH", cmd, seq, len(payload)) + payload
+    return bytes([SOF]) + body + struct.pack("<H", crc16(body))
+
+
+class Device:
+    def __init__(self, port, timeout=0.2, retries=3):
+        import serial  # pyserial, only needed for a real port
+        self.ser = serial.Serial(port, timeout=timeout)
+        self.retries = retries
+        self.seq = 0
+        self.info = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.ser.close()
+
+    # --- transport ---
+
+    def _read_frame(self):
+        while True:
+            b = self.ser.read(1)
+            if not b:
+                return None
+            if b[0] == SOF:
+                break
+        head = self.ser.read(4)
+        if len(head) != 4:
+            return None
+        cmd, seq, n = struct.unpack("<BBH", head)
+        rest = self.ser.read(n + 2)
+        if len(rest) != n + 2:
+            return None
+        payload, crc = rest[:n], struct.unpack("<H", rest[n:])[0]
+        if crc16(head + payload) != crc:
+            return None
+        return cmd, seq, payload
+
+    def request(self, cmd, payload=b""):
+        """Send one request, return the response payload after the status byte"""
+        for _ in range(self.retries):
+            self.seq = (self.seq + 1) & 0xFF
+            self.ser.reset_input_buffer()
+            self.ser.write(encode_frame(cmd, self.seq, payload))
+            frame = self._read_frame()
+            if frame is None:
+                continue
+            rcmd, rseq, data = frame
+            if rcmd != (cmd | RESPONSE) or rseq != self.seq or not data:
+                continue
+            if data[0] != 0:
+                raise ProtocolError(STATUS.get(data[0], "status %d" % data[0]))
+            return data[1:]
+        raise ProtocolError("no response")
+
+    # --- commands ---
+
+    def ping(self):
+        d = self.request(CMD_PING)
+        version, effects, pots, preamps, frames, rate, image = struct.unpack("<BBBBBIH", d[:11])
+        self.info = dict(version=version, effects=effects, pots=pots, preamps=preamps,
+                         block_frames=frames, sample_rate=rate, image_size=image)
+        return self.info
+
+    def get_param(self, effect, pot):
+        return struct.unpack("<H", self.request(CMD_GET_PARAM, bytes([effect, pot])))[0]
+
+    def set_params(self, triples):
+        """Write (effect, pot, value) triples, batched into as few frames as fit"""
+        triples = list(triples)
+        per_frame = MAX_PAYLOAD // 4
+        for i in range(0, len(triples), per_frame):
+            chunk = b"".join(struct.pack("<BBH", e, p, v) for e, p, v in triples[i:i + per_frame])
+            self.request(CMD_SET_PARAM, chunk)
+
+    def telemetry(self):
+        d = self.request(CMD_TELEMETRY)
+        period, cpu0_peak, cpu1_peak, xruns, blocks, midi_drop, crc_err, bins = struct.unpack("<HHHIIIIB", d[:25])
+        hist = list(struct.unpack("<%dI" % bins, d[25:25 + 4 * bins]))
+        out = dict(block_period_us=period, cpu0_peak_us=cpu0_peak, cpu1_peak_us=cpu1_peak,
+                   xruns=xruns, blocks=blocks, midi_dropped=midi_drop, crc_errors=crc_err, histogram=hist)
+        ring = d[25 + 4 * bins:]
+        if len(ring) >= 20:
+            (out["ring_blocks"], out["ring_depth"], out["latency_frames"], out["slack_frames"],
+             out["min_slack_frames"], out["ring_grows"], out["underruns"],
+             out["deferred_overruns"]) = struct.unpack("<BBHHHIII", ring[:20])
+        if len(ring) >= 28:
+            out["sys_clock_hz"], out["clock_switches"] = struct.unpack("<II", ring[20:28])
+        if len(ring) >= 32:
+            out["responses_dropped"], = struct.unpack("<I", ring[28:32])
+        return out
+
+    def reset_telemetry(self):
+        self.request(CMD_TELEMETRY_RST)
+
+    def _image_size(self):
+        if self.info is None:
+            self.ping()
+        return self.info["image_size"]
+
+    def read_region(self, region):
+        size = self._image_size()
+        out = b""
+        while len(out) < size:
+            n = min(MAX_PAYLOAD - 1, size - len(out))
+            out += self.request(CMD_BULK_READ, struct.pack("<BIB", region, len(out), n))
+        return out
+
+    def write_region(self, region, image):
+        if len(image) != self._image_size():
+            raise ProtocolError("image is %d bytes, device expects %d" % (len(image), self._image_size()))
+        self.request(CMD_BULK_BEGIN, struct.pack("<BI", region, len(image)))
+        step = MAX_PAYLOAD - 4
+        for off in range(0, len(image), step):
+            self.request(CMD_BULK_WRITE, struct.pack("<I", off) + image[off:off + step])
+        self.request(CMD_BULK_COMMIT, struct.pack("<I", zlib.crc32(image) & 0xFFFFFFFF))
+
+    def save(self):
+        self.request(CMD_SAVE)
+
+    def get_route(self):
+        """-> (tokens, extra slot effects, -1 = empty, flags)"""
+        d = self.request(CMD_GET_ROUTE)
+        n = d[0]
+        tokens = [(d[1 + 2 * i], d[2 + 2 * i]) for i in range(n)]
+        base = 1 + 2 * n + ROUTE_EXTRA_SLOTS
+        extra = list(struct.unpack("<%db" % ROUTE_EXTRA_SLOTS, d[1 + 2 * n:base]))
+        flags = d[base] if len(d) > base else 0
+        return tokens, extra, flags
+
+    def set_route(self, tokens, extra=(-1, -1, -1), flags=0):
+        payload = bytes([len(tokens)]) + b"".join(bytes([k, a]) for k, a in tokens)
+        self.request(CMD_SET_ROUTE, payload + struct.pack("<%dbB" % ROUTE_EXTRA_SLOTS, *extra, flags))
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description="RP2040-DSP control port client")
+    ap.add_argument("-p", "--port", required=True, help="control CDC port (second ACM device)")
+    sub = ap.add_subparsers(dest="cmd", required=True)
+    sub.add_parser("ping")
+    g = sub.add_parser("get")
+    g.add_argument("effect", type=int)
+    g.add_argument("pot", type=int)
+    s = sub.add_parser("set")
+    s.add_argument("effect", type=int)
+    s.add_argument("pot", type=int)
+    s.add_argument("value", type=int)
+    t = sub.add_parser("telemetry")
+    t.add_argument("--reset", action="store_true")
+    for name in ("download", "upload"):
+        b = sub.add_parser(name)
+        b.add_argument("region", choices=sorted(REGIONS))
+        b.add_argument("file")
+    sub.add_parser("save")
+    r = sub.add_parser("route", help="show or set the routing graph")
+    r.add_argument("graph", nargs="?", help="e.g. '0 [ 1 | 3 ]40 2' (omit to show)")
+    r.add_argument("--extra", action="append", default=[], metavar="SLOT=EFFECT",
+                   help="effect of an extra slot (3..5), -1 to clear")
+    r.add_argument("--dual-mono", choices=("on", "off"),
+                   help="left input runs the graph, right input the extra slots")
+    args = ap.parse_args(argv)
+
+    try:
+        with Device(args.port) as dev:
+            if args.cmd == "ping":
+                for k, v in dev.ping().items():
+                    print("%-13s %s" % (k, v))
+            elif args.cmd == "get":
+                print(dev.get_param(args.effect, args.pot))
+            elif args.cmd == "set":
+                dev.set_params([(args.effect, args.pot, args.value)])
+            elif args.cmd == "telemetry":
+                for k, v in dev.telemetry().items():
+                    print("%-16s %s" % (k, v))
+                if args.reset:
+                    dev.reset_telemetry()
+            elif args.cmd == "download":
+                with open(args.file, "wb") as f:
+                    f.write(dev.read_region(REGIONS[args.region]))
+            elif args.cmd == "upload":
+                with open(args.file, "rb") as f:
+                    dev.write_region(REGIONS[args.region], f.read())
+            elif args.cmd == "save":
+                dev.save()
+            elif args.cmd == "route":
+                tokens, extra, flags = dev.get_route()
+                if args.graph is not None or args.extra or args.dual_mono:
+                    if args.graph is not None:
+                        tokens = parse_route(args.graph)
+                    for item in args.extra:
+                        slot, effect = (int(v) for v in item.split("="))
+                        extra[slot - 3] = effect
+                    if args.dual_mono:
+                        flags = (flags | ROUTE_DUAL_MONO) if args.dual_mono == "on" else (flags & ~ROUTE_DUAL_MONO)
+                    dev.set_route(tokens, extra, flags)
+                print("graph  %s" % format_route(tokens))
+                print("extra  %s" % " ".join("%d=%d" % (i + 3, e) for i, e in enumerate(extra)))
+                print("mode   %s" % ("dual mono (L: graph, R: extra slots)" if flags & ROUTE_DUAL_MONO else "mono"))
+    except ProtocolError as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())